@@ -0,0 +1,209 @@
+/**
+ * @file AirQualityIndex.cpp
+ * @brief Implementation of the station-wide air quality index
+ */
+
+#include "AirQualityIndex.h"
+
+#include <algorithm>
+
+namespace {
+    /**
+     * @struct Breakpoints
+     * @brief Upper limits (ug/m3) of index levels 0-4 for one parameter; higher values are level 5
+     */
+    struct Breakpoints {
+        const char* paramCode;  ///< Parameter code as used in sensors.json
+        double upper[5];        ///< Inclusive upper limits of levels 0 to 4
+    };
+
+    /**
+     * Hourly breakpoints of the Polish air quality index. CO and C6H6 are no longer
+     * part of the official index; their limits from the earlier index version are
+     * kept so every sensor of a station contributes.
+     */
+    const Breakpoints BREAKPOINTS[] = {
+        { "PM10",  { 20.0, 50.0, 80.0, 110.0, 150.0 } },
+        { "PM2.5", { 13.0, 35.0, 55.0, 75.0, 110.0 } },
+        { "NO2",   { 40.0, 100.0, 150.0, 230.0, 400.0 } },
+        { "SO2",   { 50.0, 100.0, 200.0, 350.0, 500.0 } },
+        { "O3",    { 70.0, 120.0, 150.0, 180.0, 240.0 } },
+        { "CO",    { 3000.0, 7000.0, 11000.0, 15000.0, 21000.0 } },
+        { "C6H6",  { 5.0, 10.0, 15.0, 20.0, 50.0 } },
+    };
+
+    const char* LEVEL_NAMES[AQI_LEVEL_COUNT] = {
+        "very good", "good", "moderate", "sufficient", "bad", "very bad"
+    }; ///< Names of the index levels
+
+    /**
+     * @brief Finds the breakpoints of a parameter
+     * @return Pointer to the breakpoints, or nullptr if the parameter is not indexed
+     */
+    const Breakpoints* FindBreakpoints(const std::string& paramCode) {
+        for (const auto& breakpoints : BREAKPOINTS) {
+            if (paramCode == breakpoints.paramCode) {
+                return &breakpoints;
+            }
+        }
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Checks whether a parameter takes part in the index
+ * @param paramCode Parameter code from sensors.json
+ * @return true if index breakpoints exist for the parameter, false otherwise
+ */
+bool HasAqiBreakpoints(const std::string& paramCode) {
+    return FindBreakpoints(paramCode) != nullptr;
+}
+
+/**
+ * @brief Gets the index level of a single hourly concentration
+ * @param paramCode Parameter code
+ * @param value Concentration in ug/m3
+ * @return Index level 0-5, or AQI_NO_DATA for unknown parameters and missing values
+ */
+int AqiLevelForValue(const std::string& paramCode, double value) {
+    const Breakpoints* breakpoints = FindBreakpoints(paramCode);
+    if (!breakpoints || IsMissingValue(value)) {
+        return AQI_NO_DATA;
+    }
+
+    int level = 0;
+    while (level < AQI_LEVEL_COUNT - 1 && value > breakpoints->upper[level]) {
+        level++;
+    }
+    return level;
+}
+
+/**
+ * @brief Gets the name of an index level
+ * @param level Index level 0-5 or AQI_NO_DATA
+ * @return Level name, or "no data" for levels outside the scale
+ */
+std::string AqiLevelName(int level) {
+    if (level < 0 || level >= AQI_LEVEL_COUNT) {
+        return "no data";
+    }
+    return LEVEL_NAMES[level];
+}
+
+/**
+ * @brief Finds the most recent hour with an index level
+ * @param index [out] Slot index of that hour
+ * @return true if any hour has a level, false otherwise
+ */
+bool StationAqi::FindLatestLevel(size_t& index) const {
+    for (size_t i = levels.size(); i > 0; i--) {
+        if (levels[i - 1] != AQI_NO_DATA) {
+            index = i - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Computes the hourly station index from aligned pollutant series
+ * @param pollutants Hourly series of the station's sensors
+ * @return StationAqi for the covered hours (empty if no pollutant could be indexed)
+ *
+ * The level of a value is the number of breakpoints it exceeds, computed as a sum of
+ * comparisons rather than a chain of branches, so the inner loop has no data-dependent
+ * jumps and can be vectorized by the compiler.
+ */
+StationAqi ComputeStationAqi(const std::vector<PollutantSeries>& pollutants) {
+    StationAqi result;
+
+    // Determine the common hourly axis of all indexed pollutants
+    bool found = false;
+    long long firstHour = 0;
+    long long lastHour = 0;
+    for (const auto& pollutant : pollutants) {
+        if (pollutant.series.values.empty() || !HasAqiBreakpoints(pollutant.paramCode)) {
+            continue;
+        }
+        long long seriesFirst = pollutant.series.startHour;
+        long long seriesLast = pollutant.series.HourAt(pollutant.series.values.size() - 1);
+        firstHour = found ? std::min(firstHour, seriesFirst) : seriesFirst;
+        lastHour = found ? std::max(lastHour, seriesLast) : seriesLast;
+        found = true;
+    }
+    if (!found) {
+        return result;
+    }
+
+    size_t hourCount = static_cast<size_t>(lastHour - firstHour + 1);
+    result.startHour = firstHour;
+    result.levels.assign(hourCount, AQI_NO_DATA);
+    result.dominantPollutant.assign(hourCount, -1);
+
+    // Classify every pollutant and keep the worst level per hour
+    for (const auto& pollutant : pollutants) {
+        const Breakpoints* breakpoints = FindBreakpoints(pollutant.paramCode);
+        if (!breakpoints || pollutant.series.values.empty()) {
+            continue;
+        }
+
+        int pollutantIndex = static_cast<int>(result.pollutants.size());
+        result.pollutants.push_back(pollutant.paramCode);
+
+        const double b0 = breakpoints->upper[0];
+        const double b1 = breakpoints->upper[1];
+        const double b2 = breakpoints->upper[2];
+        const double b3 = breakpoints->upper[3];
+        const double b4 = breakpoints->upper[4];
+
+        size_t offset = static_cast<size_t>(pollutant.series.startHour - firstHour);
+        const double* values = pollutant.series.values.data();
+        int* levels = result.levels.data() + offset;
+        int* dominant = result.dominantPollutant.data() + offset;
+        const size_t count = pollutant.series.values.size();
+
+        for (size_t i = 0; i < count; i++) {
+            const double value = values[i];
+            int level = (value > b0) + (value > b1) + (value > b2) + (value > b3) + (value > b4);
+            level = IsMissingValue(value) ? AQI_NO_DATA : level;
+
+            const bool worse = level > levels[i];
+            levels[i] = worse ? level : levels[i];
+            dominant[i] = worse ? pollutantIndex : dominant[i];
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Loads the latest stored data of every sensor of a station and computes its index
+ * @param stationDirectory Path of the station directory (containing sensors.json)
+ * @param pool Thread pool used to load the sensors in parallel, or nullptr to load them sequentially
+ * @return StationAqi of the station (empty if no data is stored)
+ *
+ * Parsing the data files dominates the cost, so sensors are loaded concurrently.
+ */
+StationAqi LoadStationAqi(const std::string& stationDirectory, ThreadPool* pool) {
+    return ComputeStationAqi(LoadStationSeries(stationDirectory, pool));
+}
+
+/**
+ * @brief Computes the index of every station stored in the database
+ * @param databaseDirectory Path of the measurements directory
+ * @param pool Thread pool running the computation
+ * @return Pairs of station ID and its index, sorted by station ID
+ *
+ * Parallelism is applied across stations only; nesting ParallelFor calls on the
+ * same pool would block its workers.
+ */
+std::vector<std::pair<int, StationAqi>> LoadAllStationsAqi(const std::string& databaseDirectory, ThreadPool& pool) {
+    std::vector<int> stationIds = ListNumericDirectories(databaseDirectory);
+    std::sort(stationIds.begin(), stationIds.end());
+
+    std::vector<std::pair<int, StationAqi>> results(stationIds.size());
+    pool.ParallelFor(stationIds.size(), [&](size_t i) {
+        results[i].first = stationIds[i];
+        results[i].second = LoadStationAqi(databaseDirectory + "/" + std::to_string(stationIds[i]), nullptr);
+        });
+    return results;
+}
@@ -0,0 +1,115 @@
+#ifndef AIR_QUALITY_INDEX_H
+#define AIR_QUALITY_INDEX_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SensorCatalog.h"
+#include "ThreadPool.h"
+#include "TimeSeries.h"
+
+/**
+ * @file AirQualityIndex.h
+ * @brief Station-wide air quality index computed from all sensors of a station
+ *
+ * Uses the six levels of the Polish air quality index (GIOS), which follow the
+ * structure of the European index: 0 = very good, 1 = good, 2 = moderate,
+ * 3 = sufficient, 4 = bad, 5 = very bad. The station index for an hour is the
+ * worst level of any pollutant measured in that hour, and that pollutant is
+ * reported as dominant.
+ */
+
+ /**
+  * @brief Level stored for hours in which no indexed pollutant was measured
+  */
+const int AQI_NO_DATA = -1;
+
+/**
+ * @brief Number of index levels
+ */
+const int AQI_LEVEL_COUNT = 6;
+
+/**
+ * @brief Checks whether a parameter takes part in the index
+ * @param paramCode Parameter code from sensors.json (e.g. "PM10", "PM2.5", "NO2")
+ * @return true if index breakpoints exist for the parameter, false otherwise
+ */
+bool HasAqiBreakpoints(const std::string& paramCode);
+
+/**
+ * @brief Gets the index level of a single hourly concentration
+ * @param paramCode Parameter code
+ * @param value Concentration in ug/m3
+ * @return Index level 0-5, or AQI_NO_DATA for unknown parameters and missing values
+ */
+int AqiLevelForValue(const std::string& paramCode, double value);
+
+/**
+ * @brief Gets the name of an index level
+ * @param level Index level 0-5 or AQI_NO_DATA
+ * @return Level name (e.g. "very good")
+ */
+std::string AqiLevelName(int level);
+
+/**
+ * @struct StationAqi
+ * @brief Hourly index of a station
+ *
+ * All vectors are aligned: slot i describes hour startHour + i.
+ */
+struct StationAqi {
+    long long startHour = 0;              /**< Hour (since 1970-01-01 00:00) of the first slot */
+    std::vector<int> levels;              /**< Index level per hour, AQI_NO_DATA if nothing was measured */
+    std::vector<int> dominantPollutant;   /**< Index into pollutants of the worst pollutant per hour, -1 if none */
+    std::vector<std::string> pollutants;  /**< Parameter codes of the pollutants taking part in the index */
+
+    /**
+     * @brief Gets the hour of the given slot
+     * @param index Slot index
+     * @return Hours since 1970-01-01 00:00
+     */
+    long long HourAt(size_t index) const { return startHour + static_cast<long long>(index); }
+
+    /**
+     * @brief Finds the most recent hour with an index level
+     * @param index [out] Slot index of that hour
+     * @return true if any hour has a level, false otherwise
+     */
+    bool FindLatestLevel(size_t& index) const;
+};
+
+/**
+ * @brief Computes the hourly station index from aligned pollutant series
+ *
+ * The series are placed on a common hourly axis covering all of them. Each pollutant
+ * is then classified in a single branch-free pass over its contiguous values, which
+ * also keeps the running worst level and dominant pollutant per hour. Series of
+ * parameters without breakpoints are ignored.
+ *
+ * @param pollutants Hourly series of the station's sensors
+ * @return StationAqi for the covered hours (empty if no pollutant could be indexed)
+ */
+StationAqi ComputeStationAqi(const std::vector<PollutantSeries>& pollutants);
+
+/**
+ * @brief Loads the latest stored data of every sensor of a station and computes its index
+ *
+ * @param stationDirectory Path of the station directory (containing sensors.json)
+ * @param pool Thread pool used to load the sensors in parallel, or nullptr to load them sequentially
+ * @return StationAqi of the station (empty if no data is stored)
+ */
+StationAqi LoadStationAqi(const std::string& stationDirectory, ThreadPool* pool);
+
+/**
+ * @brief Computes the index of every station stored in the database
+ *
+ * Stations are processed in parallel, each one on a single worker.
+ *
+ * @param databaseDirectory Path of the measurements directory
+ * @param pool Thread pool running the computation
+ * @return Pairs of station ID and its index, sorted by station ID
+ */
+std::vector<std::pair<int, StationAqi>> LoadAllStationsAqi(const std::string& databaseDirectory, ThreadPool& pool);
+
+#endif // AIR_QUALITY_INDEX_H
@@ -0,0 +1,322 @@
+/**
+ * @file AnomalyDetection.cpp
+ * @brief Implementation of the streaming anomaly detector
+ */
+
+#include "AnomalyDetection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+
+#include "JsonFiles.h"
+
+namespace {
+    const std::string ANOMALY_STORE_DIRECTORY = "store";       ///< Subdirectory of a sensor directory holding derived data
+    const std::string ANOMALY_STORE_FILE = "anomalies.json";   ///< File name of the detector state
+    const std::string ANOMALY_STORE_MONTHS = "anomalies";      ///< Subdirectory of the store holding one flag file per month
+    const long long WARMUP_VALUES = 24;                        ///< Values processed before z-scores are evaluated
+    const double LOCATION_WEIGHT = 1.0 / 72.0;                 ///< Weight of a new value in location and scale (about three days)
+    const double CLIP_LIMIT = 3.0;                             ///< Residuals are clipped at this many scales before updating
+    const double MIN_SCALE = 0.05;                             ///< Lower bound of the log-scale spread, so constant data does not give infinite z-scores
+    const double ABS_DEVIATION_TO_SIGMA = 1.2533;              ///< Ratio of standard deviation to mean absolute deviation for normal data
+    const double Z_SCORE_LIMIT = 5.0;                          ///< Robust z-score above which a value is an outlier
+    const int STUCK_HOURS = 8;                                 ///< Consecutive identical values flagged as a stuck sensor
+    const double SPIKE_RATIO = 10.0;                           ///< Rise relative to the previous hour flagged as a spike
+    const double SPIKE_FLOOR = 5.0;                            ///< Smallest previous value used for the spike ratio (ug/m3)
+    const long long SPIKE_MAX_GAP_HOURS = 3;                   ///< Spikes are only detected against a value at most this old
+
+    /**
+     * @brief Returns the path of the flag file of a month
+     */
+    std::string MonthFilePath(const std::string& sensorDirectory, const std::string& month) {
+        return sensorDirectory + "/" + ANOMALY_STORE_DIRECTORY + "/" + ANOMALY_STORE_MONTHS + "/" + month + ".json";
+    }
+
+    /**
+     * @brief Moves the flags kept in the state file by earlier versions into monthly files
+     *
+     * The monthly files are written before the state file is rewritten without its flags,
+     * so an interrupted migration is simply repeated on the next load.
+     */
+    void MigrateLegacyFlags(const std::string& sensorDirectory) {
+        std::string path = sensorDirectory + "/" + ANOMALY_STORE_DIRECTORY + "/" + ANOMALY_STORE_FILE;
+        Json::Value root;
+        if (!std::filesystem::exists(path) || !LoadJsonFromFile(path, root) || !root.isMember("flags")) {
+            return;
+        }
+
+        std::map<std::string, Json::Value> monthFiles;
+        const Json::Value& storedFlags = root["flags"];
+        for (const auto& timestamp : storedFlags.getMemberNames()) {
+            if (timestamp.length() >= 7) {
+                monthFiles[timestamp.substr(0, 7)][timestamp] = storedFlags[timestamp];
+            }
+        }
+
+        try {
+            std::filesystem::create_directories(sensorDirectory + "/" + ANOMALY_STORE_DIRECTORY + "/" + ANOMALY_STORE_MONTHS);
+            for (auto& [month, monthRoot] : monthFiles) {
+                SaveToFile(monthRoot, MonthFilePath(sensorDirectory, month));
+            }
+            root.removeMember("flags");
+            SaveToFile(root, path);
+        }
+        catch (const std::exception&) {
+            // Keep the old file; the migration is retried on the next load
+        }
+    }
+}
+
+/**
+ * @brief Describes the flags of an hour
+ * @param flags Combination of AnomalyFlag values
+ * @return Comma-separated names (e.g. "negative, spike"), empty for ANOMALY_NONE
+ */
+std::string DescribeAnomalyFlags(int flags) {
+    static const std::pair<int, const char*> names[] = {
+        { ANOMALY_NEGATIVE, "negative" },
+        { ANOMALY_SPIKE, "spike" },
+        { ANOMALY_STUCK, "stuck" },
+        { ANOMALY_OUTLIER, "outlier" }
+    };
+
+    std::string description;
+    for (const auto& [flag, name] : names) {
+        if (flags & flag) {
+            if (!description.empty()) {
+                description += ", ";
+            }
+            description += name;
+        }
+    }
+    return description;
+}
+
+/**
+ * @brief Processes one measured value
+ * @param hour Hour of the value
+ * @param value Measured value
+ * @return Combination of AnomalyFlag values for the hour
+ *
+ * The value is first checked against the state and then folded into it. During the
+ * first values location and scale are plain running averages; afterwards residuals are
+ * clipped at a few scales, so a single wild value moves the estimates only slightly.
+ */
+int SensorAnomalyDetector::Process(long long hour, double value) {
+    int result = ANOMALY_NONE;
+
+    if (value < 0.0) {
+        result |= ANOMALY_NEGATIVE;
+    }
+
+    if (state.count > 0 && hour - state.lastHour <= SPIKE_MAX_GAP_HOURS
+        && value >= SPIKE_RATIO * std::max(state.lastValue, SPIKE_FLOOR)) {
+        result |= ANOMALY_SPIKE;
+    }
+
+    state.repeatCount = (state.count > 0 && value == state.lastValue) ? state.repeatCount + 1 : 1;
+    if (state.repeatCount >= STUCK_HOURS) {
+        result |= ANOMALY_STUCK;
+    }
+
+    // Concentrations are right-skewed, so the z-score is taken on a logarithmic scale
+    double transformed = std::log1p(std::max(value, 0.0));
+    double residual = transformed - state.location;
+    double scale = std::max(state.scale, MIN_SCALE);
+    if (state.count >= WARMUP_VALUES && std::abs(residual) / (ABS_DEVIATION_TO_SIGMA * scale) > Z_SCORE_LIMIT) {
+        result |= ANOMALY_OUTLIER;
+    }
+
+    // Fold the value into the robust location and scale
+    if (state.count == 0) {
+        state.location = transformed;
+        state.scale = 0.0;
+    }
+    else if (state.count < WARMUP_VALUES) {
+        double weight = 1.0 / static_cast<double>(state.count + 1);
+        state.location += weight * residual;
+        state.scale += weight * (std::abs(residual) - state.scale);
+    }
+    else {
+        double limit = CLIP_LIMIT * scale;
+        state.location += LOCATION_WEIGHT * std::max(-limit, std::min(limit, residual));
+        state.scale += LOCATION_WEIGHT * (std::min(std::abs(residual), limit) - state.scale);
+    }
+
+    state.lastHour = hour;
+    state.lastValue = value;
+    state.count++;
+    return result;
+}
+
+/**
+ * @brief Runs the detector over the hours of a series newer than the last processed hour
+ * @param series Measurements aligned to an hourly grid
+ * @return true if the state changed, false if the series held no new hours
+ *
+ * Hours that were already processed are skipped, so overlapping downloads are only
+ * examined once and the result does not depend on how the data was split into files.
+ */
+bool SensorAnomalyDetector::Ingest(const HourlySeries& series) {
+    bool changed = false;
+    for (size_t i = 0; i < series.values.size(); i++) {
+        long long hour = series.HourAt(i);
+        if ((state.count > 0 && hour <= state.lastHour) || IsMissingValue(series.values[i])) {
+            continue;
+        }
+
+        int result = Process(hour, series.values[i]);
+        if (result != ANOMALY_NONE) {
+            // Merge with the month's stored flags, since the whole month file is rewritten
+            std::string month = FormatHoursAsTimestamp(hour).substr(0, 7);
+            LoadMonth(month);
+            flags[hour] = result;
+            changedMonths.insert(month);
+        }
+        changed = true;
+    }
+    return changed;
+}
+
+/**
+ * @brief Gets the flags of a range of hours
+ * @param firstHour First hour (since 1970-01-01 00:00)
+ * @param count Number of hours
+ * @return One entry per hour, ANOMALY_NONE for unflagged hours
+ */
+std::vector<int> SensorAnomalyDetector::GetFlags(long long firstHour, size_t count) const {
+    std::vector<int> result(count, ANOMALY_NONE);
+    long long endHour = firstHour + static_cast<long long>(count);
+    for (auto it = flags.lower_bound(firstHour); it != flags.end() && it->first < endHour; ++it) {
+        result[static_cast<size_t>(it->first - firstHour)] = it->second;
+    }
+    return result;
+}
+
+/**
+ * @brief Loads the detector state from "store/anomalies.json" and the flags of a range of hours
+ *        from "store/anomalies/<YYYY-MM>.json" inside the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param firstHour First hour whose flags are needed (since 1970-01-01 00:00)
+ * @param lastHour Last hour whose flags are needed, inclusive
+ * @return true if a stored detector file was found and parsed, false otherwise
+ *
+ * Ingest() reads the other months it adds flags to. An empty range loads the state only.
+ */
+bool SensorAnomalyDetector::Load(const std::string& sensorDirectory, long long firstHour, long long lastHour) {
+    state = State();
+    flags.clear();
+    directory = sensorDirectory;
+    loadedMonths.clear();
+    changedMonths.clear();
+
+    MigrateLegacyFlags(sensorDirectory);
+
+    if (firstHour <= lastHour) {
+        for (const auto& month : ListMonths(FormatHoursAsTimestamp(firstHour), FormatHoursAsTimestamp(lastHour))) {
+            LoadMonth(month);
+        }
+    }
+
+    Json::Value root;
+    std::string path = sensorDirectory + "/" + ANOMALY_STORE_DIRECTORY + "/" + ANOMALY_STORE_FILE;
+    if (!std::filesystem::exists(path) || !LoadJsonFromFile(path, root)) {
+        return false;
+    }
+
+    const Json::Value& stored = root["state"];
+    state.lastHour = stored["lastHour"].asInt64();
+    state.lastValue = stored["lastValue"].asDouble();
+    state.repeatCount = stored["repeatCount"].asInt();
+    state.location = stored["location"].asDouble();
+    state.scale = stored["scale"].asDouble();
+    state.count = stored["count"].asInt64();
+    return true;
+}
+
+/**
+ * @brief Reads the flags of a month unless they were read already
+ * @param month Month key ("YYYY-MM")
+ */
+void SensorAnomalyDetector::LoadMonth(const std::string& month) {
+    if (directory.empty() || !loadedMonths.insert(month).second) {
+        return;
+    }
+
+    Json::Value storedFlags;
+    std::string path = MonthFilePath(directory, month);
+    if (!std::filesystem::exists(path) || !LoadJsonFromFile(path, storedFlags)) {
+        return;
+    }
+    for (const auto& timestamp : storedFlags.getMemberNames()) {
+        long long hour;
+        if (ParseTimestampToHours(timestamp, hour)) {
+            flags[hour] = storedFlags[timestamp].asInt();
+        }
+    }
+}
+
+/**
+ * @brief Writes the detector state into "store/anomalies.json" and the flags of the changed
+ *        months into "store/anomalies" inside the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @return true if the files were written successfully, false otherwise
+ */
+bool SensorAnomalyDetector::Save(const std::string& sensorDirectory) const {
+    std::string storeDirectory = sensorDirectory + "/" + ANOMALY_STORE_DIRECTORY;
+
+    Json::Value root;
+    Json::Value& stored = root["state"];
+    stored["lastHour"] = static_cast<Json::Int64>(state.lastHour);
+    stored["lastValue"] = state.lastValue;
+    stored["repeatCount"] = state.repeatCount;
+    stored["location"] = state.location;
+    stored["scale"] = state.scale;
+    stored["count"] = static_cast<Json::Int64>(state.count);
+
+    try {
+        std::filesystem::create_directories(storeDirectory + "/" + ANOMALY_STORE_MONTHS);
+        for (const auto& month : changedMonths) {
+            // Hours of a month lie between its first hour and the first hour of the next month
+            Json::Value monthFlags(Json::objectValue);
+            long long firstHour;
+            if (!ParseTimestampToHours(month + "-01 00:00:00", firstHour)) {
+                continue;
+            }
+            for (auto it = flags.lower_bound(firstHour); it != flags.end(); ++it) {
+                std::string timestamp = FormatHoursAsTimestamp(it->first);
+                if (timestamp.compare(0, 7, month) != 0) {
+                    break;
+                }
+                monthFlags[timestamp] = it->second;
+            }
+            SaveToFile(monthFlags, MonthFilePath(sensorDirectory, month));
+        }
+        return SaveToFile(root, storeDirectory + "/" + ANOMALY_STORE_FILE);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Runs the anomaly detector of a sensor over freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param series Downloaded measurements aligned to an hourly grid
+ * @return true if the detector was updated successfully, false otherwise
+ *
+ * Aligning the API's newest-first values to the hourly grid puts them in time order, as
+ * the detector requires. Only the state file and the months that gained flags are
+ * rewritten, and only when the download contained new hours.
+ * The caller holds LockSensorStore() of the sensor directory.
+ */
+bool UpdateSensorAnomalyFlags(const std::string& sensorDirectory, const HourlySeries& series) {
+    SensorAnomalyDetector detector;
+    detector.Load(sensorDirectory, 0, -1);
+    if (!detector.Ingest(series)) {
+        return true;
+    }
+    return detector.Save(sensorDirectory);
+}
@@ -0,0 +1,127 @@
+#ifndef ANOMALY_DETECTION_H
+#define ANOMALY_DETECTION_H
+
+#include <json/json.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "TimeSeries.h"
+
+/**
+ * @file AnomalyDetection.h
+ * @brief Online detection of implausible sensor readings with per-sensor flag storage
+ */
+
+ /**
+  * @brief Kinds of anomalies, combined as bit flags per hour
+  */
+enum AnomalyFlag {
+    ANOMALY_NONE = 0,       /**< Plausible value */
+    ANOMALY_NEGATIVE = 1,   /**< Negative concentration */
+    ANOMALY_SPIKE = 2,      /**< Jump to at least ten times the previous hour */
+    ANOMALY_STUCK = 4,      /**< Same value repeated for many consecutive hours */
+    ANOMALY_OUTLIER = 8     /**< Robust z-score far outside the recent distribution */
+};
+
+/**
+ * @brief Describes the flags of an hour
+ * @param flags Combination of AnomalyFlag values
+ * @return Comma-separated names (e.g. "negative, spike"), empty for ANOMALY_NONE
+ */
+std::string DescribeAnomalyFlags(int flags);
+
+/**
+ * @class SensorAnomalyDetector
+ * @brief Streaming anomaly detector with constant-size state per sensor
+ *
+ * Values are processed in time order, each in constant time:
+ * - the robust z-score compares the logarithm of a value with an exponentially weighted
+ *   location and scale (median / MAD analogues updated with clipped residuals, so
+ *   outliers barely move them)
+ * - the stuck-value check counts how many consecutive hours repeated the same value
+ * - the rate-of-change check compares a value with the previous hour
+ *
+ * Only hours with at least one flag are stored, so the flag map stays small. The state is
+ * stored in one small file and the flags in one file per month; only the months a caller
+ * touches are read and rewritten. Load and Save must be called under LockSensorStore()
+ * of the sensor directory.
+ */
+class SensorAnomalyDetector {
+public:
+    /**
+     * @brief Loads the detector state and the flags of a range of hours from a sensor directory
+     * @param sensorDirectory Directory containing the sensor's measurement files
+     * @param firstHour First hour whose flags are needed (since 1970-01-01 00:00)
+     * @param lastHour Last hour whose flags are needed, inclusive
+     * @return true if a stored detector file was found and parsed, false otherwise
+     */
+    bool Load(const std::string& sensorDirectory, long long firstHour, long long lastHour);
+
+    /**
+     * @brief Saves the detector state and the flags of the changed months into the sensor directory
+     * @param sensorDirectory Directory containing the sensor's measurement files
+     * @return true if the file was written successfully, false otherwise
+     */
+    bool Save(const std::string& sensorDirectory) const;
+
+    /**
+     * @brief Runs the detector over the hours of a series newer than the last processed hour
+     * @param series Measurements aligned to an hourly grid
+     * @return true if the state changed, false if the series held no new hours
+     */
+    bool Ingest(const HourlySeries& series);
+
+    /**
+     * @brief Gets the flags of a range of hours
+     * @param firstHour First hour (since 1970-01-01 00:00)
+     * @param count Number of hours
+     * @return One entry per hour, ANOMALY_NONE for unflagged hours
+     */
+    std::vector<int> GetFlags(long long firstHour, size_t count) const;
+
+private:
+    /**
+     * @struct State
+     * @brief Everything the detector remembers between values
+     */
+    struct State {
+        long long lastHour = 0;       /**< Hour of the last processed value */
+        double lastValue = 0.0;       /**< Last measured value */
+        int repeatCount = 0;          /**< Consecutive measured hours holding lastValue */
+        double location = 0.0;        /**< Robust running location (median analogue) */
+        double scale = 0.0;           /**< Robust running scale (mean absolute deviation of clipped residuals) */
+        long long count = 0;          /**< Number of values processed */
+    };
+
+    State state;                         /**< Detector state */
+    std::map<long long, int> flags;      /**< Flags of anomalous hours keyed by hour */
+    std::string directory;               /**< Sensor directory the flags are read from */
+    std::set<std::string> loadedMonths;  /**< Months whose flags were read from disk (or found missing) */
+    std::set<std::string> changedMonths; /**< Months with flags added since loading */
+
+    /**
+     * @brief Reads the flags of a month unless they were read already
+     * @param month Month key ("YYYY-MM")
+     */
+    void LoadMonth(const std::string& month);
+
+    /**
+     * @brief Processes one measured value
+     * @param hour Hour of the value
+     * @param value Measured value
+     * @return Combination of AnomalyFlag values for the hour
+     */
+    int Process(long long hour, double value);
+};
+
+/**
+ * @brief Runs the anomaly detector of a sensor over freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param series Downloaded measurements aligned to an hourly grid
+ * @return true if the detector was updated successfully, false otherwise
+ */
+bool UpdateSensorAnomalyFlags(const std::string& sensorDirectory, const HourlySeries& series);
+
+#endif // ANOMALY_DETECTION_H
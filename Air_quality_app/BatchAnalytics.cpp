@@ -0,0 +1,262 @@
+/**
+ * @file BatchAnalytics.cpp
+ * @brief Implementation of the batch analytics job
+ */
+
+#include "BatchAnalytics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <locale>
+#include <memory>
+
+#include <json/json.h>
+
+#include "AirQualityIndex.h"
+#include "Forecasting.h"
+#include "SensorCatalog.h"
+#include "SensorStores.h"
+
+namespace {
+    const int AQI_BAD_LEVEL = 4; ///< Index level ("bad") from which an hour is counted as a bad-air hour
+
+    /**
+     * @brief Quotes a CSV field if it contains separators, quotes or line breaks
+     */
+    std::string EscapeCsv(const std::string& field) {
+        if (field.find_first_of(",\"\n") == std::string::npos) {
+            return field;
+        }
+        std::string escaped = "\"";
+        for (char c : field) {
+            if (c == '"') {
+                escaped += '"';
+            }
+            escaped += c;
+        }
+        return escaped + "\"";
+    }
+
+    /**
+     * @brief Analyses one sensor directory and fills its report entry
+     *
+     * Runs on a worker thread; writes only to the given entry and to the sensor's own
+     * forecast model file.
+     */
+    void AnalyzeSensor(const std::string& sensorDirectory, SensorReport& report) {
+        if (ListDataFiles(sensorDirectory).empty()) {
+            report.error = "no data files";
+            return;
+        }
+
+        HourlySeries series = LoadSensorHistory(sensorDirectory, nullptr, &report.fileCount, &report.paramCode);
+        if (series.values.empty()) {
+            report.error = report.fileCount == 0 ? "unreadable data files" : "no valid measurements";
+            return;
+        }
+
+        report.hoursCovered = series.values.size();
+        report.firstTimestamp = FormatHoursAsTimestamp(series.startHour);
+        report.lastTimestamp = FormatHoursAsTimestamp(series.HourAt(series.values.size() - 1));
+        report.statistics = ComputeSeriesStatistics(series);
+        report.trend = AnalyzeSeriesTrend(series);
+
+        // Refit the forecast model on the merged history. The history was read without the
+        // store lock, so a download may have stored a newer model meanwhile; that one is kept
+        HoltWintersModel model;
+        if (model.Fit(series)) {
+            report.forecastFitted = true;
+            report.forecastErrorStdDev = model.GetErrorStdDev();
+
+            std::unique_lock<std::mutex> storeLock = LockSensorStore(sensorDirectory);
+            HoltWintersModel stored;
+            if (!stored.Load(sensorDirectory) || stored.GetLastHour() < model.GetLastHour()) {
+                model.Save(sensorDirectory);
+            }
+        }
+
+        // Classify the hours with the index engine; the series is no longer needed afterwards
+        std::vector<PollutantSeries> pollutant(1);
+        pollutant[0].paramCode = report.paramCode;
+        pollutant[0].series = std::move(series);
+        StationAqi aqi = ComputeStationAqi(pollutant);
+        report.aqiBadHours = static_cast<size_t>(std::count_if(aqi.levels.begin(), aqi.levels.end(),
+            [](int level) { return level >= AQI_BAD_LEVEL; }));
+    }
+}
+
+/**
+ * @brief Gets the throughput of the run
+ * @return Analysed sensors per second (0 if the run took no measurable time)
+ */
+double BatchReport::SensorsPerSecond() const {
+    return (elapsedSeconds > 0.0) ? static_cast<double>(sensors.size()) / elapsedSeconds : 0.0;
+}
+
+/**
+ * @brief Analyses every sensor stored in the database
+ * @param databaseDirectory Path of the measurements directory
+ * @param pool Thread pool running the analysis
+ * @param cancel Token skipping the remaining sensors when cancelled
+ * @return BatchReport with one entry per sensor
+ *
+ * This function:
+ * 1. Walks measurements/<stationId>/<sensorId> and reads each station's sensors.json for parameter codes
+ * 2. Preallocates one report entry per sensor
+ * 3. Analyses the sensors on the thread pool (statistics, trend, bad-air hours and forecast model)
+ * 4. Records the elapsed time for the throughput figure
+ */
+BatchReport RunBatchAnalytics(const std::string& databaseDirectory, ThreadPool& pool, const CancellationToken& cancel) {
+    BatchReport report;
+    report.workerCount = pool.Size();
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Collect the sensor directories of all stations
+    std::vector<std::string> sensorDirectories;
+    std::vector<int> stationIds = ListNumericDirectories(databaseDirectory);
+    std::sort(stationIds.begin(), stationIds.end());
+    for (int stationId : stationIds) {
+        std::string stationDirectory = databaseDirectory + "/" + std::to_string(stationId);
+
+        std::vector<SensorInfo> sensors;
+        LoadStationSensors(stationDirectory, sensors);
+
+        std::vector<int> sensorIds = ListNumericDirectories(stationDirectory);
+        std::sort(sensorIds.begin(), sensorIds.end());
+        for (int sensorId : sensorIds) {
+            SensorReport entry;
+            entry.stationId = stationId;
+            entry.sensorId = sensorId;
+            auto info = std::find_if(sensors.begin(), sensors.end(),
+                [sensorId](const SensorInfo& sensor) { return sensor.id == sensorId; });
+            if (info != sensors.end()) {
+                entry.paramCode = info->paramCode;
+            }
+            report.sensors.push_back(entry);
+            sensorDirectories.push_back(stationDirectory + "/" + std::to_string(sensorId));
+        }
+    }
+
+    // Analyse all sensors in parallel, each worker writing only to its own entries
+    pool.ParallelFor(report.sensors.size(), [&](size_t i) {
+        if (cancel.IsCancelled()) {
+            report.sensors[i].error = "cancelled";
+            return;
+        }
+        AnalyzeSensor(sensorDirectories[i], report.sensors[i]);
+        });
+
+    report.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+/**
+ * @brief Writes a batch report as CSV (one row per sensor)
+ * @param report Report to write
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ *
+ * Numbers are always written with a decimal point, independent of the user's locale.
+ */
+bool WriteBatchReportCsv(const BatchReport& report, const std::string& filePath) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.imbue(std::locale::classic());
+
+    file << "station_id,sensor_id,param_code,files,hours_covered,measurements,first_hour,last_hour,"
+        "min,max,mean,trend_slope_per_day,trend_change_percent,trend_p_value,trend,aqi_bad_hours,"
+        "forecast_error_sd,error\n";
+
+    for (const auto& sensor : report.sensors) {
+        file << sensor.stationId << ',' << sensor.sensorId << ',' << EscapeCsv(sensor.paramCode) << ','
+            << sensor.fileCount << ',' << sensor.hoursCovered << ',' << sensor.statistics.count << ','
+            << sensor.firstTimestamp << ',' << sensor.lastTimestamp << ',';
+
+        if (sensor.error.empty()) {
+            file << sensor.statistics.min << ',' << sensor.statistics.max << ',' << sensor.statistics.mean << ',';
+            if (sensor.trend.valid) {
+                file << sensor.trend.slopePerHour * 24.0 << ',' << sensor.trend.percentChange << ','
+                    << sensor.trend.pValue << ',';
+            }
+            else {
+                file << ",,,";
+            }
+            file << EscapeCsv(DescribeTrend(sensor.trend)) << ',' << sensor.aqiBadHours << ',';
+            if (sensor.forecastFitted) {
+                file << sensor.forecastErrorStdDev;
+            }
+            file << ",\n";
+        }
+        else {
+            file << ",,,,,,,,," << EscapeCsv(sensor.error) << '\n';
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Writes a batch report as JSON, including the run's throughput
+ * @param report Report to write
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ */
+bool WriteBatchReportJson(const BatchReport& report, const std::string& filePath) {
+    Json::Value root;
+    root["sensorCount"] = static_cast<Json::UInt64>(report.sensors.size());
+    root["workerCount"] = static_cast<Json::UInt64>(report.workerCount);
+    root["elapsedSeconds"] = report.elapsedSeconds;
+    root["sensorsPerSecond"] = report.SensorsPerSecond();
+
+    Json::Value sensors(Json::arrayValue);
+    for (const auto& sensor : report.sensors) {
+        Json::Value entry;
+        entry["stationId"] = sensor.stationId;
+        entry["sensorId"] = sensor.sensorId;
+        entry["paramCode"] = sensor.paramCode;
+        entry["files"] = static_cast<Json::UInt64>(sensor.fileCount);
+
+        if (!sensor.error.empty()) {
+            entry["error"] = sensor.error;
+            sensors.append(entry);
+            continue;
+        }
+
+        entry["hoursCovered"] = static_cast<Json::UInt64>(sensor.hoursCovered);
+        entry["measurements"] = static_cast<Json::UInt64>(sensor.statistics.count);
+        entry["firstHour"] = sensor.firstTimestamp;
+        entry["lastHour"] = sensor.lastTimestamp;
+        entry["min"] = sensor.statistics.min;
+        entry["max"] = sensor.statistics.max;
+        entry["mean"] = sensor.statistics.mean;
+        entry["aqiBadHours"] = static_cast<Json::UInt64>(sensor.aqiBadHours);
+        if (sensor.forecastFitted) {
+            entry["forecastErrorStdDev"] = sensor.forecastErrorStdDev;
+        }
+
+        Json::Value trend;
+        trend["description"] = DescribeTrend(sensor.trend);
+        if (sensor.trend.valid) {
+            trend["slopePerDay"] = sensor.trend.slopePerHour * 24.0;
+            trend["changePercent"] = sensor.trend.percentChange;
+            trend["pValue"] = sensor.trend.pValue;
+            trend["seasonal"] = sensor.trend.seasonal;
+        }
+        entry["trend"] = trend;
+        sensors.append(entry);
+    }
+    root["sensors"] = sensors;
+
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        return false;
+    }
+    Json::StreamWriterBuilder writerBuilder;
+    writerBuilder["indentation"] = "  ";
+    std::unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+    writer->write(root, &file);
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,86 @@
+#ifndef BATCH_ANALYTICS_H
+#define BATCH_ANALYTICS_H
+
+#include <string>
+#include <vector>
+
+#include "CancellationToken.h"
+#include "ThreadPool.h"
+#include "TimeSeries.h"
+#include "TrendAnalysis.h"
+
+/**
+ * @file BatchAnalytics.h
+ * @brief Analysis of every stored sensor in one parallel batch job with a consolidated report
+ */
+
+ /**
+  * @struct SensorReport
+  * @brief Analysis result of one sensor
+  *
+  * All data files stored for the sensor are merged into one hourly series and analysed
+  * with the same statistics and trend engine as the interactive view.
+  */
+struct SensorReport {
+    int stationId = -1;               /**< ID of the station */
+    int sensorId = -1;                /**< ID of the sensor */
+    std::string paramCode;            /**< Parameter code (from sensors.json or the data files) */
+    size_t fileCount = 0;             /**< Number of data files that were read */
+    size_t hoursCovered = 0;          /**< Length of the hourly grid from first to last measurement */
+    std::string firstTimestamp;       /**< Timestamp of the first hour of the grid */
+    std::string lastTimestamp;        /**< Timestamp of the last hour of the grid */
+    SeriesStatistics statistics;      /**< Minimum, maximum and average over the measured hours */
+    TrendResult trend;                /**< Theil-Sen / Mann-Kendall trend */
+    size_t aqiBadHours = 0;           /**< Hours at air quality index level "bad" or worse for the parameter (not limit value exceedances) */
+    bool forecastFitted = false;      /**< Whether a forecast model was fitted (stored unless a newer one was on disk) */
+    double forecastErrorStdDev = 0.0; /**< One-step-ahead error standard deviation of the forecast model */
+    std::string error;                /**< Reason why the sensor could not be analysed, empty on success */
+};
+
+/**
+ * @struct BatchReport
+ * @brief Results of a batch run together with its performance figures
+ */
+struct BatchReport {
+    std::vector<SensorReport> sensors;  /**< One entry per sensor directory, ordered by station and sensor ID */
+    double elapsedSeconds = 0.0;        /**< Wall-clock duration of the analysis */
+    size_t workerCount = 0;             /**< Number of worker threads used */
+
+    /**
+     * @brief Gets the throughput of the run
+     * @return Analysed sensors per second
+     */
+    double SensorsPerSecond() const;
+};
+
+/**
+ * @brief Analyses every sensor stored in the database
+ *
+ * The catalog is walked once to collect the sensor directories, which are then
+ * analysed independently on the thread pool. Workers share no mutable state apart
+ * from their own slot of the result vector, so the run scales with the number of cores.
+ *
+ * @param databaseDirectory Path of the measurements directory
+ * @param pool Thread pool running the analysis
+ * @param cancel Token skipping the remaining sensors when cancelled
+ * @return BatchReport with one entry per sensor
+ */
+BatchReport RunBatchAnalytics(const std::string& databaseDirectory, ThreadPool& pool, const CancellationToken& cancel = CancellationToken());
+
+/**
+ * @brief Writes a batch report as CSV (one row per sensor)
+ * @param report Report to write
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ */
+bool WriteBatchReportCsv(const BatchReport& report, const std::string& filePath);
+
+/**
+ * @brief Writes a batch report as JSON, including the run's throughput
+ * @param report Report to write
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ */
+bool WriteBatchReportJson(const BatchReport& report, const std::string& filePath);
+
+#endif // BATCH_ANALYTICS_H
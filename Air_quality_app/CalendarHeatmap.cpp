@@ -0,0 +1,71 @@
+/**
+ * @file CalendarHeatmap.cpp
+ * @brief Implementation of the day-by-hour calendar aggregate
+ */
+
+#include "CalendarHeatmap.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    const double SCALE_QUANTILE = 0.99; ///< Quantile of the measured values used as the top of the colour scale
+
+    /**
+     * @brief Gets the day containing an hour, rounding towards negative infinity
+     */
+    long long DayOfHour(long long hour) {
+        long long day = hour / CalendarAggregate::HOURS_PER_DAY;
+        return (hour % CalendarAggregate::HOURS_PER_DAY < 0) ? day - 1 : day;
+    }
+}
+
+/**
+ * @brief Arranges an hourly series into a day-by-hour grid
+ * @param series Measurements aligned to an hourly grid
+ * @return CalendarAggregate of the series (no columns if the series has no measurements)
+ *
+ * This function:
+ * 1. Sizes the grid to the whole days touched by the series
+ * 2. Writes every hour into its cell in one pass over the series
+ * 3. Computes the value range and the 99th percentile for the colour scale
+ */
+CalendarAggregate BuildCalendarAggregate(const HourlySeries& series) {
+    CalendarAggregate aggregate;
+    if (series.values.empty() || series.ValidCount() == 0) {
+        return aggregate;
+    }
+
+    const int hoursPerDay = CalendarAggregate::HOURS_PER_DAY;
+    long long lastHour = series.HourAt(series.values.size() - 1);
+    aggregate.firstDay = DayOfHour(series.startHour);
+    aggregate.dayCount = static_cast<size_t>(DayOfHour(lastHour) - aggregate.firstDay + 1);
+    aggregate.values.assign(hoursPerDay * aggregate.dayCount, std::numeric_limits<float>::quiet_NaN());
+
+    // Hour h of day d lands in row h, column d
+    std::vector<float> measured;
+    measured.reserve(series.values.size());
+    long long firstGridHour = aggregate.firstDay * hoursPerDay;
+    for (size_t i = 0; i < series.values.size(); i++) {
+        if (IsMissingValue(series.values[i])) {
+            continue;
+        }
+        long long offset = series.HourAt(i) - firstGridHour;
+        size_t day = static_cast<size_t>(offset / hoursPerDay);
+        size_t hour = static_cast<size_t>(offset % hoursPerDay);
+        float value = static_cast<float>(series.values[i]);
+        aggregate.values[hour * aggregate.dayCount + day] = value;
+        measured.push_back(value);
+    }
+
+    aggregate.measuredHours = measured.size();
+    auto range = std::minmax_element(measured.begin(), measured.end());
+    aggregate.minValue = *range.first;
+    aggregate.maxValue = *range.second;
+
+    // Cap the colour scale so that single extreme hours keep their own colour only
+    size_t quantileIndex = static_cast<size_t>(SCALE_QUANTILE * (measured.size() - 1));
+    std::nth_element(measured.begin(), measured.begin() + quantileIndex, measured.end());
+    aggregate.scaleMax = std::max(static_cast<double>(measured[quantileIndex]), aggregate.minValue);
+    return aggregate;
+}
@@ -0,0 +1,68 @@
+#ifndef CALENDAR_HEATMAP_H
+#define CALENDAR_HEATMAP_H
+
+#include <cstddef>
+#include <vector>
+
+#include "TimeSeries.h"
+
+/**
+ * @file CalendarHeatmap.h
+ * @brief Day-by-hour aggregate of an hourly series for the calendar heatmap view
+ */
+
+ /**
+  * @struct CalendarAggregate
+  * @brief Hourly values arranged as a grid of 24 hour rows by one column per day
+  *
+  * The values are stored row by row (hour-major), which is the pixel order of an image
+  * with one pixel per cell, so the heatmap can be coloured in one linear pass.
+  * The grid is built once per series; redrawing and resizing only scale the image.
+  */
+struct CalendarAggregate {
+    static const int HOURS_PER_DAY = 24; /**< Number of rows of the grid */
+
+    long long firstDay = 0;      /**< Day (since 1970-01-01) of the first column */
+    size_t dayCount = 0;         /**< Number of columns */
+    std::vector<float> values;   /**< HOURS_PER_DAY * dayCount values, NaN where nothing was measured */
+    size_t measuredHours = 0;    /**< Number of cells holding a measurement */
+    double minValue = 0.0;       /**< Smallest measured value */
+    double maxValue = 0.0;       /**< Largest measured value */
+    double scaleMax = 0.0;       /**< 99th percentile of the measured values, the top of the colour scale */
+
+    /**
+     * @brief Gets the value of a cell
+     * @param hour Hour of day (row)
+     * @param day Day index (column)
+     * @return Measured value or NaN
+     */
+    float At(int hour, size_t day) const { return values[static_cast<size_t>(hour) * dayCount + day]; }
+
+    /**
+     * @brief Gets the day of the week of a column
+     * @param day Day index (column)
+     * @return 0 for Monday through 6 for Sunday
+     */
+    int WeekdayOf(size_t day) const { return static_cast<int>(((firstDay + static_cast<long long>(day)) % 7 + 10) % 7); }
+
+    /**
+     * @brief Gets the hour (since 1970-01-01 00:00) of the first hour of a column
+     * @param day Day index (column)
+     * @return Hours since the epoch
+     */
+    long long FirstHourOf(size_t day) const { return (firstDay + static_cast<long long>(day)) * HOURS_PER_DAY; }
+};
+
+/**
+ * @brief Arranges an hourly series into a day-by-hour grid
+ *
+ * The grid covers whole days from the first to the last day of the series. Hours
+ * outside the series and missing hours are NaN. The colour scale is capped at the
+ * 99th percentile, so a few extreme hours do not wash out the rest of the heatmap.
+ *
+ * @param series Measurements aligned to an hourly grid
+ * @return CalendarAggregate of the series (no columns if the series has no measurements)
+ */
+CalendarAggregate BuildCalendarAggregate(const HourlySeries& series);
+
+#endif // CALENDAR_HEATMAP_H
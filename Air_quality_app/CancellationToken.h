@@ -0,0 +1,45 @@
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <atomic>
+#include <memory>
+
+/**
+ * @file CancellationToken.h
+ * @brief Flag through which the owner of a job asks the job to stop
+ */
+
+ /**
+  * @class CancellationToken
+  * @brief Shared flag telling a running job that its result is no longer needed
+  *
+  * Copies share the flag, so the scheduler keeps one copy and the download another;
+  * the download polls it from its transfer callback.
+  */
+class CancellationToken {
+public:
+    CancellationToken() : cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    /**
+     * @brief Asks the job (and every other holder of the token) to stop
+     */
+    void Cancel() const { cancelled->store(true); }
+
+    /**
+     * @brief Checks whether the job was asked to stop
+     * @return true after Cancel() was called on any copy of the token
+     */
+    bool IsCancelled() const { return cancelled->load(); }
+
+    /**
+     * @brief Checks whether two tokens share their flag
+     * @param other Token to compare with
+     * @return true if both are copies of the same token
+     */
+    bool operator==(const CancellationToken& other) const { return cancelled == other.cancelled; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled; /**< Flag shared by all copies */
+};
+
+#endif // CANCELLATION_TOKEN_H
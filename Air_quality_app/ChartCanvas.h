@@ -0,0 +1,162 @@
+#ifndef CHART_CANVAS_H
+#define CHART_CANVAS_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @file ChartCanvas.h
+ * @brief Drawing target of the chart renderer, independent of any GUI toolkit
+ */
+
+ /**
+  * @struct ChartColour
+  * @brief RGB colour of a pen, brush or text
+  */
+struct ChartColour {
+    unsigned char red = 0;     /**< Red component */
+    unsigned char green = 0;   /**< Green component */
+    unsigned char blue = 0;    /**< Blue component */
+
+    ChartColour() {}
+    ChartColour(unsigned char red, unsigned char green, unsigned char blue) : red(red), green(green), blue(blue) {}
+};
+
+/**
+ * @struct ChartPoint
+ * @brief Pixel position on the canvas
+ */
+struct ChartPoint {
+    int x = 0;   /**< Horizontal position, growing to the right */
+    int y = 0;   /**< Vertical position, growing downwards */
+
+    ChartPoint() {}
+    ChartPoint(int x, int y) : x(x), y(y) {}
+};
+
+/**
+ * @brief Dash patterns of lines
+ */
+enum ChartLineStyle {
+    CHART_LINE_SOLID,       /**< Continuous line */
+    CHART_LINE_DOT,         /**< Dotted line (grid) */
+    CHART_LINE_SHORT_DASH   /**< Short dashes (forecast, repeated series colours) */
+};
+
+/**
+ * @brief Text styles used by the chart; each canvas maps them onto its own fonts
+ */
+enum ChartFont {
+    CHART_FONT_TITLE,        /**< Chart title and the no-data message (12 pt bold) */
+    CHART_FONT_AXIS_LABEL,   /**< Axis labels (10 pt) */
+    CHART_FONT_TICK,         /**< Tick labels and legends (8 pt) */
+    CHART_FONT_LEGEND,       /**< Anomaly summary (8 pt bold) */
+    CHART_FONT_NOTE          /**< Forecast note (8 pt italic) */
+};
+
+/**
+ * @class ChartCanvas
+ * @brief Minimal set of drawing operations the chart renderer needs
+ *
+ * The renderer only talks to this interface, so the same drawing code fills the
+ * window's cached bitmap through a wxDC and writes SVG files without any display.
+ * Like a wxDC, a canvas keeps a current pen, brush, font and text colour; shapes are
+ * outlined with the pen and filled with the brush.
+ */
+class ChartCanvas {
+public:
+    virtual ~ChartCanvas() {}
+
+    /**
+     * @brief Sets the pen used for lines and outlines
+     * @param colour Line colour
+     * @param width Line width in pixels
+     * @param style Dash pattern
+     */
+    virtual void SetPen(const ChartColour& colour, int width, ChartLineStyle style = CHART_LINE_SOLID) = 0;
+
+    /**
+     * @brief Draws following shapes without an outline
+     */
+    virtual void SetNoPen() = 0;
+
+    /**
+     * @brief Sets the brush used to fill shapes
+     * @param colour Fill colour
+     */
+    virtual void SetBrush(const ChartColour& colour) = 0;
+
+    /**
+     * @brief Sets the font of following text
+     * @param font Text style
+     */
+    virtual void SetFont(ChartFont font) = 0;
+
+    /**
+     * @brief Sets the colour of following text
+     * @param colour Text colour
+     */
+    virtual void SetTextColour(const ChartColour& colour) = 0;
+
+    /**
+     * @brief Draws a line with the pen
+     */
+    virtual void DrawLine(int x1, int y1, int x2, int y2) = 0;
+
+    /**
+     * @brief Draws a polyline with the pen
+     * @param points Vertices in drawing order
+     */
+    virtual void DrawLines(const std::vector<ChartPoint>& points) = 0;
+
+    /**
+     * @brief Draws a closed polygon, filled with the brush and outlined with the pen
+     * @param points Vertices in drawing order
+     */
+    virtual void DrawPolygon(const std::vector<ChartPoint>& points) = 0;
+
+    /**
+     * @brief Draws a rectangle, filled with the brush and outlined with the pen
+     */
+    virtual void DrawRectangle(int x, int y, int width, int height) = 0;
+
+    /**
+     * @brief Draws a circle, filled with the brush and outlined with the pen
+     */
+    virtual void DrawCircle(int x, int y, int radius) = 0;
+
+    /**
+     * @brief Draws text with its top left corner at a position
+     * @param text UTF-8 text
+     */
+    virtual void DrawText(const std::string& text, int x, int y) = 0;
+
+    /**
+     * @brief Draws text rotated counter-clockwise around its top left corner
+     * @param text UTF-8 text
+     * @param angle Rotation in degrees
+     */
+    virtual void DrawRotatedText(const std::string& text, int x, int y, double angle) = 0;
+
+    /**
+     * @brief Measures text in the current font
+     * @param text UTF-8 text
+     * @param width [out] Width in pixels
+     * @param height [out] Height in pixels
+     */
+    virtual void GetTextExtent(const std::string& text, int& width, int& height) = 0;
+
+    /**
+     * @brief Limits drawing to a rectangle inside the current clipping area
+     *
+     * Calls nest; each PopClip restores the area before the matching PushClip.
+     */
+    virtual void PushClip(int x, int y, int width, int height) = 0;
+
+    /**
+     * @brief Restores the clipping area before the last PushClip
+     */
+    virtual void PopClip() = 0;
+};
+
+#endif // CHART_CANVAS_H
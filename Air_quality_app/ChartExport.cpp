@@ -0,0 +1,164 @@
+/**
+ * @file ChartExport.cpp
+ * @brief Implementation of the chart export job
+ */
+
+#include "ChartExport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+#include "AnomalyDetection.h"
+#include "ChartRenderer.h"
+#include "Forecasting.h"
+#include "SensorCatalog.h"
+#include "SensorStores.h"
+#include "SvgChartCanvas.h"
+
+namespace {
+    /**
+     * @brief Renders the chart of one sensor directory and fills its export entry
+     *
+     * Runs on a worker thread with its own renderer; reads the sensor's files and stored
+     * models but does not modify them. The entry arrives with the target path, which is
+     * cleared if no chart is written.
+     */
+    void ExportSensorChart(const std::string& sensorDirectory, const std::string& paramCode, int width, int height,
+        const ChartWriter& writer, const CancellationToken& cancel, ChartExportEntry& entry) {
+        if (cancel.IsCancelled()) {
+            entry.error = "cancelled";
+            entry.filePath.clear();
+            return;
+        }
+
+        HourlySeries series = LoadSensorHistory(sensorDirectory, nullptr);
+        if (series.values.empty()) {
+            entry.error = "no valid measurements";
+            entry.filePath.clear();
+            return;
+        }
+
+        std::string label = paramCode.empty() ? "Value" : paramCode;
+        ChartRenderer renderer;
+        renderer.SetSize(width, height);
+        renderer.SetData(series, std::vector<std::string>(),
+            "Station " + std::to_string(entry.stationId) + ", sensor " + std::to_string(entry.sensorId) + ": " + label, "Date", label);
+
+        // Same forecast as the interactive view, from the stored model advanced to the last hour
+        HoltWintersModel model;
+        if (PrepareForecastModel(sensorDirectory, series, model)) {
+            Forecast forecast = model.Predict(FORECAST_HORIZON_HOURS);
+            renderer.SetForecast(forecast.values, forecast.lower, forecast.upper);
+        }
+
+        // Run the detector in memory over hours it has not seen yet; its files stay as they are
+        SensorAnomalyDetector detector;
+        {
+            // Loading may migrate a store written by an earlier version
+            std::unique_lock<std::mutex> storeLock = LockSensorStore(sensorDirectory);
+            detector.Load(sensorDirectory, series.startHour, series.HourAt(series.values.size() - 1));
+        }
+        detector.Ingest(series);
+        renderer.SetAnomalyFlags(detector.GetFlags(series.startHour, series.values.size()));
+
+        if (!writer(renderer, width, height, entry.filePath)) {
+            entry.error = cancel.IsCancelled() ? "cancelled" : "cannot write " + entry.filePath;
+            entry.filePath.clear();
+        }
+    }
+}
+
+/**
+ * @brief Draws a chart into an SVG file
+ * @param renderer Renderer holding the chart's data
+ * @param width Width of the chart in pixels
+ * @param height Height of the chart in pixels
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ */
+bool WriteSvgChart(const ChartRenderer& renderer, int width, int height, const std::string& filePath) {
+    SvgChartCanvas canvas(width, height);
+    renderer.Render(canvas);
+    return canvas.Save(filePath);
+}
+
+/**
+ * @brief Counts the charts that were written
+ * @return Number of entries without an error
+ */
+size_t ChartExportReport::WrittenCount() const {
+    return static_cast<size_t>(std::count_if(charts.begin(), charts.end(),
+        [](const ChartExportEntry& entry) { return entry.error.empty(); }));
+}
+
+/**
+ * @brief Gets the throughput of the export
+ * @return Written charts per second (0 if the export took no measurable time)
+ */
+double ChartExportReport::ChartsPerSecond() const {
+    return (elapsedSeconds > 0.0) ? static_cast<double>(WrittenCount()) / elapsedSeconds : 0.0;
+}
+
+/**
+ * @brief Renders the chart of every sensor stored in the database into an image file
+ * @param databaseDirectory Path of the measurements directory
+ * @param outputDirectory Directory the charts are written to (created if missing)
+ * @param width Width of each chart in pixels
+ * @param height Height of each chart in pixels
+ * @param pool Thread pool rendering the charts
+ * @param extension File name extension of the charts, matching the writer (e.g. ".svg")
+ * @param writer Function drawing a prepared chart into a file
+ * @param cancel Token skipping the remaining sensors when cancelled
+ * @return ChartExportReport with one entry per sensor
+ *
+ * This function:
+ * 1. Walks measurements/<stationId>/<sensorId> and reads each station's sensors.json for parameter codes
+ * 2. Preallocates one entry per sensor, named <stationId>_<sensorId><extension> in the output directory
+ * 3. Loads, forecasts and renders the sensors on the thread pool, passing each chart to the writer
+ * 4. Records the elapsed time for the throughput figure
+ */
+ChartExportReport ExportSensorCharts(const std::string& databaseDirectory, const std::string& outputDirectory, int width, int height, ThreadPool& pool,
+    const std::string& extension, const ChartWriter& writer, const CancellationToken& cancel) {
+    ChartExportReport report;
+    report.workerCount = pool.Size();
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::error_code error;
+    std::filesystem::create_directories(outputDirectory, error);
+
+    // Collect the sensor directories of all stations
+    std::vector<std::string> sensorDirectories;
+    std::vector<std::string> paramCodes;
+    std::vector<int> stationIds = ListNumericDirectories(databaseDirectory);
+    std::sort(stationIds.begin(), stationIds.end());
+    for (int stationId : stationIds) {
+        std::string stationDirectory = databaseDirectory + "/" + std::to_string(stationId);
+
+        std::vector<SensorInfo> sensors;
+        LoadStationSensors(stationDirectory, sensors);
+
+        std::vector<int> sensorIds = ListNumericDirectories(stationDirectory);
+        std::sort(sensorIds.begin(), sensorIds.end());
+        for (int sensorId : sensorIds) {
+            ChartExportEntry entry;
+            entry.stationId = stationId;
+            entry.sensorId = sensorId;
+            entry.filePath = outputDirectory + "/" + std::to_string(stationId) + "_" + std::to_string(sensorId) + extension;
+            auto info = std::find_if(sensors.begin(), sensors.end(),
+                [sensorId](const SensorInfo& sensor) { return sensor.id == sensorId; });
+            report.charts.push_back(entry);
+            sensorDirectories.push_back(stationDirectory + "/" + std::to_string(sensorId));
+            paramCodes.push_back(info != sensors.end() ? info->paramCode : std::string());
+        }
+    }
+
+    // Render all charts in parallel, each worker writing only to its own entries and files
+    pool.ParallelFor(report.charts.size(), [&](size_t i) {
+        ExportSensorChart(sensorDirectories[i], paramCodes[i], width, height, writer, cancel, report.charts[i]);
+        });
+
+    report.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,89 @@
+#ifndef CHART_EXPORT_H
+#define CHART_EXPORT_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "CancellationToken.h"
+#include "ChartRenderer.h"
+#include "ThreadPool.h"
+
+/**
+ * @file ChartExport.h
+ * @brief Rendering the chart of every stored sensor into image files in one parallel batch job
+ */
+
+ /**
+  * @struct ChartExportEntry
+  * @brief Export result of one sensor
+  */
+struct ChartExportEntry {
+    int stationId = -1;      /**< ID of the station */
+    int sensorId = -1;       /**< ID of the sensor */
+    std::string filePath;    /**< Path of the written chart, empty if none was written */
+    std::string error;       /**< Reason why no chart was written, empty on success */
+};
+
+/**
+ * @struct ChartExportReport
+ * @brief Results of a chart export together with its performance figures
+ */
+struct ChartExportReport {
+    std::vector<ChartExportEntry> charts;  /**< One entry per sensor directory, ordered by station and sensor ID */
+    double elapsedSeconds = 0.0;           /**< Wall-clock duration of the export */
+    size_t workerCount = 0;                /**< Number of worker threads used */
+
+    /**
+     * @brief Counts the charts that were written
+     * @return Number of entries without an error
+     */
+    size_t WrittenCount() const;
+
+    /**
+     * @brief Gets the throughput of the export
+     * @return Written charts per second
+     */
+    double ChartsPerSecond() const;
+};
+
+/**
+ * @brief Draws a prepared chart into a file
+ *
+ * Receives a renderer holding the sensor's data, forecast and anomaly flags, the size of
+ * the chart and the path of the file to write. Called on the export's worker threads.
+ */
+typedef std::function<bool(const ChartRenderer& renderer, int width, int height, const std::string& filePath)> ChartWriter;
+
+/**
+ * @brief Draws a chart into an SVG file
+ * @param renderer Renderer holding the chart's data
+ * @param width Width of the chart in pixels
+ * @param height Height of the chart in pixels
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ */
+bool WriteSvgChart(const ChartRenderer& renderer, int width, int height, const std::string& filePath);
+
+/**
+ * @brief Renders the chart of every sensor stored in the database into an image file
+ *
+ * Each sensor's whole stored history is drawn like the interactive line chart, with its
+ * forecast and anomaly flags, by the same ChartRenderer. With the default SVG writer no
+ * window or display is needed, so the export also runs on servers; every worker uses
+ * its own renderer.
+ *
+ * @param databaseDirectory Path of the measurements directory
+ * @param outputDirectory Directory the charts are written to (created if missing)
+ * @param width Width of each chart in pixels
+ * @param height Height of each chart in pixels
+ * @param pool Thread pool rendering the charts
+ * @param extension File name extension of the charts, matching the writer (e.g. ".svg")
+ * @param writer Function drawing a prepared chart into a file
+ * @param cancel Token skipping the remaining sensors when cancelled
+ * @return ChartExportReport with one entry per sensor
+ */
+ChartExportReport ExportSensorCharts(const std::string& databaseDirectory, const std::string& outputDirectory, int width, int height, ThreadPool& pool,
+    const std::string& extension = ".svg", const ChartWriter& writer = WriteSvgChart, const CancellationToken& cancel = CancellationToken());
+
+#endif // CHART_EXPORT_H
@@ -0,0 +1,101 @@
+/**
+ * @file ChartExportCommand.cpp
+ * @brief Implementation of the command-line chart export
+ */
+
+#include "ChartExportCommand.h"
+
+#include <cstdio>
+#include <string>
+
+#include "ChartExport.h"
+#include "ThreadPool.h"
+
+namespace {
+    const std::string EXPORT_COMMAND = "--export-charts";           ///< Argument selecting the headless chart export
+    const std::string DEFAULT_DATABASE_DIRECTORY = "measurements";  ///< Measurements directory, as used by the application
+    const std::string DEFAULT_OUTPUT_DIRECTORY = "reports/charts";  ///< Output directory, as used by the Export charts button
+    const int DEFAULT_WIDTH = 1200;                                 ///< Default chart width in pixels
+    const int DEFAULT_HEIGHT = 600;                                 ///< Default chart height in pixels
+    const int MAX_SIZE = 10000;                                     ///< Largest accepted width or height in pixels
+
+    /**
+     * @brief Prints the usage of the command
+     */
+    void PrintUsage() {
+        std::fprintf(stderr, "Usage: Air_quality_app %s [--database DIR] [--output DIR] [--size WIDTHxHEIGHT]\n", EXPORT_COMMAND.c_str());
+    }
+}
+
+/**
+ * @brief Checks whether the command line asks for the headless chart export
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return true if the first argument is "--export-charts", false otherwise
+ */
+bool IsChartExportCommand(int argc, char* argv[]) {
+    return argc >= 2 && argv[1] != nullptr && EXPORT_COMMAND == argv[1];
+}
+
+/**
+ * @brief Exports the charts of all stored sensors as SVG files and prints a summary
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return Process exit code: 0 if every chart was written, 1 if some failed or none were found, 2 for invalid arguments
+ *
+ * This function:
+ * 1. Parses the options following "--export-charts"
+ * 2. Renders the charts on a thread pool with one worker per core
+ * 3. Prints every failed sensor to the error stream and the summary to the output stream
+ */
+int RunChartExportCommand(int argc, char* argv[]) {
+    std::string databaseDirectory = DEFAULT_DATABASE_DIRECTORY;
+    std::string outputDirectory = DEFAULT_OUTPUT_DIRECTORY;
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (i + 1 >= argc) {
+            PrintUsage();
+            return 2;
+        }
+        std::string value = argv[++i];
+        if (option == "--database") {
+            databaseDirectory = value;
+        }
+        else if (option == "--output") {
+            outputDirectory = value;
+        }
+        else if (option == "--size") {
+            if (std::sscanf(value.c_str(), "%dx%d", &width, &height) != 2 ||
+                width <= 0 || height <= 0 || width > MAX_SIZE || height > MAX_SIZE) {
+                std::fprintf(stderr, "Invalid chart size: %s\n", value.c_str());
+                return 2;
+            }
+        }
+        else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    ThreadPool pool;
+    ChartExportReport report = ExportSensorCharts(databaseDirectory, outputDirectory, width, height, pool);
+    if (report.charts.empty()) {
+        std::fprintf(stderr, "No sensor data found in %s\n", databaseDirectory.c_str());
+        return 1;
+    }
+
+    for (const auto& chart : report.charts) {
+        if (!chart.error.empty()) {
+            std::fprintf(stderr, "Station %d, sensor %d: %s\n", chart.stationId, chart.sensorId, chart.error.c_str());
+        }
+    }
+
+    size_t written = report.WrittenCount();
+    std::printf("Exported %d charts (%d sensors failed) in %.2f s\nThroughput: %.1f charts/s on %d threads\nCharts saved to: %s\n",
+        static_cast<int>(written), static_cast<int>(report.charts.size() - written), report.elapsedSeconds,
+        report.ChartsPerSecond(), static_cast<int>(report.workerCount), outputDirectory.c_str());
+    return written == report.charts.size() ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+#ifndef CHART_EXPORT_COMMAND_H
+#define CHART_EXPORT_COMMAND_H
+
+/**
+ * @file ChartExportCommand.h
+ * @brief Command-line chart export that runs without creating any window
+ */
+
+ /**
+  * @brief Checks whether the command line asks for the headless chart export
+  * @param argc Number of command-line arguments
+  * @param argv Command-line arguments
+  * @return true if the first argument is "--export-charts", false otherwise
+  */
+bool IsChartExportCommand(int argc, char* argv[]);
+
+/**
+ * @brief Exports the charts of all stored sensors as SVG files and prints a summary
+ *
+ * Usage: Air_quality_app --export-charts [--database DIR] [--output DIR] [--size WIDTHxHEIGHT]
+ *
+ * Uses neither wxWidgets nor a display, so it also runs on servers without one.
+ * The defaults match the Export charts button.
+ *
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return Process exit code: 0 if every chart was written, 1 if some failed or none were found, 2 for invalid arguments
+ */
+int RunChartExportCommand(int argc, char* argv[]);
+
+#endif // CHART_EXPORT_COMMAND_H
@@ -5,18 +5,88 @@
 
 #include "ChartPanel.h"
 
+#include <chrono>
+#include <wx/dcclient.h>
+#include <wx/dcmemory.h>
+
+namespace {
+    const int CALENDAR_LEGEND_WIDTH = 12;                    ///< Width of the calendar colour bar in pixels
+    const wxColour CALENDAR_MISSING_COLOUR(235, 235, 235);   ///< Colour of calendar cells without a measurement
+    const wxColour CALENDAR_WEEKEND_COLOUR(120, 120, 120);   ///< Colour of the weekend marks below the calendar
+    const double ZOOM_STEP = 0.8;                            ///< Factor applied to the visible span per wheel notch
+    const int LIVE_REDRAW_MARGIN = 8;                        ///< Pixels redrawn left of the first changed hour (covers the markers)
+    const int HOVER_MARKER_RADIUS = 6;                       ///< Radius of the ring around the hovered point
+    const int HOVER_TOOLTIP_PADDING = 4;                     ///< Space between the tooltip border and its text
+    const int HOVER_TOOLTIP_OFFSET = 12;                     ///< Distance of the tooltip from the hovered point
+}
+
  /**
   * @brief Constructor for the chart panel that initializes the panel with default settings
   * @param parent Pointer to the parent window
   *
-  * Creates a new chart panel with a white background and binds the paint event handler.
+  * Creates a new chart panel with a white background and binds the paint, size and
+  * mouse event handlers. The fonts used by every render are kept by the canvas.
   */
-ChartPanel::ChartPanel(wxWindow* parent) : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxSize(1200, 600)) {
+ChartPanel::ChartPanel(wxWindow* parent) : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxSize(1200, 600)),
+    borderPen(wxColour(200, 200, 200), 1), calendarScale(0.0, 1.0) {
     SetBackgroundColour(*wxWHITE);
     hasData = false;
+    viewMode = CHART_VIEW_LINE;
+    panning = false;
+    hovering = false;
+    panStartX = 0;
+    panStartFirst = 0.0;
+    chartCacheValid = false;
+    partialRenderPending = false;
+    dirtyFromHour = 0;
+
+    // The cached bitmap covers the whole panel, so the background never needs erasing
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
 
     // Bind the paint event to handle rendering
     Bind(wxEVT_PAINT, &ChartPanel::OnPaint, this);
+
+    // Render again when the panel is resized, since every element scales with it
+    Bind(wxEVT_SIZE, [this](wxSizeEvent& event) {
+        renderer.SetSize(GetClientSize().GetWidth(), GetClientSize().GetHeight());
+        InvalidateChart();
+        event.Skip();
+        });
+
+    // Zoom with the wheel, pan by dragging, reset with a double click
+    Bind(wxEVT_MOUSEWHEEL, &ChartPanel::OnMouseWheel, this);
+    Bind(wxEVT_LEFT_DOWN, &ChartPanel::OnLeftDown, this);
+    Bind(wxEVT_LEFT_UP, &ChartPanel::OnLeftUp, this);
+    Bind(wxEVT_MOTION, &ChartPanel::OnMouseMove, this);
+    Bind(wxEVT_LEFT_DCLICK, &ChartPanel::OnLeftDoubleClick, this);
+    Bind(wxEVT_MOUSE_CAPTURE_LOST, [this](wxMouseCaptureLostEvent&) {
+        panning = false;
+        });
+
+    // Remove the tooltip when the cursor leaves the panel
+    Bind(wxEVT_LEAVE_WINDOW, [this](wxMouseEvent& event) {
+        ClearHover();
+        event.Skip();
+        });
+}
+
+/**
+ * @brief Marks the cached chart as outdated and triggers a redraw
+ *
+ * The next paint event renders all layers into the cache again.
+ */
+void ChartPanel::InvalidateChart() {
+    chartCacheValid = false;
+    partialRenderPending = false;
+    Refresh();
+}
+
+/**
+ * @brief Gets the paint and render counters of the panel
+ * @return PaintStatistics accumulated since the panel was created
+ */
+PaintStatistics ChartPanel::GetPaintStatistics() const {
+    return paintStatistics;
 }
 
 /**
@@ -27,313 +97,649 @@ ChartPanel::ChartPanel(wxWindow* parent) : wxPanel(parent, wxID_ANY, wxDefaultPo
  * @param yLabel Label for the Y axis
  *
  * Updates the chart with new data and properties, then triggers a redraw to display the changes.
+ * The X axis maps hours to pixels, so the data must hold one point per consecutive hour;
+ * other data (irregular, unsorted or with dropped hours) is placed on an hourly grid with
+ * NaN for the missing hours first. Data whose timestamps cannot be parsed is shown one
+ * slot per point and labelled with its raw timestamps.
  */
 void ChartPanel::SetChartData(const std::vector<std::pair<wxString, double>>& data, const wxString& title, const wxString& xLabel, const wxString& yLabel) {
-    chartData = data;
+    HourlySeries series;
+    std::vector<std::string> pointLabels;
+    bool timeAxis = !data.empty();
+
+    // Check that the timestamps are consecutive hours
+    bool hourly = true;
+    for (size_t i = 0; i < data.size() && timeAxis; i++) {
+        long long hour;
+        if (!ParseTimestampToHours(data[i].first.ToStdString(), hour)) {
+            timeAxis = false;
+        }
+        else if (i == 0) {
+            series.startHour = hour;
+        }
+        else if (hour != series.startHour + static_cast<long long>(i)) {
+            hourly = false;
+        }
+    }
+
+    // Place other data on an hourly grid, so gaps take up the time they lasted
+    if (timeAxis && !hourly) {
+        std::vector<std::pair<std::string, double>> points;
+        points.reserve(data.size());
+        for (const auto& point : data) {
+            points.push_back(std::make_pair(point.first.ToStdString(), point.second));
+        }
+        series = ResampleToHourlyGrid(points);
+        if (series.values.empty()) {
+            timeAxis = false;
+        }
+    }
+    if (!timeAxis || hourly) {
+        series.values.clear();
+        series.values.reserve(data.size());
+        for (const auto& point : data) {
+            series.values.push_back(point.second);
+        }
+    }
+    if (!timeAxis) {
+        // Keep the raw timestamps to label the data points with
+        series.startHour = 0;
+        pointLabels.reserve(data.size());
+        for (const auto& point : data) {
+            pointLabels.push_back(std::string(point.first.utf8_str()));
+        }
+    }
+    renderer.SetData(series, pointLabels, std::string(title.utf8_str()), std::string(xLabel.utf8_str()), std::string(yLabel.utf8_str()));
     chartTitle = title;
-    xAxisLabel = xLabel;
-    yAxisLabel = yLabel;
     hasData = true;
 
-    // Refresh the panel to trigger repainting
-    Refresh();
+    // Switch back from the calendar and release its image
+    viewMode = CHART_VIEW_LINE;
+    calendar = CalendarAggregate();
+    calendarImage = wxImage();
+    calendarBitmap = wxBitmap();
+
+    // Render the chart again with the new data
+    InvalidateChart();
 }
 
 /**
- * @brief Displays a message when no data is available
- * @param dc Device context for drawing
+ * @brief Sets the forecast drawn after the last data point and triggers a redraw
+ * @param values Predicted value for each hour following the chart data
+ * @param lower Lower bound of the confidence band for each hour
+ * @param upper Upper bound of the confidence band for each hour
  *
- * Draws a centered message instructing the user to select a data file
- * when no data is available to display.
+ * The three vectors must have the same length; the first entry belongs to the hour
+ * directly after the last data point. A zoomed window stays where it is; the whole
+ * time axis, shown after a reset, then includes the forecast hours.
  */
-void ChartPanel::DrawNoDataMessage(wxPaintDC& dc) {
-    // Set text properties for the message
-    dc.SetTextForeground(*wxBLACK);
-    dc.SetFont(wxFont(12, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
-    wxString noDataText = "No data to display. Please select a data file.";
-    // Calculate text dimensions for centering
-    wxSize textSize = dc.GetTextExtent(noDataText);
-    // Draw the message centered in the panel
-    dc.DrawText(noDataText,
-        (GetSize().GetWidth() - textSize.GetWidth()) / 2,
-        (GetSize().GetHeight() - textSize.GetHeight()) / 2);
+void ChartPanel::SetForecast(const std::vector<double>& values, const std::vector<double>& lower, const std::vector<double>& upper) {
+    if (!renderer.SetForecast(values, lower, upper)) {
+        return;
+    }
+
+    // Render the chart again with the new data
+    InvalidateChart();
 }
 
 /**
- * @brief Calculates chart dimensions and positioning based on panel size
- * @param chartLeft [out] Left edge position of chart area
- * @param chartTop [out] Top edge position of chart area
- * @param chartWidth [out] Width of chart area
- * @param chartHeight [out] Height of chart area
- * @param chartBottom [out] Bottom edge position of chart area
- * @param chartRight [out] Right edge position of chart area
+ * @brief Sets the anomaly flags of the data points and triggers a redraw
+ * @param flags AnomalyFlag combination for each data point
  *
- * Sets up the chart dimensions with appropriate margins and calculates
- * all important coordinates for rendering the chart.
+ * Flags that do not match the chart data in length are ignored.
  */
-void ChartPanel::SetupChartDimensions(int& chartLeft, int& chartTop, int& chartWidth, int& chartHeight, int& chartBottom, int& chartRight) {
-    int margin = 60;
-    // Calculate chart dimensions with margins
-    chartWidth = GetSize().GetWidth() - 2 * margin;
-    chartHeight = GetSize().GetHeight() - 2 * margin;
-    // Calculate chart position
-    chartLeft = margin;
-    chartTop = margin;
-    // Calculate bottom and right edges
-    chartBottom = chartTop + chartHeight;
-    chartRight = chartLeft + chartWidth;
+void ChartPanel::SetAnomalyFlags(const std::vector<int>& flags) {
+    if (!renderer.SetAnomalyFlags(flags)) {
+        return;
+    }
+
+    // Render the chart again with the new data
+    InvalidateChart();
 }
 
 /**
- * @brief Draws the chart background and border
- * @param dc Device context for drawing
- * @param chartLeft Left edge position of chart area
- * @param chartTop Top edge position of chart area
- * @param chartWidth Width of chart area
- * @param chartHeight Height of chart area
+ * @brief Sets several series on a common time axis and triggers a redraw
+ * @param timestamps Timestamp of each hour of the time axis
+ * @param series Series to draw, each with one value per timestamp
+ * @param title Title for the chart
+ * @param xLabel Label for the X axis
+ * @param yLabel Label for the Y axis
  *
- * Creates a white rectangle with a light gray border to serve as the chart background.
+ * The first series becomes the chart data, so axes and scaling work as for a single
+ * series; the others are overlaid on it.
  */
-void ChartPanel::DrawChartBackground(wxPaintDC& dc, int chartLeft, int chartTop, int chartWidth, int chartHeight) {
-    // Set background fill color to white
-    dc.SetBrush(wxBrush(*wxWHITE));
-    // Set border to light gray
-    dc.SetPen(wxPen(wxColour(200, 200, 200), 1));
-    // Draw the chart background rectangle
-    dc.DrawRectangle(chartLeft, chartTop, chartWidth, chartHeight);
+void ChartPanel::SetComparisonData(const std::vector<wxString>& timestamps, const std::vector<ChartSeries>& series, const wxString& title, const wxString& xLabel, const wxString& yLabel) {
+    std::vector<ChartSeries> usable;
+    for (const auto& entry : series) {
+        if (entry.values.size() == timestamps.size()) {
+            usable.push_back(entry);
+        }
+    }
+    if (usable.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<wxString, double>> data;
+    data.reserve(timestamps.size());
+    for (size_t i = 0; i < timestamps.size(); i++) {
+        data.push_back(std::make_pair(timestamps[i], usable.front().values[i]));
+    }
+    SetChartData(data, title, xLabel, yLabel);
+
+    // Overlays share the time axis only if it was already hourly
+    if (renderer.Size() != timestamps.size()) {
+        return;
+    }
+    renderer.SetOverlays(usable.front().label, std::vector<ChartSeries>(usable.begin() + 1, usable.end()));
 }
 
 /**
- * @brief Determines the minimum and maximum data values with padding
- * @param minValue [out] Calculated minimum value for Y axis
- * @param maxValue [out] Calculated maximum value for Y axis
+ * @brief Shows the newest hours of a live series, to be extended by AppendLiveData
+ * @param buffer Ring buffer of the series; its capacity is kept
+ * @param title Title for the chart
+ * @param xLabel Label for the X axis
+ * @param yLabel Label for the Y axis
  *
- * Finds the minimum and maximum values in the data set and adds padding
- * to provide better visual display with appropriate spacing.
+ * Live mode ends with the next call to SetChartData.
  */
-void ChartPanel::CalculateValueRange(double& minValue, double& maxValue) {
-    // Initialize min/max to extreme values
-    minValue = std::numeric_limits<double>::max();
-    maxValue = std::numeric_limits<double>::lowest();
+void ChartPanel::SetLiveData(const HourlyRingBuffer& buffer, const wxString& title, const wxString& xLabel, const wxString& yLabel) {
+    SetChartData(std::vector<std::pair<wxString, double>>(), title, xLabel, yLabel);
+    renderer.SetLiveData(buffer, std::string(title.utf8_str()), std::string(xLabel.utf8_str()), std::string(yLabel.utf8_str()));
+}
 
-    // Find actual min/max values in data
-    for (const auto& point : chartData) {
-        minValue = std::min(minValue, point.second);
-        maxValue = std::max(maxValue, point.second);
+/**
+ * @brief Adds new or corrected hours to a live series
+ * @param points Hours (since 1970-01-01 00:00) and values, in time order
+ *
+ * This function:
+ * 1. Appends the points through the renderer, which keeps a zoomed window on the same
+ *    hours and drops the forecast and anomaly flags
+ * 2. Renders everything again if the forecast or anomaly flags were dropped
+ * 3. Otherwise remembers the earliest changed hour, so the next paint renders only the
+ *    strip from there on if the layout did not change
+ */
+void ChartPanel::AppendLiveData(const std::vector<std::pair<long long, double>>& points) {
+    if (!renderer.IsLive() || points.empty()) {
+        return;
     }
 
-    // Add padding to min/max values for better visual display
-    double valuePadding = (maxValue - minValue) * 0.1;
-    if (valuePadding == 0) {
-        valuePadding = std::abs(minValue) * 0.1;
-        if (valuePadding == 0)
-            valuePadding = 1.0;
+    long long earliest = points.front().first;
+    for (const auto& point : points) {
+        earliest = std::min(earliest, point.first);
+    }
+    if (renderer.AppendLiveData(points)) {
+        chartCacheValid = false;
     }
 
-    // Apply padding to range
-    minValue -= valuePadding;
-    maxValue += valuePadding;
+    dirtyFromHour = partialRenderPending ? std::min(dirtyFromHour, earliest) : earliest;
+    partialRenderPending = true;
+    Refresh();
 }
 
 /**
- * @brief Draws the chart title centered above the chart
- * @param dc Device context for drawing
- * @param chartLeft Left edge position of chart area
- * @param chartWidth Width of chart area
- * @param chartTop Top edge position of chart area
- *
- * Draws the chart title centered horizontally above the chart area.
+ * @brief Checks whether the panel shows a live series
+ * @return true in live mode, false otherwise
  */
-void ChartPanel::DrawChartTitle(wxPaintDC& dc, int chartLeft, int chartWidth, int chartTop) {
-    dc.SetTextForeground(*wxBLACK);
-    dc.SetFont(wxFont(12, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
-    // Calculate title dimensions for centering
-    wxSize titleSize = dc.GetTextExtent(chartTitle);
-    // Draw title centered above chart
-    dc.DrawText(chartTitle, chartLeft + (chartWidth - titleSize.GetWidth()) / 2, chartTop - 40);
+bool ChartPanel::IsLive() const {
+    return renderer.IsLive() && viewMode == CHART_VIEW_LINE;
 }
 
 /**
- * @brief Draws the X and Y axis labels
- * @param dc Device context for drawing
- * @param chartLeft Left edge position of chart area
- * @param chartTop Top edge position of chart area
- * @param chartWidth Width of chart area
- * @param chartHeight Height of chart area
- * @param chartBottom Bottom edge position of chart area
+ * @brief Shows a calendar heatmap instead of the line chart and triggers a redraw
+ * @param aggregate Day-by-hour values to display
+ * @param title Title for the chart
  *
- * Draws the X-axis label centered below the chart and the Y-axis label
- * rotated vertically and centered along the left side of the chart.
+ * The aggregate is coloured into an image here, once; painting only scales it.
  */
-void ChartPanel::DrawAxisLabels(wxPaintDC& dc, int chartLeft, int chartTop, int chartWidth, int chartHeight, int chartBottom) {
-    // Set font for axis labels
-    dc.SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
-    // Draw Y-axis label vertically
-    dc.DrawRotatedText(yAxisLabel, chartLeft - 45, chartTop + chartHeight / 2 + dc.GetTextExtent(yAxisLabel).GetWidth() / 2, 90);
-
-    // Draw X-axis label horizontally
-    wxSize xLabelSize = dc.GetTextExtent(xAxisLabel);
-    dc.DrawText(xAxisLabel, chartLeft + (chartWidth - xLabelSize.GetWidth()) / 2, chartBottom + 35);
+void ChartPanel::SetCalendarData(const CalendarAggregate& aggregate, const wxString& title) {
+    calendar = aggregate;
+    calendarScale = ColourScale(aggregate.minValue, aggregate.scaleMax);
+    chartTitle = title;
+    hasData = aggregate.dayCount > 0;
+    viewMode = CHART_VIEW_CALENDAR;
+
+    RenderCalendarImage();
+    calendarBitmap = wxBitmap();
+
+    // Render the chart again with the new data
+    InvalidateChart();
 }
 
 /**
- * @brief Draws Y-axis tick marks, labels, and horizontal grid lines
- * @param dc Device context for drawing
- * @param chartLeft Left edge position of chart area
- * @param chartRight Right edge position of chart area
- * @param chartBottom Bottom edge position of chart area
- * @param chartHeight Height of chart area
- * @param minValue Minimum value for Y axis
- * @param maxValue Maximum value for Y axis
+ * @brief Colours the calendar aggregate into the heatmap image
  *
- * Creates evenly spaced tick marks along the Y-axis with appropriate labels
- * and dotted horizontal grid lines across the chart area.
+ * The aggregate is stored in the pixel order of the image (hour rows, day columns),
+ * so one linear pass looks every cell up in the palette and writes its RGB triple.
  */
-void ChartPanel::DrawYAxisTicksAndGrid(wxPaintDC& dc, int chartLeft, int chartRight, int chartBottom, int chartHeight, double minValue, double maxValue) {
-    dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
-
-    // Define number of Y-axis tick marks
-    const int numYTicks = 5;
-    for (int i = 0; i <= numYTicks; i++) {
-        // Calculate value for this tick
-        double value = minValue + ((maxValue - minValue) * i / numYTicks);
-        // Calculate Y position for this tick
-        int y = chartBottom - (i * chartHeight / numYTicks);
-
-        // Format value based on its magnitude for better readability
-        wxString valueStr;
-        if (std::abs(value) < 0.01)
-            valueStr = wxString::Format("%.4f", value);
-        else if (std::abs(value) < 1)
-            valueStr = wxString::Format("%.3f", value);
-        else if (std::abs(value) < 10)
-            valueStr = wxString::Format("%.2f", value);
-        else if (std::abs(value) < 100)
-            valueStr = wxString::Format("%.1f", value);
-        else
-            valueStr = wxString::Format("%.0f", value);
-
-        // Calculate label width for alignment
-        wxSize textSize = dc.GetTextExtent(valueStr);
-        // Draw the tick label
-        dc.DrawText(valueStr, chartLeft - textSize.GetWidth() - 5, y - textSize.GetHeight() / 2);
-
-        // Draw horizontal grid line
-        wxPen gridPen(wxColour(220, 220, 220), 1, wxPENSTYLE_DOT);
-        dc.SetPen(gridPen);
-        dc.DrawLine(chartLeft, y, chartRight, y);
+void ChartPanel::RenderCalendarImage() {
+    if (calendar.dayCount == 0) {
+        calendarImage = wxImage();
+        return;
+    }
+
+    calendarImage = wxImage(static_cast<int>(calendar.dayCount), CalendarAggregate::HOURS_PER_DAY, false);
+    unsigned char* rgb = calendarImage.GetData();
+    if (!rgb) {
+        return;
+    }
+
+    for (size_t i = 0; i < calendar.values.size(); i++) {
+        float value = calendar.values[i];
+        if (std::isnan(value)) {
+            rgb[3 * i] = CALENDAR_MISSING_COLOUR.Red();
+            rgb[3 * i + 1] = CALENDAR_MISSING_COLOUR.Green();
+            rgb[3 * i + 2] = CALENDAR_MISSING_COLOUR.Blue();
+            continue;
+        }
+        const unsigned char* colour = calendarScale.RgbAt(calendarScale.IndexOf(value));
+        rgb[3 * i] = colour[0];
+        rgb[3 * i + 1] = colour[1];
+        rgb[3 * i + 2] = colour[2];
     }
 }
 
 /**
- * @brief Draws X-axis tick marks, labels, and vertical grid lines
+ * @brief Shows a range of hour slots, clamped to the time axis, and triggers a redraw
+ * @param first First slot to show
+ * @param last Last slot to show
+ */
+void ChartPanel::SetVisibleSlots(double first, double last) {
+    renderer.SetVisibleSlots(first, last);
+    InvalidateChart();
+}
+
+/**
+ * @brief Draws the calendar heatmap with its hour and date axes
  * @param dc Device context for drawing
  * @param chartLeft Left edge position of chart area
  * @param chartTop Top edge position of chart area
- * @param chartBottom Bottom edge position of chart area
  * @param chartWidth Width of chart area
+ * @param chartHeight Height of chart area
  *
- * Creates evenly spaced tick marks along the X-axis with timestamp labels
- * and dotted vertical grid lines across the chart area.
+ * The heatmap image is scaled without smoothing, so every cell stays a sharp block;
+ * the scaled bitmap is kept until the chart area changes size. Hours of day are
+ * labelled on the Y axis, and the X axis marks Mondays for short histories or the
+ * first day of each month for long ones. Weekend days are marked below the heatmap,
+ * so weekly patterns can be told apart from daily ones.
  */
-void ChartPanel::DrawXAxisTicksAndGrid(wxPaintDC& dc, int chartLeft, int chartTop, int chartBottom, int chartWidth) {
-    // Determine how many X-axis labels to display
-    int numPointsToShow = std::min(10, static_cast<int>(chartData.size()));
-    int step = std::max(1, static_cast<int>(chartData.size()) / numPointsToShow);
+void ChartPanel::DrawCalendar(wxDC& dc, int chartLeft, int chartTop, int chartWidth, int chartHeight) {
+    if (!calendarImage.IsOk() || chartWidth <= 0 || chartHeight <= 0) {
+        return;
+    }
 
-    // Draw labels at regular intervals
-    for (size_t i = 0; i < chartData.size(); i += step) {
-        wxString dateLabel = chartData[i].first;
+    if (!calendarBitmap.IsOk() || calendarBitmap.GetWidth() != chartWidth || calendarBitmap.GetHeight() != chartHeight) {
+        calendarBitmap = wxBitmap(calendarImage.Scale(chartWidth, chartHeight, wxIMAGE_QUALITY_NORMAL));
+    }
+    dc.DrawBitmap(calendarBitmap, chartLeft, chartTop, false);
 
-        // Format date string to "d00 h00" format
-        dateLabel = "d" + dateLabel.substr(8, 2) + " h" + dateLabel.substr(11, 2);
+    int chartBottom = chartTop + chartHeight;
+    auto dayToX = [&](size_t day) {
+        return chartLeft + static_cast<int>(day * chartWidth / calendar.dayCount);
+    };
 
-        // Calculate X position for this label
-        int x = chartLeft + (i * chartWidth / (chartData.size() - 1));
+    // Hours of day, every three hours at the middle of their row
+    dc.SetFont(canvas.GetFont(CHART_FONT_TICK));
+    dc.SetTextForeground(*wxBLACK);
+    for (int hour = 0; hour < CalendarAggregate::HOURS_PER_DAY; hour += 3) {
+        wxString label = wxString::Format("%02d:00", hour);
+        int y = chartTop + (2 * hour + 1) * chartHeight / (2 * CalendarAggregate::HOURS_PER_DAY);
+        wxSize textSize = dc.GetTextExtent(label);
+        dc.DrawText(label, chartLeft - textSize.GetWidth() - 5, y - textSize.GetHeight() / 2);
+    }
 
-        // Draw rotated label for better space utilization
-        dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
-        dc.DrawRotatedText(dateLabel, x - 5, chartBottom + 5, 45);
+    // Weekend marks below the heatmap
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(wxBrush(CALENDAR_WEEKEND_COLOUR));
+    for (size_t day = 0; day < calendar.dayCount; day++) {
+        if (calendar.WeekdayOf(day) >= 5) {
+            int x = dayToX(day);
+            dc.DrawRectangle(x, chartBottom + 1, std::max(1, dayToX(day + 1) - x), 3);
+        }
+    }
 
-        // Draw vertical grid line
-        wxPen gridPen(wxColour(220, 220, 220), 1, wxPENSTYLE_DOT);
-        dc.SetPen(gridPen);
+    // Date labels with separators: weekly for short histories, monthly for long ones
+    bool weekly = calendar.dayCount <= 62;
+    wxPen separatorPen(*wxWHITE, 1);
+    for (size_t day = 0; day < calendar.dayCount; day++) {
+        std::string date = FormatHoursAsTimestamp(calendar.FirstHourOf(day));
+        bool labelled = weekly ? calendar.WeekdayOf(day) == 0 : date.compare(8, 2, "01") == 0;
+        if (!labelled) {
+            continue;
+        }
+        int x = dayToX(day);
+        dc.SetPen(separatorPen);
         dc.DrawLine(x, chartTop, x, chartBottom);
+        dc.DrawRotatedText(weekly ? date.substr(5, 5) : date.substr(0, 7), x - 5, chartBottom + 5, 45);
     }
+
+    dc.SetPen(borderPen);
+    dc.SetBrush(*wxTRANSPARENT_BRUSH);
+    dc.DrawRectangle(chartLeft, chartTop, chartWidth, chartHeight);
 }
 
 /**
- * @brief Draws data points and the line connecting them
+ * @brief Draws the colour scale of the calendar heatmap to the right of the chart
  * @param dc Device context for drawing
- * @param chartLeft Left edge position of chart area
- * @param chartBottom Bottom edge position of chart area
- * @param chartWidth Width of chart area
+ * @param chartRight Right edge position of chart area
+ * @param chartTop Top edge position of chart area
  * @param chartHeight Height of chart area
- * @param minValue Minimum value for Y axis
- * @param maxValue Maximum value for Y axis
  *
- * Creates a line graph by plotting data points as circles and connecting them
- * with a continuous line.
+ * Draws a vertical colour bar with the lowest value at the bottom. The top label is
+ * the 99th percentile; when larger values exist it is prefixed with ">=", since those
+ * hours share the last colour.
  */
-void ChartPanel::DrawDataPointsAndLines(wxPaintDC& dc, int chartLeft, int chartBottom, int chartWidth, int chartHeight, double minValue, double maxValue) {
-    if (chartData.size() > 1) {
-        wxPen linePen(wxColour(41, 128, 185), 2);
-        dc.SetPen(linePen);
-
-        std::vector<wxPoint> points;
-
-        // Calculate screen coordinates for each data point
-        for (size_t i = 0; i < chartData.size(); i++) {
-            int x = chartLeft + (i * chartWidth / (chartData.size() - 1));
-            // Map data value to screen Y coordinate
-            int y = chartBottom - ((chartData[i].second - minValue) / (maxValue - minValue) * chartHeight);
-            points.push_back(wxPoint(x, y));
-        }
+void ChartPanel::DrawCalendarLegend(wxDC& dc, int chartRight, int chartTop, int chartHeight) {
+    const int steps = 64;
+    int left = chartRight + 10;
+
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    for (int i = 0; i < steps; i++) {
+        int y0 = chartTop + chartHeight - (i + 1) * chartHeight / steps;
+        int y1 = chartTop + chartHeight - i * chartHeight / steps;
+        double value = calendarScale.GetMin() + (calendarScale.GetMax() - calendarScale.GetMin()) * (i + 0.5) / steps;
+        dc.SetBrush(wxBrush(calendarScale.ColourOf(value)));
+        dc.DrawRectangle(left, y0, CALENDAR_LEGEND_WIDTH, y1 - y0);
+    }
 
-        // Draw polyline connecting all points
-        dc.DrawLines(points.size(), points.data());
+    dc.SetFont(canvas.GetFont(CHART_FONT_TICK));
+    dc.SetTextForeground(*wxBLACK);
+    wxString maxLabel = wxString::Format(calendar.maxValue > calendarScale.GetMax() ? ">=%.0f" : "%.0f", calendarScale.GetMax());
+    wxString minLabel = wxString::Format("%.0f", calendarScale.GetMin());
+    dc.DrawText(maxLabel, left, chartTop - dc.GetTextExtent(maxLabel).GetHeight() - 2);
+    dc.DrawText(minLabel, left, chartTop + chartHeight + 2);
+}
 
-        // Draw each data point as a circle
-        for (const auto& point : points) {
-            dc.SetBrush(wxBrush(wxColour(41, 128, 185)));
-            dc.SetPen(wxPen(*wxWHITE, 1));
-            dc.DrawCircle(point, 4);
-        }
+/**
+ * @brief Renders all chart elements into a device context
+ * @param dc Device context for drawing (the memory DC of the chart cache)
+ * @param area Part of the panel to render; nothing outside it is touched
+ *
+ * The line chart is drawn by the renderer through the canvas, clipped to the given
+ * area, so a strip of the cache can be rendered again on its own. The calendar heatmap
+ * brings its own axes and only borrows the renderer's title and axis labels.
+ */
+void ChartPanel::RenderChart(wxDC& dc, const wxRect& area) {
+    wxSize panelSize = GetClientSize();
+    renderer.SetSize(panelSize.GetWidth(), panelSize.GetHeight());
+    canvas.Attach(dc);
+
+    // Show message if no data is available
+    if (!hasData || (viewMode == CHART_VIEW_LINE && renderer.Size() == 0)) {
+        renderer.DrawNoDataMessage(canvas);
+        return;
+    }
+
+    if (viewMode == CHART_VIEW_CALENDAR) {
+        ChartArea chartArea = renderer.GetChartArea();
+        renderer.DrawTitleAndAxisLabels(canvas, std::string(chartTitle.utf8_str()), "Day", "Hour of day");
+        DrawCalendar(dc, chartArea.left, chartArea.top, chartArea.width, chartArea.height);
+        DrawCalendarLegend(dc, chartArea.right, chartArea.top, chartArea.height);
+        return;
     }
+
+    renderer.Render(canvas, area.GetLeft(), area.GetTop(), area.GetWidth(), area.GetHeight());
 }
 
 /**
- * @brief Main paint handler that orchestrates the drawing of all chart elements
+ * @brief Draws the paint counters in the bottom right corner of the panel
+ * @param dc Device context of the paint event
+ *
+ * Only called in debug builds; drawn over the blitted cache, so it is not cached itself.
+ */
+void ChartPanel::DrawPaintStatistics(wxDC& dc) {
+    wxString text = wxString::Format("paints %lu, renders %lu (partial %lu), last blit %.2f ms, last render %.2f ms",
+        paintStatistics.paintCount, paintStatistics.renderCount, paintStatistics.partialRenderCount,
+        paintStatistics.lastPaintMilliseconds, paintStatistics.lastRenderMilliseconds);
+    dc.SetFont(canvas.GetFont(CHART_FONT_TICK));
+    dc.SetTextForeground(wxColour(150, 150, 150));
+    wxSize textSize = dc.GetTextExtent(text);
+    wxSize panelSize = GetClientSize();
+    dc.DrawText(text, panelSize.GetWidth() - textSize.GetWidth() - 5, panelSize.GetHeight() - textSize.GetHeight() - 2);
+    dc.SetTextForeground(*wxBLACK);
+}
+
+/**
+ * @brief Main paint handler that shows the cached chart
  * @param event The paint event
  *
- * Coordinates the drawing of all chart components in the correct order when
- * the panel needs to be repainted.
+ * The chart is rendered into an offscreen bitmap only after the data or the panel
+ * size changed; every other repaint (e.g. a dialog moved over the window) is a single
+ * blit of that bitmap. Both paths are counted and timed in the paint statistics.
+ *
+ * After live data was appended, only the strip from the first changed hour to the
+ * right edge is rendered again, provided the layout of the cached chart still holds;
+ * a new Y range or a moved axis renders everything.
  */
 void ChartPanel::OnPaint(wxPaintEvent& event) {
+    auto paintStart = std::chrono::steady_clock::now();
+
+    // The window content is painted over, so a tooltip on the overlay is gone
+    hoverOverlay.Reset();
+    hovering = false;
+
     // Create device context for drawing
     wxPaintDC dc(this);
+    wxSize panelSize = GetClientSize();
+    if (panelSize.GetWidth() <= 0 || panelSize.GetHeight() <= 0) {
+        return;
+    }
 
-    // Show message if no data is available
-    if (!hasData || chartData.empty()) {
-        DrawNoDataMessage(dc);
+    bool sizeChanged = !chartCache.IsOk() || chartCache.GetSize() != panelSize;
+
+    // Render only the strip exposed by appended live data while the layout holds
+    if (partialRenderPending && chartCacheValid && !sizeChanged && viewMode == CHART_VIEW_LINE) {
+        auto renderStart = std::chrono::steady_clock::now();
+        if (renderer.CurrentLayout() == renderedLayout) {
+            double dirtySlot = static_cast<double>(dirtyFromHour - 1 - renderer.FirstHour());
+            int left = std::max(0, renderer.SlotToX(dirtySlot) - LIVE_REDRAW_MARGIN);
+            wxRect area(left, 0, std::max(0, panelSize.GetWidth() - left), panelSize.GetHeight());
+
+            wxMemoryDC memoryDC(chartCache);
+            memoryDC.SetPen(*wxTRANSPARENT_PEN);
+            memoryDC.SetBrush(wxBrush(GetBackgroundColour()));
+            memoryDC.DrawRectangle(area);
+            RenderChart(memoryDC, area);
+            memoryDC.SelectObject(wxNullBitmap);
+
+            paintStatistics.partialRenderCount++;
+            paintStatistics.lastRenderMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+        }
+        else {
+            chartCacheValid = false;
+        }
+    }
+    partialRenderPending = false;
+
+    // Render all layers into the cache if the data or the size changed
+    if (!chartCacheValid || sizeChanged) {
+        auto renderStart = std::chrono::steady_clock::now();
+        if (sizeChanged) {
+            chartCache = wxBitmap(panelSize.GetWidth(), panelSize.GetHeight());
+        }
+        wxMemoryDC memoryDC(chartCache);
+        memoryDC.SetBackground(wxBrush(GetBackgroundColour()));
+        memoryDC.Clear();
+        RenderChart(memoryDC, wxRect(0, 0, panelSize.GetWidth(), panelSize.GetHeight()));
+        memoryDC.SelectObject(wxNullBitmap);
+        chartCacheValid = true;
+        if (viewMode == CHART_VIEW_LINE) {
+            renderedLayout = renderer.CurrentLayout();
+        }
+
+        paintStatistics.renderCount++;
+        paintStatistics.lastRenderMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - renderStart).count();
+    }
+
+    dc.DrawBitmap(chartCache, 0, 0, false);
+
+    paintStatistics.paintCount++;
+    paintStatistics.lastPaintMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - paintStart).count();
+    paintStatistics.totalPaintMilliseconds += paintStatistics.lastPaintMilliseconds;
+
+#ifdef _DEBUG
+    DrawPaintStatistics(dc);
+#endif
+}
+
+/**
+ * @brief Event handler for the mouse wheel, zooms the time axis around the cursor
+ * @param event The mouse event
+ *
+ * Each wheel notch scales the visible span by ZOOM_STEP while the slot under the
+ * cursor keeps its position, so the hour being looked at stays in place.
+ */
+void ChartPanel::OnMouseWheel(wxMouseEvent& event) {
+    if (!hasData || viewMode != CHART_VIEW_LINE || renderer.Size() < 2 || event.GetWheelRotation() == 0) {
+        event.Skip();
         return;
     }
 
-    // Set up chart dimensions
-    int chartLeft, chartTop, chartWidth, chartHeight, chartBottom, chartRight;
-    SetupChartDimensions(chartLeft, chartTop, chartWidth, chartHeight, chartBottom, chartRight);
+    ChartArea chartArea = renderer.GetChartArea();
+    int x = std::min(std::max(event.GetX(), chartArea.left), chartArea.right);
 
-    // Draw chart background and border
-    DrawChartBackground(dc, chartLeft, chartTop, chartWidth, chartHeight);
+    double first, last;
+    renderer.GetVisibleSlots(first, last);
+    double anchor = renderer.XToSlot(x);
+    double notches = static_cast<double>(event.GetWheelRotation()) / std::max(1, event.GetWheelDelta());
+    double factor = std::pow(ZOOM_STEP, notches);
+    SetVisibleSlots(anchor - (anchor - first) * factor, anchor + (last - anchor) * factor);
+}
 
-    // Calculate data value range
-    double minValue, maxValue;
-    CalculateValueRange(minValue, maxValue);
+/**
+ * @brief Event handler for pressing the left button, starts panning a zoomed chart
+ * @param event The mouse event
+ *
+ * The mouse is captured, so the drag continues when the cursor leaves the panel.
+ */
+void ChartPanel::OnLeftDown(wxMouseEvent& event) {
+    event.Skip();
+    ClearHover();
+    if (!renderer.IsZoomed() || viewMode != CHART_VIEW_LINE) {
+        return;
+    }
+    double last;
+    panning = true;
+    panStartX = event.GetX();
+    renderer.GetVisibleSlots(panStartFirst, last);
+    if (!HasCapture()) {
+        CaptureMouse();
+    }
+}
+
+/**
+ * @brief Event handler for releasing the left button, ends panning
+ * @param event The mouse event
+ */
+void ChartPanel::OnLeftUp(wxMouseEvent& event) {
+    event.Skip();
+    panning = false;
+    if (HasCapture()) {
+        ReleaseMouse();
+    }
+}
 
-    // Draw all chart elements in proper order
-    DrawChartTitle(dc, chartLeft, chartWidth, chartTop);
-    DrawAxisLabels(dc, chartLeft, chartTop, chartWidth, chartHeight, chartBottom);
-    DrawYAxisTicksAndGrid(dc, chartLeft, chartRight, chartBottom, chartHeight, minValue, maxValue);
-    DrawXAxisTicksAndGrid(dc, chartLeft, chartTop, chartBottom, chartWidth);
-    DrawDataPointsAndLines(dc, chartLeft, chartBottom, chartWidth, chartHeight, minValue, maxValue);
-}
\ No newline at end of file
+/**
+ * @brief Event handler for mouse motion, moves the visible window while panning or updates the hover tooltip
+ * @param event The mouse event
+ *
+ * The window follows the cursor: dragging right reveals earlier hours.
+ */
+void ChartPanel::OnMouseMove(wxMouseEvent& event) {
+    event.Skip();
+    if (!panning || !event.LeftIsDown()) {
+        UpdateHover(event.GetPosition());
+        return;
+    }
+
+    double first, last;
+    renderer.GetVisibleSlots(first, last);
+    double span = last - first;
+    first = panStartFirst + static_cast<double>(panStartX - event.GetX()) * span / std::max(1, renderer.GetChartArea().width);
+    SetVisibleSlots(first, first + span);
+}
+
+/**
+ * @brief Marks the data point nearest to a position and shows its tooltip
+ * @param position Mouse position in client coordinates
+ *
+ * This function:
+ * 1. Asks the renderer for the nearest point among those drawn in the cached chart,
+ *    a binary search per series
+ * 2. Leaves the window untouched if there is neither a point nor a tooltip to remove
+ * 3. Clears the overlay, which restores the chart under the previous tooltip, and draws
+ *    a ring around the point with a box showing its series, time and value; the box is
+ *    moved to the other side of the point where it would leave the panel
+ */
+void ChartPanel::UpdateHover(const wxPoint& position) {
+    ChartHoverPoint point;
+    bool found = hasData && viewMode == CHART_VIEW_LINE && !panning && chartCacheValid &&
+        renderer.FindNearestPoint(position.x, position.y, point);
+    if (!found && !hovering) {
+        return;
+    }
+
+    wxClientDC dc(this);
+    wxDCOverlay overlayDC(hoverOverlay, &dc);
+    overlayDC.Clear();
+    hovering = found;
+    if (!found) {
+        return;
+    }
+
+    wxString text = wxString::FromUTF8(point.timestamp.c_str()) + wxString::Format("  %.2f", point.value);
+    if (!point.seriesLabel.empty()) {
+        text = wxString::FromUTF8(point.seriesLabel.c_str()) + "  " + text;
+    }
+
+    dc.SetPen(wxPen(*wxBLACK, 2));
+    dc.SetBrush(*wxTRANSPARENT_BRUSH);
+    dc.DrawCircle(point.x, point.y, HOVER_MARKER_RADIUS);
+
+    dc.SetFont(canvas.GetFont(CHART_FONT_TICK));
+    wxSize textSize = dc.GetTextExtent(text);
+    int boxWidth = textSize.GetWidth() + 2 * HOVER_TOOLTIP_PADDING;
+    int boxHeight = textSize.GetHeight() + 2 * HOVER_TOOLTIP_PADDING;
+    wxSize panelSize = GetClientSize();
+    int boxX = point.x + HOVER_TOOLTIP_OFFSET;
+    int boxY = point.y - HOVER_TOOLTIP_OFFSET - boxHeight;
+    if (boxX + boxWidth > panelSize.GetWidth()) {
+        boxX = point.x - HOVER_TOOLTIP_OFFSET - boxWidth;
+    }
+    if (boxY < 0) {
+        boxY = point.y + HOVER_TOOLTIP_OFFSET;
+    }
+
+    dc.SetPen(borderPen);
+    dc.SetBrush(*wxWHITE_BRUSH);
+    dc.DrawRectangle(boxX, boxY, boxWidth, boxHeight);
+    dc.SetTextForeground(*wxBLACK);
+    dc.DrawText(text, boxX + HOVER_TOOLTIP_PADDING, boxY + HOVER_TOOLTIP_PADDING);
+}
+
+/**
+ * @brief Removes the hover tooltip
+ */
+void ChartPanel::ClearHover() {
+    if (!hovering) {
+        return;
+    }
+    {
+        wxClientDC dc(this);
+        wxDCOverlay overlayDC(hoverOverlay, &dc);
+        overlayDC.Clear();
+    }
+    hoverOverlay.Reset();
+    hovering = false;
+}
+
+/**
+ * @brief Event handler for a left double click, shows the whole time axis again
+ * @param event The mouse event
+ */
+void ChartPanel::OnLeftDoubleClick(wxMouseEvent& event) {
+    event.Skip();
+    if (renderer.IsZoomed()) {
+        renderer.ResetZoom();
+        InvalidateChart();
+    }
+}
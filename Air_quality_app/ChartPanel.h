@@ -4,10 +4,18 @@
 #define CHART_PANEL_H
 
 #include <wx/wx.h>
+#include <wx/overlay.h>
 #include <algorithm>
 #include <vector>
 #include <utility>
 #include <limits>
+#include <cmath>
+
+#include "CalendarHeatmap.h"
+#include "ChartRenderer.h"
+#include "ColourScale.h"
+#include "DcChartCanvas.h"
+#include "HourlyRingBuffer.h"
 
 /**
  * @file ChartPanel.h
@@ -15,28 +23,155 @@
  */
 
  /**
-  * @class ChartPanel
-  * @brief A panel that displays time-series data as a line chart
-  *
-  * ChartPanel renders data points as a line chart with proper axes, labels, and grid.
-  * It supports dynamic data updates and handles proper scaling of values.
+  * @brief Visualizations the chart panel can show
   */
+enum ChartViewMode {
+    CHART_VIEW_LINE,     /**< Line chart of the chart data */
+    CHART_VIEW_CALENDAR  /**< Day-by-hour heatmap of a calendar aggregate */
+};
+
+/**
+ * @struct PaintStatistics
+ * @brief Counters of the chart panel's paint events and offscreen renders
+ *
+ * A paint that finds the cache up to date only blits it, so paintCount - renderCount
+ * repaints cost a blit each.
+ */
+struct PaintStatistics {
+    unsigned long paintCount = 0;          /**< Number of handled paint events */
+    unsigned long renderCount = 0;         /**< Number of times the chart was rendered into the cache */
+    unsigned long partialRenderCount = 0;  /**< Renders limited to the part exposed by appended live data */
+    double lastPaintMilliseconds = 0.0;    /**< Duration of the last paint event, including a render if one was needed */
+    double lastRenderMilliseconds = 0.0;   /**< Duration of the last render into the cache */
+    double totalPaintMilliseconds = 0.0;   /**< Total time spent in paint events */
+};
+
+/**
+ * @class ChartPanel
+ * @brief A panel that displays time-series data as a line chart or a calendar heatmap
+ *
+ * ChartPanel shows data points as a line chart with proper axes, labels, and grid.
+ * It supports dynamic data updates and handles proper scaling of values. The X axis is
+ * proportional to time: data is kept on an hourly grid with NaN for missing hours, so
+ * outages break the line, and the ticks are chosen by time scale. An optional
+ * forecast with its confidence band is drawn after the last data point, and data
+ * points flagged by the anomaly detector are highlighted. Further series on the same
+ * time axis can be overlaid in distinct colours with a legend, e.g. to compare stations.
+ * The line chart itself is modelled and drawn by a ChartRenderer, which the panel
+ * feeds with the parsed data and draws through a DcChartCanvas.
+ *
+ * In calendar mode the panel shows a sensor's history with one column per day and
+ * one row per hour of day. The aggregate is coloured once into an image with one pixel
+ * per cell; repainting only draws that image scaled to the chart area.
+ *
+ * Every mode is rendered into an offscreen bitmap, which is only rendered again after
+ * the data, the visible window or the panel size changed; other paint events just blit it.
+ *
+ * In live mode the chart data is a fixed-capacity ring of the newest hours, to which
+ * downloaded points are appended in place. The X axis then spans the capacity plus a
+ * day and moves on in whole days, so while the Y range holds, an append only renders
+ * the strip of the cache right of the first changed hour.
+ *
+ * The line chart can be zoomed with the mouse wheel around the cursor and panned by
+ * dragging; a double click shows the whole series again. Every series keeps a min/max
+ * pyramid, so the visible window is drawn from the level matching the chart width and
+ * its Y range is queried without scanning the samples.
+ *
+ * Hovering over the line chart marks the nearest drawn point and shows its time and
+ * value in a tooltip. The tooltip is drawn on a wxOverlay above the window, so mouse
+ * motion neither renders the chart nor blits the cache.
+ */
 class ChartPanel : public wxPanel {
 private:
-    std::vector<std::pair<wxString, double>> chartData; /**< Data points to be displayed (timestamp, value) */
-    wxString chartTitle; /**< Title displayed at the top of the chart */
-    wxString xAxisLabel; /**< Label for the X axis */
-    wxString yAxisLabel; /**< Label for the Y axis */
+    ChartRenderer renderer; /**< Data, visible window and drawing code of the line chart */
+    DcChartCanvas canvas; /**< Canvas the renderer and the calendar draw into the cache through */
+    wxString chartTitle; /**< Title displayed at the top of the calendar */
     bool hasData; /**< Flag indicating whether there is data to display */
+    bool panning; /**< Whether the visible window is being dragged */
+    int panStartX; /**< Mouse X coordinate where the drag started */
+    double panStartFirst; /**< First visible hour slot when the drag started */
+    wxBitmap chartCache; /**< All chart layers rendered at the panel size */
+    bool chartCacheValid; /**< Whether chartCache shows the current data */
+    PaintStatistics paintStatistics; /**< Paint and render counters */
+    bool partialRenderPending; /**< Whether live data was appended since the last render */
+    long long dirtyFromHour; /**< Earliest hour changed by live data since the last render */
+    ChartLayout renderedLayout; /**< Layout of the data in the cached chart */
+    wxPen borderPen; /**< Pen of the calendar border */
+    ChartViewMode viewMode; /**< Visualization currently shown */
+    CalendarAggregate calendar; /**< Day-by-hour values shown in calendar mode */
+    ColourScale calendarScale; /**< Colour scale of the calendar heatmap */
+    wxImage calendarImage; /**< Calendar heatmap at one pixel per cell */
+    wxBitmap calendarBitmap; /**< Calendar heatmap scaled to the current chart area */
+    wxOverlay hoverOverlay; /**< Overlay the hover tooltip is drawn on */
+    bool hovering; /**< Whether a hover tooltip is shown */
 
     /**
      * @brief Event handler for paint events
      * @param event The paint event
      *
-     * Coordinates the drawing of all chart elements when the panel needs to be repainted
+     * Blits the cached chart, rendering it first if the data or the size changed
      */
     void OnPaint(wxPaintEvent& event);
 
+    /**
+     * @brief Renders all chart elements into a device context
+     * @param dc Device context for drawing
+     * @param area Part of the panel to render; nothing outside it is touched
+     */
+    void RenderChart(wxDC& dc, const wxRect& area);
+
+    /**
+     * @brief Marks the cached chart as outdated and triggers a redraw
+     */
+    void InvalidateChart();
+
+    /**
+     * @brief Draws the paint counters in the bottom right corner of the panel (debug builds)
+     * @param dc Device context of the paint event
+     */
+    void DrawPaintStatistics(wxDC& dc);
+
+    /**
+     * @brief Event handler for the mouse wheel, zooms the time axis around the cursor
+     * @param event The mouse event
+     */
+    void OnMouseWheel(wxMouseEvent& event);
+
+    /**
+     * @brief Event handler for pressing the left button, starts panning a zoomed chart
+     * @param event The mouse event
+     */
+    void OnLeftDown(wxMouseEvent& event);
+
+    /**
+     * @brief Event handler for releasing the left button, ends panning
+     * @param event The mouse event
+     */
+    void OnLeftUp(wxMouseEvent& event);
+
+    /**
+     * @brief Event handler for mouse motion, moves the visible window while panning or updates the hover tooltip
+     * @param event The mouse event
+     */
+    void OnMouseMove(wxMouseEvent& event);
+
+    /**
+     * @brief Marks the data point nearest to a position and shows its tooltip
+     * @param position Mouse position in client coordinates
+     */
+    void UpdateHover(const wxPoint& position);
+
+    /**
+     * @brief Removes the hover tooltip
+     */
+    void ClearHover();
+
+    /**
+     * @brief Event handler for a left double click, shows the whole time axis again
+     * @param event The mouse event
+     */
+    void OnLeftDoubleClick(wxMouseEvent& event);
+
 public:
     /**
      * @brief Constructor for ChartPanel
@@ -53,98 +188,113 @@ public:
      * @param xLabel Label for the X axis
      * @param yLabel Label for the Y axis
      *
-     * Updates the chart with new data and triggers a redraw
+     * Updates the chart with new data and triggers a redraw. Data that is not one point
+     * per consecutive hour is placed on an hourly grid first
      */
     void SetChartData(const std::vector<std::pair<wxString, double>>& data, const wxString& title, const wxString& xLabel, const wxString& yLabel);
 
-private:
     /**
-     * @brief Displays a message when no data is available
-     * @param dc Device context for drawing
+     * @brief Sets the forecast drawn after the last data point
+     * @param values Predicted value for each hour following the chart data
+     * @param lower Lower bound of the confidence band for each hour
+     * @param upper Upper bound of the confidence band for each hour
+     *
+     * The forecast is cleared by the next call to SetChartData
+     */
+    void SetForecast(const std::vector<double>& values, const std::vector<double>& lower, const std::vector<double>& upper);
+
+    /**
+     * @brief Sets the anomaly flags of the data points
+     * @param flags AnomalyFlag combination for each data point (same length as the chart data)
+     *
+     * The flags are cleared by the next call to SetChartData
      */
-    void DrawNoDataMessage(wxPaintDC& dc);
+    void SetAnomalyFlags(const std::vector<int>& flags);
 
     /**
-     * @brief Calculates chart dimensions and positioning based on panel size
-     * @param chartLeft [out] Left edge position of chart area
-     * @param chartTop [out] Top edge position of chart area
-     * @param chartWidth [out] Width of chart area
-     * @param chartHeight [out] Height of chart area
-     * @param chartBottom [out] Bottom edge position of chart area
-     * @param chartRight [out] Right edge position of chart area
+     * @brief Sets several series on a common time axis to be overlaid with a legend
+     * @param timestamps Timestamp of each hour of the time axis
+     * @param series Series to draw, each with one value per timestamp; the first one is drawn on top
+     * @param title Title for the chart
+     * @param xLabel Label for the X axis
+     * @param yLabel Label for the Y axis
+     *
+     * Series whose length differs from the time axis are skipped. The overlay is cleared
+     * by the next call to SetChartData
      */
-    void SetupChartDimensions(int& chartLeft, int& chartTop, int& chartWidth, int& chartHeight, int& chartBottom, int& chartRight);
+    void SetComparisonData(const std::vector<wxString>& timestamps, const std::vector<ChartSeries>& series, const wxString& title, const wxString& xLabel, const wxString& yLabel);
 
     /**
-     * @brief Draws the chart background and border
-     * @param dc Device context for drawing
-     * @param chartLeft Left edge position of chart area
-     * @param chartTop Top edge position of chart area
-     * @param chartWidth Width of chart area
-     * @param chartHeight Height of chart area
+     * @brief Shows the newest hours of a live series, to be extended by AppendLiveData
+     * @param buffer Ring buffer of the series; its capacity is kept
+     * @param title Title for the chart
+     * @param xLabel Label for the X axis
+     * @param yLabel Label for the Y axis
+     *
+     * Live mode ends with the next call to SetChartData.
      */
-    void DrawChartBackground(wxPaintDC& dc, int chartLeft, int chartTop, int chartWidth, int chartHeight);
+    void SetLiveData(const HourlyRingBuffer& buffer, const wxString& title, const wxString& xLabel, const wxString& yLabel);
 
     /**
-     * @brief Determines the minimum and maximum data values with padding
-     * @param minValue [out] Calculated minimum value for Y axis
-     * @param maxValue [out] Calculated maximum value for Y axis
+     * @brief Adds new or corrected hours to a live series
+     * @param points Hours (since 1970-01-01 00:00) and values, in time order
+     *
+     * Ignored unless the panel is in live mode.
      */
-    void CalculateValueRange(double& minValue, double& maxValue);
+    void AppendLiveData(const std::vector<std::pair<long long, double>>& points);
 
     /**
-     * @brief Draws the chart title centered above the chart
-     * @param dc Device context for drawing
-     * @param chartLeft Left edge position of chart area
-     * @param chartWidth Width of chart area
-     * @param chartTop Top edge position of chart area
+     * @brief Checks whether the panel shows a live series
+     * @return true in live mode, false otherwise
      */
-    void DrawChartTitle(wxPaintDC& dc, int chartLeft, int chartWidth, int chartTop);
+    bool IsLive() const;
 
     /**
-     * @brief Draws the X and Y axis labels
-     * @param dc Device context for drawing
-     * @param chartLeft Left edge position of chart area
-     * @param chartTop Top edge position of chart area
-     * @param chartWidth Width of chart area
-     * @param chartHeight Height of chart area
-     * @param chartBottom Bottom edge position of chart area
+     * @brief Shows a calendar heatmap instead of the line chart
+     * @param aggregate Day-by-hour values to display
+     * @param title Title for the chart
+     *
+     * The line chart is shown again by the next call to SetChartData
      */
-    void DrawAxisLabels(wxPaintDC& dc, int chartLeft, int chartTop, int chartWidth, int chartHeight, int chartBottom);
+    void SetCalendarData(const CalendarAggregate& aggregate, const wxString& title);
 
     /**
-     * @brief Draws Y-axis tick marks, labels, and horizontal grid lines
-     * @param dc Device context for drawing
-     * @param chartLeft Left edge position of chart area
-     * @param chartRight Right edge position of chart area
-     * @param chartBottom Bottom edge position of chart area
-     * @param chartHeight Height of chart area
-     * @param minValue Minimum value for Y axis
-     * @param maxValue Maximum value for Y axis
+     * @brief Gets the paint and render counters of the panel
+     * @return PaintStatistics accumulated since the panel was created
+     */
+    PaintStatistics GetPaintStatistics() const;
+
+private:
+    /**
+     * @brief Shows a range of hour slots, clamped to the time axis, and triggers a redraw
+     * @param first First slot to show
+     * @param last Last slot to show
+     */
+    void SetVisibleSlots(double first, double last);
+
+    /**
+     * @brief Colours the calendar aggregate into the heatmap image
      */
-    void DrawYAxisTicksAndGrid(wxPaintDC& dc, int chartLeft, int chartRight, int chartBottom, int chartHeight, double minValue, double maxValue);
+    void RenderCalendarImage();
 
     /**
-     * @brief Draws X-axis tick marks, labels, and vertical grid lines
+     * @brief Draws the calendar heatmap with its hour and date axes
      * @param dc Device context for drawing
      * @param chartLeft Left edge position of chart area
      * @param chartTop Top edge position of chart area
-     * @param chartBottom Bottom edge position of chart area
      * @param chartWidth Width of chart area
+     * @param chartHeight Height of chart area
      */
-    void DrawXAxisTicksAndGrid(wxPaintDC& dc, int chartLeft, int chartTop, int chartBottom, int chartWidth);
+    void DrawCalendar(wxDC& dc, int chartLeft, int chartTop, int chartWidth, int chartHeight);
 
     /**
-     * @brief Draws data points and the line connecting them
+     * @brief Draws the colour scale of the calendar heatmap to the right of the chart
      * @param dc Device context for drawing
-     * @param chartLeft Left edge position of chart area
-     * @param chartBottom Bottom edge position of chart area
-     * @param chartWidth Width of chart area
+     * @param chartRight Right edge position of chart area
+     * @param chartTop Top edge position of chart area
      * @param chartHeight Height of chart area
-     * @param minValue Minimum value for Y axis
-     * @param maxValue Maximum value for Y axis
      */
-    void DrawDataPointsAndLines(wxPaintDC& dc, int chartLeft, int chartBottom, int chartWidth, int chartHeight, double minValue, double maxValue);
+    void DrawCalendarLegend(wxDC& dc, int chartRight, int chartTop, int chartHeight);
 };
 
 #endif // CHART_PANEL_H
\ No newline at end of file
@@ -0,0 +1,996 @@
+/**
+ * @file ChartRenderer.cpp
+ * @brief Implementation of the ChartRenderer class
+ */
+
+#include "ChartRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+
+#include "AnomalyDetection.h"
+
+namespace {
+    const int CHART_MARGIN = 60;                             ///< Space around the plot area for title, ticks and labels
+    const int LEGEND_LINE_HEIGHT = 14;                       ///< Height of one entry of the series legend in pixels
+    const size_t MIN_MARKER_SPACING = 6;                     ///< Pixels per data point below which no circles are drawn
+    const double MIN_VISIBLE_SLOTS = 12.0;                   ///< Fewest hours the zoom can narrow the X axis to
+    const int MIN_TICK_SPACING = 60;                         ///< Fewest pixels between two X-axis ticks
+    const long long LIVE_AXIS_STEP_HOURS = 24;               ///< Hours the live time axis moves on by at once
+    const int HOVER_MAX_DISTANCE = 20;                       ///< Farthest horizontal distance in pixels at which a point is found
+    const ChartColour BLACK(0, 0, 0);                        ///< Text colour
+    const ChartColour WHITE(255, 255, 255);                  ///< Plot and legend background
+    const ChartColour GRID_COLOUR(220, 220, 220);            ///< Colour of the dotted grid lines
+    const ChartColour BORDER_COLOUR(200, 200, 200);          ///< Colour of the chart and legend borders
+
+    /**
+     * @brief Gets the colour of a series; the chart data is series 0
+     *
+     * Ten distinct colours are used first, further series repeat them.
+     */
+    ChartColour SeriesColour(size_t index) {
+        static const unsigned char colours[10][3] = {
+            { 41, 128, 185 }, { 230, 126, 34 }, { 39, 174, 96 }, { 192, 57, 43 }, { 142, 68, 173 },
+            { 22, 160, 133 }, { 241, 196, 15 }, { 127, 140, 141 }, { 211, 84, 0 }, { 44, 62, 80 }
+        };
+        const unsigned char* colour = colours[index % 10];
+        return ChartColour(colour[0], colour[1], colour[2]);
+    }
+
+    /**
+     * @brief Sets the pen of a series; repeated colours get a dashed line
+     */
+    void SetSeriesPen(ChartCanvas& canvas, size_t index, int width) {
+        canvas.SetPen(SeriesColour(index), width, index < 10 ? CHART_LINE_SOLID : CHART_LINE_SHORT_DASH);
+    }
+
+    /**
+     * @brief Formats a tick value with a precision matching its magnitude
+     */
+    std::string FormatTickValue(double value) {
+        const char* format = "%.0f";
+        if (std::abs(value) < 0.01)
+            format = "%.4f";
+        else if (std::abs(value) < 1)
+            format = "%.3f";
+        else if (std::abs(value) < 10)
+            format = "%.2f";
+        else if (std::abs(value) < 100)
+            format = "%.1f";
+
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), format, value);
+        return buffer;
+    }
+}
+
+/**
+ * @brief Creates a renderer without data
+ */
+ChartRenderer::ChartRenderer() {
+    timeAxis = false;
+    liveMode = false;
+    zoomed = false;
+    viewFirst = 0.0;
+    viewLast = 0.0;
+    canvasWidth = 0;
+    canvasHeight = 0;
+}
+
+/**
+ * @brief Sets the canvas size the chart is laid out for
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+void ChartRenderer::SetSize(int width, int height) {
+    canvasWidth = width;
+    canvasHeight = height;
+}
+
+/**
+ * @brief Gets the plot area at the current size
+ * @return ChartArea inside the margins
+ *
+ * Leaves CHART_MARGIN pixels on every side for the title, tick labels and axis labels.
+ */
+ChartArea ChartRenderer::GetChartArea() const {
+    ChartArea area;
+    area.width = canvasWidth - 2 * CHART_MARGIN;
+    area.height = canvasHeight - 2 * CHART_MARGIN;
+    area.left = CHART_MARGIN;
+    area.top = CHART_MARGIN;
+    area.bottom = area.top + area.height;
+    area.right = area.left + area.width;
+    return area;
+}
+
+/**
+ * @brief Sets the data to be displayed and shows all of it
+ * @param series Values on an hourly grid
+ * @param pointLabels Raw timestamps of the values if they could not be parsed, otherwise empty
+ * @param title Title for the chart (UTF-8)
+ * @param xLabel Label for the X axis (UTF-8)
+ * @param yLabel Label for the Y axis (UTF-8)
+ *
+ * With point labels, the values are shown one slot per point and the X axis is
+ * labelled with the labels instead of by time.
+ */
+void ChartRenderer::SetData(const HourlySeries& series, const std::vector<std::string>& pointLabels, const std::string& title, const std::string& xLabel, const std::string& yLabel) {
+    chartValues.Assign(series, 0);
+    this->pointLabels = pointLabels;
+    timeAxis = pointLabels.empty();
+    chartTitle = title;
+    xAxisLabel = xLabel;
+    yAxisLabel = yLabel;
+    forecastValues.clear();
+    forecastLower.clear();
+    forecastUpper.clear();
+    anomalyFlags.clear();
+    anomalyIndices.clear();
+    overlaySeries.clear();
+    overlayPyramids.clear();
+    primaryLabel.clear();
+    liveMode = false;
+    zoomed = false;
+}
+
+/**
+ * @brief Shows the newest hours of a live series, to be extended by AppendLiveData
+ * @param buffer Ring buffer of the series; its capacity is kept
+ * @param title Title for the chart (UTF-8)
+ * @param xLabel Label for the X axis (UTF-8)
+ * @param yLabel Label for the Y axis (UTF-8)
+ */
+void ChartRenderer::SetLiveData(const HourlyRingBuffer& buffer, const std::string& title, const std::string& xLabel, const std::string& yLabel) {
+    SetData(HourlySeries(), std::vector<std::string>(), title, xLabel, yLabel);
+    chartValues = buffer;
+    liveMode = true;
+}
+
+/**
+ * @brief Adds new or corrected hours to a live series
+ * @param points Hours (since 1970-01-01 00:00) and values, in time order
+ * @return true if the forecast or anomaly flags were dropped, so more than the new hours changed
+ *
+ * This function:
+ * 1. Appends the points to the ring buffer, which updates its pyramid in place
+ * 2. Moves a zoomed window along with the dropped hours, so it keeps showing the same
+ *    hours, and back inside the axis once those hours are gone
+ * 3. Drops the forecast and anomaly flags, which no longer match the data
+ */
+bool ChartRenderer::AppendLiveData(const std::vector<std::pair<long long, double>>& points) {
+    if (!liveMode || points.empty()) {
+        return false;
+    }
+
+    long long previousFirstHour = chartValues.FirstHour();
+    for (const auto& point : points) {
+        chartValues.Append(point.first, point.second);
+    }
+
+    if (zoomed) {
+        double shift = static_cast<double>(previousFirstHour - chartValues.FirstHour());
+        double axisFirst, axisLast;
+        GetFullSlots(axisFirst, axisLast);
+        viewFirst += shift;
+        viewLast += shift;
+        if (viewFirst < axisFirst) {
+            viewLast += axisFirst - viewFirst;
+            viewFirst = axisFirst;
+        }
+    }
+
+    if (forecastValues.empty() && anomalyFlags.empty()) {
+        return false;
+    }
+    forecastValues.clear();
+    forecastLower.clear();
+    forecastUpper.clear();
+    anomalyFlags.clear();
+    anomalyIndices.clear();
+    return true;
+}
+
+/**
+ * @brief Sets the forecast drawn after the last data point
+ * @param values Predicted value for each hour following the chart data
+ * @param lower Lower bound of the confidence band for each hour
+ * @param upper Upper bound of the confidence band for each hour
+ * @return true if the forecast was accepted, false if the vectors differ in length
+ *
+ * The first entry belongs to the hour directly after the last data point. A zoomed
+ * window stays where it is; the whole time axis then includes the forecast hours.
+ */
+bool ChartRenderer::SetForecast(const std::vector<double>& values, const std::vector<double>& lower, const std::vector<double>& upper) {
+    if (values.size() != lower.size() || values.size() != upper.size()) {
+        return false;
+    }
+    forecastValues = values;
+    forecastLower = lower;
+    forecastUpper = upper;
+    return true;
+}
+
+/**
+ * @brief Sets the anomaly flags of the data points
+ * @param flags AnomalyFlag combination for each data point
+ * @return true if the flags were accepted, false if they do not match the data in length
+ *
+ * The indices of the flagged points are kept sorted, so drawing the visible ones is a
+ * binary search and a walk over those shown.
+ */
+bool ChartRenderer::SetAnomalyFlags(const std::vector<int>& flags) {
+    if (flags.size() != chartValues.Size()) {
+        return false;
+    }
+    anomalyFlags = flags;
+    anomalyIndices.clear();
+    for (size_t i = 0; i < flags.size(); i++) {
+        if (flags[i] != ANOMALY_NONE) {
+            anomalyIndices.push_back(i);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sets the series overlaid on the chart data, with a legend
+ * @param primaryLabel Legend label of the chart data (UTF-8)
+ * @param series Further series with one value per hour of the chart data
+ *
+ * Builds the min/max pyramid of every series once, in linear time; zooming and
+ * panning only query them. The chart data keeps its pyramid in chartValues.
+ */
+void ChartRenderer::SetOverlays(const std::string& primaryLabel, const std::vector<ChartSeries>& series) {
+    this->primaryLabel = primaryLabel;
+    overlaySeries = series;
+    overlayPyramids.assign(overlaySeries.size(), MinMaxPyramid());
+    for (size_t s = 0; s < overlaySeries.size(); s++) {
+        const std::vector<double>& values = overlaySeries[s].values;
+        overlayPyramids[s].Build(values.size(), [&values](size_t i) { return values[i]; });
+    }
+}
+
+/**
+ * @brief Gets the range of hour slots the whole time axis spans
+ * @param first [out] First slot of the axis
+ * @param last [out] Last slot of the axis
+ *
+ * Normally the axis spans the data points followed by the forecast hours. In live mode
+ * it spans the buffer capacity from the first step of LIVE_AXIS_STEP_HOURS at or after
+ * the oldest hour. New hours then land inside it, hours dropped from the buffer are
+ * already left of it, and it only moves on once per step.
+ */
+void ChartRenderer::GetFullSlots(double& first, double& last) const {
+    if (liveMode) {
+        long long firstHour = chartValues.FirstHour();
+        long long offset = ((firstHour % LIVE_AXIS_STEP_HOURS) + LIVE_AXIS_STEP_HOURS) % LIVE_AXIS_STEP_HOURS;
+        first = static_cast<double>(offset == 0 ? 0 : LIVE_AXIS_STEP_HOURS - offset);
+        last = first + static_cast<double>(std::max<size_t>(2, chartValues.Capacity()) - 1);
+        return;
+    }
+    size_t slotCount = chartValues.Size() + forecastValues.size();
+    first = 0.0;
+    last = static_cast<double>(std::max<size_t>(1, slotCount - 1));
+}
+
+/**
+ * @brief Gets the range of hour slots currently shown on the X axis
+ * @param first [out] First visible slot
+ * @param last [out] Last visible slot
+ *
+ * Slots count hours from the first data point; unless zoomed, the whole axis is shown.
+ */
+void ChartRenderer::GetVisibleSlots(double& first, double& last) const {
+    if (zoomed) {
+        first = viewFirst;
+        last = viewLast;
+        return;
+    }
+    GetFullSlots(first, last);
+}
+
+/**
+ * @brief Shows a range of hour slots, clamped to the time axis
+ * @param first First slot to show
+ * @param last Last slot to show
+ *
+ * The span is kept between MIN_VISIBLE_SLOTS and the whole axis and the window is
+ * shifted back inside the axis; a window covering the whole axis ends the zoom.
+ */
+void ChartRenderer::SetVisibleSlots(double first, double last) {
+    double axisFirst, axisLast;
+    GetFullSlots(axisFirst, axisLast);
+    double axisSpan = axisLast - axisFirst;
+    double span = std::max(last - first, std::min(MIN_VISIBLE_SLOTS, axisSpan));
+    if (span >= axisSpan) {
+        zoomed = false;
+    }
+    else {
+        first = std::min(std::max(first, axisFirst), axisLast - span);
+        viewFirst = first;
+        viewLast = first + span;
+        zoomed = true;
+    }
+}
+
+/**
+ * @brief Gets the range of chart data samples drawn for the visible slots
+ * @param begin [out] First visible sample of the chart data
+ * @param end [out] Sample past the last visible one
+ *
+ * One sample on either side of the window is included, so the line runs on to the
+ * chart edges; the parts outside are clipped.
+ */
+void ChartRenderer::GetVisibleSamples(size_t& begin, size_t& end) const {
+    double first, last;
+    GetVisibleSlots(first, last);
+    begin = static_cast<size_t>(std::max(0.0, std::floor(first) - 1.0));
+    end = std::min(chartValues.Size(), static_cast<size_t>(std::max(0.0, std::ceil(last) + 2.0)));
+}
+
+/**
+ * @brief Maps an hour slot to its X coordinate
+ * @param slot Index of the hour (data points first, then forecast hours)
+ * @return X coordinate of the slot
+ *
+ * The visible slots span the chart width; slots outside them map outside the chart.
+ */
+int ChartRenderer::SlotToX(double slot) const {
+    ChartArea area = GetChartArea();
+    double first, last;
+    GetVisibleSlots(first, last);
+    return area.left + static_cast<int>(std::lround((slot - first) * area.width / (last - first)));
+}
+
+/**
+ * @brief Maps an X coordinate to the hour slot shown there
+ * @param x X coordinate
+ * @return Slot at the coordinate (fractional between hours)
+ */
+double ChartRenderer::XToSlot(int x) const {
+    ChartArea area = GetChartArea();
+    double first, last;
+    GetVisibleSlots(first, last);
+    return first + static_cast<double>(x - area.left) * (last - first) / std::max(1, area.width);
+}
+
+/**
+ * @brief Computes where the data is placed at the current state
+ * @return ChartLayout of the visible window and value range
+ *
+ * The window is given in hours, so it compares equal across appends that drop the
+ * oldest hours of a live series, as long as the view did not move.
+ */
+ChartLayout ChartRenderer::CurrentLayout() const {
+    ChartLayout layout;
+    double first, last;
+    GetVisibleSlots(first, last);
+    layout.firstHour = static_cast<double>(chartValues.FirstHour()) + first;
+    layout.lastHour = static_cast<double>(chartValues.FirstHour()) + last;
+    CalculateValueRange(layout.minValue, layout.maxValue);
+    return layout;
+}
+
+/**
+ * @brief Draws a centered message when no data is available
+ * @param canvas Canvas to draw on
+ *
+ * Draws a centered message instructing the user to select a data file.
+ */
+void ChartRenderer::DrawNoDataMessage(ChartCanvas& canvas) const {
+    // Set text properties for the message
+    canvas.SetTextColour(BLACK);
+    canvas.SetFont(CHART_FONT_TITLE);
+    std::string noDataText = "No data to display. Please select a data file.";
+    // Calculate text dimensions for centering
+    int textWidth, textHeight;
+    canvas.GetTextExtent(noDataText, textWidth, textHeight);
+    // Draw the message centered in the canvas
+    canvas.DrawText(noDataText, (canvasWidth - textWidth) / 2, (canvasHeight - textHeight) / 2);
+}
+
+/**
+ * @brief Draws the chart background and border
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ *
+ * Creates a white rectangle with a light gray border to serve as the chart background.
+ */
+void ChartRenderer::DrawChartBackground(ChartCanvas& canvas, const ChartArea& area) const {
+    // Set background fill color to white
+    canvas.SetBrush(WHITE);
+    // Set border to light gray
+    canvas.SetPen(BORDER_COLOUR, 1);
+    // Draw the chart background rectangle
+    canvas.DrawRectangle(area.left, area.top, area.width, area.height);
+}
+
+/**
+ * @brief Determines the minimum and maximum data values with padding
+ * @param minValue [out] Calculated minimum value for Y axis
+ * @param maxValue [out] Calculated maximum value for Y axis
+ *
+ * Finds the minimum and maximum values of the visible hours in the data set (ignoring
+ * missing hours), the overlaid series and the forecast band, and adds padding to provide
+ * better visual display with appropriate spacing. The series extremes come from their
+ * min/max pyramids, so zooming and panning never rescan the samples.
+ */
+void ChartRenderer::CalculateValueRange(double& minValue, double& maxValue) const {
+    // Initialize min/max to extreme values
+    minValue = std::numeric_limits<double>::max();
+    maxValue = std::numeric_limits<double>::lowest();
+
+    double first, last;
+    GetVisibleSlots(first, last);
+    size_t begin = static_cast<size_t>(std::max(0.0, std::ceil(first)));
+    size_t end = static_cast<size_t>(std::max(0.0, std::floor(last) + 1.0));
+
+    // Find the min/max values of the chart data and the overlaid series, skipping hours without a measurement
+    double seriesMin, seriesMax;
+    if (chartValues.Range(begin, end, seriesMin, seriesMax)) {
+        minValue = seriesMin;
+        maxValue = seriesMax;
+    }
+    for (const auto& pyramid : overlayPyramids) {
+        if (pyramid.Range(begin, end, seriesMin, seriesMax)) {
+            minValue = std::min(minValue, seriesMin);
+            maxValue = std::max(maxValue, seriesMax);
+        }
+    }
+
+    // Keep the visible part of the forecast confidence band in view
+    for (size_t i = 0; i < forecastValues.size(); i++) {
+        size_t slot = chartValues.Size() + i;
+        if (slot < begin || slot >= end) {
+            continue;
+        }
+        minValue = std::min(minValue, forecastLower[i]);
+        maxValue = std::max(maxValue, forecastUpper[i]);
+    }
+
+    // Fall back to a unit range when no hour has a measurement
+    if (minValue > maxValue) {
+        minValue = 0.0;
+        maxValue = 1.0;
+    }
+
+    // Add padding to min/max values for better visual display
+    double valuePadding = (maxValue - minValue) * 0.1;
+    if (valuePadding == 0) {
+        valuePadding = std::abs(minValue) * 0.1;
+        if (valuePadding == 0)
+            valuePadding = 1.0;
+    }
+
+    // Apply padding to range
+    minValue -= valuePadding;
+    maxValue += valuePadding;
+}
+
+/**
+ * @brief Draws a title and axis labels around the plot area
+ * @param canvas Canvas to draw on
+ * @param title Title (UTF-8)
+ * @param xLabel Label below the X axis (UTF-8)
+ * @param yLabel Label along the Y axis (UTF-8)
+ *
+ * Draws the title centered above the chart area, the X-axis label centered below it
+ * and the Y-axis label rotated vertically and centered along its left side.
+ */
+void ChartRenderer::DrawTitleAndAxisLabels(ChartCanvas& canvas, const std::string& title, const std::string& xLabel, const std::string& yLabel) const {
+    ChartArea area = GetChartArea();
+    int textWidth, textHeight;
+
+    // Draw title centered above chart
+    canvas.SetTextColour(BLACK);
+    canvas.SetFont(CHART_FONT_TITLE);
+    canvas.GetTextExtent(title, textWidth, textHeight);
+    canvas.DrawText(title, area.left + (area.width - textWidth) / 2, area.top - 40);
+
+    // Draw Y-axis label vertically
+    canvas.SetFont(CHART_FONT_AXIS_LABEL);
+    canvas.GetTextExtent(yLabel, textWidth, textHeight);
+    canvas.DrawRotatedText(yLabel, area.left - 45, area.top + area.height / 2 + textWidth / 2, 90);
+
+    // Draw X-axis label horizontally
+    canvas.GetTextExtent(xLabel, textWidth, textHeight);
+    canvas.DrawText(xLabel, area.left + (area.width - textWidth) / 2, area.bottom + 35);
+}
+
+/**
+ * @brief Draws Y-axis tick marks, labels, and horizontal grid lines
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ * @param minValue Minimum value for Y axis
+ * @param maxValue Maximum value for Y axis
+ *
+ * Creates evenly spaced tick marks along the Y-axis with appropriate labels
+ * and dotted horizontal grid lines across the chart area.
+ */
+void ChartRenderer::DrawYAxisTicksAndGrid(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const {
+    canvas.SetFont(CHART_FONT_TICK);
+
+    // Define number of Y-axis tick marks
+    const int numYTicks = 5;
+    for (int i = 0; i <= numYTicks; i++) {
+        // Calculate value for this tick
+        double value = minValue + ((maxValue - minValue) * i / numYTicks);
+        // Calculate Y position for this tick
+        int y = area.bottom - (i * area.height / numYTicks);
+
+        // Format value based on its magnitude for better readability
+        std::string valueStr = FormatTickValue(value);
+
+        // Calculate label width for alignment
+        int textWidth, textHeight;
+        canvas.GetTextExtent(valueStr, textWidth, textHeight);
+        // Draw the tick label
+        canvas.DrawText(valueStr, area.left - textWidth - 5, y - textHeight / 2);
+
+        // Draw horizontal grid line
+        canvas.SetPen(GRID_COLOUR, 1, CHART_LINE_DOT);
+        canvas.DrawLine(area.left, y, area.right, y);
+    }
+}
+
+/**
+ * @brief Draws X-axis tick marks, labels, and vertical grid lines
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ *
+ * Creates tick marks along the visible part of the X-axis with timestamp labels and
+ * dotted vertical grid lines across the chart area. The ticks are chosen by time scale
+ * for the visible hours (including forecast hours): hours, days, weeks, months or
+ * years, whichever keeps them at least MIN_TICK_SPACING pixels apart, aligned to whole
+ * units so they move with the data while panning. The cost depends on the number of
+ * ticks, not on the number of data points. Data without parsed timestamps gets evenly
+ * spaced ticks labelled with the raw timestamps.
+ */
+void ChartRenderer::DrawXAxisTicksAndGrid(ChartCanvas& canvas, const ChartArea& area) const {
+    double first, last, axisFirst, axisLast;
+    GetVisibleSlots(first, last);
+    GetFullSlots(axisFirst, axisLast);
+    long long firstShown = static_cast<long long>(std::ceil(std::max(first, axisFirst)));
+    long long lastShown = static_cast<long long>(std::floor(std::min(last, axisLast)));
+    if (firstShown > lastShown) {
+        return;
+    }
+    size_t maxTicks = static_cast<size_t>(std::max(2, area.width / MIN_TICK_SPACING));
+
+    // Collect the slots and labels of the ticks
+    std::vector<std::pair<long long, std::string>> ticks;
+    if (timeAxis) {
+        long long startHour = chartValues.FirstHour();
+        for (const auto& tick : ChooseTimeTicks(startHour + firstShown, startHour + lastShown, maxTicks)) {
+            ticks.push_back(std::make_pair(tick.hour - startHour, tick.label));
+        }
+    }
+    else {
+        size_t firstPoint = static_cast<size_t>(std::max(0LL, firstShown));
+        size_t endPoint = std::min(pointLabels.size(), static_cast<size_t>(std::max(0LL, lastShown + 1)));
+        size_t step = std::max<size_t>(1, (endPoint - std::min(endPoint, firstPoint) + maxTicks - 1) / maxTicks);
+        for (size_t i = (firstPoint + step - 1) / step * step; i < endPoint; i += step) {
+            ticks.push_back(std::make_pair(static_cast<long long>(i), pointLabels[i]));
+        }
+    }
+
+    canvas.SetFont(CHART_FONT_TICK);
+    for (const auto& tick : ticks) {
+        // Calculate X position for this label
+        int x = SlotToX(static_cast<double>(tick.first));
+
+        // Draw rotated label for better space utilization
+        canvas.DrawRotatedText(tick.second, x - 5, area.bottom + 5, 45);
+
+        // Draw vertical grid line
+        canvas.SetPen(GRID_COLOUR, 1, CHART_LINE_DOT);
+        canvas.DrawLine(x, area.top, x, area.bottom);
+    }
+}
+
+/**
+ * @brief Draws data points and the line connecting them
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ * @param minValue Minimum value for Y axis
+ * @param maxValue Maximum value for Y axis
+ *
+ * Creates a line graph by plotting data points as circles and connecting them
+ * with a line. Hours without a measurement (NaN values) break the line, so
+ * outages remain visible instead of being bridged. Points flagged as anomalies
+ * are drawn as larger red circles.
+ *
+ * The line is drawn from the min/max pyramid at the chart width, so a multi-year
+ * series costs about as much as one that fits the chart. Circles are only drawn while
+ * the visible points do not overlap, and never when series are overlaid, so the
+ * individual stations stay distinguishable.
+ */
+void ChartRenderer::DrawDataPointsAndLines(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const {
+    if (chartValues.Size() > 1) {
+        auto toY = [&](size_t i) {
+            // Map data value to screen Y coordinate
+            return area.bottom - static_cast<int>((chartValues.At(i) - minValue) / (maxValue - minValue) * area.height);
+        };
+
+        size_t begin, end;
+        GetVisibleSamples(begin, end);
+        double first, last;
+        GetVisibleSlots(first, last);
+
+        // Draw each data point as a circle while the circles do not overlap; otherwise
+        // only isolated measurements get a small dot, since they have no line
+        bool drawMarkers = overlaySeries.empty() && (last - first + 1.0) * MIN_MARKER_SPACING <= std::max(0, area.width);
+        DrawSeriesLine(canvas, 0, area, minValue, maxValue, !drawMarkers);
+        if (drawMarkers) {
+            canvas.SetBrush(ChartColour(41, 128, 185));
+            canvas.SetPen(WHITE, 1);
+            for (size_t i = begin; i < end; i++) {
+                if (!std::isnan(chartValues.At(i)) && (anomalyFlags.empty() || anomalyFlags[i] == ANOMALY_NONE)) {
+                    canvas.DrawCircle(SlotToX(static_cast<double>(i)), toY(i), 4);
+                }
+            }
+        }
+
+        // Draw the visible anomalies last, so they stay visible in dense charts
+        canvas.SetBrush(ChartColour(231, 76, 60));
+        canvas.SetPen(ChartColour(146, 43, 33), 1);
+        for (auto it = std::lower_bound(anomalyIndices.begin(), anomalyIndices.end(), begin); it != anomalyIndices.end() && *it < end; ++it) {
+            if (!std::isnan(chartValues.At(*it))) {
+                canvas.DrawCircle(SlotToX(static_cast<double>(*it)), toY(*it), 6);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Draws the overlaid series as lines in their legend colours
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ * @param minValue Minimum value for Y axis
+ * @param maxValue Maximum value for Y axis
+ *
+ * Like the chart data, every series is drawn from its min/max pyramid and broken at
+ * its missing hours. The series are drawn last to first, so those earlier in the
+ * legend end up on top.
+ */
+void ChartRenderer::DrawOverlaySeries(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const {
+    for (size_t s = overlaySeries.size(); s-- > 0;) {
+        DrawSeriesLine(canvas, s + 1, area, minValue, maxValue, false);
+    }
+}
+
+/**
+ * @brief Draws the visible part of a series from its min/max pyramid
+ * @param canvas Canvas to draw on
+ * @param series Index of the series (0 for the chart data, then the overlaid series)
+ * @param area Plot area
+ * @param minValue Minimum value for Y axis
+ * @param maxValue Maximum value for Y axis
+ * @param dotIsolated Whether measurements without a neighbour get a small dot
+ *
+ * This function:
+ * 1. Takes the buckets of the visible samples from the finest pyramid level with at
+ *    most one bucket per pixel, so the work depends on the chart width only
+ * 2. Connects the minimum and maximum of every bucket in time order, which draws the
+ *    same extremes as the full line would at each pixel
+ * 3. Breaks the line at empty buckets; gaps shorter than a bucket are not visible
+ *    at this zoom and are bridged
+ * 4. Records the vertices for FindNearestPoint; buckets are in time order, so the
+ *    vertices are sorted by X
+ */
+void ChartRenderer::DrawSeriesLine(ChartCanvas& canvas, size_t series, const ChartArea& area, double minValue, double maxValue, bool dotIsolated) const {
+    if (series > overlayPyramids.size()) {
+        return;
+    }
+
+    size_t begin, end;
+    GetVisibleSamples(begin, end);
+    std::vector<MinMaxPyramid::Bucket> buckets;
+    size_t maxBuckets = static_cast<size_t>(std::max(1, area.width));
+    if (series == 0) {
+        chartValues.Envelope(begin, end, maxBuckets, buckets);
+    }
+    else {
+        overlayPyramids[series - 1].Envelope(begin, end, maxBuckets, buckets);
+    }
+
+    std::vector<DrawnPoint>& drawn = drawnPoints[series];
+    drawn.clear();
+    auto toPoint = [&](size_t i, double value) {
+        int y = area.bottom - static_cast<int>((value - minValue) / (maxValue - minValue) * area.height);
+        ChartPoint point(SlotToX(static_cast<double>(i)), y);
+        drawn.push_back(DrawnPoint{ point.x, point.y, i });
+        return point;
+    };
+
+    SetSeriesPen(canvas, series, 2);
+    std::vector<ChartPoint> segment;
+    std::vector<ChartPoint> isolated;
+    auto flushSegment = [&]() {
+        if (segment.size() > 1) {
+            canvas.DrawLines(segment);
+        }
+        else if (segment.size() == 1) {
+            isolated.push_back(segment.front());
+        }
+        segment.clear();
+    };
+
+    for (const auto& bucket : buckets) {
+        if (bucket.IsMissing()) {
+            flushSegment();
+            continue;
+        }
+        if (bucket.minIndex <= bucket.maxIndex) {
+            segment.push_back(toPoint(bucket.minIndex, bucket.min));
+            if (bucket.maxIndex != bucket.minIndex) {
+                segment.push_back(toPoint(bucket.maxIndex, bucket.max));
+            }
+        }
+        else {
+            segment.push_back(toPoint(bucket.maxIndex, bucket.max));
+            segment.push_back(toPoint(bucket.minIndex, bucket.min));
+        }
+    }
+    flushSegment();
+
+    if (dotIsolated && !isolated.empty()) {
+        canvas.SetNoPen();
+        canvas.SetBrush(SeriesColour(series));
+        for (const auto& point : isolated) {
+            canvas.DrawCircle(point.x, point.y, 2);
+        }
+    }
+}
+
+/**
+ * @brief Draws the legend of the chart data and the overlaid series in the top right corner of the chart
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ *
+ * Each entry shows a short line in the colour and style of its series followed by the label.
+ */
+void ChartRenderer::DrawSeriesLegend(ChartCanvas& canvas, const ChartArea& area) const {
+    if (overlaySeries.empty()) {
+        return;
+    }
+
+    const int swatchWidth = 20;
+    canvas.SetFont(CHART_FONT_TICK);
+
+    std::vector<std::string> labels;
+    labels.push_back(primaryLabel);
+    for (const auto& series : overlaySeries) {
+        labels.push_back(series.label);
+    }
+    int labelWidth = 0;
+    for (const auto& label : labels) {
+        int textWidth, textHeight;
+        canvas.GetTextExtent(label, textWidth, textHeight);
+        labelWidth = std::max(labelWidth, textWidth);
+    }
+
+    // Framed box so the legend stays readable over the lines
+    int boxWidth = swatchWidth + labelWidth + 15;
+    int boxHeight = static_cast<int>(labels.size()) * LEGEND_LINE_HEIGHT + 6;
+    int boxLeft = area.right - boxWidth - 5;
+    int boxTop = area.top + 5;
+    canvas.SetPen(BORDER_COLOUR, 1);
+    canvas.SetBrush(WHITE);
+    canvas.DrawRectangle(boxLeft, boxTop, boxWidth, boxHeight);
+
+    canvas.SetTextColour(BLACK);
+    for (size_t i = 0; i < labels.size(); i++) {
+        int y = boxTop + 3 + static_cast<int>(i) * LEGEND_LINE_HEIGHT;
+        SetSeriesPen(canvas, i, 2);
+        canvas.DrawLine(boxLeft + 5, y + LEGEND_LINE_HEIGHT / 2, boxLeft + 5 + swatchWidth, y + LEGEND_LINE_HEIGHT / 2);
+        canvas.DrawText(labels[i], boxLeft + 10 + swatchWidth, y);
+    }
+}
+
+/**
+ * @brief Draws the forecast line and its confidence band after the last data point
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ * @param minValue Minimum value for Y axis
+ * @param maxValue Maximum value for Y axis
+ *
+ * Marks the last data point with a vertical line, fills the confidence band
+ * with a light shade and draws the predicted values as a dashed line.
+ */
+void ChartRenderer::DrawForecast(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const {
+    if (forecastValues.empty() || chartValues.Empty()) {
+        return;
+    }
+
+    auto toY = [&](double value) {
+        return static_cast<int>(area.bottom - ((value - minValue) / (maxValue - minValue) * area.height));
+    };
+
+    // Separate measured and predicted hours
+    size_t firstSlot = chartValues.Size();
+    int lastDataX = SlotToX(static_cast<double>(firstSlot - 1));
+    canvas.SetPen(ChartColour(150, 150, 150), 1, CHART_LINE_SHORT_DASH);
+    canvas.DrawLine(lastDataX, area.top, lastDataX, area.bottom);
+
+    // Confidence band: upper bound left to right, then lower bound right to left
+    std::vector<ChartPoint> band;
+    std::vector<ChartPoint> line;
+    band.reserve(2 * forecastValues.size());
+    line.reserve(forecastValues.size() + 1);
+    for (size_t i = 0; i < forecastValues.size(); i++) {
+        band.push_back(ChartPoint(SlotToX(static_cast<double>(firstSlot + i)), toY(forecastUpper[i])));
+    }
+    for (size_t i = forecastValues.size(); i-- > 0;) {
+        band.push_back(ChartPoint(SlotToX(static_cast<double>(firstSlot + i)), toY(forecastLower[i])));
+    }
+    canvas.SetNoPen();
+    canvas.SetBrush(ChartColour(214, 234, 248));
+    canvas.DrawPolygon(band);
+
+    // Start the forecast line at the last measured value if there is one
+    double lastValue = chartValues.At(firstSlot - 1);
+    if (!std::isnan(lastValue)) {
+        line.push_back(ChartPoint(lastDataX, toY(lastValue)));
+    }
+    for (size_t i = 0; i < forecastValues.size(); i++) {
+        line.push_back(ChartPoint(SlotToX(static_cast<double>(firstSlot + i)), toY(forecastValues[i])));
+    }
+    if (line.size() > 1) {
+        canvas.SetPen(ChartColour(41, 128, 185), 2, CHART_LINE_SHORT_DASH);
+        canvas.DrawLines(line);
+    }
+
+    // Label the forecast area
+    canvas.SetTextColour(ChartColour(100, 100, 100));
+    canvas.SetFont(CHART_FONT_NOTE);
+    canvas.DrawText("Forecast +" + std::to_string(forecastValues.size()) + "h (95%)", lastDataX + 5, area.top + 5);
+    canvas.SetTextColour(BLACK);
+}
+
+/**
+ * @brief Draws a summary of the highlighted anomalies in the top left corner of the chart
+ * @param canvas Canvas to draw on
+ * @param area Plot area
+ *
+ * Shows the number of flagged hours and the kinds of anomalies found among them.
+ */
+void ChartRenderer::DrawAnomalyLegend(ChartCanvas& canvas, const ChartArea& area) const {
+    int allFlags = ANOMALY_NONE;
+    for (size_t i : anomalyIndices) {
+        allFlags |= anomalyFlags[i];
+    }
+    if (anomalyIndices.empty()) {
+        return;
+    }
+
+    std::string legend = "Anomalies: " + std::to_string(anomalyIndices.size()) + " h (" + DescribeAnomalyFlags(allFlags) + ")";
+    canvas.SetFont(CHART_FONT_LEGEND);
+    canvas.SetTextColour(ChartColour(192, 57, 43));
+    canvas.DrawText(legend, area.left + 5, area.top + 5);
+    canvas.SetTextColour(BLACK);
+}
+
+/**
+ * @brief Draws the whole chart, or the part of it inside a rectangle
+ * @param canvas Canvas to draw on, of the size given to SetSize
+ * @param clipX Left edge of the part to draw
+ * @param clipY Top edge of the part to draw
+ * @param clipWidth Width of the part to draw
+ * @param clipHeight Height of the part to draw
+ *
+ * Coordinates the drawing of all chart components in the correct order: the static
+ * layers (background, title, axis labels and grids) first, then the data layers,
+ * clipped to the chart area. Everything is clipped to the given rectangle, so a strip
+ * of a cached chart can be drawn again on its own. While zoomed, the X-axis label
+ * says how to show the whole series again.
+ */
+void ChartRenderer::Render(ChartCanvas& canvas, int clipX, int clipY, int clipWidth, int clipHeight) const {
+    drawnPoints.assign(overlaySeries.size() + 1, std::vector<DrawnPoint>());
+
+    // Show message if no data is available
+    if (chartValues.Empty()) {
+        DrawNoDataMessage(canvas);
+        return;
+    }
+
+    ChartArea area = GetChartArea();
+    canvas.PushClip(clipX, clipY, clipWidth, clipHeight);
+
+    // Draw chart background and border
+    DrawChartBackground(canvas, area);
+
+    // Calculate data value range
+    double minValue, maxValue;
+    CalculateValueRange(minValue, maxValue);
+
+    // Draw all chart elements in proper order
+    DrawTitleAndAxisLabels(canvas, chartTitle, zoomed ? xAxisLabel + " (zoomed, double-click to show all)" : xAxisLabel, yAxisLabel);
+    DrawYAxisTicksAndGrid(canvas, area, minValue, maxValue);
+    DrawXAxisTicksAndGrid(canvas, area);
+
+    // Keep the data layers inside the chart while zoomed
+    canvas.PushClip(area.left, area.top, area.width + 1, area.height + 1);
+    DrawForecast(canvas, area, minValue, maxValue);
+    DrawOverlaySeries(canvas, area, minValue, maxValue);
+    DrawDataPointsAndLines(canvas, area, minValue, maxValue);
+    canvas.PopClip();
+    DrawAnomalyLegend(canvas, area);
+    DrawSeriesLegend(canvas, area);
+    canvas.PopClip();
+}
+
+/**
+ * @brief Finds the drawn data point nearest to a position
+ * @param x Horizontal position on the canvas
+ * @param y Vertical position on the canvas
+ * @param point [out] Nearest point with its timestamp and value
+ * @return true if a point was drawn near the position in the last render, false otherwise
+ *
+ * This function:
+ * 1. Binary-searches the vertices of every drawn line for those nearest to x; several
+ *    vertices share a column where a line spans a value range, so all of them are checked
+ * 2. Takes the candidate closest to the position, so among overlaid series the line
+ *    under the mouse wins
+ * 3. Looks up the timestamp and value of its sample
+ *
+ * The cost is logarithmic in the number of drawn points per series, so hovering over
+ * a long series does not slow down the mouse.
+ */
+bool ChartRenderer::FindNearestPoint(int x, int y, ChartHoverPoint& point) const {
+    ChartArea area = GetChartArea();
+    if (x < area.left || x > area.right || y < area.top || y > area.bottom) {
+        return false;
+    }
+
+    bool found = false;
+    long long bestDistance = std::numeric_limits<long long>::max();
+    for (size_t s = 0; s < drawnPoints.size(); s++) {
+        const std::vector<DrawnPoint>& drawn = drawnPoints[s];
+        auto it = std::lower_bound(drawn.begin(), drawn.end(), x,
+            [](const DrawnPoint& drawnPoint, int value) { return drawnPoint.x < value; });
+
+        // Column of the nearest vertex on either side
+        int nearestX = std::numeric_limits<int>::max();
+        if (it != drawn.end()) {
+            nearestX = it->x;
+        }
+        if (it != drawn.begin() && (it == drawn.end() || x - std::prev(it)->x < it->x - x)) {
+            nearestX = std::prev(it)->x;
+        }
+        if (nearestX == std::numeric_limits<int>::max() || std::abs(nearestX - x) > HOVER_MAX_DISTANCE) {
+            continue;
+        }
+
+        auto columnBegin = std::lower_bound(drawn.begin(), drawn.end(), nearestX,
+            [](const DrawnPoint& drawnPoint, int value) { return drawnPoint.x < value; });
+        for (auto candidate = columnBegin; candidate != drawn.end() && candidate->x == nearestX; ++candidate) {
+            long long dx = candidate->x - x;
+            long long dy = candidate->y - y;
+            if (dx * dx + dy * dy < bestDistance) {
+                bestDistance = dx * dx + dy * dy;
+                point.x = candidate->x;
+                point.y = candidate->y;
+                point.series = s;
+                point.value = (s == 0) ? chartValues.At(candidate->index) : overlaySeries[s - 1].values[candidate->index];
+                point.timestamp = timeAxis ? FormatHoursAsTimestamp(chartValues.FirstHour() + static_cast<long long>(candidate->index))
+                    : pointLabels[candidate->index];
+                point.seriesLabel = overlaySeries.empty() ? std::string() : (s == 0 ? primaryLabel : overlaySeries[s - 1].label);
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Draws the whole chart
+ * @param canvas Canvas to draw on, of the size given to SetSize
+ */
+void ChartRenderer::Render(ChartCanvas& canvas) const {
+    Render(canvas, 0, 0, canvasWidth, canvasHeight);
+}
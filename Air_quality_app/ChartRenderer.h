@@ -0,0 +1,405 @@
+#ifndef CHART_RENDERER_H
+#define CHART_RENDERER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ChartCanvas.h"
+#include "HourlyRingBuffer.h"
+#include "MinMaxPyramid.h"
+#include "TimeSeries.h"
+
+/**
+ * @file ChartRenderer.h
+ * @brief Line chart of an hourly series, drawn onto any ChartCanvas
+ */
+
+ /**
+  * @struct ChartSeries
+  * @brief Named series of values on the chart's hourly time axis
+  */
+struct ChartSeries {
+    std::string label;           /**< Name shown in the legend (UTF-8) */
+    std::vector<double> values;  /**< One value per hour of the chart data, NaN marks a missing hour */
+};
+
+/**
+ * @struct ChartLayout
+ * @brief Placement of the data in a rendered chart
+ *
+ * New live data can be drawn into a cached chart on its own only while this stays the same.
+ */
+struct ChartLayout {
+    double firstHour = 0.0;   /**< Hour at the left edge of the chart */
+    double lastHour = 0.0;    /**< Hour at the right edge of the chart */
+    double minValue = 0.0;    /**< Value at the bottom edge of the chart */
+    double maxValue = 0.0;    /**< Value at the top edge of the chart */
+
+    /**
+     * @brief Compares two layouts
+     * @param other Layout to compare with
+     * @return true if both place the data identically, false otherwise
+     */
+    bool operator==(const ChartLayout& other) const {
+        return firstHour == other.firstHour && lastHour == other.lastHour && minValue == other.minValue && maxValue == other.maxValue;
+    }
+};
+
+/**
+ * @struct ChartArea
+ * @brief Position of the plot area inside the canvas
+ */
+struct ChartArea {
+    int left = 0;     /**< Left edge */
+    int top = 0;      /**< Top edge */
+    int width = 0;    /**< Width */
+    int height = 0;   /**< Height */
+    int bottom = 0;   /**< Bottom edge (top + height) */
+    int right = 0;    /**< Right edge (left + width) */
+};
+
+/**
+ * @struct ChartHoverPoint
+ * @brief Drawn data point found under the mouse, with what a tooltip shows about it
+ */
+struct ChartHoverPoint {
+    int x = 0;                 /**< Horizontal position of the point on the canvas */
+    int y = 0;                 /**< Vertical position of the point on the canvas */
+    size_t series = 0;         /**< Index of the series (0 for the chart data, then the overlaid series) */
+    std::string seriesLabel;   /**< Legend label of the series, empty without overlays (UTF-8) */
+    std::string timestamp;     /**< Timestamp of the point (UTF-8) */
+    double value = 0.0;        /**< Value of the point */
+};
+
+/**
+ * @class ChartRenderer
+ * @brief Model and drawing code of the line chart, without any window
+ *
+ * Holds the chart data, forecast, anomaly flags, overlaid series and visible window,
+ * and draws the chart layer by layer onto a ChartCanvas of a given size. ChartPanel
+ * renders it through a wxDC into its cached bitmap; the chart export renders it into
+ * SVG files on worker threads, so the same charts are produced on machines without
+ * a display. A renderer is not thread-safe; use one per thread.
+ *
+ * The X axis is proportional to time: the data is kept on an hourly grid with NaN for
+ * missing hours, so outages break the line, and the ticks are chosen by time scale.
+ * Data whose timestamps could not be parsed is shown one slot per point instead and
+ * labelled with the raw timestamps. Every series keeps a min/max pyramid, so any
+ * window is drawn from the level matching the chart width and its Y range is queried
+ * without scanning the samples.
+ *
+ * In live mode the chart data is a fixed-capacity ring of the newest hours, to which
+ * points are appended in place. The X axis then spans the capacity from a midnight
+ * and moves on in whole days, so the layout of a rendered chart mostly survives an append.
+ *
+ * Rendering records the vertices of every drawn line in X order, so the point under
+ * the mouse is found by binary search among the points actually shown.
+ */
+class ChartRenderer {
+public:
+    /**
+     * @brief Creates a renderer without data
+     */
+    ChartRenderer();
+
+    /**
+     * @brief Sets the canvas size the chart is laid out for
+     * @param width Width in pixels
+     * @param height Height in pixels
+     */
+    void SetSize(int width, int height);
+
+    /**
+     * @brief Gets the plot area at the current size
+     * @return ChartArea inside the margins
+     */
+    ChartArea GetChartArea() const;
+
+    /**
+     * @brief Sets the data to be displayed and shows all of it
+     * @param series Values on an hourly grid
+     * @param pointLabels Raw timestamps of the values if they could not be parsed, otherwise empty
+     * @param title Title for the chart (UTF-8)
+     * @param xLabel Label for the X axis (UTF-8)
+     * @param yLabel Label for the Y axis (UTF-8)
+     *
+     * Clears the forecast, anomaly flags and overlaid series and ends live mode.
+     */
+    void SetData(const HourlySeries& series, const std::vector<std::string>& pointLabels, const std::string& title, const std::string& xLabel, const std::string& yLabel);
+
+    /**
+     * @brief Shows the newest hours of a live series, to be extended by AppendLiveData
+     * @param buffer Ring buffer of the series; its capacity is kept
+     * @param title Title for the chart (UTF-8)
+     * @param xLabel Label for the X axis (UTF-8)
+     * @param yLabel Label for the Y axis (UTF-8)
+     */
+    void SetLiveData(const HourlyRingBuffer& buffer, const std::string& title, const std::string& xLabel, const std::string& yLabel);
+
+    /**
+     * @brief Adds new or corrected hours to a live series
+     * @param points Hours (since 1970-01-01 00:00) and values, in time order
+     * @return true if the forecast or anomaly flags were dropped, so more than the new hours changed
+     */
+    bool AppendLiveData(const std::vector<std::pair<long long, double>>& points);
+
+    /**
+     * @brief Sets the forecast drawn after the last data point
+     * @param values Predicted value for each hour following the chart data
+     * @param lower Lower bound of the confidence band for each hour
+     * @param upper Upper bound of the confidence band for each hour
+     * @return true if the forecast was accepted, false if the vectors differ in length
+     */
+    bool SetForecast(const std::vector<double>& values, const std::vector<double>& lower, const std::vector<double>& upper);
+
+    /**
+     * @brief Sets the anomaly flags of the data points
+     * @param flags AnomalyFlag combination for each data point
+     * @return true if the flags were accepted, false if they do not match the data in length
+     */
+    bool SetAnomalyFlags(const std::vector<int>& flags);
+
+    /**
+     * @brief Sets the series overlaid on the chart data, with a legend
+     * @param primaryLabel Legend label of the chart data (UTF-8)
+     * @param series Further series with one value per hour of the chart data
+     */
+    void SetOverlays(const std::string& primaryLabel, const std::vector<ChartSeries>& series);
+
+    /**
+     * @brief Gets the number of hours of chart data
+     * @return Number of data points
+     */
+    size_t Size() const { return chartValues.Size(); }
+
+    /**
+     * @brief Gets the hour of the first data point
+     * @return Hour since 1970-01-01 00:00
+     */
+    long long FirstHour() const { return chartValues.FirstHour(); }
+
+    /**
+     * @brief Checks whether the chart shows a live series
+     * @return true in live mode, false otherwise
+     */
+    bool IsLive() const { return liveMode; }
+
+    /**
+     * @brief Checks whether only part of the time axis is shown
+     * @return true while zoomed, false otherwise
+     */
+    bool IsZoomed() const { return zoomed; }
+
+    /**
+     * @brief Shows the whole time axis again
+     */
+    void ResetZoom() { zoomed = false; }
+
+    /**
+     * @brief Gets the range of hour slots currently shown on the X axis
+     * @param first [out] First visible slot
+     * @param last [out] Last visible slot
+     */
+    void GetVisibleSlots(double& first, double& last) const;
+
+    /**
+     * @brief Shows a range of hour slots, clamped to the time axis
+     * @param first First slot to show
+     * @param last Last slot to show
+     */
+    void SetVisibleSlots(double first, double last);
+
+    /**
+     * @brief Maps an hour slot to its X coordinate
+     * @param slot Index of the hour (data points first, then forecast hours)
+     * @return X coordinate of the slot
+     */
+    int SlotToX(double slot) const;
+
+    /**
+     * @brief Maps an X coordinate to the hour slot shown there
+     * @param x X coordinate
+     * @return Slot at the coordinate (fractional between hours)
+     */
+    double XToSlot(int x) const;
+
+    /**
+     * @brief Computes where the data is placed at the current state
+     * @return ChartLayout of the visible window and value range
+     */
+    ChartLayout CurrentLayout() const;
+
+    /**
+     * @brief Finds the drawn data point nearest to a position
+     * @param x Horizontal position on the canvas
+     * @param y Vertical position on the canvas
+     * @param point [out] Nearest point with its timestamp and value
+     * @return true if a point was drawn near the position in the last render, false otherwise
+     */
+    bool FindNearestPoint(int x, int y, ChartHoverPoint& point) const;
+
+    /**
+     * @brief Draws the whole chart, or the part of it inside a rectangle
+     * @param canvas Canvas to draw on, of the size given to SetSize
+     * @param clipX Left edge of the part to draw
+     * @param clipY Top edge of the part to draw
+     * @param clipWidth Width of the part to draw
+     * @param clipHeight Height of the part to draw
+     */
+    void Render(ChartCanvas& canvas, int clipX, int clipY, int clipWidth, int clipHeight) const;
+
+    /**
+     * @brief Draws the whole chart
+     * @param canvas Canvas to draw on, of the size given to SetSize
+     */
+    void Render(ChartCanvas& canvas) const;
+
+    /**
+     * @brief Draws a centered message when no data is available
+     * @param canvas Canvas to draw on
+     */
+    void DrawNoDataMessage(ChartCanvas& canvas) const;
+
+    /**
+     * @brief Draws a title and axis labels around the plot area
+     * @param canvas Canvas to draw on
+     * @param title Title (UTF-8)
+     * @param xLabel Label below the X axis (UTF-8)
+     * @param yLabel Label along the Y axis (UTF-8)
+     *
+     * Also used for views drawn outside the renderer, e.g. the calendar heatmap.
+     */
+    void DrawTitleAndAxisLabels(ChartCanvas& canvas, const std::string& title, const std::string& xLabel, const std::string& yLabel) const;
+
+private:
+    /**
+     * @struct DrawnPoint
+     * @brief Vertex of a drawn series line
+     */
+    struct DrawnPoint {
+        int x;         /**< Horizontal position on the canvas */
+        int y;         /**< Vertical position on the canvas */
+        size_t index;  /**< Index of the sample in its series */
+    };
+
+    HourlyRingBuffer chartValues; /**< Values to be displayed, one per hour from chartValues.FirstHour(); NaN marks a missing hour */
+    std::vector<std::string> pointLabels; /**< Raw timestamps of the data points, kept only when they could not be parsed */
+    bool timeAxis; /**< Whether the timestamps were parsed, so the X axis is labelled by time; otherwise by data point */
+    std::string chartTitle; /**< Title displayed at the top of the chart */
+    std::string xAxisLabel; /**< Label for the X axis */
+    std::string yAxisLabel; /**< Label for the Y axis */
+    std::vector<double> forecastValues; /**< Predicted values for the hours following the last data point */
+    std::vector<double> forecastLower; /**< Lower bound of the forecast confidence band */
+    std::vector<double> forecastUpper; /**< Upper bound of the forecast confidence band */
+    std::vector<int> anomalyFlags; /**< AnomalyFlag combination per data point, empty if not available */
+    std::vector<size_t> anomalyIndices; /**< Increasing indices of the data points with an anomaly flag */
+    std::vector<ChartSeries> overlaySeries; /**< Series drawn over the chart data, sharing its time axis */
+    std::string primaryLabel; /**< Legend label of the chart data when series are overlaid */
+    std::vector<MinMaxPyramid> overlayPyramids; /**< Min/max pyramid of each overlaid series (the chart data keeps its own) */
+    bool liveMode; /**< Whether appended live data extends the chart data */
+    bool zoomed; /**< Whether only part of the time axis is shown */
+    double viewFirst; /**< First visible hour slot while zoomed (may be fractional) */
+    double viewLast; /**< Last visible hour slot while zoomed (may be fractional) */
+    int canvasWidth; /**< Width of the canvas the chart is laid out for */
+    int canvasHeight; /**< Height of the canvas the chart is laid out for */
+    mutable std::vector<std::vector<DrawnPoint>> drawnPoints; /**< Vertices of each series' line in the last render, in X order */
+
+    /**
+     * @brief Gets the range of hour slots the whole time axis spans
+     * @param first [out] First slot of the axis
+     * @param last [out] Last slot of the axis
+     */
+    void GetFullSlots(double& first, double& last) const;
+
+    /**
+     * @brief Gets the range of chart data samples drawn for the visible slots
+     * @param begin [out] First visible sample of the chart data
+     * @param end [out] Sample past the last visible one
+     */
+    void GetVisibleSamples(size_t& begin, size_t& end) const;
+
+    /**
+     * @brief Determines the minimum and maximum data values with padding
+     * @param minValue [out] Calculated minimum value for Y axis
+     * @param maxValue [out] Calculated maximum value for Y axis
+     */
+    void CalculateValueRange(double& minValue, double& maxValue) const;
+
+    /**
+     * @brief Draws the chart background and border
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     */
+    void DrawChartBackground(ChartCanvas& canvas, const ChartArea& area) const;
+
+    /**
+     * @brief Draws Y-axis tick marks, labels, and horizontal grid lines
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     * @param minValue Minimum value for Y axis
+     * @param maxValue Maximum value for Y axis
+     */
+    void DrawYAxisTicksAndGrid(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const;
+
+    /**
+     * @brief Draws X-axis tick marks, labels, and vertical grid lines
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     */
+    void DrawXAxisTicksAndGrid(ChartCanvas& canvas, const ChartArea& area) const;
+
+    /**
+     * @brief Draws data points and the line connecting them
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     * @param minValue Minimum value for Y axis
+     * @param maxValue Maximum value for Y axis
+     */
+    void DrawDataPointsAndLines(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const;
+
+    /**
+     * @brief Draws the overlaid series as lines in their legend colours
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     * @param minValue Minimum value for Y axis
+     * @param maxValue Maximum value for Y axis
+     */
+    void DrawOverlaySeries(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const;
+
+    /**
+     * @brief Draws the visible part of a series from its min/max pyramid
+     * @param canvas Canvas to draw on
+     * @param series Index of the series (0 for the chart data, then the overlaid series)
+     * @param area Plot area
+     * @param minValue Minimum value for Y axis
+     * @param maxValue Maximum value for Y axis
+     * @param dotIsolated Whether measurements without a neighbour get a small dot
+     */
+    void DrawSeriesLine(ChartCanvas& canvas, size_t series, const ChartArea& area, double minValue, double maxValue, bool dotIsolated) const;
+
+    /**
+     * @brief Draws the legend of the chart data and the overlaid series in the top right corner of the chart
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     */
+    void DrawSeriesLegend(ChartCanvas& canvas, const ChartArea& area) const;
+
+    /**
+     * @brief Draws the forecast line and its confidence band after the last data point
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     * @param minValue Minimum value for Y axis
+     * @param maxValue Maximum value for Y axis
+     */
+    void DrawForecast(ChartCanvas& canvas, const ChartArea& area, double minValue, double maxValue) const;
+
+    /**
+     * @brief Draws a summary of the highlighted anomalies in the top left corner of the chart
+     * @param canvas Canvas to draw on
+     * @param area Plot area
+     */
+    void DrawAnomalyLegend(ChartCanvas& canvas, const ChartArea& area) const;
+};
+
+#endif // CHART_RENDERER_H
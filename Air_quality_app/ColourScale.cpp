@@ -0,0 +1,78 @@
+/**
+ * @file ColourScale.cpp
+ * @brief Implementation of the ColourScale class
+ */
+
+#include "ColourScale.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+    /**
+     * @brief Gets the precomputed palette (green, yellow, orange, red, purple)
+     * @return PALETTE_SIZE RGB triples
+     */
+    const std::array<std::array<unsigned char, 3>, ColourScale::PALETTE_SIZE>& GetPalette() {
+        static const std::array<std::array<unsigned char, 3>, ColourScale::PALETTE_SIZE> palette = [] {
+            const double stops[5][3] = {
+                { 0, 153, 0 }, { 255, 221, 0 }, { 255, 128, 0 }, { 204, 0, 0 }, { 128, 0, 96 }
+            };
+            std::array<std::array<unsigned char, 3>, ColourScale::PALETTE_SIZE> colours{};
+            for (int i = 0; i < ColourScale::PALETTE_SIZE; i++) {
+                double position = 4.0 * i / (ColourScale::PALETTE_SIZE - 1);
+                int stop = std::min(3, static_cast<int>(position));
+                double t = position - stop;
+                for (int c = 0; c < 3; c++) {
+                    colours[i][c] = static_cast<unsigned char>(stops[stop][c] + t * (stops[stop + 1][c] - stops[stop][c]));
+                }
+            }
+            return colours;
+        }();
+        return palette;
+    }
+}
+
+/**
+ * @brief Constructor mapping a value range onto the palette
+ * @param minValue Value mapped to the first colour
+ * @param maxValue Value mapped to the last colour (values above it are clamped)
+ *
+ * An empty or inverted range is widened to one unit, so every value still gets a colour.
+ */
+ColourScale::ColourScale(double minValue, double maxValue)
+    : minValue(minValue), maxValue(maxValue > minValue ? maxValue : minValue + 1.0) {
+    factor = (PALETTE_SIZE - 1) / (this->maxValue - this->minValue);
+}
+
+/**
+ * @brief Gets the palette index of a value
+ * @param value Value to map
+ * @return Index in [0, PALETTE_SIZE)
+ */
+int ColourScale::IndexOf(double value) const {
+    double position = (value - minValue) * factor;
+    if (!(position > 0.0)) {
+        return 0;
+    }
+    return std::min(PALETTE_SIZE - 1, static_cast<int>(position));
+}
+
+/**
+ * @brief Gets the RGB triple of a palette entry
+ * @param index Palette index from IndexOf()
+ * @return Pointer to three bytes (red, green, blue)
+ */
+const unsigned char* ColourScale::RgbAt(int index) const {
+    return GetPalette()[index].data();
+}
+
+/**
+ * @brief Gets the colour of a value
+ * @param value Value to map
+ * @return Colour of the value on the scale
+ */
+wxColour ColourScale::ColourOf(double value) const {
+    const unsigned char* rgb = RgbAt(IndexOf(value));
+    return wxColour(rgb[0], rgb[1], rgb[2]);
+}
@@ -0,0 +1,69 @@
+#ifndef COLOUR_SCALE_H
+#define COLOUR_SCALE_H
+
+#include <wx/wx.h>
+
+/**
+ * @file ColourScale.h
+ * @brief Precomputed colour scale for concentration heatmaps
+ */
+
+ /**
+  * @class ColourScale
+  * @brief Maps a value range onto a fixed palette (green, yellow, orange, red, purple)
+  *
+  * The palette is computed once and shared by all scales, so colouring a value is an
+  * index computation and a table lookup. This keeps rendering large heatmaps into an
+  * image to a single cheap pass over the cells.
+  */
+class ColourScale {
+public:
+    static const int PALETTE_SIZE = 256; /**< Number of precomputed colours */
+
+    /**
+     * @brief Constructor mapping a value range onto the palette
+     * @param minValue Value mapped to the first colour
+     * @param maxValue Value mapped to the last colour (values above it are clamped)
+     */
+    ColourScale(double minValue, double maxValue);
+
+    /**
+     * @brief Gets the palette index of a value
+     * @param value Value to map
+     * @return Index in [0, PALETTE_SIZE)
+     */
+    int IndexOf(double value) const;
+
+    /**
+     * @brief Gets the RGB triple of a palette entry
+     * @param index Palette index from IndexOf()
+     * @return Pointer to three bytes (red, green, blue)
+     */
+    const unsigned char* RgbAt(int index) const;
+
+    /**
+     * @brief Gets the colour of a value
+     * @param value Value to map
+     * @return Colour of the value on the scale
+     */
+    wxColour ColourOf(double value) const;
+
+    /**
+     * @brief Gets the value mapped to the first colour
+     * @return Minimum of the scale
+     */
+    double GetMin() const { return minValue; }
+
+    /**
+     * @brief Gets the value mapped to the last colour
+     * @return Maximum of the scale
+     */
+    double GetMax() const { return maxValue; }
+
+private:
+    double minValue;  /**< Value mapped to the first colour */
+    double maxValue;  /**< Value mapped to the last colour */
+    double factor;    /**< Palette entries per unit of value */
+};
+
+#endif // COLOUR_SCALE_H
@@ -0,0 +1,247 @@
+/**
+ * @file CorrelationAnalysis.cpp
+ * @brief Implementation of the correlation matrices
+ */
+
+#include "CorrelationAnalysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+
+namespace {
+    const size_t MIN_COMMON_HOURS = 3;  ///< Fewest common hours for which a pair gets a coefficient
+
+    /**
+     * @brief Centers a column and scales it to unit length
+     * @return false if the column is constant, true otherwise
+     *
+     * After this step the Pearson coefficient of two columns is their dot product.
+     */
+    bool Standardize(std::vector<double>& column) {
+        double mean = std::accumulate(column.begin(), column.end(), 0.0) / static_cast<double>(column.size());
+        double sumSquares = 0.0;
+        for (double& value : column) {
+            value -= mean;
+            sumSquares += value * value;
+        }
+        if (sumSquares <= 0.0) {
+            return false;
+        }
+
+        double scale = 1.0 / std::sqrt(sumSquares);
+        for (double& value : column) {
+            value *= scale;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Replaces the values of a column by their ranks (ties get the average rank)
+     */
+    void RankTransform(std::vector<double>& column, std::vector<size_t>& order) {
+        order.resize(column.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&column](size_t a, size_t b) { return column[a] < column[b]; });
+
+        std::vector<double> ranks(column.size());
+        for (size_t i = 0; i < order.size();) {
+            size_t j = i;
+            while (j < order.size() && column[order[j]] == column[order[i]]) {
+                j++;
+            }
+            double averageRank = (static_cast<double>(i) + static_cast<double>(j - 1)) / 2.0 + 1.0;
+            for (size_t k = i; k < j; k++) {
+                ranks[order[k]] = averageRank;
+            }
+            i = j;
+        }
+        column.swap(ranks);
+    }
+
+    /**
+     * @brief Computes the Pearson coefficient of two columns of equal length
+     * @return Coefficient in [-1, 1], or NaN if either column is constant
+     *
+     * Both columns are standardized in place.
+     */
+    double Correlate(std::vector<double>& first, std::vector<double>& second) {
+        if (!Standardize(first) || !Standardize(second)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        double sum = std::inner_product(first.begin(), first.end(), second.begin(), 0.0);
+        return std::max(-1.0, std::min(1.0, sum));
+    }
+
+    /**
+     * @brief Joins two series on the hours in which both have a measurement
+     *
+     * Sweeps once over the period both series cover; first and second receive the
+     * values of the joined hours in time order.
+     */
+    void JoinPair(const HourlySeries& a, const HourlySeries& b, std::vector<double>& first, std::vector<double>& second) {
+        first.clear();
+        second.clear();
+        long long firstHour = std::max(a.startHour, b.startHour);
+        long long lastHour = std::min(a.HourAt(a.values.size() - 1), b.HourAt(b.values.size() - 1));
+        for (long long hour = firstHour; hour <= lastHour; hour++) {
+            double x = a.values[static_cast<size_t>(hour - a.startHour)];
+            double y = b.values[static_cast<size_t>(hour - b.startHour)];
+            if (!IsMissingValue(x) && !IsMissingValue(y)) {
+                first.push_back(x);
+                second.push_back(y);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Checks whether any pair of series has a coefficient
+ * @return true if at least one pair had enough common hours, false otherwise
+ */
+bool CorrelationMatrix::HasCoefficients() const {
+    const size_t k = labels.size();
+    for (size_t i = 0; i < k; i++) {
+        for (size_t j = i + 1; j < k; j++) {
+            if (Samples(i, j) >= MIN_COMMON_HOURS) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Computes the Pearson and Spearman correlation matrices of hourly series
+ * @param series Hourly series to correlate
+ * @return CorrelationMatrix (no rows if fewer than 2 series have data)
+ *
+ * This function:
+ * 1. Leaves out the series without data
+ * 2. Counts the measured hours of every series for the diagonal
+ * 3. Joins every pair separately in one sweep over the hours both cover, keeping the
+ *    hours in which both have a measurement
+ * 4. Computes the Pearson coefficient of the joined values and the Spearman coefficient
+ *    of their ranks, leaving pairs with fewer than MIN_COMMON_HOURS hours undefined
+ */
+CorrelationMatrix ComputeCorrelationMatrix(const std::vector<PollutantSeries>& series) {
+    CorrelationMatrix result;
+
+    std::vector<const HourlySeries*> used;
+    for (const auto& pollutant : series) {
+        if (!pollutant.series.values.empty()) {
+            used.push_back(&pollutant.series);
+            result.labels.push_back(pollutant.paramCode);
+        }
+    }
+    if (used.size() < 2) {
+        result.labels.clear();
+        return result;
+    }
+
+    const size_t k = used.size();
+    const double undefined = std::numeric_limits<double>::quiet_NaN();
+    result.samples.assign(k * k, 0);
+    result.pearson.assign(k * k, undefined);
+    result.spearman.assign(k * k, undefined);
+
+    std::vector<double> first;
+    std::vector<double> second;
+    std::vector<size_t> order;
+    for (size_t i = 0; i < k; i++) {
+        // A series correlates with itself unless it is constant or too short
+        first.clear();
+        for (double value : used[i]->values) {
+            if (!IsMissingValue(value)) {
+                first.push_back(value);
+            }
+        }
+        result.samples[i * k + i] = first.size();
+        if (first.size() >= MIN_COMMON_HOURS && Standardize(first)) {
+            result.pearson[i * k + i] = 1.0;
+            result.spearman[i * k + i] = 1.0;
+        }
+
+        for (size_t j = i + 1; j < k; j++) {
+            JoinPair(*used[i], *used[j], first, second);
+            result.samples[i * k + j] = first.size();
+            result.samples[j * k + i] = first.size();
+            if (first.size() < MIN_COMMON_HOURS) {
+                continue;
+            }
+
+            // Ranks are taken from the raw values before they are standardized
+            std::vector<double> firstRanks = first;
+            std::vector<double> secondRanks = second;
+            RankTransform(firstRanks, order);
+            RankTransform(secondRanks, order);
+
+            double pearson = Correlate(first, second);
+            double spearman = Correlate(firstRanks, secondRanks);
+            result.pearson[i * k + j] = pearson;
+            result.pearson[j * k + i] = pearson;
+            result.spearman[i * k + j] = spearman;
+            result.spearman[j * k + i] = spearman;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Formats both matrices as one fixed-width table
+ * @param matrix Result of ComputeCorrelationMatrix()
+ * @return Table text with one line per row
+ *
+ * Pearson coefficients are shown above the diagonal and Spearman coefficients below it,
+ * so a single square table shows both measures. Undefined coefficients are shown as "n/a".
+ * The table of hours below has the common hours of each pair and, on the diagonal, the
+ * measured hours of each series.
+ */
+std::string FormatCorrelationTable(const CorrelationMatrix& matrix) {
+    const size_t k = matrix.labels.size();
+    if (!matrix.HasCoefficients()) {
+        return "not enough common measurements";
+    }
+
+    char cell[32];
+    std::string header = "       ";
+    for (size_t j = 0; j < k; j++) {
+        std::snprintf(cell, sizeof(cell), "%7.6s", matrix.labels[j].c_str());
+        header += cell;
+    }
+    header += "\n";
+
+    std::string table = header;
+    for (size_t i = 0; i < k; i++) {
+        std::snprintf(cell, sizeof(cell), "%-7.6s", matrix.labels[i].c_str());
+        table += cell;
+        for (size_t j = 0; j < k; j++) {
+            double value = (j >= i) ? matrix.Pearson(i, j) : matrix.Spearman(i, j);
+            if (i == j) {
+                std::snprintf(cell, sizeof(cell), "%7s", "-");
+            }
+            else if (std::isnan(value)) {
+                std::snprintf(cell, sizeof(cell), "%7s", "n/a");
+            }
+            else {
+                std::snprintf(cell, sizeof(cell), "%7.2f", value);
+            }
+            table += cell;
+        }
+        table += "\n";
+    }
+
+    table += "\nhours\n" + header;
+    for (size_t i = 0; i < k; i++) {
+        std::snprintf(cell, sizeof(cell), "%-7.6s", matrix.labels[i].c_str());
+        table += cell;
+        for (size_t j = 0; j < k; j++) {
+            std::snprintf(cell, sizeof(cell), "%7zu", matrix.Samples(i, j));
+            table += cell;
+        }
+        table += "\n";
+    }
+    return table;
+}
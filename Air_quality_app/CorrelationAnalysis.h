@@ -0,0 +1,86 @@
+#ifndef CORRELATION_ANALYSIS_H
+#define CORRELATION_ANALYSIS_H
+
+#include <string>
+#include <vector>
+
+#include "SensorCatalog.h"
+#include "TimeSeries.h"
+
+/**
+ * @file CorrelationAnalysis.h
+ * @brief Pearson and Spearman correlation matrices of a station's pollutants
+ */
+
+ /**
+  * @struct CorrelationMatrix
+  * @brief Correlations between all pairs of series, each over the hours both series measured
+  *
+  * The matrices are stored row-major with labels.size() rows and columns. A coefficient
+  * is NaN when the pair has fewer than 3 common hours or one of the series is constant
+  * over them. The diagonal of samples holds the number of measured hours of each series.
+  */
+struct CorrelationMatrix {
+    std::vector<std::string> labels;  /**< Parameter code of each row and column */
+    std::vector<size_t> samples;      /**< Number of hours in which both series of a pair have a measurement */
+    std::vector<double> pearson;      /**< Pearson coefficients */
+    std::vector<double> spearman;     /**< Spearman rank coefficients */
+
+    /**
+     * @brief Gets a Pearson coefficient
+     * @param row Row index
+     * @param column Column index
+     * @return Correlation coefficient in [-1, 1] or NaN
+     */
+    double Pearson(size_t row, size_t column) const { return pearson[row * labels.size() + column]; }
+
+    /**
+     * @brief Gets a Spearman coefficient
+     * @param row Row index
+     * @param column Column index
+     * @return Rank correlation coefficient in [-1, 1] or NaN
+     */
+    double Spearman(size_t row, size_t column) const { return spearman[row * labels.size() + column]; }
+
+    /**
+     * @brief Gets the number of hours a coefficient was computed from
+     * @param row Row index
+     * @param column Column index
+     * @return Number of hours in which both series have a measurement
+     */
+    size_t Samples(size_t row, size_t column) const { return samples[row * labels.size() + column]; }
+
+    /**
+     * @brief Checks whether any pair of series has a coefficient
+     * @return true if at least one pair had enough common hours, false otherwise
+     */
+    bool HasCoefficients() const;
+};
+
+/**
+ * @brief Computes the Pearson and Spearman correlation matrices of hourly series
+ *
+ * Every pair of series is joined on its timestamps in one linear sweep over the period
+ * both cover, keeping the hours in which both have a measurement (pairwise-complete).
+ * A sparse or dead sensor therefore only affects its own row and column. The joined
+ * values are standardized, so each coefficient is a single dot product.
+ *
+ * Series without data are left out of the matrix.
+ *
+ * @param series Hourly series to correlate
+ * @return CorrelationMatrix (no rows if fewer than 2 series have data)
+ */
+CorrelationMatrix ComputeCorrelationMatrix(const std::vector<PollutantSeries>& series);
+
+/**
+ * @brief Formats both matrices as one fixed-width table
+ *
+ * The upper triangle holds the Pearson and the lower triangle the Spearman coefficients.
+ * A second table below lists the number of hours behind each coefficient.
+ *
+ * @param matrix Result of ComputeCorrelationMatrix()
+ * @return Table text with one line per row, intended for a monospaced font
+ */
+std::string FormatCorrelationTable(const CorrelationMatrix& matrix);
+
+#endif // CORRELATION_ANALYSIS_H
@@ -11,9 +11,13 @@
   * This function:
   * 1. Loads and parses a JSON file
   * 2. Validates the JSON structure for required elements
-  * 3. Extracts time series data points
-  * 4. Calculates statistics (min, max, average, trend)
-  * 5. Updates the UI components with processed data
+  * 3. Extracts time series data points and aligns them to an hourly grid
+  * 4. Calculates statistics (min, max, average, trend) over the measured hours
+  * 5. Estimates percentiles (median, P95, P99) from the sensor's quantile rollups
+  * 6. Reads the limit value exceedances of the file's last year from the sensor's counters
+  * 7. Updates the UI components with processed data
+  * 8. Forecasts the hours after the last measurement with the sensor's Holt-Winters model
+  * 9. Highlights the hours flagged by the sensor's anomaly detector
   *
   * @param filePath Path to the JSON file containing the data
   * @param infoPanel Pointer to the InfoPanel to update with statistics (can be nullptr)
@@ -43,46 +47,73 @@ void ProcessFileData(const std::string& filePath, InfoPanel* infoPanel, ChartPan
         return;
     }
 
-    // Initialize variables for statistical calculations
-    double max = std::numeric_limits<double>::lowest();
-    double min = std::numeric_limits<double>::max();
-    double sum = 0.0;
-    int count = 0;
-    // Create vectors to store time series data for analysis and chart display
+    // Create vector to store time series data for analysis
     std::vector<std::pair<std::string, double>> timeSeriesData;
-    std::vector<std::pair<wxString, double>> chartData;
+    timeSeriesData.reserve(values.size());
 
     // Scan values array for valid data points
     for (Json::Value::ArrayIndex i = 0; i < values.size(); i++) {
         const Json::Value& item = values[i];
         if (item.isMember("value") && !item["value"].isNull() && item.isMember("date")) {
-            double value = item["value"].asDouble();
-            std::string dateStr = item["date"].asString();
-
-            max = std::max(max, value);
-            min = std::min(min, value);
-            sum += value;
-            count++;
-
-            timeSeriesData.push_back(std::make_pair(dateStr, value));
-            chartData.push_back(std::make_pair(wxString(dateStr), value));
+            timeSeriesData.push_back(std::make_pair(item["date"].asString(), item["value"].asDouble()));
         }
     }
 
-    // Sort chart data by date
-    std::sort(chartData.begin(), chartData.end(),
-        [](const std::pair<wxString, double>& a, const std::pair<wxString, double>& b) {
-            return a.first < b.first;
-        });
+    // Align measurements to a regular hourly grid with explicit gaps
+    HourlySeries series = ResampleToHourlyGrid(timeSeriesData);
+    if (series.values.empty()) {
+        wxMessageBox("No valid measurements found in the data file.", "Warning", wxOK | wxICON_WARNING);
+        return;
+    }
+
+    // Calculate statistics over the measured hours only
+    SeriesStatistics stats = ComputeSeriesStatistics(series);
 
-    double average = (count > 0) ? (sum / count) : 0.0;
+    // Create vector to store chart data, one entry per hour of the grid
+    std::vector<std::pair<wxString, double>> chartData;
+    chartData.reserve(series.values.size());
+    for (size_t i = 0; i < series.values.size(); i++) {
+        chartData.push_back(std::make_pair(wxString(FormatHoursAsTimestamp(series.HourAt(i))), series.values[i]));
+    }
 
     // Calculate trend
-    std::string trend = CalculateTrend(timeSeriesData);
+    std::string trend = CalculateTrend(series);
 
     // Update info panel with calculated statistics if available
     if (infoPanel) {
-        infoPanel->UpdateStatistics(key, max, min, average, trend);
+        infoPanel->UpdateStatistics(key, stats.max, stats.min, stats.mean, trend);
+    }
+
+    // Estimate percentiles for the file's date range from the sensor's quantile rollups
+    if (infoPanel && !chartData.empty()) {
+        std::string sensorDirectory = std::filesystem::path(filePath).parent_path().string();
+        std::string firstDay = chartData.front().first.ToStdString().substr(0, 10);
+        std::string lastDay = chartData.back().first.ToStdString().substr(0, 10);
+
+        // Downloads update the same stores on worker threads
+        std::unique_lock<std::mutex> storeLock = LockSensorStore(sensorDirectory);
+        SensorQuantileStore quantileStore;
+        quantileStore.Load(sensorDirectory, firstDay, lastDay);
+
+        // Backfill rollups for files downloaded before the store existed
+        if (quantileStore.Ingest(timeSeriesData)) {
+            quantileStore.Save(sensorDirectory);
+        }
+
+        TDigest digest = quantileStore.Query(firstDay, lastDay);
+        infoPanel->UpdateDistribution(digest.Quantile(0.5), digest.Quantile(0.95), digest.Quantile(0.99), digest.Count());
+
+        // Look up the exceedance counters of the year, backfilling them like the rollups
+        SensorExceedanceStore exceedanceStore;
+        exceedanceStore.Load(sensorDirectory);
+        if (exceedanceStore.Ingest(key, timeSeriesData)) {
+            exceedanceStore.Save(sensorDirectory);
+        }
+
+        YearlyExceedances exceedances;
+        if (exceedanceStore.Query(std::stoi(lastDay.substr(0, 4)), exceedances)) {
+            infoPanel->UpdateExceedances(key, exceedances);
+        }
     }
 
     // Prepare parameters for ChartPanel
@@ -109,18 +140,41 @@ void ProcessFileData(const std::string& filePath, InfoPanel* infoPanel, ChartPan
     // Update chart panel with processed data if available
     if (chartPanel && !chartData.empty()) {
         chartPanel->SetChartData(chartData, chartTitle, "Date", yAxisLabel);
+
+        // Continue the stored model to the end of the file, or fit one on the file if that is not possible
+        HoltWintersModel model;
+        std::string sensorDirectory = std::filesystem::path(filePath).parent_path().string();
+        if (PrepareForecastModel(sensorDirectory, series, model)) {
+            Forecast forecast = model.Predict(FORECAST_HORIZON_HOURS);
+            chartPanel->SetForecast(forecast.values, forecast.lower, forecast.upper);
+        }
+
+        // Highlight anomalous hours, running the detector first for files downloaded before it existed
+        SensorAnomalyDetector detector;
+        {
+            std::unique_lock<std::mutex> storeLock = LockSensorStore(sensorDirectory);
+            detector.Load(sensorDirectory, series.startHour, series.HourAt(series.values.size() - 1));
+            if (detector.Ingest(series)) {
+                detector.Save(sensorDirectory);
+            }
+        }
+        chartPanel->SetAnomalyFlags(detector.GetFlags(series.startHour, series.values.size()));
     }
 }
 
 /**
  * @brief Analyzes time series data to determine and describe the trend direction and magnitude
  *
- * Uses linear regression to calculate the slope of the time series data and
- * categorizes the trend based on the percentage change relative to the average value.
+ * Aligns the samples to an hourly grid and runs the robust trend engine:
+ * the Theil-Sen median slope estimates the rate of change and the
+ * Mann-Kendall test decides whether the trend is statistically significant.
+ * Series covering at least two weeks use the seasonal (hour of day) variant, so the
+ * daily pollution cycle does not distort the result.
  *
- * The function returns one of the following trend descriptions:
- * - "insufficient data for trend analysis": When there are fewer than 2 data points
- * - "stable": When the percentage change is less than 5%
+ * The function returns one of the following trend descriptions, followed by the
+ * slope and the p-value of the test:
+ * - "insufficient data for trend analysis": When there are fewer than 3 data points
+ * - "stable": When the trend is not significant or the change is less than 5%
  * - "increasing": When the percentage change is between 5% and 20%
  * - "strongly increasing": When the percentage change is greater than 20%
  * - "decreasing": When the percentage change is between -5% and -20%
@@ -130,56 +184,18 @@ void ProcessFileData(const std::string& filePath, InfoPanel* infoPanel, ChartPan
  * @return std::string Description of the trend
  */
 std::string CalculateTrend(const std::vector<std::pair<std::string, double>>& data) {
-    if (data.size() < 2) {
-        return "insufficient data for trend analysis";
-    }
-
-    // Create a sorted copy of the data by date
-    std::vector<std::pair<std::string, double>> sortedData = data;
-    std::sort(sortedData.begin(), sortedData.end(),
-        [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
-            return a.first < b.first;
-        });
-
-    int n = sortedData.size();
-
-    // Initialize variables for linear regression calculation
-    double sumX = 0.0;
-    double sumY = 0.0;
-    double sumXY = 0.0;
-    double sumX2 = 0.0;
-
-    // Trend calculations
-    for (int i = 0; i < n; i++) {
-        sumX += i;
-        sumY += sortedData[i].second;
-        sumXY += i * sortedData[i].second;
-        sumX2 += i * i;
-    }
-
-    double slope = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
-    double average = sumY / n;
-    double totalChange = slope * (n - 1);
-    double percentChange = (average != 0) ? (totalChange / average) * 100.0 : 0.0;
+    return CalculateTrend(ResampleToHourlyGrid(data));
+}
 
-    // Determine trend description based on percent change thresholds
-    if (std::abs(percentChange) < 5.0) {
-        return "stable";
-    }
-    else if (percentChange > 0) {
-        if (percentChange > 20.0) {
-            return "strongly increasing";
-        }
-        else {
-            return "increasing";
-        }
-    }
-    else {
-        if (percentChange < -20.0) {
-            return "strongly decreasing";
-        }
-        else {
-            return "decreasing";
-        }
-    }
+/**
+ * @brief Analyzes an hourly series to determine and describe the trend direction and magnitude
+ *
+ * Only measured hours take part in the analysis; missing hours keep their position
+ * on the time axis, so an outage does not compress the time between measurements.
+ *
+ * @param series Measurements aligned to an hourly grid
+ * @return std::string Description of the trend
+ */
+std::string CalculateTrend(const HourlySeries& series) {
+    return DescribeTrend(AnalyzeSeriesTrend(series));
 }
\ No newline at end of file
@@ -4,13 +4,21 @@
 #include <wx/wx.h>
 #include <Json/json.h>
 #include <algorithm>
+#include <filesystem>
 #include <string>
 #include <vector>
 
 #include "InfoPanel.h"
 #include "ChartPanel.h"
 
+#include "AnomalyDetection.h"
+#include "ExceedanceEngine.h"
+#include "Forecasting.h"
 #include "NetworkingAndFileHandling.h"
+#include "QuantileSketch.h"
+#include "SensorStores.h"
+#include "TimeSeries.h"
+#include "TrendAnalysis.h"
 
 /**
  * @file DataProcessing.h
@@ -32,13 +40,24 @@ void ProcessFileData(const std::string& filePath, InfoPanel* infoPanel, ChartPan
 /**
  * @brief Analyzes time series data to determine the trend
  *
- * Performs linear regression on the time series data to calculate the slope
- * and describes the trend as "stable", "increasing", "strongly increasing",
- * "decreasing", or "strongly decreasing".
+ * Estimates the Theil-Sen slope with Mann-Kendall significance (seasonal for
+ * series longer than two weeks) and describes the trend as "stable", "increasing",
+ * "strongly increasing", "decreasing", or "strongly decreasing".
  *
  * @param data Vector of date-value pairs representing time series data
  * @return std::string Description of the trend
  */
 std::string CalculateTrend(const std::vector<std::pair<std::string, double>>& data);
 
+/**
+ * @brief Analyzes an hourly series to determine the trend
+ *
+ * Same analysis as above for data that is already aligned to an hourly grid;
+ * missing hours are skipped but keep their place on the time axis.
+ *
+ * @param series Measurements aligned to an hourly grid
+ * @return std::string Description of the trend
+ */
+std::string CalculateTrend(const HourlySeries& series);
+
 #endif // DATA_PROCESSING_H
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**
+ * @file DcChartCanvas.cpp
+ * @brief Implementation of the DcChartCanvas class
+ */
+
+#include "DcChartCanvas.h"
+
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Converts a chart colour into a wxColour
+     */
+    wxColour ToColour(const ChartColour& colour) {
+        return wxColour(colour.red, colour.green, colour.blue);
+    }
+}
+
+/**
+ * @brief Constructor creating the chart fonts
+ */
+DcChartCanvas::DcChartCanvas() : dc(nullptr),
+    titleFont(12, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD),
+    axisLabelFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL),
+    tickFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL),
+    legendFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD),
+    noteFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_ITALIC, wxFONTWEIGHT_NORMAL) {
+}
+
+/**
+ * @brief Directs the following drawing to a device context
+ * @param dc Device context to draw on; must outlive the drawing
+ *
+ * Clips left over from an earlier render are forgotten.
+ */
+void DcChartCanvas::Attach(wxDC& dc) {
+    this->dc = &dc;
+    clips.clear();
+}
+
+/**
+ * @brief Gets the wxFont of a chart text style
+ * @param font Text style
+ * @return Font used for the style
+ */
+const wxFont& DcChartCanvas::GetFont(ChartFont font) const {
+    switch (font) {
+    case CHART_FONT_TITLE:
+        return titleFont;
+    case CHART_FONT_AXIS_LABEL:
+        return axisLabelFont;
+    case CHART_FONT_LEGEND:
+        return legendFont;
+    case CHART_FONT_NOTE:
+        return noteFont;
+    default:
+        return tickFont;
+    }
+}
+
+/**
+ * @brief Sets the pen used for lines and outlines
+ */
+void DcChartCanvas::SetPen(const ChartColour& colour, int width, ChartLineStyle style) {
+    wxPenStyle penStyle = wxPENSTYLE_SOLID;
+    if (style == CHART_LINE_DOT) {
+        penStyle = wxPENSTYLE_DOT;
+    }
+    else if (style == CHART_LINE_SHORT_DASH) {
+        penStyle = wxPENSTYLE_SHORT_DASH;
+    }
+    dc->SetPen(wxPen(ToColour(colour), width, penStyle));
+}
+
+/**
+ * @brief Draws following shapes without an outline
+ */
+void DcChartCanvas::SetNoPen() {
+    dc->SetPen(*wxTRANSPARENT_PEN);
+}
+
+/**
+ * @brief Sets the brush used to fill shapes
+ */
+void DcChartCanvas::SetBrush(const ChartColour& colour) {
+    dc->SetBrush(wxBrush(ToColour(colour)));
+}
+
+/**
+ * @brief Sets the font of following text
+ */
+void DcChartCanvas::SetFont(ChartFont font) {
+    dc->SetFont(GetFont(font));
+}
+
+/**
+ * @brief Sets the colour of following text
+ */
+void DcChartCanvas::SetTextColour(const ChartColour& colour) {
+    dc->SetTextForeground(ToColour(colour));
+}
+
+/**
+ * @brief Draws a line with the pen
+ */
+void DcChartCanvas::DrawLine(int x1, int y1, int x2, int y2) {
+    dc->DrawLine(x1, y1, x2, y2);
+}
+
+/**
+ * @brief Draws a polyline with the pen
+ */
+void DcChartCanvas::DrawLines(const std::vector<ChartPoint>& source) {
+    CopyPoints(source);
+    dc->DrawLines(static_cast<int>(points.size()), points.data());
+}
+
+/**
+ * @brief Draws a closed polygon, filled with the brush and outlined with the pen
+ */
+void DcChartCanvas::DrawPolygon(const std::vector<ChartPoint>& source) {
+    CopyPoints(source);
+    dc->DrawPolygon(static_cast<int>(points.size()), points.data());
+}
+
+/**
+ * @brief Draws a rectangle, filled with the brush and outlined with the pen
+ */
+void DcChartCanvas::DrawRectangle(int x, int y, int width, int height) {
+    dc->DrawRectangle(x, y, width, height);
+}
+
+/**
+ * @brief Draws a circle, filled with the brush and outlined with the pen
+ */
+void DcChartCanvas::DrawCircle(int x, int y, int radius) {
+    dc->DrawCircle(x, y, radius);
+}
+
+/**
+ * @brief Draws UTF-8 text with its top left corner at a position
+ */
+void DcChartCanvas::DrawText(const std::string& text, int x, int y) {
+    dc->DrawText(wxString::FromUTF8(text), x, y);
+}
+
+/**
+ * @brief Draws UTF-8 text rotated counter-clockwise around its top left corner
+ */
+void DcChartCanvas::DrawRotatedText(const std::string& text, int x, int y, double angle) {
+    dc->DrawRotatedText(wxString::FromUTF8(text), x, y, angle);
+}
+
+/**
+ * @brief Measures UTF-8 text in the current font
+ */
+void DcChartCanvas::GetTextExtent(const std::string& text, int& width, int& height) {
+    wxSize size = dc->GetTextExtent(wxString::FromUTF8(text));
+    width = size.GetWidth();
+    height = size.GetHeight();
+}
+
+/**
+ * @brief Limits drawing to a rectangle inside the current clipping area
+ *
+ * The rectangle is intersected with the enclosing clip here, so the DC always holds a
+ * single rectangular region that PopClip can restore exactly.
+ */
+void DcChartCanvas::PushClip(int x, int y, int width, int height) {
+    wxRect clip(x, y, std::max(0, width), std::max(0, height));
+    if (!clips.empty()) {
+        const wxRect& outer = clips.back();
+        int left = std::max(clip.x, outer.x);
+        int top = std::max(clip.y, outer.y);
+        int right = std::min(clip.x + clip.width, outer.x + outer.width);
+        int bottom = std::min(clip.y + clip.height, outer.y + outer.height);
+        clip = wxRect(left, top, std::max(0, right - left), std::max(0, bottom - top));
+    }
+    clips.push_back(clip);
+    dc->DestroyClippingRegion();
+    dc->SetClippingRegion(clip);
+}
+
+/**
+ * @brief Restores the clipping area before the last PushClip
+ */
+void DcChartCanvas::PopClip() {
+    if (clips.empty()) {
+        return;
+    }
+    clips.pop_back();
+    dc->DestroyClippingRegion();
+    if (!clips.empty()) {
+        dc->SetClippingRegion(clips.back());
+    }
+}
+
+/**
+ * @brief Converts chart points into the reused wxPoint buffer
+ * @param source Points to convert
+ */
+void DcChartCanvas::CopyPoints(const std::vector<ChartPoint>& source) {
+    points.clear();
+    points.reserve(source.size());
+    for (const auto& point : source) {
+        points.push_back(wxPoint(point.x, point.y));
+    }
+}
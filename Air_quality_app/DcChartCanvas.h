@@ -0,0 +1,75 @@
+#ifndef DC_CHART_CANVAS_H
+#define DC_CHART_CANVAS_H
+
+#include <wx/wx.h>
+#include <vector>
+
+#include "ChartCanvas.h"
+
+/**
+ * @file DcChartCanvas.h
+ * @brief Chart canvas drawing through a wxWidgets device context
+ */
+
+ /**
+  * @class DcChartCanvas
+  * @brief ChartCanvas forwarding to a wxDC, e.g. the memory DC of a cached bitmap
+  *
+  * The fonts are created once and kept, so attaching the canvas to a new DC for every
+  * render costs nothing. Clipping rectangles are intersected here and set on the DC as
+  * one region, so nested clips behave alike on every platform.
+  */
+class DcChartCanvas : public ChartCanvas {
+public:
+    /**
+     * @brief Constructor creating the chart fonts
+     */
+    DcChartCanvas();
+
+    /**
+     * @brief Directs the following drawing to a device context
+     * @param dc Device context to draw on; must outlive the drawing
+     */
+    void Attach(wxDC& dc);
+
+    /**
+     * @brief Gets the wxFont of a chart text style
+     * @param font Text style
+     * @return Font used for the style
+     */
+    const wxFont& GetFont(ChartFont font) const;
+
+    void SetPen(const ChartColour& colour, int width, ChartLineStyle style = CHART_LINE_SOLID) override;
+    void SetNoPen() override;
+    void SetBrush(const ChartColour& colour) override;
+    void SetFont(ChartFont font) override;
+    void SetTextColour(const ChartColour& colour) override;
+    void DrawLine(int x1, int y1, int x2, int y2) override;
+    void DrawLines(const std::vector<ChartPoint>& points) override;
+    void DrawPolygon(const std::vector<ChartPoint>& points) override;
+    void DrawRectangle(int x, int y, int width, int height) override;
+    void DrawCircle(int x, int y, int radius) override;
+    void DrawText(const std::string& text, int x, int y) override;
+    void DrawRotatedText(const std::string& text, int x, int y, double angle) override;
+    void GetTextExtent(const std::string& text, int& width, int& height) override;
+    void PushClip(int x, int y, int width, int height) override;
+    void PopClip() override;
+
+private:
+    wxDC* dc; /**< Device context drawn on, set by Attach */
+    wxFont titleFont; /**< Font of the chart title */
+    wxFont axisLabelFont; /**< Font of the axis labels */
+    wxFont tickFont; /**< Font of the tick labels and series legend */
+    wxFont legendFont; /**< Font of the anomaly summary */
+    wxFont noteFont; /**< Font of the forecast note */
+    std::vector<wxRect> clips; /**< Stack of effective clipping rectangles, innermost last */
+    std::vector<wxPoint> points; /**< Reused buffer for polylines and polygons */
+
+    /**
+     * @brief Converts chart points into the reused wxPoint buffer
+     * @param source Points to convert
+     */
+    void CopyPoints(const std::vector<ChartPoint>& source);
+};
+
+#endif // DC_CHART_CANVAS_H
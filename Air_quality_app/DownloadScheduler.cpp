@@ -0,0 +1,331 @@
+/**
+ * @file DownloadScheduler.cpp
+ * @brief Implementation of the DownloadScheduler class
+ */
+
+#include "DownloadScheduler.h"
+
+#include <algorithm>
+
+/**
+ * @brief Constructor that starts the worker threads
+ * @param connectionCount Number of downloads running at the same time
+ */
+DownloadScheduler::DownloadScheduler(size_t connectionCount) : stopping(false) {
+    connectionCount = std::max<size_t>(1, connectionCount);
+    for (size_t i = 0; i < connectionCount; i++) {
+        workers.emplace_back(&DownloadScheduler::WorkerLoop, this);
+    }
+}
+
+/**
+ * @brief Destructor that cancels all downloads and joins the workers
+ *
+ * The futures of dropped downloads report failure, so nobody waits on them forever,
+ * and running downloads stop at their next transfer callback instead of their timeout.
+ */
+DownloadScheduler::~DownloadScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    CancelAll();
+    queueCondition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+/**
+ * @brief Queues a download unless one with the same key is pending
+ * @param key Identifier of the download
+ * @param group Identifier of the downloads that are cancelled together
+ * @param priority Priority of the download; interactive also promotes a pending download
+ * @param download Function performing the download, returning whether it succeeded; it should stop when its token is cancelled
+ * @return Future of the download's result; false if it failed or was cancelled
+ *
+ * This function:
+ * 1. Returns the future of a queued, waiting or running download with the same key,
+ *    moving it to the front of the queue if the new request is interactive
+ * 2. Otherwise parks the download until a cancelled download of the same key that is
+ *    still running has stopped, so the two never write the sensor's files at once
+ * 3. Otherwise queues the download, interactive ones at the front (most recent first)
+ *    and background ones at the back
+ */
+std::shared_future<bool> DownloadScheduler::Schedule(const std::string& key, const std::string& group, DownloadPriority priority,
+    std::function<bool(const CancellationToken&)> download) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    auto existing = pending.find(key);
+    if (existing != pending.end()) {
+        if (priority == DownloadPriority::Interactive) {
+            MoveToFront(key);
+        }
+        return existing->second.result;
+    }
+
+    Job job;
+    job.key = key;
+    job.group = group;
+    job.download = std::move(download);
+    job.priority = priority;
+    job.result = std::make_shared<std::promise<bool>>();
+    std::shared_future<bool> result = job.result->get_future().share();
+    if (stopping) {
+        job.result->set_value(false);
+        return result;
+    }
+
+    PendingDownload& entry = pending[key];
+    entry.group = group;
+    entry.cancel = job.cancel;
+    entry.result = result;
+    if (running.count(key) != 0) {
+        waiting[key] = std::move(job);
+    }
+    else {
+        Enqueue(std::move(job));
+    }
+    return result;
+}
+
+/**
+ * @brief Moves a queued or waiting download ahead of all other queued downloads
+ * @param key Identifier of the download
+ * @return true if the download was queued or waiting, false if it is running, finished or unknown
+ */
+bool DownloadScheduler::Promote(const std::string& key) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return MoveToFront(key);
+}
+
+/**
+ * @brief Gets the result of the pending download of a key, or else of its last finished one
+ * @param key Identifier of the download
+ * @param result [out] Future of the download's result
+ * @return true if the key has a pending or finished download, false otherwise
+ *
+ * A pending download takes precedence, since its result is newer than a finished one.
+ * Cancelled downloads are not remembered as finished.
+ */
+bool DownloadScheduler::FindResult(const std::string& key, std::shared_future<bool>& result) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    auto entry = pending.find(key);
+    if (entry != pending.end()) {
+        result = entry->second.result;
+        return true;
+    }
+    auto done = finished.find(key);
+    if (done != finished.end()) {
+        result = done->second;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Moves all queued interactive downloads behind the background ones
+ *
+ * The downloads keep their futures; they are only started later. Waiting downloads
+ * are queued as background ones once they may start.
+ */
+void DownloadScheduler::DeprioritizeInteractive() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    for (auto& job : interactiveQueue) {
+        job.priority = DownloadPriority::Background;
+        backgroundQueue.push_back(std::move(job));
+    }
+    interactiveQueue.clear();
+    for (auto& entry : waiting) {
+        entry.second.priority = DownloadPriority::Background;
+    }
+}
+
+/**
+ * @brief Cancels the queued and running downloads of a group
+ * @param group Identifier of the group
+ * @return Number of cancelled downloads
+ */
+size_t DownloadScheduler::CancelGroup(const std::string& group) {
+    return CancelMatching([&group](const std::string& jobGroup) { return jobGroup == group; });
+}
+
+/**
+ * @brief Cancels all queued and running downloads
+ * @return Number of cancelled downloads
+ */
+size_t DownloadScheduler::CancelAll() {
+    return CancelMatching([](const std::string&) { return true; });
+}
+
+/**
+ * @brief Cancels the queued and running downloads matching a condition
+ * @param matches Function selecting downloads by their group
+ * @return Number of cancelled downloads
+ *
+ * This function:
+ * 1. Removes the matching queued and waiting downloads, whose futures report failure
+ *    right away
+ * 2. Cancels the token of the matching running downloads; their futures report
+ *    failure once the transfer has stopped
+ * 3. Forgets all matching downloads, so a later request for the same key starts a
+ *    new download instead of joining the cancelled one; the worker keeps the key in
+ *    running until the cancelled download has stopped, and the new one waits for it
+ */
+size_t DownloadScheduler::CancelMatching(const std::function<bool(const std::string&)>& matches) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    for (auto* queue : { &interactiveQueue, &backgroundQueue }) {
+        auto kept = std::stable_partition(queue->begin(), queue->end(),
+            [&matches](const Job& job) { return !matches(job.group); });
+        for (auto it = kept; it != queue->end(); ++it) {
+            it->result->set_value(false);
+        }
+        queue->erase(kept, queue->end());
+    }
+    for (auto it = waiting.begin(); it != waiting.end();) {
+        if (matches(it->second.group)) {
+            it->second.result->set_value(false);
+            it = waiting.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    size_t cancelled = 0;
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (matches(it->second.group)) {
+            it->second.cancel.Cancel();
+            it = pending.erase(it);
+            cancelled++;
+        }
+        else {
+            ++it;
+        }
+    }
+    return cancelled;
+}
+
+/**
+ * @brief Removes a queued download from the queues
+ * @param key Identifier of the download
+ * @param job [out] The removed download
+ * @return true if the download was queued, false otherwise
+ *
+ * The caller must hold queueMutex. Queues hold a station's worth of sensors, so a
+ * linear search is enough.
+ */
+bool DownloadScheduler::TakeQueued(const std::string& key, Job& job) {
+    for (auto* queue : { &interactiveQueue, &backgroundQueue }) {
+        auto it = std::find_if(queue->begin(), queue->end(),
+            [&key](const Job& queued) { return queued.key == key; });
+        if (it != queue->end()) {
+            job = std::move(*it);
+            queue->erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Moves a queued or waiting download ahead of the other queued downloads
+ * @param key Identifier of the download
+ * @return true if the download was queued or waiting, false otherwise
+ *
+ * The caller must hold queueMutex. A waiting download is only marked interactive, so
+ * it goes to the front of the queue once the cancelled download before it has stopped.
+ */
+bool DownloadScheduler::MoveToFront(const std::string& key) {
+    auto parked = waiting.find(key);
+    if (parked != waiting.end()) {
+        parked->second.priority = DownloadPriority::Interactive;
+        return true;
+    }
+
+    Job job;
+    if (!TakeQueued(key, job)) {
+        return false;
+    }
+    job.priority = DownloadPriority::Interactive;
+    interactiveQueue.push_front(std::move(job));
+    return true;
+}
+
+/**
+ * @brief Adds a download to the queue of its priority
+ * @param job Download to be started
+ *
+ * The caller must hold queueMutex. Interactive downloads go to the front of their
+ * queue (most recent first), background ones to the back.
+ */
+void DownloadScheduler::Enqueue(Job job) {
+    if (job.priority == DownloadPriority::Interactive) {
+        interactiveQueue.push_front(std::move(job));
+    }
+    else {
+        backgroundQueue.push_back(std::move(job));
+    }
+    queueCondition.notify_one();
+}
+
+/**
+ * @brief Takes downloads from the queues, interactive ones first, until the scheduler is stopped
+ *
+ * A download that throws reports failure. Its key is released before the result is
+ * published, and the result is kept for FindResult(), so a caller retrying after a
+ * failure schedules a new download. A key already taken over by a newer download
+ * (after a cancellation) is left alone, and that download is queued now that the
+ * cancelled one has stopped.
+ */
+void DownloadScheduler::WorkerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() {
+                return stopping || !interactiveQueue.empty() || !backgroundQueue.empty();
+                });
+            if (stopping) {
+                return;
+            }
+            std::deque<Job>& queue = interactiveQueue.empty() ? backgroundQueue : interactiveQueue;
+            job = std::move(queue.front());
+            queue.pop_front();
+            running.insert(job.key);
+        }
+
+        bool success = false;
+        try {
+            success = !job.cancel.IsCancelled() && job.download(job.cancel);
+        }
+        catch (...) {
+            success = false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            auto entry = pending.find(job.key);
+            if (entry != pending.end() && entry->second.cancel == job.cancel) {
+                finished[job.key] = entry->second.result;
+                pending.erase(entry);
+            }
+            running.erase(job.key);
+
+            auto next = waiting.find(job.key);
+            if (next != waiting.end()) {
+                Job nextJob = std::move(next->second);
+                waiting.erase(next);
+                if (!stopping) {
+                    Enqueue(std::move(nextJob));
+                }
+                else {
+                    nextJob.result->set_value(false);
+                }
+            }
+        }
+        job.result->set_value(success && !job.cancel.IsCancelled());
+    }
+}
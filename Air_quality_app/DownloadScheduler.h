@@ -0,0 +1,181 @@
+#ifndef DOWNLOAD_SCHEDULER_H
+#define DOWNLOAD_SCHEDULER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "CancellationToken.h"
+
+/**
+ * @file DownloadScheduler.h
+ * @brief Priority queue of downloads served by a fixed number of connections
+ */
+
+ /**
+  * @enum DownloadPriority
+  * @brief Urgency of a download
+  */
+enum class DownloadPriority {
+    Background,  /**< Prefetch the user is not waiting for */
+    Interactive  /**< Download the user is waiting for (selected or highlighted sensor) */
+};
+
+/**
+ * @class DownloadScheduler
+ * @brief Runs downloads on a few worker threads, interactive ones first
+ *
+ * Downloads are identified by a key (the sensor directory) so that scheduling the
+ * same download twice returns the pending one instead of fetching the data again;
+ * scheduling it as interactive moves it ahead of the queued background downloads.
+ * The most recent interactive download is started first, since it is the one the
+ * user looks at. Each download also belongs to a group (the station directory)
+ * whose downloads can be cancelled together: queued ones are dropped and running
+ * ones are asked to stop through their CancellationToken, which frees their
+ * connection for the downloads that are still needed. A download scheduled while
+ * a cancelled one with the same key is still running waits until it has stopped,
+ * so two downloads never write the same files at once.
+ */
+class DownloadScheduler {
+public:
+    /**
+     * @brief Constructor that starts the worker threads
+     * @param connectionCount Number of downloads running at the same time
+     */
+    explicit DownloadScheduler(size_t connectionCount);
+
+    /**
+     * @brief Destructor that cancels all downloads and joins the workers
+     */
+    ~DownloadScheduler();
+
+    DownloadScheduler(const DownloadScheduler&) = delete;
+    DownloadScheduler& operator=(const DownloadScheduler&) = delete;
+
+    /**
+     * @brief Queues a download unless one with the same key is pending
+     * @param key Identifier of the download
+     * @param group Identifier of the downloads that are cancelled together
+     * @param priority Priority of the download; interactive also promotes a pending download
+     * @param download Function performing the download, returning whether it succeeded; it should stop when its token is cancelled
+     * @return Future of the download's result; false if it failed or was cancelled
+     */
+    std::shared_future<bool> Schedule(const std::string& key, const std::string& group, DownloadPriority priority,
+        std::function<bool(const CancellationToken&)> download);
+
+    /**
+     * @brief Moves a queued or waiting download ahead of all other queued downloads
+     * @param key Identifier of the download
+     * @return true if the download was queued or waiting, false if it is running, finished or unknown
+     */
+    bool Promote(const std::string& key);
+
+    /**
+     * @brief Gets the result of the pending download of a key, or else of its last finished one
+     * @param key Identifier of the download
+     * @param result [out] Future of the download's result
+     * @return true if the key has a pending or finished download, false otherwise
+     *
+     * Unlike Schedule(), this never starts a download, so a caller can wait for a
+     * prefetch without fetching the data again once the prefetch has finished.
+     */
+    bool FindResult(const std::string& key, std::shared_future<bool>& result);
+
+    /**
+     * @brief Moves all queued interactive downloads behind the background ones
+     *
+     * Used when the user stops waiting for them, e.g. after a highlighted sensor was not chosen.
+     */
+    void DeprioritizeInteractive();
+
+    /**
+     * @brief Cancels the queued and running downloads of a group
+     * @param group Identifier of the group
+     * @return Number of cancelled downloads
+     */
+    size_t CancelGroup(const std::string& group);
+
+    /**
+     * @brief Cancels all queued and running downloads
+     * @return Number of cancelled downloads
+     */
+    size_t CancelAll();
+
+private:
+    /**
+     * @struct Job
+     * @brief Queued download with the promise of its result
+     */
+    struct Job {
+        std::string key;                               /**< Identifier of the download */
+        std::string group;                             /**< Identifier of the download's group */
+        std::function<bool(const CancellationToken&)> download; /**< Function performing the download */
+        DownloadPriority priority = DownloadPriority::Background; /**< Queue the download is started from */
+        CancellationToken cancel;                      /**< Asks the download to stop */
+        std::shared_ptr<std::promise<bool>> result;    /**< Receives the result of the download */
+    };
+
+    /**
+     * @struct PendingDownload
+     * @brief Queued, waiting or running download as seen by new requests and cancellation
+     */
+    struct PendingDownload {
+        std::string group;                             /**< Identifier of the download's group */
+        CancellationToken cancel;                      /**< Token shared with the download */
+        std::shared_future<bool> result;               /**< Result of the download */
+    };
+
+    std::vector<std::thread> workers;                  /**< Worker threads, one per connection */
+    std::deque<Job> interactiveQueue;                  /**< Queued interactive downloads, next one first */
+    std::deque<Job> backgroundQueue;                   /**< Queued background downloads, in scheduling order */
+    std::unordered_map<std::string, PendingDownload> pending; /**< Queued, waiting and running downloads by key, until cancelled */
+    std::unordered_map<std::string, Job> waiting;      /**< Downloads waiting for a cancelled download of their key to stop */
+    std::unordered_set<std::string> running;           /**< Keys of the running downloads, cancelled ones included */
+    std::unordered_map<std::string, std::shared_future<bool>> finished; /**< Result of the last finished, not cancelled download of each key */
+    std::mutex queueMutex;                             /**< Protects the queues, pending, waiting, running and finished */
+    std::condition_variable queueCondition;            /**< Signals new downloads or shutdown */
+    bool stopping;                                     /**< Set when the scheduler is being destroyed */
+
+    /**
+     * @brief Removes a queued download from the queues
+     * @param key Identifier of the download
+     * @param job [out] The removed download
+     * @return true if the download was queued, false otherwise
+     */
+    bool TakeQueued(const std::string& key, Job& job);
+
+    /**
+     * @brief Moves a queued or waiting download ahead of the other queued downloads
+     * @param key Identifier of the download
+     * @return true if the download was queued or waiting, false otherwise
+     */
+    bool MoveToFront(const std::string& key);
+
+    /**
+     * @brief Adds a download to the queue of its priority
+     * @param job Download to be started
+     */
+    void Enqueue(Job job);
+
+    /**
+     * @brief Cancels the queued and running downloads matching a condition
+     * @param matches Function selecting downloads by their group
+     * @return Number of cancelled downloads
+     */
+    size_t CancelMatching(const std::function<bool(const std::string&)>& matches);
+
+    /**
+     * @brief Main loop of a worker thread
+     */
+    void WorkerLoop();
+};
+
+#endif // DOWNLOAD_SCHEDULER_H
@@ -0,0 +1,341 @@
+/**
+ * @file ExceedanceEngine.cpp
+ * @brief Implementation of the limit value table and the exceedance store
+ */
+
+#include "ExceedanceEngine.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <set>
+
+#include "JsonFiles.h"
+#include "TimeSeries.h"
+
+namespace {
+    const std::string EXCEEDANCE_STORE_DIRECTORY = "store";         ///< Subdirectory of a sensor directory holding derived data
+    const std::string EXCEEDANCE_STORE_FILE = "exceedances.json";   ///< File name of the exceedance counters
+    const int MIN_HOURS_FOR_DAILY_MEAN = 18;                        ///< Measured hours needed for a valid daily mean (75%)
+    const int MIN_HOURS_FOR_8H_MEAN = 6;                            ///< Measured hours needed for a valid 8-hour mean (75%)
+
+    /**
+     * @brief Gets the value of the series at an absolute hour, MISSING_VALUE outside the grid
+     */
+    double ValueAt(const HourlySeries& series, long long hour) {
+        if (hour < series.startHour || hour >= series.HourAt(series.values.size())) {
+            return MISSING_VALUE;
+        }
+        return series.values[static_cast<size_t>(hour - series.startHour)];
+    }
+
+    /**
+     * @brief Computes the maximum 8-hour running mean over the windows ending in a day
+     * @return Maximum valid window mean, or MISSING_VALUE if no window has enough hours
+     *
+     * Windows reaching into the previous day use its hours when they are part of the series.
+     */
+    double MaxDaily8HourMean(const HourlySeries& series, long long dayStart) {
+        double best = MISSING_VALUE;
+        for (long long end = dayStart; end < dayStart + 24; end++) {
+            double sum = 0.0;
+            int count = 0;
+            for (long long hour = end - 7; hour <= end; hour++) {
+                double value = ValueAt(series, hour);
+                if (!IsMissingValue(value)) {
+                    sum += value;
+                    count++;
+                }
+            }
+            if (count >= MIN_HOURS_FOR_8H_MEAN) {
+                double mean = sum / count;
+                best = IsMissingValue(best) ? mean : std::max(best, mean);
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Reads a counters object ({hours, sum, exceedances}) from JSON
+     */
+    void CountersFromJson(const Json::Value& json, long long& hours, double& sum, std::vector<long long>& exceedances) {
+        hours = json["hours"].asInt64();
+        sum = json["sum"].asDouble();
+        exceedances.clear();
+        for (const auto& count : json["exceedances"]) {
+            exceedances.push_back(count.asInt64());
+        }
+    }
+
+    /**
+     * @brief Writes a counters object ({hours, sum, exceedances}) to JSON
+     */
+    Json::Value CountersToJson(long long hours, double sum, const std::vector<long long>& exceedances) {
+        Json::Value json;
+        json["hours"] = static_cast<Json::Int64>(hours);
+        json["sum"] = sum;
+        json["exceedances"] = Json::Value(Json::arrayValue);
+        for (long long count : exceedances) {
+            json["exceedances"].append(static_cast<Json::Int64>(count));
+        }
+        return json;
+    }
+}
+
+/**
+ * @brief Gets the limit values of a parameter
+ * @param paramCode Parameter code from sensors.json
+ * @return Limit values of the parameter, empty if the parameter is not regulated
+ *
+ * Limit and target values, information and alarm thresholds for the protection of
+ * human health, all in ug/m3 as reported by the GIOS API.
+ */
+const std::vector<LimitValue>& GetLimitValues(const std::string& paramCode) {
+    static const std::map<std::string, std::vector<LimitValue>> LIMIT_VALUES = {
+        { "PM10", {
+            { "daily limit value", AveragingPeriod::Day, 50.0, 35 },
+            { "information threshold", AveragingPeriod::Day, 100.0, 0 },
+            { "alarm threshold", AveragingPeriod::Day, 150.0, 0 },
+            { "annual limit value", AveragingPeriod::Year, 40.0, 0 } } },
+        { "PM2.5", {
+            { "annual limit value", AveragingPeriod::Year, 25.0, 0 } } },
+        { "NO2", {
+            { "hourly limit value", AveragingPeriod::Hour, 200.0, 18 },
+            { "annual limit value", AveragingPeriod::Year, 40.0, 0 } } },
+        { "SO2", {
+            { "hourly limit value", AveragingPeriod::Hour, 350.0, 24 },
+            { "daily limit value", AveragingPeriod::Day, 125.0, 3 } } },
+        { "O3", {
+            { "target value", AveragingPeriod::MaxDaily8Hour, 120.0, 25 },
+            { "information threshold", AveragingPeriod::Hour, 180.0, 0 },
+            { "alarm threshold", AveragingPeriod::Hour, 240.0, 0 } } },
+        { "CO", {
+            { "limit value", AveragingPeriod::MaxDaily8Hour, 10000.0, 0 } } },
+        { "C6H6", {
+            { "annual limit value", AveragingPeriod::Year, 5.0, 0 } } },
+    };
+    static const std::vector<LimitValue> NO_LIMITS;
+
+    auto it = LIMIT_VALUES.find(paramCode);
+    return (it != LIMIT_VALUES.end()) ? it->second : NO_LIMITS;
+}
+
+/**
+ * @brief Loads the daily records and yearly counters stored in the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @return true if a stored counter file was found and parsed, false otherwise
+ */
+bool SensorExceedanceStore::Load(const std::string& sensorDirectory) {
+    paramCode.clear();
+    days.clear();
+    years.clear();
+
+    Json::Value root;
+    std::string path = sensorDirectory + "/" + EXCEEDANCE_STORE_DIRECTORY + "/" + EXCEEDANCE_STORE_FILE;
+    if (!std::filesystem::exists(path) || !LoadJsonFromFile(path, root)) {
+        return false;
+    }
+
+    paramCode = root["paramCode"].asString();
+
+    const Json::Value& storedDays = root["days"];
+    for (const auto& day : storedDays.getMemberNames()) {
+        Counters& counters = days[day];
+        CountersFromJson(storedDays[day], counters.hours, counters.sum, counters.exceedances);
+    }
+
+    const Json::Value& storedYears = root["years"];
+    for (const auto& year : storedYears.getMemberNames()) {
+        Counters& counters = years[std::stoi(year)];
+        CountersFromJson(storedYears[year], counters.hours, counters.sum, counters.exceedances);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the counters into "store/exceedances.json" inside the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @return true if the store was written successfully, false otherwise
+ */
+bool SensorExceedanceStore::Save(const std::string& sensorDirectory) const {
+    std::string storeDirectory = sensorDirectory + "/" + EXCEEDANCE_STORE_DIRECTORY;
+    Json::Value root;
+    root["paramCode"] = paramCode;
+    root["days"] = Json::Value(Json::objectValue);
+    root["years"] = Json::Value(Json::objectValue);
+    for (const auto& [day, counters] : days) {
+        root["days"][day] = CountersToJson(counters.hours, counters.sum, counters.exceedances);
+    }
+    for (const auto& [year, counters] : years) {
+        root["years"][std::to_string(year)] = CountersToJson(counters.hours, counters.sum, counters.exceedances);
+    }
+
+    try {
+        std::filesystem::create_directories(storeDirectory);
+        return SaveToFile(root, storeDirectory + "/" + EXCEEDANCE_STORE_FILE);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Updates the counters with measurements
+ * @param code Parameter code of the sensor, selecting its limit values
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return true if any counter changed, false otherwise
+ *
+ * Downloads overlap, so a day's record is only replaced when the incoming data covers
+ * more hours than the stored record; repeated ingestion of the same data changes nothing.
+ * The totals of every affected year are then rebuilt from its daily records.
+ */
+bool SensorExceedanceStore::Ingest(const std::string& code, const std::vector<std::pair<std::string, double>>& data) {
+    // Counters computed for another parameter cannot be combined with the new ones
+    if (code != paramCode) {
+        days.clear();
+        years.clear();
+        paramCode = code;
+    }
+
+    const std::vector<LimitValue>& limits = GetLimitValues(paramCode);
+    HourlySeries series = ResampleToHourlyGrid(data);
+    if (series.values.empty()) {
+        return false;
+    }
+
+    long long lastHour = series.HourAt(series.values.size() - 1);
+    long long firstDayStart = series.startHour - ((series.startHour % 24) + 24) % 24;
+
+    std::set<int> changedYears;
+    for (long long dayStart = firstDayStart; dayStart <= lastHour; dayStart += 24) {
+        Counters counters;
+        for (long long hour = dayStart; hour < dayStart + 24; hour++) {
+            double value = ValueAt(series, hour);
+            if (!IsMissingValue(value)) {
+                counters.hours++;
+                counters.sum += value;
+            }
+        }
+        if (counters.hours == 0) {
+            continue;
+        }
+
+        std::string day = FormatHoursAsTimestamp(dayStart).substr(0, 10);
+        auto existing = days.find(day);
+        if (existing != days.end() && existing->second.hours >= counters.hours) {
+            continue;
+        }
+
+        // Count the exceedances of every limit value in this day
+        counters.exceedances.assign(limits.size(), 0);
+        for (size_t l = 0; l < limits.size(); l++) {
+            const LimitValue& limit = limits[l];
+            switch (limit.period) {
+            case AveragingPeriod::Hour:
+                for (long long hour = dayStart; hour < dayStart + 24; hour++) {
+                    double value = ValueAt(series, hour);
+                    if (!IsMissingValue(value) && value > limit.threshold) {
+                        counters.exceedances[l]++;
+                    }
+                }
+                break;
+            case AveragingPeriod::Day:
+                if (counters.hours >= MIN_HOURS_FOR_DAILY_MEAN && counters.sum / counters.hours > limit.threshold) {
+                    counters.exceedances[l] = 1;
+                }
+                break;
+            case AveragingPeriod::MaxDaily8Hour: {
+                double maxMean = MaxDaily8HourMean(series, dayStart);
+                if (!IsMissingValue(maxMean) && maxMean > limit.threshold) {
+                    counters.exceedances[l] = 1;
+                }
+                break;
+            }
+            case AveragingPeriod::Year:
+                // Evaluated from the yearly sum and hour count
+                break;
+            }
+        }
+
+        days[day] = counters;
+        changedYears.insert(std::stoi(day.substr(0, 4)));
+    }
+
+    for (int year : changedYears) {
+        RebuildYear(year);
+    }
+    return !changedYears.empty();
+}
+
+/**
+ * @brief Recomputes the totals of a year from its daily records
+ * @param year Calendar year
+ */
+void SensorExceedanceStore::RebuildYear(int year) {
+    Counters totals;
+    totals.exceedances.assign(GetLimitValues(paramCode).size(), 0);
+
+    std::string firstDay = std::to_string(year) + "-01-01";
+    std::string lastDay = std::to_string(year) + "-12-31";
+    for (auto it = days.lower_bound(firstDay); it != days.end() && it->first <= lastDay; ++it) {
+        totals.hours += it->second.hours;
+        totals.sum += it->second.sum;
+        for (size_t l = 0; l < totals.exceedances.size() && l < it->second.exceedances.size(); l++) {
+            totals.exceedances[l] += it->second.exceedances[l];
+        }
+    }
+    years[year] = totals;
+}
+
+/**
+ * @brief Gets the exceedance counters of a year
+ * @param year Calendar year
+ * @param result [out] Counters of every limit value of the parameter
+ * @return true if the year has stored data, false otherwise
+ *
+ * Reads only the stored yearly totals, independent of how much data the year holds.
+ */
+bool SensorExceedanceStore::Query(int year, YearlyExceedances& result) const {
+    auto it = years.find(year);
+    if (it == years.end()) {
+        return false;
+    }
+
+    const Counters& totals = it->second;
+    const std::vector<LimitValue>& limits = GetLimitValues(paramCode);
+
+    result.year = year;
+    result.hours = totals.hours;
+    result.limits.clear();
+    for (size_t l = 0; l < limits.size(); l++) {
+        ExceedanceSummary summary;
+        summary.limit = limits[l];
+        if (limits[l].period == AveragingPeriod::Year) {
+            summary.mean = (totals.hours > 0) ? totals.sum / static_cast<double>(totals.hours) : 0.0;
+            summary.breached = totals.hours > 0 && summary.mean > limits[l].threshold;
+        }
+        else {
+            summary.count = (l < totals.exceedances.size()) ? totals.exceedances[l] : 0;
+            summary.breached = summary.count > limits[l].allowedPerYear;
+        }
+        result.limits.push_back(summary);
+    }
+    return true;
+}
+
+/**
+ * @brief Updates the exceedance store of a sensor with freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param paramCode Parameter code of the sensor
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return true if the store was updated successfully, false otherwise
+ *
+ * The caller holds LockSensorStore() of the sensor directory.
+ */
+bool UpdateSensorExceedanceStore(const std::string& sensorDirectory, const std::string& paramCode, const std::vector<std::pair<std::string, double>>& data) {
+    SensorExceedanceStore store;
+    store.Load(sensorDirectory);
+    if (!store.Ingest(paramCode, data)) {
+        return true;
+    }
+    return store.Save(sensorDirectory);
+}
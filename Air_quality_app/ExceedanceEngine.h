@@ -0,0 +1,143 @@
+#ifndef EXCEEDANCE_ENGINE_H
+#define EXCEEDANCE_ENGINE_H
+
+#include <json/json.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file ExceedanceEngine.h
+ * @brief Legal limit values per parameter and per-sensor store of exceedance counters
+ */
+
+ /**
+  * @brief Averaging period a limit value applies to
+  */
+enum class AveragingPeriod {
+    Hour,           /**< Hourly mean */
+    Day,            /**< Calendar day mean (valid with at least 18 hours) */
+    MaxDaily8Hour,  /**< Maximum daily 8-hour running mean (windows valid with at least 6 hours) */
+    Year            /**< Calendar year mean */
+};
+
+/**
+ * @struct LimitValue
+ * @brief Legal threshold of a parameter (Directive 2008/50/EC as adopted in Poland)
+ */
+struct LimitValue {
+    std::string name;        /**< Description (e.g. "daily limit value") */
+    AveragingPeriod period;  /**< Averaging period of the threshold */
+    double threshold;        /**< Threshold in ug/m3 */
+    int allowedPerYear;      /**< Number of exceedances permitted per calendar year (ignored for annual limits) */
+};
+
+/**
+ * @brief Gets the limit values of a parameter
+ * @param paramCode Parameter code from sensors.json (e.g. "PM10", "NO2")
+ * @return Limit values of the parameter, empty if the parameter is not regulated
+ */
+const std::vector<LimitValue>& GetLimitValues(const std::string& paramCode);
+
+/**
+ * @struct ExceedanceSummary
+ * @brief Exceedances of one limit value within a calendar year
+ */
+struct ExceedanceSummary {
+    LimitValue limit;       /**< Limit value */
+    long long count = 0;    /**< Exceedance hours (hourly limits) or days (daily and 8-hour limits) */
+    double mean = 0.0;      /**< Annual mean for annual limits, 0 otherwise */
+    bool breached = false;  /**< Whether the limit is breached (more exceedances than permitted, or annual mean above threshold) */
+};
+
+/**
+ * @struct YearlyExceedances
+ * @brief Exceedance counters of a sensor for one calendar year
+ */
+struct YearlyExceedances {
+    int year = 0;                            /**< Calendar year */
+    long long hours = 0;                     /**< Number of measured hours in the year */
+    std::vector<ExceedanceSummary> limits;   /**< One entry per limit value of the parameter */
+};
+
+/**
+ * @class SensorExceedanceStore
+ * @brief Per-sensor store of daily exceedance records and yearly counters
+ *
+ * Every day keeps its own contribution (measured hours, sum and exceedances per limit),
+ * and every year keeps the totals of its days. Questions such as "how many PM10 daily
+ * exceedances this year" are answered from the yearly counters without reading any
+ * measurement file. Load and Save must be called under LockSensorStore() of the sensor
+ * directory.
+ */
+class SensorExceedanceStore {
+public:
+    /**
+     * @brief Loads the store from a sensor directory
+     * @param sensorDirectory Directory containing the sensor's measurement files
+     * @return true if a stored counter file was found and parsed, false otherwise
+     */
+    bool Load(const std::string& sensorDirectory);
+
+    /**
+     * @brief Saves the store into the sensor directory
+     * @param sensorDirectory Directory containing the sensor's measurement files
+     * @return true if the store was written successfully, false otherwise
+     */
+    bool Save(const std::string& sensorDirectory) const;
+
+    /**
+     * @brief Updates the counters with measurements
+     * @param paramCode Parameter code of the sensor, selecting its limit values
+     * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+     * @return true if any counter changed, false otherwise
+     */
+    bool Ingest(const std::string& paramCode, const std::vector<std::pair<std::string, double>>& data);
+
+    /**
+     * @brief Gets the exceedance counters of a year
+     * @param year Calendar year
+     * @param result [out] Counters of every limit value of the parameter
+     * @return true if the year has stored data, false otherwise
+     */
+    bool Query(int year, YearlyExceedances& result) const;
+
+    /**
+     * @brief Gets the parameter code the counters were computed for
+     * @return Parameter code, empty if nothing was ingested
+     */
+    const std::string& GetParamCode() const { return paramCode; }
+
+private:
+    /**
+     * @struct Counters
+     * @brief Measured hours, sum of values and exceedances per limit of a day or a year
+     */
+    struct Counters {
+        long long hours = 0;                 /**< Number of measured hours */
+        double sum = 0.0;                    /**< Sum of the hourly values */
+        std::vector<long long> exceedances;  /**< Exceedance hours or days per limit value */
+    };
+
+    std::string paramCode;                /**< Parameter code selecting the limit values */
+    std::map<std::string, Counters> days; /**< Daily records keyed by "YYYY-MM-DD" */
+    std::map<int, Counters> years;        /**< Yearly totals keyed by year */
+
+    /**
+     * @brief Recomputes the totals of a year from its daily records
+     * @param year Calendar year
+     */
+    void RebuildYear(int year);
+};
+
+/**
+ * @brief Updates the exceedance store of a sensor with freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param paramCode Parameter code of the sensor
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return true if the store was updated successfully, false otherwise
+ */
+bool UpdateSensorExceedanceStore(const std::string& sensorDirectory, const std::string& paramCode, const std::vector<std::pair<std::string, double>>& data);
+
+#endif // EXCEEDANCE_ENGINE_H
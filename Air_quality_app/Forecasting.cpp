@@ -0,0 +1,406 @@
+/**
+ * @file Forecasting.cpp
+ * @brief Implementation of the Holt-Winters forecasting model
+ */
+
+#include "Forecasting.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <utility>
+
+#include "JsonFiles.h"
+#include "SensorCatalog.h"
+
+namespace {
+    const std::string FORECAST_STORE_DIRECTORY = "store";       ///< Subdirectory of a sensor directory holding derived data
+    const std::string FORECAST_STORE_FILE = "forecast.json";    ///< File name of the stored model
+    const size_t FIT_WINDOW_HOURS = 28 * 24;                    ///< Recent hours used to fit the model
+    const size_t MIN_FIT_HOURS = 3 * 24;                        ///< Fewest hours needed: two days to initialize, one to score
+    const long long MAX_BRIDGED_GAP_HOURS = 72;                 ///< Longest outage an update may bridge before a refit is needed
+    const double ERROR_WEIGHT = 1.0 / 168.0;                    ///< Weight of a new error in the error variance (about one week)
+
+    const double ALPHA_GRID[] = { 0.05, 0.1, 0.2, 0.3, 0.5, 0.7 }; ///< Candidate level smoothing factors
+    const double BETA_GRID[] = { 0.0, 0.005, 0.02 };               ///< Candidate trend smoothing factors
+    const double GAMMA_GRID[] = { 0.05, 0.1, 0.2, 0.3 };           ///< Candidate seasonal smoothing factors
+
+    /**
+     * @brief Gets the hour of day of an absolute hour
+     */
+    size_t HourOfDay(long long hour) {
+        long long remainder = hour % HoltWintersModel::SEASON_LENGTH;
+        return static_cast<size_t>(remainder < 0 ? remainder + HoltWintersModel::SEASON_LENGTH : remainder);
+    }
+}
+
+/**
+ * @brief Advances a state by one hour
+ * @param state State to update
+ * @param hour Hour being processed
+ * @param value Measured value, or MISSING_VALUE to advance with the prediction
+ * @return One-step-ahead prediction error (0 for a missing value)
+ *
+ * A missing value is treated as if the prediction had been measured, which leaves
+ * trend and seasonal components unchanged and moves the level along the trend.
+ */
+double HoltWintersModel::Step(State& state, long long hour, double value) {
+    double& season = state.seasonal[HourOfDay(hour)];
+    double previousLevel = state.level;
+    if (IsMissingValue(value)) {
+        state.level += state.trend;
+        return 0.0;
+    }
+
+    double error = value - (state.level + state.trend + season);
+    state.level = state.alpha * (value - season) + (1.0 - state.alpha) * (previousLevel + state.trend);
+    state.trend = state.beta * (state.level - previousLevel) + (1.0 - state.beta) * state.trend;
+    season = state.gamma * (value - state.level) + (1.0 - state.gamma) * season;
+    return error;
+}
+
+/**
+ * @brief Sets initial level, trend and seasonal components from the first two days of a series
+ * @param state State to initialize (parameters are kept)
+ * @param series Measurements aligned to an hourly grid
+ * @param begin Index of the first slot used
+ * @return false if either of the two days has no measurement, true otherwise
+ *
+ * The trend is the difference of the two daily means, the seasonal component of an
+ * hour of day is its average deviation from the daily mean, and the level is placed
+ * just before the first slot.
+ */
+bool HoltWintersModel::Initialize(State& state, const HourlySeries& series, size_t begin) {
+    double dayMean[2] = { 0.0, 0.0 };
+    for (size_t day = 0; day < 2; day++) {
+        size_t count = 0;
+        for (size_t i = begin + day * SEASON_LENGTH; i < begin + (day + 1) * SEASON_LENGTH; i++) {
+            if (!IsMissingValue(series.values[i])) {
+                dayMean[day] += series.values[i];
+                count++;
+            }
+        }
+        if (count == 0) {
+            return false;
+        }
+        dayMean[day] /= static_cast<double>(count);
+    }
+
+    std::array<double, SEASON_LENGTH> deviationSum{};
+    std::array<int, SEASON_LENGTH> deviationCount{};
+    for (size_t i = begin; i < begin + 2 * SEASON_LENGTH; i++) {
+        if (!IsMissingValue(series.values[i])) {
+            size_t hourOfDay = HourOfDay(series.HourAt(i));
+            deviationSum[hourOfDay] += series.values[i] - dayMean[(i - begin) / SEASON_LENGTH];
+            deviationCount[hourOfDay]++;
+        }
+    }
+
+    // Center the seasonal components so that they do not shift the level
+    double seasonalMean = 0.0;
+    for (size_t h = 0; h < SEASON_LENGTH; h++) {
+        state.seasonal[h] = deviationCount[h] > 0 ? deviationSum[h] / deviationCount[h] : 0.0;
+        seasonalMean += state.seasonal[h];
+    }
+    seasonalMean /= SEASON_LENGTH;
+    for (double& season : state.seasonal) {
+        season -= seasonalMean;
+    }
+
+    state.trend = (dayMean[1] - dayMean[0]) / SEASON_LENGTH;
+    state.level = dayMean[0] - state.trend * (SEASON_LENGTH + 1) / 2.0;
+    return true;
+}
+
+/**
+ * @brief Fits the model to the recent part of a series
+ * @param series Measurements aligned to an hourly grid
+ * @return true if the series has enough measurements for a fit, false otherwise
+ *
+ * This function:
+ * 1. Takes the last four weeks of the series (or the whole series if shorter)
+ * 2. Initializes the components from the first two days of that window
+ * 3. Runs every candidate parameter set over the window and scores the one-step errors
+ *    after the initialization days, abandoning a candidate once it is worse than the best
+ * 4. Runs the best candidate again to obtain the final state and error variance
+ */
+bool HoltWintersModel::Fit(const HourlySeries& series) {
+    fitted = false;
+    const size_t size = series.values.size();
+    if (size < MIN_FIT_HOURS) {
+        return false;
+    }
+    const size_t begin = size > FIT_WINDOW_HOURS ? size - FIT_WINDOW_HOURS : 0;
+    const size_t scoredFrom = begin + 2 * SEASON_LENGTH;
+
+    State initial;
+    if (!Initialize(initial, series, begin)) {
+        return false;
+    }
+
+    // Grid search over the smoothing factors
+    double bestError = std::numeric_limits<double>::max();
+    State best = initial;
+    for (double alpha : ALPHA_GRID) {
+        for (double beta : BETA_GRID) {
+            for (double gamma : GAMMA_GRID) {
+                State candidate = initial;
+                candidate.alpha = alpha;
+                candidate.beta = beta;
+                candidate.gamma = gamma;
+
+                double squaredError = 0.0;
+                for (size_t i = begin; i < size && squaredError < bestError; i++) {
+                    double error = Step(candidate, series.HourAt(i), series.values[i]);
+                    if (i >= scoredFrom) {
+                        squaredError += error * error;
+                    }
+                }
+                if (squaredError < bestError) {
+                    bestError = squaredError;
+                    best.alpha = alpha;
+                    best.beta = beta;
+                    best.gamma = gamma;
+                }
+            }
+        }
+    }
+
+    // Run the chosen parameters to the end of the series
+    size_t scoredCount = 0;
+    double squaredError = 0.0;
+    for (size_t i = begin; i < size; i++) {
+        double error = Step(best, series.HourAt(i), series.values[i]);
+        if (i >= scoredFrom && !IsMissingValue(series.values[i])) {
+            squaredError += error * error;
+            scoredCount++;
+        }
+    }
+    if (scoredCount == 0) {
+        return false;
+    }
+
+    state = best;
+    lastHour = series.HourAt(size - 1);
+    errorVariance = squaredError / static_cast<double>(scoredCount);
+    fitted = true;
+    return true;
+}
+
+/**
+ * @brief Updates the model with a new measurement
+ * @param hour Hour of the measurement (since 1970-01-01 00:00)
+ * @param value Measured value (MISSING_VALUE advances the model without correcting it)
+ * @return false if the model is not fitted or the gap since the last update is too long to bridge, true otherwise
+ *
+ * Costs one step per hour since the last update, independent of the series length.
+ */
+bool HoltWintersModel::Update(long long hour, double value) {
+    if (!fitted) {
+        return false;
+    }
+    if (hour <= lastHour) {
+        return true;
+    }
+    if (hour - lastHour > MAX_BRIDGED_GAP_HOURS) {
+        return false;
+    }
+
+    for (long long skipped = lastHour + 1; skipped < hour; skipped++) {
+        Step(state, skipped, MISSING_VALUE);
+    }
+    double error = Step(state, hour, value);
+    if (!IsMissingValue(value)) {
+        errorVariance = (1.0 - ERROR_WEIGHT) * errorVariance + ERROR_WEIGHT * error * error;
+    }
+    lastHour = hour;
+    return true;
+}
+
+/**
+ * @brief Predicts the hours following the last processed hour
+ * @param hours Number of hours to predict
+ * @param z Width of the confidence band in standard deviations (1.96 for 95%)
+ * @return Forecast starting at GetLastHour() + 1 (empty if the model is not fitted)
+ *
+ * The band widens with the horizon using the prediction variance of the additive
+ * model: sigma^2 * (1 + sum of c_j^2 for j < h), with c_j = alpha * (1 + j * beta)
+ * plus gamma for whole seasons. Concentrations cannot be negative, so all values
+ * are clipped at zero.
+ */
+Forecast HoltWintersModel::Predict(int hours, double z) const {
+    Forecast forecast;
+    if (!fitted || hours <= 0) {
+        return forecast;
+    }
+
+    forecast.startHour = lastHour + 1;
+    forecast.values.reserve(hours);
+    forecast.lower.reserve(hours);
+    forecast.upper.reserve(hours);
+
+    double varianceFactor = 1.0;
+    for (int h = 1; h <= hours; h++) {
+        if (h > 1) {
+            int j = h - 1;
+            double c = state.alpha * (1.0 + j * state.beta) + (j % SEASON_LENGTH == 0 ? state.gamma : 0.0);
+            varianceFactor += c * c;
+        }
+
+        double value = state.level + h * state.trend + state.seasonal[HourOfDay(lastHour + h)];
+        double margin = z * std::sqrt(errorVariance * varianceFactor);
+        forecast.values.push_back(std::max(0.0, value));
+        forecast.lower.push_back(std::max(0.0, value - margin));
+        forecast.upper.push_back(std::max(0.0, value + margin));
+    }
+    return forecast;
+}
+
+/**
+ * @brief Gets the standard deviation of the one-step-ahead prediction errors
+ * @return Exponentially weighted error standard deviation
+ */
+double HoltWintersModel::GetErrorStdDev() const {
+    return std::sqrt(errorVariance);
+}
+
+/**
+ * @brief Serializes the model state
+ * @return JSON object with parameters and state
+ */
+Json::Value HoltWintersModel::ToJson() const {
+    Json::Value json;
+    json["alpha"] = state.alpha;
+    json["beta"] = state.beta;
+    json["gamma"] = state.gamma;
+    json["level"] = state.level;
+    json["trend"] = state.trend;
+    json["lastHour"] = static_cast<Json::Int64>(lastHour);
+    json["errorVariance"] = errorVariance;
+
+    Json::Value seasonal(Json::arrayValue);
+    for (double season : state.seasonal) {
+        seasonal.append(season);
+    }
+    json["seasonal"] = seasonal;
+    return json;
+}
+
+/**
+ * @brief Restores the model state
+ * @param json Object written by ToJson()
+ * @return true if the object holds a complete model, false otherwise
+ */
+bool HoltWintersModel::FromJson(const Json::Value& json) {
+    fitted = false;
+    const Json::Value& seasonal = json["seasonal"];
+    if (!json.isMember("level") || !json.isMember("lastHour") || !seasonal.isArray() || seasonal.size() != SEASON_LENGTH) {
+        return false;
+    }
+
+    state.alpha = json["alpha"].asDouble();
+    state.beta = json["beta"].asDouble();
+    state.gamma = json["gamma"].asDouble();
+    state.level = json["level"].asDouble();
+    state.trend = json["trend"].asDouble();
+    for (Json::Value::ArrayIndex i = 0; i < seasonal.size(); i++) {
+        state.seasonal[i] = seasonal[i].asDouble();
+    }
+    lastHour = json["lastHour"].asInt64();
+    errorVariance = json["errorVariance"].asDouble();
+    fitted = true;
+    return true;
+}
+
+/**
+ * @brief Loads the model stored in "store/forecast.json" inside the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @return true if a fitted model was found and parsed, false otherwise
+ */
+bool HoltWintersModel::Load(const std::string& sensorDirectory) {
+    fitted = false;
+    Json::Value root;
+    std::string path = sensorDirectory + "/" + FORECAST_STORE_DIRECTORY + "/" + FORECAST_STORE_FILE;
+    if (!std::filesystem::exists(path) || !LoadJsonFromFile(path, root)) {
+        return false;
+    }
+    return FromJson(root);
+}
+
+/**
+ * @brief Writes the model into "store/forecast.json" inside the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @return true if the model was written successfully, false otherwise
+ */
+bool HoltWintersModel::Save(const std::string& sensorDirectory) const {
+    if (!fitted) {
+        return false;
+    }
+    std::string storeDirectory = sensorDirectory + "/" + FORECAST_STORE_DIRECTORY;
+    Json::Value root = ToJson();
+    try {
+        std::filesystem::create_directories(storeDirectory);
+        return SaveToFile(root, storeDirectory + "/" + FORECAST_STORE_FILE);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Brings the stored model of a sensor up to the end of a series
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param series Measurements aligned to an hourly grid
+ * @param model [out] Model whose last processed hour is the last hour of the series
+ * @return true if the model is ready for a forecast, false if the series is too short to fit one
+ *
+ * A stored model that ends within the series (or shortly before it) is advanced over the
+ * newer hours. Otherwise (no model, a model ahead of the series, or a gap too long to
+ * bridge) the model is fitted on the series itself. Nothing is written to disk.
+ */
+bool PrepareForecastModel(const std::string& sensorDirectory, const HourlySeries& series, HoltWintersModel& model) {
+    if (series.values.empty()) {
+        return false;
+    }
+    const long long lastSeriesHour = series.HourAt(series.values.size() - 1);
+
+    bool ready = model.Load(sensorDirectory) && model.GetLastHour() <= lastSeriesHour;
+    if (ready) {
+        size_t first = model.GetLastHour() < series.startHour ? 0 : static_cast<size_t>(model.GetLastHour() + 1 - series.startHour);
+        for (size_t i = first; i < series.values.size() && ready; i++) {
+            ready = model.Update(series.HourAt(i), series.values[i]);
+        }
+    }
+    return ready || model.Fit(series);
+}
+
+/**
+ * @brief Updates the stored forecast model of a sensor with freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param series Downloaded measurements aligned to an hourly grid
+ * @return true if the model was updated successfully, false otherwise
+ *
+ * The caller holds LockSensorStore() of the sensor directory.
+ */
+bool UpdateSensorForecastModel(const std::string& sensorDirectory, const HourlySeries& series) {
+    if (series.values.empty()) {
+        return false;
+    }
+
+    // Keep a model that is already ahead of the downloaded data
+    HoltWintersModel model;
+    bool stored = model.Load(sensorDirectory);
+    if (stored && model.GetLastHour() >= series.HourAt(series.values.size() - 1)) {
+        return true;
+    }
+
+    // A single download rarely holds MIN_FIT_HOURS after nulls are dropped, so a missing
+    // model is fitted on the whole stored history, which already includes the download
+    if (!stored || !PrepareForecastModel(sensorDirectory, series, model)) {
+        if (!model.Fit(LoadSensorHistory(sensorDirectory, nullptr))) {
+            return false;
+        }
+    }
+    return model.Save(sensorDirectory);
+}
@@ -0,0 +1,186 @@
+#ifndef FORECASTING_H
+#define FORECASTING_H
+
+#include <json/json.h>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "TimeSeries.h"
+
+/**
+ * @file Forecasting.h
+ * @brief Short-term forecasts of hourly series with an additive Holt-Winters model
+ */
+
+ /**
+  * @brief Number of hours predicted after the last measurement
+  */
+const int FORECAST_HORIZON_HOURS = 48;
+
+/**
+ * @struct Forecast
+ * @brief Predicted values with a confidence band for consecutive hours
+ */
+struct Forecast {
+    long long startHour = 0;       /**< Hour (since 1970-01-01 00:00) of the first predicted value */
+    std::vector<double> values;    /**< Point forecast per hour (never negative) */
+    std::vector<double> lower;     /**< Lower bound of the confidence band per hour (never negative) */
+    std::vector<double> upper;     /**< Upper bound of the confidence band per hour */
+};
+
+/**
+ * @class HoltWintersModel
+ * @brief Additive Holt-Winters model (level, trend and 24-hour seasonality)
+ *
+ * The model is fitted once on the recent part of a series; afterwards every new
+ * hourly measurement updates level, trend and the seasonal component of its hour
+ * of day in constant time, so the model follows new data without a refit.
+ * The seasonal components are indexed by the hour of day (hour % 24).
+ */
+class HoltWintersModel {
+public:
+    static const int SEASON_LENGTH = 24; /**< Length of the seasonal cycle in hours */
+
+    /**
+     * @brief Fits the model to the recent part of a series
+     *
+     * Chooses the smoothing parameters with the smallest one-step-ahead squared error
+     * over the last four weeks of the series, then runs the model up to the last hour.
+     *
+     * @param series Measurements aligned to an hourly grid
+     * @return true if the series has enough measurements for a fit, false otherwise
+     */
+    bool Fit(const HourlySeries& series);
+
+    /**
+     * @brief Updates the model with a new measurement
+     *
+     * Hours skipped since the last update are filled with the model's own prediction.
+     * Measurements at or before the last processed hour are ignored, so data that was
+     * already seen can be passed again.
+     *
+     * @param hour Hour of the measurement (since 1970-01-01 00:00)
+     * @param value Measured value (MISSING_VALUE advances the model without correcting it)
+     * @return false if the model is not fitted or the gap since the last update is too long to bridge, true otherwise
+     */
+    bool Update(long long hour, double value);
+
+    /**
+     * @brief Predicts the hours following the last processed hour
+     * @param hours Number of hours to predict
+     * @param z Width of the confidence band in standard deviations (1.96 for 95%)
+     * @return Forecast starting at GetLastHour() + 1 (empty if the model is not fitted)
+     */
+    Forecast Predict(int hours, double z = 1.96) const;
+
+    /**
+     * @brief Checks whether the model has been fitted
+     * @return true if Fit() succeeded or a fitted model was loaded, false otherwise
+     */
+    bool IsFitted() const { return fitted; }
+
+    /**
+     * @brief Gets the last hour processed by the model
+     * @return Hours since 1970-01-01 00:00
+     */
+    long long GetLastHour() const { return lastHour; }
+
+    /**
+     * @brief Gets the standard deviation of the one-step-ahead prediction errors
+     * @return Exponentially weighted error standard deviation
+     */
+    double GetErrorStdDev() const;
+
+    /**
+     * @brief Serializes the model state
+     * @return JSON object with parameters and state
+     */
+    Json::Value ToJson() const;
+
+    /**
+     * @brief Restores the model state
+     * @param json Object written by ToJson()
+     * @return true if the object holds a complete model, false otherwise
+     */
+    bool FromJson(const Json::Value& json);
+
+    /**
+     * @brief Loads the model stored in a sensor directory
+     * @param sensorDirectory Directory containing the sensor's measurement files
+     * @return true if a fitted model was found and parsed, false otherwise
+     */
+    bool Load(const std::string& sensorDirectory);
+
+    /**
+     * @brief Saves the model into the sensor directory
+     * @param sensorDirectory Directory containing the sensor's measurement files
+     * @return true if the model was written successfully, false otherwise
+     */
+    bool Save(const std::string& sensorDirectory) const;
+
+private:
+    /**
+     * @struct State
+     * @brief Smoothing parameters and components of the model
+     */
+    struct State {
+        double alpha = 0.0;                            /**< Level smoothing factor */
+        double beta = 0.0;                             /**< Trend smoothing factor */
+        double gamma = 0.0;                            /**< Seasonal smoothing factor */
+        double level = 0.0;                            /**< Current level */
+        double trend = 0.0;                            /**< Current trend per hour */
+        std::array<double, SEASON_LENGTH> seasonal{};  /**< Seasonal component per hour of day */
+    };
+
+    State state;                 /**< Parameters and components */
+    long long lastHour = 0;      /**< Last hour processed */
+    double errorVariance = 0.0;  /**< Exponentially weighted variance of the one-step errors */
+    bool fitted = false;         /**< Whether the model holds a fitted state */
+
+    /**
+     * @brief Advances a state by one hour
+     * @param state State to update
+     * @param hour Hour being processed
+     * @param value Measured value, or MISSING_VALUE to advance with the prediction
+     * @return One-step-ahead prediction error (0 for a missing value)
+     */
+    static double Step(State& state, long long hour, double value);
+
+    /**
+     * @brief Sets initial level, trend and seasonal components from the first two days of a series
+     * @param state State to initialize (parameters are kept)
+     * @param series Measurements aligned to an hourly grid
+     * @param begin Index of the first slot used
+     * @return false if either of the two days has no measurement, true otherwise
+     */
+    static bool Initialize(State& state, const HourlySeries& series, size_t begin);
+};
+
+/**
+ * @brief Brings the stored model of a sensor up to the end of a series
+ *
+ * A stored model ending within the series is advanced over the newer hours only;
+ * otherwise the model is fitted on the series. The stored model is not modified.
+ *
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param series Measurements aligned to an hourly grid
+ * @param model [out] Model whose last processed hour is the last hour of the series
+ * @return true if the model is ready for a forecast, false if the series is too short to fit one
+ */
+bool PrepareForecastModel(const std::string& sensorDirectory, const HourlySeries& series, HoltWintersModel& model);
+
+/**
+ * @brief Updates the stored forecast model of a sensor with freshly downloaded values
+ *
+ * The stored model is advanced over the new hours only. If the new data does not connect
+ * to it, the model is fitted on the downloaded values. If there is no model yet, or the
+ * download is too short to fit one, the model is fitted on all stored measurement files.
+ *
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param series Downloaded measurements aligned to an hourly grid
+ * @return true if the model was updated successfully, false otherwise
+ */
+bool UpdateSensorForecastModel(const std::string& sensorDirectory, const HourlySeries& series);
+
+#endif // FORECASTING_H
@@ -0,0 +1,179 @@
+/**
+ * @file HourlyRingBuffer.cpp
+ * @brief Implementation of the HourlyRingBuffer class
+ */
+
+#include "HourlyRingBuffer.h"
+
+#include <algorithm>
+
+/**
+ * @brief Creates an empty buffer without capacity
+ */
+HourlyRingBuffer::HourlyRingBuffer() : head(0), count(0), firstHour(0) {
+}
+
+/**
+ * @brief Replaces the contents with the newest hours of a series
+ * @param series Series to copy
+ * @param capacity Number of hours the buffer holds (0 to use the series length)
+ *
+ * The kept hours are stored from slot 0 on and the pyramid is built once over all
+ * slots, including the still unused ones.
+ */
+void HourlyRingBuffer::Assign(const HourlySeries& series, size_t capacity) {
+    size_t length = series.values.size();
+    if (capacity == 0) {
+        capacity = length;
+    }
+    size_t kept = std::min(length, capacity);
+    size_t offset = length - kept;
+
+    slots.assign(capacity, MISSING_VALUE);
+    std::copy(series.values.begin() + offset, series.values.end(), slots.begin());
+    head = 0;
+    count = kept;
+    firstHour = series.startHour + static_cast<long long>(offset);
+    pyramid.Build(slots.size(), [this](size_t slot) { return slots[slot]; });
+}
+
+/**
+ * @brief Writes a slot and updates the pyramid
+ * @param slot Ring slot
+ * @param value Value to store
+ */
+void HourlyRingBuffer::Write(size_t slot, double value) {
+    slots[slot] = value;
+    pyramid.Update(slot, value);
+}
+
+/**
+ * @brief Stores the value of an hour
+ * @param hour Hour (since 1970-01-01 00:00) of the value
+ * @param value Measured value
+ * @return Number of hours the newest end advanced by
+ *
+ * This function:
+ * 1. Overwrites the slot of an hour already held, ignores hours before the oldest one
+ * 2. Otherwise writes NaN for the skipped hours and the value for the new one, each
+ *    taking the next free slot or, once the ring is full, the slot of the oldest hour
+ * 3. Restarts the ring when the new hour is more than a full capacity ahead, since
+ *    none of the held hours would remain
+ */
+size_t HourlyRingBuffer::Append(long long hour, double value) {
+    if (slots.empty()) {
+        return 0;
+    }
+    if (count == 0) {
+        head = 0;
+        count = 1;
+        firstHour = hour;
+        Write(0, value);
+        return 1;
+    }
+    if (hour < firstHour) {
+        return 0;
+    }
+    if (hour <= LastHour()) {
+        Write(SlotOf(static_cast<size_t>(hour - firstHour)), value);
+        return 0;
+    }
+
+    size_t advance = static_cast<size_t>(hour - LastHour());
+    if (advance >= slots.size()) {
+        std::fill(slots.begin(), slots.end(), MISSING_VALUE);
+        slots.back() = value;
+        pyramid.Build(slots.size(), [this](size_t slot) { return slots[slot]; });
+        head = 0;
+        count = slots.size();
+        firstHour = hour - static_cast<long long>(slots.size()) + 1;
+        return advance;
+    }
+
+    for (size_t step = 1; step <= advance; step++) {
+        double stored = (step == advance) ? value : MISSING_VALUE;
+        if (count < slots.size()) {
+            Write(SlotOf(count), stored);
+            count++;
+        }
+        else {
+            Write(head, stored);
+            head = (head + 1) % slots.size();
+            firstHour++;
+        }
+    }
+    return advance;
+}
+
+/**
+ * @brief Finds the extremes of the measured values in a range of indices
+ * @param begin First index of the range
+ * @param end Index past the end of the range (clamped to Size())
+ * @param min [out] Smallest value
+ * @param max [out] Largest value
+ * @return true if the range contains a measured value, false otherwise
+ *
+ * A range that wraps around the end of the ring is queried as two slot ranges.
+ */
+bool HourlyRingBuffer::Range(size_t begin, size_t end, double& min, double& max) const {
+    end = std::min(end, count);
+    if (begin >= end) {
+        return false;
+    }
+
+    size_t first = SlotOf(begin);
+    size_t length = end - begin;
+    if (first + length <= slots.size()) {
+        return pyramid.Range(first, first + length, min, max);
+    }
+
+    double minA, maxA, minB, maxB;
+    bool foundA = pyramid.Range(first, slots.size(), minA, maxA);
+    bool foundB = pyramid.Range(0, first + length - slots.size(), minB, maxB);
+    if (!foundA && !foundB) {
+        return false;
+    }
+    min = foundA ? (foundB ? std::min(minA, minB) : minA) : minB;
+    max = foundA ? (foundB ? std::max(maxA, maxB) : maxA) : maxB;
+    return true;
+}
+
+/**
+ * @brief Gets the min/max buckets of a range of indices for drawing
+ * @param begin First index of the range
+ * @param end Index past the end of the range (clamped to Size())
+ * @param maxBuckets Largest number of buckets wanted
+ * @param buckets [out] Buckets in time order, with minIndex and maxIndex counted from FirstHour()
+ *
+ * A range that wraps around the end of the ring is split into its two slot ranges,
+ * which share the bucket budget in proportion to their length. The slot indices of
+ * the buckets are translated back to indices counted from FirstHour().
+ */
+void HourlyRingBuffer::Envelope(size_t begin, size_t end, size_t maxBuckets, std::vector<MinMaxPyramid::Bucket>& buckets) const {
+    buckets.clear();
+    end = std::min(end, count);
+    if (begin >= end) {
+        return;
+    }
+
+    size_t first = SlotOf(begin);
+    size_t length = end - begin;
+    if (first + length <= slots.size()) {
+        pyramid.Envelope(first, first + length, maxBuckets, buckets);
+    }
+    else {
+        size_t lengthA = slots.size() - first;
+        size_t budgetA = std::max<size_t>(1, maxBuckets * lengthA / length);
+        std::vector<MinMaxPyramid::Bucket> wrapped;
+        pyramid.Envelope(first, slots.size(), budgetA, buckets);
+        pyramid.Envelope(0, length - lengthA, std::max<size_t>(1, maxBuckets - std::min(maxBuckets, budgetA)), wrapped);
+        buckets.insert(buckets.end(), wrapped.begin(), wrapped.end());
+    }
+
+    for (auto& bucket : buckets) {
+        if (!bucket.IsMissing()) {
+            bucket.minIndex = (bucket.minIndex + slots.size() - head) % slots.size();
+            bucket.maxIndex = (bucket.maxIndex + slots.size() - head) % slots.size();
+        }
+    }
+}
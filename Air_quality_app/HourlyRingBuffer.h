@@ -0,0 +1,131 @@
+#ifndef HOURLY_RING_BUFFER_H
+#define HOURLY_RING_BUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "MinMaxPyramid.h"
+#include "TimeSeries.h"
+
+/**
+ * @file HourlyRingBuffer.h
+ * @brief Fixed-capacity hourly series for live data
+ */
+
+ /**
+  * @class HourlyRingBuffer
+  * @brief The newest hours of a series in a ring of fixed capacity, with a min/max pyramid
+  *
+  * Values are indexed in time order: index 0 is FirstHour(), every further index one
+  * hour later, and missing hours hold NaN like in HourlySeries. Appending a newer hour
+  * fills the hours in between with NaN and, once the ring is full, drops the oldest
+  * ones, without moving the stored values. A min/max pyramid over the ring slots is
+  * updated with every write, so range and envelope queries of the chart stay
+  * O(log n) and O(buckets) however the data arrived.
+  */
+class HourlyRingBuffer {
+public:
+    /**
+     * @brief Creates an empty buffer without capacity
+     */
+    HourlyRingBuffer();
+
+    /**
+     * @brief Replaces the contents with the newest hours of a series
+     * @param series Series to copy
+     * @param capacity Number of hours the buffer holds (0 to use the series length)
+     */
+    void Assign(const HourlySeries& series, size_t capacity);
+
+    /**
+     * @brief Stores the value of an hour
+     *
+     * An hour after the newest one extends the buffer, dropping the oldest hours when
+     * it is full; an hour inside the buffer is overwritten (a corrected measurement);
+     * an hour before the oldest one is ignored.
+     *
+     * @param hour Hour (since 1970-01-01 00:00) of the value
+     * @param value Measured value
+     * @return Number of hours the newest end advanced by
+     */
+    size_t Append(long long hour, double value);
+
+    /**
+     * @brief Gets the number of hours held
+     * @return Number of hours from FirstHour() to LastHour()
+     */
+    size_t Size() const { return count; }
+
+    /**
+     * @brief Gets the number of hours the buffer can hold
+     * @return Capacity in hours
+     */
+    size_t Capacity() const { return slots.size(); }
+
+    /**
+     * @brief Checks whether the buffer holds no hour
+     * @return true if the buffer is empty, false otherwise
+     */
+    bool Empty() const { return count == 0; }
+
+    /**
+     * @brief Gets the oldest hour held
+     * @return Hour since 1970-01-01 00:00
+     */
+    long long FirstHour() const { return firstHour; }
+
+    /**
+     * @brief Gets the newest hour held
+     * @return Hour since 1970-01-01 00:00 (FirstHour() - 1 if empty)
+     */
+    long long LastHour() const { return firstHour + static_cast<long long>(count) - 1; }
+
+    /**
+     * @brief Gets the value of an hour by its index
+     * @param index Index counted from FirstHour()
+     * @return Value of the hour, NaN if it was not measured
+     */
+    double At(size_t index) const { return slots[SlotOf(index)]; }
+
+    /**
+     * @brief Finds the extremes of the measured values in a range of indices
+     * @param begin First index of the range
+     * @param end Index past the end of the range (clamped to Size())
+     * @param min [out] Smallest value
+     * @param max [out] Largest value
+     * @return true if the range contains a measured value, false otherwise
+     */
+    bool Range(size_t begin, size_t end, double& min, double& max) const;
+
+    /**
+     * @brief Gets the min/max buckets of a range of indices for drawing
+     * @param begin First index of the range
+     * @param end Index past the end of the range (clamped to Size())
+     * @param maxBuckets Largest number of buckets wanted
+     * @param buckets [out] Buckets in time order, with minIndex and maxIndex counted from FirstHour()
+     */
+    void Envelope(size_t begin, size_t end, size_t maxBuckets, std::vector<MinMaxPyramid::Bucket>& buckets) const;
+
+private:
+    std::vector<double> slots;  /**< Ring storage, one slot per hour of capacity */
+    size_t head;                /**< Slot of FirstHour() */
+    size_t count;               /**< Number of hours held */
+    long long firstHour;        /**< Oldest hour held */
+    MinMaxPyramid pyramid;      /**< Min/max pyramid over the slots (not the indices) */
+
+    /**
+     * @brief Maps an index counted from FirstHour() to its ring slot
+     * @param index Index of the hour
+     * @return Slot holding the hour
+     */
+    size_t SlotOf(size_t index) const { return (head + index) % slots.size(); }
+
+    /**
+     * @brief Writes a slot and updates the pyramid
+     * @param slot Ring slot
+     * @param value Value to store
+     */
+    void Write(size_t slot, double value);
+};
+
+#endif // HOURLY_RING_BUFFER_H
@@ -26,9 +26,33 @@ InfoPanel::InfoPanel(wxWindow* parent) : wxPanel(parent, wxID_ANY, wxDefaultPosi
     statsText = new wxStaticText(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize);
     statsText->SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
 
+    // Create distribution text control that will display the percentiles
+    distributionText = new wxStaticText(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize);
+    distributionText->SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+
+    // Create exceedance text control that will display the limit value exceedances
+    exceedanceText = new wxStaticText(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize);
+    exceedanceText->SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+
+    // Create index text control that will display the station air quality index
+    indexText = new wxStaticText(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize);
+    indexText->SetFont(wxFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+
+    // Create correlation text control with a monospaced font so the matrix columns line up
+    correlationText = new wxStaticText(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize);
+    correlationText->SetFont(wxFont(9, wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+
+    // Arrange result columns side by side
+    wxBoxSizer* columnsSizer = new wxBoxSizer(wxHORIZONTAL);
+    columnsSizer->Add(statsText, 1, wxALL | wxEXPAND, 10);
+    columnsSizer->Add(distributionText, 1, wxALL | wxEXPAND, 10);
+    columnsSizer->Add(exceedanceText, 1, wxALL | wxEXPAND, 10);
+    columnsSizer->Add(indexText, 1, wxALL | wxEXPAND, 10);
+    columnsSizer->Add(correlationText, 1, wxALL | wxEXPAND, 10);
+
     // Add title text and statistics to the panel
     sizer->Add(titleText, 0, wxALL, 10);
-    sizer->Add(statsText, 1, wxALL | wxEXPAND, 10);
+    sizer->Add(columnsSizer, 1, wxEXPAND);
 
     // Apply the sizer to layout the panel
     SetSizer(sizer);
@@ -57,4 +81,108 @@ void InfoPanel::UpdateStatistics(const wxString& key, double max, double min, do
     statsText->SetLabel(content);
     // Recalculate layout to accommodate the new text
     Layout();
+}
+
+/**
+ * @brief Updates the displayed percentiles of the pollutant values
+ * @param median Median (P50) of the values
+ * @param p95 95th percentile of the values
+ * @param p99 99th percentile of the values
+ * @param count Number of measurements the percentiles were estimated from
+ *
+ * Displays the percentiles estimated from the sensor's stored quantile sketches,
+ * which describe the distribution of values better than minimum and maximum alone.
+ */
+void InfoPanel::UpdateDistribution(double median, double p95, double p99, double count) {
+    wxString unit = wxT("\u03BCg / m\u00B3");  // Unicode for micrograms per meter cubed
+
+    wxString content = wxString::Format("percentiles (%.0f measurements):\nmedian: %.2f %s,\nP95: %.2f %s,\nP99: %.2f %s",
+        count, median, unit, p95, unit, p99, unit
+    );
+
+    distributionText->SetLabel(content);
+    // Recalculate layout to accommodate the new text
+    Layout();
+}
+
+/**
+ * @brief Updates the displayed limit value exceedances of the pollutant
+ * @param key Identifier of the pollutant being displayed
+ * @param exceedances Exceedance counters of the year
+ *
+ * Lists every limit value of the parameter with the number of exceedance hours or days
+ * in the year (or the annual mean for annual limits) and marks breached limits.
+ */
+void InfoPanel::UpdateExceedances(const wxString& key, const YearlyExceedances& exceedances) {
+    wxString unit = wxT("\u03BCg / m\u00B3");  // Unicode for micrograms per meter cubed
+
+    wxString content = wxString::Format("%s limit values in %d (%lld hours measured):", key, exceedances.year, exceedances.hours);
+    if (exceedances.limits.empty()) {
+        content += "\nno limit values for this parameter";
+    }
+
+    for (const auto& summary : exceedances.limits) {
+        const LimitValue& limit = summary.limit;
+        content += wxString::Format("\n%s %.0f %s: ", limit.name, limit.threshold, unit);
+
+        if (limit.period == AveragingPeriod::Year) {
+            content += wxString::Format("mean %.2f %s", summary.mean, unit);
+        }
+        else {
+            wxString units = (limit.period == AveragingPeriod::Hour) ? "hours" : "days";
+            content += wxString::Format("%lld %s", summary.count, units);
+            if (limit.allowedPerYear > 0) {
+                content += wxString::Format(" (%d allowed)", limit.allowedPerYear);
+            }
+        }
+
+        if (summary.breached) {
+            content += " - exceeded";
+        }
+    }
+
+    exceedanceText->SetLabel(content);
+    // Recalculate layout to accommodate the new text
+    Layout();
+}
+
+/**
+ * @brief Updates the displayed air quality index of a station
+ * @param stationName Name of the station
+ * @param timestamp Hour the index refers to
+ * @param levelName Name of the index level
+ * @param dominantPollutant Parameter code of the pollutant determining the index
+ * @param pollutantCount Number of pollutants taking part in the index
+ *
+ * The index of a station is the worst level of all its pollutants in the given hour,
+ * so the dominant pollutant is shown along with it.
+ */
+void InfoPanel::UpdateAirQualityIndex(const wxString& stationName, const wxString& timestamp, const wxString& levelName,
+    const wxString& dominantPollutant, int pollutantCount) {
+    wxString content = wxString::Format("air quality index (%s):\n%s: %s,\ndominant pollutant: %s,\nbased on %d pollutants",
+        stationName, timestamp, levelName, dominantPollutant, pollutantCount
+    );
+
+    indexText->SetLabel(content);
+    // Recalculate layout to accommodate the new text
+    Layout();
+}
+
+/**
+ * @brief Updates the displayed correlation matrix of a station's pollutants
+ * @param stationName Name of the station
+ * @param table Formatted correlation table (Pearson above, Spearman below the diagonal, hours per pair)
+ *
+ * Shows how strongly the pollutants of a station move together, next to the
+ * statistics of the selected sensor. Each pair is correlated over the hours in
+ * which both pollutants were measured.
+ */
+void InfoPanel::UpdateCorrelations(const wxString& stationName, const wxString& table) {
+    wxString content = wxString::Format("correlations (%s, each pair over the hours both were measured),\nPearson above / Spearman below diagonal:\n%s",
+        stationName, table
+    );
+
+    correlationText->SetLabel(content);
+    // Recalculate layout to accommodate the new text
+    Layout();
 }
\ No newline at end of file
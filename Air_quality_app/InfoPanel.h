@@ -4,6 +4,8 @@
 #include <wx/wx.h>
 #include <string>
 
+#include "ExceedanceEngine.h"
+
 /**
  * @file InfoPanel.h
  * @brief Header for the InfoPanel class which displays data analysis information
@@ -21,6 +23,10 @@ class InfoPanel : public wxPanel {
 private:
     wxStaticText* titleText; /**< Title text displayed at the top of the panel */
     wxStaticText* statsText; /**< Text control that displays the statistical information */
+    wxStaticText* distributionText; /**< Text control that displays the percentiles of the values */
+    wxStaticText* exceedanceText; /**< Text control that displays the limit value exceedances */
+    wxStaticText* indexText; /**< Text control that displays the air quality index of a station */
+    wxStaticText* correlationText; /**< Text control that displays the correlation matrix of a station */
 
 public:
     /**
@@ -44,6 +50,40 @@ public:
      * including its maximum, minimum, and average values, with appropriate units.
      */
     void UpdateStatistics(const wxString& key, double max, double min, double avg, const wxString& trend);
+
+    /**
+     * @brief Updates the displayed percentiles of the pollutant values
+     * @param median Median (P50) of the values
+     * @param p95 95th percentile of the values
+     * @param p99 99th percentile of the values
+     * @param count Number of measurements the percentiles were estimated from
+     */
+    void UpdateDistribution(double median, double p95, double p99, double count);
+
+    /**
+     * @brief Updates the displayed limit value exceedances of the pollutant
+     * @param key Identifier of the pollutant being displayed
+     * @param exceedances Exceedance counters of the year
+     */
+    void UpdateExceedances(const wxString& key, const YearlyExceedances& exceedances);
+
+    /**
+     * @brief Updates the displayed air quality index of a station
+     * @param stationName Name of the station
+     * @param timestamp Hour the index refers to
+     * @param levelName Name of the index level
+     * @param dominantPollutant Parameter code of the pollutant determining the index
+     * @param pollutantCount Number of pollutants taking part in the index
+     */
+    void UpdateAirQualityIndex(const wxString& stationName, const wxString& timestamp, const wxString& levelName,
+        const wxString& dominantPollutant, int pollutantCount);
+
+    /**
+     * @brief Updates the displayed correlation matrix of a station's pollutants
+     * @param stationName Name of the station
+     * @param table Formatted correlation table (Pearson above, Spearman below the diagonal, hours per pair)
+     */
+    void UpdateCorrelations(const wxString& stationName, const wxString& table);
 };
 
 #endif // INFO_PANEL_H
\ No newline at end of file
@@ -0,0 +1,75 @@
+/**
+ * @file JsonFiles.cpp
+ * @brief Implementation of the JSON file helpers
+ */
+
+#include "JsonFiles.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * @brief Saves JSON data to a file with indentation
+ * @param data Json::Value object to save
+ * @param filePath Path where the file will be saved
+ * @return true if successful, false otherwise
+ * @throw std::runtime_error if the file cannot be written
+ *
+ * Writes JSON data to a file with proper indentation for readability. The data is first
+ * written to a temporary file next to the target, which then replaces the target, so a
+ * concurrent reader never sees a truncated file.
+ */
+bool SaveToFile(Json::Value& data, const std::string& filePath) {
+    // Open a temporary file next to the target for writing
+    std::string temporaryPath = filePath + ".tmp";
+    std::ofstream file(temporaryPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file for writing: " + filePath);
+    }
+
+    // Configure JSON writer with indentation and save to the temporary file
+    Json::StreamWriterBuilder writerBuilder;
+    writerBuilder["indentation"] = "  ";
+    std::unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+    writer->write(data, &file);
+    file.close();
+    if (file.fail()) {
+        std::filesystem::remove(temporaryPath);
+        throw std::runtime_error("Could not write file: " + filePath);
+    }
+
+    // Replace the target in one step
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, filePath, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath);
+        throw std::runtime_error("Could not replace file: " + filePath);
+    }
+    return true;
+}
+
+/**
+ * @brief Loads and parses JSON data from a file into the provided output value
+ * @param filePath Path of the file to load
+ * @param output Json::Value object where parsed data will be stored
+ * @return true if file loading and parsing were successful, false otherwise
+ *
+ * Opens a file, reads its contents, and parses it as JSON into the provided output parameter.
+ */
+bool LoadJsonFromFile(const std::string& filePath, Json::Value& output) {
+    // Open file for reading
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Parse JSON from file
+    Json::CharReaderBuilder builder;
+    std::string errors;
+    bool parsingSuccessful = Json::parseFromStream(builder, file, &output, &errors);
+    file.close();
+
+    return parsingSuccessful;
+}
@@ -0,0 +1,29 @@
+#ifndef JSON_FILES_H
+#define JSON_FILES_H
+
+#include <json/json.h>
+#include <string>
+
+/**
+ * @file JsonFiles.h
+ * @brief Reading and writing JSON files, independent of any GUI toolkit
+ */
+
+ /**
+  * @brief Saves JSON data to a file with indentation
+  * @param data Json::Value object to save
+  * @param filePath Path where the file will be saved
+  * @return true if successful, false otherwise
+  * @throw std::runtime_error if the file cannot be written
+  */
+bool SaveToFile(Json::Value& data, const std::string& filePath);
+
+/**
+ * @brief Loads and parses JSON data from a file
+ * @param filePath Path of the file to load
+ * @param output Json::Value object where parsed data will be stored
+ * @return true if file loading and parsing were successful, false otherwise
+ */
+bool LoadJsonFromFile(const std::string& filePath, Json::Value& output);
+
+#endif // JSON_FILES_H
@@ -0,0 +1,102 @@
+/**
+ * @file LiveFeed.cpp
+ * @brief Implementation of the LiveFeed class
+ */
+
+#include "LiveFeed.h"
+
+#include <algorithm>
+
+/**
+ * @brief Creates an empty feed
+ * @param capacityHours Number of hours kept per sensor
+ */
+LiveFeed::LiveFeed(size_t capacityHours) : capacityHours(capacityHours) {
+}
+
+/**
+ * @brief Starts following a sensor
+ * @param sensorDirectory Directory of the sensor's data files
+ * @param history Stored history of the sensor; its newest hours seed the buffer
+ */
+void LiveFeed::Follow(const std::string& sensorDirectory, const HourlySeries& history) {
+    HourlyRingBuffer buffer;
+    buffer.Assign(history, capacityHours);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    buffers[sensorDirectory] = std::move(buffer);
+}
+
+/**
+ * @brief Stops following all sensors
+ */
+void LiveFeed::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    buffers.clear();
+}
+
+/**
+ * @brief Checks whether any sensor is followed
+ * @return true if the feed is empty, false otherwise
+ */
+bool LiveFeed::Empty() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return buffers.empty();
+}
+
+/**
+ * @brief Merges downloaded measurements into a followed sensor
+ * @param sensorDirectory Directory of the sensor's data files
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return New or changed hours (hour since 1970-01-01 00:00, value) in time order
+ *
+ * The API lists the newest measurement first, so the points are sorted by hour before
+ * they are appended; this way the buffer advances once instead of overwriting.
+ */
+std::vector<std::pair<long long, double>> LiveFeed::Ingest(const std::string& sensorDirectory, const std::vector<std::pair<std::string, double>>& data) {
+    std::vector<std::pair<long long, double>> points;
+    points.reserve(data.size());
+    for (const auto& point : data) {
+        long long hour;
+        if (ParseTimestampToHours(point.first, hour)) {
+            points.push_back(std::make_pair(hour, point.second));
+        }
+    }
+    std::sort(points.begin(), points.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<std::pair<long long, double>> changed;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = buffers.find(sensorDirectory);
+    if (it == buffers.end()) {
+        return changed;
+    }
+
+    HourlyRingBuffer& buffer = it->second;
+    for (const auto& point : points) {
+        bool held = !buffer.Empty() && point.first >= buffer.FirstHour() && point.first <= buffer.LastHour();
+        if (held && buffer.At(static_cast<size_t>(point.first - buffer.FirstHour())) == point.second) {
+            continue;
+        }
+        if (held || buffer.Empty() || point.first > buffer.LastHour()) {
+            buffer.Append(point.first, point.second);
+            changed.push_back(point);
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Copies the buffer of a followed sensor
+ * @param sensorDirectory Directory of the sensor's data files
+ * @param buffer [out] Copy of the sensor's buffer
+ * @return true if the sensor is followed, false otherwise
+ */
+bool LiveFeed::Snapshot(const std::string& sensorDirectory, HourlyRingBuffer& buffer) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = buffers.find(sensorDirectory);
+    if (it == buffers.end()) {
+        return false;
+    }
+    buffer = it->second;
+    return true;
+}
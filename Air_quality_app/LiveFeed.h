@@ -0,0 +1,78 @@
+#ifndef LIVE_FEED_H
+#define LIVE_FEED_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "HourlyRingBuffer.h"
+#include "TimeSeries.h"
+
+/**
+ * @file LiveFeed.h
+ * @brief Newest hours of the followed sensors, updated as downloads arrive
+ */
+
+ /**
+  * @class LiveFeed
+  * @brief Ring buffers of the sensors followed live, keyed by sensor directory
+  *
+  * Downloads hand their measurements to Ingest right after they are saved, so the
+  * followed series are kept current without reading any file again. Every method
+  * may be called from any thread.
+  */
+class LiveFeed {
+public:
+    /**
+     * @brief Creates an empty feed
+     * @param capacityHours Number of hours kept per sensor
+     */
+    explicit LiveFeed(size_t capacityHours);
+
+    /**
+     * @brief Starts following a sensor
+     * @param sensorDirectory Directory of the sensor's data files
+     * @param history Stored history of the sensor; its newest hours seed the buffer
+     */
+    void Follow(const std::string& sensorDirectory, const HourlySeries& history);
+
+    /**
+     * @brief Stops following all sensors
+     */
+    void Clear();
+
+    /**
+     * @brief Checks whether any sensor is followed
+     * @return true if the feed is empty, false otherwise
+     */
+    bool Empty() const;
+
+    /**
+     * @brief Merges downloaded measurements into a followed sensor
+     *
+     * Downloads overlap, so hours already held with the same value are skipped. Sensors
+     * that are not followed are ignored.
+     *
+     * @param sensorDirectory Directory of the sensor's data files
+     * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+     * @return New or changed hours (hour since 1970-01-01 00:00, value) in time order
+     */
+    std::vector<std::pair<long long, double>> Ingest(const std::string& sensorDirectory, const std::vector<std::pair<std::string, double>>& data);
+
+    /**
+     * @brief Copies the buffer of a followed sensor
+     * @param sensorDirectory Directory of the sensor's data files
+     * @param buffer [out] Copy of the sensor's buffer
+     * @return true if the sensor is followed, false otherwise
+     */
+    bool Snapshot(const std::string& sensorDirectory, HourlyRingBuffer& buffer) const;
+
+private:
+    size_t capacityHours;                               /**< Number of hours kept per sensor */
+    mutable std::mutex mutex;                           /**< Guards the buffers */
+    std::map<std::string, HourlyRingBuffer> buffers;    /**< Buffer of every followed sensor */
+};
+
+#endif // LIVE_FEED_H
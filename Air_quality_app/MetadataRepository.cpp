@@ -0,0 +1,187 @@
+/**
+ * @file MetadataRepository.cpp
+ * @brief Implementation of the MetadataRepository class
+ */
+
+#include "MetadataRepository.h"
+
+/**
+ * @brief Creates an empty repository for a measurement database
+ * @param databaseDirectory Path of the measurements directory (containing stations.json)
+ *
+ * Nothing is read until the first access.
+ */
+MetadataRepository::MetadataRepository(const std::string& databaseDirectory)
+    : databaseDirectory(databaseDirectory), stationsLoaded(false), paramIndexValid(false) {
+}
+
+/**
+ * @brief Loads stations.json unless the loaded copy is current
+ * @return true if the station table is available, false if the file is missing or cannot be parsed
+ *
+ * This function:
+ * 1. Compares the modification time of stations.json with that of the loaded copy,
+ *    which is all an access costs while the file is unchanged
+ * 2. Otherwise parses the file and builds the spatial index, the search index and the
+ *    ID lookup from the typed station list
+ */
+bool MetadataRepository::LoadStations() {
+    std::string stationsFile = databaseDirectory + "/stations.json";
+    std::error_code error;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(stationsFile, error);
+    if (error) {
+        return false;
+    }
+    if (stationsLoaded && modified == stationsModified) {
+        return true;
+    }
+
+    std::vector<StationLocation> stations;
+    if (!LoadStationLocations(stationsFile, stations)) {
+        return false;
+    }
+    locator.Build(stations);
+    search.Build(stations);
+    stationById.clear();
+    for (size_t i = 0; i < stations.size(); i++) {
+        stationById[stations[i].id] = i;
+    }
+    stationsModified = modified;
+    stationsLoaded = true;
+    paramIndexValid = false;
+    return true;
+}
+
+/**
+ * @brief Finds a station by its ID
+ * @param stationId Station ID
+ * @return Station of the loaded table, or nullptr if there is none with this ID
+ */
+const StationLocation* MetadataRepository::FindStation(int stationId) const {
+    auto it = stationById.find(stationId);
+    return (it != stationById.end()) ? &locator.Stations()[it->second] : nullptr;
+}
+
+/**
+ * @brief Gets the sensors of a station, loading its sensors.json unless the loaded copy is current
+ * @param stationId Station ID
+ * @param sensors [out] Sensors of the station
+ * @return true if the station has a readable sensors.json, false otherwise
+ */
+bool MetadataRepository::GetStationSensors(int stationId, std::vector<SensorInfo>& sensors) {
+    RefreshSensors(stationId);
+    auto it = sensorsByStation.find(stationId);
+    if (it == sensorsByStation.end()) {
+        return false;
+    }
+    sensors = it->second.sensors;
+    return true;
+}
+
+/**
+ * @brief Finds the stations with a stored sensor list containing a parameter
+ * @param paramCode Parameter code (e.g. "PM10")
+ * @return One entry per station measuring the parameter, with its first such sensor, in stations.json order
+ *
+ * This function:
+ * 1. Checks the modification time of every station's sensors.json, reloading the
+ *    changed ones
+ * 2. Rebuilds the parameter index from the cached sensors if anything changed
+ * 3. Returns the entries of the parameter from the index
+ */
+std::vector<StationSensor> MetadataRepository::FindSensorsMeasuring(const std::string& paramCode) {
+    if (!LoadStations()) {
+        return std::vector<StationSensor>();
+    }
+
+    for (const auto& station : locator.Stations()) {
+        if (RefreshSensors(station.id)) {
+            paramIndexValid = false;
+        }
+    }
+
+    if (!paramIndexValid) {
+        sensorsByParam.clear();
+        for (const auto& station : locator.Stations()) {
+            auto cached = sensorsByStation.find(station.id);
+            if (cached == sensorsByStation.end()) {
+                continue;
+            }
+            std::string stationDirectory = StationDirectory(station.id);
+            for (const auto& sensor : cached->second.sensors) {
+                std::vector<StationSensor>& entries = sensorsByParam[sensor.paramCode];
+                // Only the first sensor of a station measuring the parameter
+                if (!entries.empty() && entries.back().station.id == station.id) {
+                    continue;
+                }
+                StationSensor entry;
+                entry.station = station;
+                entry.sensorId = sensor.id;
+                entry.sensorDirectory = stationDirectory + "/" + std::to_string(sensor.id);
+                entries.push_back(entry);
+            }
+        }
+        paramIndexValid = true;
+    }
+
+    auto it = sensorsByParam.find(paramCode);
+    return (it != sensorsByParam.end()) ? it->second : std::vector<StationSensor>();
+}
+
+/**
+ * @brief Drops the loaded station table, e.g. after stations.json was downloaded
+ *
+ * The next access parses the file again, even if its modification time did not change.
+ */
+void MetadataRepository::InvalidateStations() {
+    stationsLoaded = false;
+    paramIndexValid = false;
+}
+
+/**
+ * @brief Drops the loaded sensors of a station, e.g. after its sensors.json was downloaded
+ * @param stationId Station ID
+ */
+void MetadataRepository::InvalidateSensors(int stationId) {
+    if (sensorsByStation.erase(stationId) > 0) {
+        paramIndexValid = false;
+    }
+}
+
+/**
+ * @brief Brings the cached sensors of a station up to date with its sensors.json
+ * @param stationId Station ID
+ * @return true if the cache entry changed (loaded, reloaded or removed), false otherwise
+ *
+ * A file that disappeared or can no longer be parsed removes the entry.
+ */
+bool MetadataRepository::RefreshSensors(int stationId) {
+    std::string stationDirectory = StationDirectory(stationId);
+    std::error_code error;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(stationDirectory + "/sensors.json", error);
+    auto it = sensorsByStation.find(stationId);
+    if (!error && it != sensorsByStation.end() && it->second.modified == modified) {
+        return false;
+    }
+
+    CachedSensors cached;
+    cached.modified = modified;
+    if (error || !LoadStationSensors(stationDirectory, cached.sensors)) {
+        if (it == sensorsByStation.end()) {
+            return false;
+        }
+        sensorsByStation.erase(it);
+        return true;
+    }
+    sensorsByStation[stationId] = std::move(cached);
+    return true;
+}
+
+/**
+ * @brief Gets the path of a station's directory
+ * @param stationId Station ID
+ * @return Path below the measurements directory
+ */
+std::string MetadataRepository::StationDirectory(int stationId) const {
+    return databaseDirectory + "/" + std::to_string(stationId);
+}
@@ -0,0 +1,126 @@
+#ifndef METADATA_REPOSITORY_H
+#define METADATA_REPOSITORY_H
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SensorCatalog.h"
+#include "StationLocator.h"
+#include "StationSearch.h"
+
+/**
+ * @file MetadataRepository.h
+ * @brief In-memory station and sensor metadata, reloaded only when its files change
+ */
+
+ /**
+  * @class MetadataRepository
+  * @brief Typed, indexed copy of stations.json and of every station's sensors.json
+  *
+  * The files are parsed on first use and kept in memory: the stations with their
+  * spatial and search indexes and an ID lookup, the sensors of each station, and the
+  * stations measuring each parameter. Every access compares the modification time of
+  * the file behind the data with the one it was loaded from, so a file rewritten by a
+  * download is picked up without reparsing unchanged files; after a download the
+  * caller can also invalidate the entry directly.
+  *
+  * Not thread-safe; meant for the user interface thread. Batch jobs on worker
+  * threads read the files through the SensorCatalog functions instead.
+  */
+class MetadataRepository {
+public:
+    /**
+     * @brief Creates an empty repository for a measurement database
+     * @param databaseDirectory Path of the measurements directory (containing stations.json)
+     */
+    explicit MetadataRepository(const std::string& databaseDirectory);
+
+    /**
+     * @brief Loads stations.json unless the loaded copy is current
+     * @return true if the station table is available, false if the file is missing or cannot be parsed
+     */
+    bool LoadStations();
+
+    /**
+     * @brief Gets the stations with their spatial index
+     * @return Locator over the stations of the last successful LoadStations()
+     */
+    const StationLocator& Stations() const { return locator; }
+
+    /**
+     * @brief Gets the search index over the station names and cities
+     * @return Index with the same station positions as Stations()
+     */
+    const StationSearchIndex& StationSearch() const { return search; }
+
+    /**
+     * @brief Finds a station by its ID
+     * @param stationId Station ID
+     * @return Station of the loaded table, or nullptr if there is none with this ID
+     */
+    const StationLocation* FindStation(int stationId) const;
+
+    /**
+     * @brief Gets the sensors of a station, loading its sensors.json unless the loaded copy is current
+     * @param stationId Station ID
+     * @param sensors [out] Sensors of the station
+     * @return true if the station has a readable sensors.json, false otherwise
+     */
+    bool GetStationSensors(int stationId, std::vector<SensorInfo>& sensors);
+
+    /**
+     * @brief Finds the stations with a stored sensor list containing a parameter
+     * @param paramCode Parameter code (e.g. "PM10")
+     * @return One entry per station measuring the parameter, with its first such sensor, in stations.json order
+     */
+    std::vector<StationSensor> FindSensorsMeasuring(const std::string& paramCode);
+
+    /**
+     * @brief Drops the loaded station table, e.g. after stations.json was downloaded
+     */
+    void InvalidateStations();
+
+    /**
+     * @brief Drops the loaded sensors of a station, e.g. after its sensors.json was downloaded
+     * @param stationId Station ID
+     */
+    void InvalidateSensors(int stationId);
+
+private:
+    /**
+     * @struct CachedSensors
+     * @brief Sensors of one station with the time of the file they were loaded from
+     */
+    struct CachedSensors {
+        std::filesystem::file_time_type modified; /**< Modification time of sensors.json when loaded */
+        std::vector<SensorInfo> sensors;          /**< Sensors of the station */
+    };
+
+    std::string databaseDirectory; /**< Path of the measurements directory */
+    bool stationsLoaded; /**< Whether the station table holds a parsed stations.json */
+    std::filesystem::file_time_type stationsModified; /**< Modification time of stations.json when loaded */
+    StationLocator locator; /**< Stations with a 2-d tree over their positions */
+    StationSearchIndex search; /**< N-gram index of the station names and cities */
+    std::unordered_map<int, size_t> stationById; /**< Position in the station table of each station ID */
+    std::unordered_map<int, CachedSensors> sensorsByStation; /**< Loaded sensors per station ID */
+    std::unordered_map<std::string, std::vector<StationSensor>> sensorsByParam; /**< Stations measuring each parameter code */
+    bool paramIndexValid; /**< Whether sensorsByParam matches the loaded stations and sensors */
+
+    /**
+     * @brief Brings the cached sensors of a station up to date with its sensors.json
+     * @param stationId Station ID
+     * @return true if the cache entry changed (loaded, reloaded or removed), false otherwise
+     */
+    bool RefreshSensors(int stationId);
+
+    /**
+     * @brief Gets the path of a station's directory
+     * @param stationId Station ID
+     * @return Path below the measurements directory
+     */
+    std::string StationDirectory(int stationId) const;
+};
+
+#endif // METADATA_REPOSITORY_H
@@ -0,0 +1,170 @@
+/**
+ * @file MinMaxPyramid.cpp
+ * @brief Implementation of the MinMaxPyramid class
+ */
+
+#include "MinMaxPyramid.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Combines two buckets into the bucket of their union
+ * @param a First bucket
+ * @param b Second bucket
+ * @return Merged bucket
+ *
+ * Ties keep the extreme of the first bucket, so indices stay deterministic.
+ */
+MinMaxPyramid::Bucket MinMaxPyramid::Merge(const Bucket& a, const Bucket& b) {
+    if (a.IsMissing()) {
+        return b;
+    }
+    if (b.IsMissing()) {
+        return a;
+    }
+    Bucket merged = a;
+    if (b.min < merged.min) {
+        merged.min = b.min;
+        merged.minIndex = b.minIndex;
+    }
+    if (b.max > merged.max) {
+        merged.max = b.max;
+        merged.maxIndex = b.maxIndex;
+    }
+    return merged;
+}
+
+/**
+ * @brief Builds the pyramid over a series
+ * @param count Number of samples
+ * @param valueAt Function returning the value of a sample (NaN for a missing hour)
+ *
+ * Level 0 copies the samples; every further level merges pairs of buckets of the level
+ * below until a single bucket covers the whole series.
+ */
+void MinMaxPyramid::Build(size_t count, const std::function<double(size_t)>& valueAt) {
+    levels.clear();
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<Bucket> base(count);
+    for (size_t i = 0; i < count; i++) {
+        double value = valueAt(i);
+        base[i] = Bucket{ value, value, i, i };
+    }
+    levels.push_back(std::move(base));
+
+    while (levels.back().size() > 1) {
+        const std::vector<Bucket>& below = levels.back();
+        std::vector<Bucket> level((below.size() + 1) / 2);
+        for (size_t j = 0; j < level.size(); j++) {
+            level[j] = (2 * j + 1 < below.size()) ? Merge(below[2 * j], below[2 * j + 1]) : below[2 * j];
+        }
+        levels.push_back(std::move(level));
+    }
+}
+
+/**
+ * @brief Replaces one sample and updates the buckets covering it
+ * @param index Index of the sample
+ * @param value New value (NaN for a missing hour)
+ *
+ * Only the one bucket per level that contains the sample is merged again from its
+ * two children, so the update takes O(log n).
+ */
+void MinMaxPyramid::Update(size_t index, double value) {
+    if (index >= Size()) {
+        return;
+    }
+    levels[0][index] = Bucket{ value, value, index, index };
+    for (size_t level = 1; level < levels.size(); level++) {
+        const std::vector<Bucket>& below = levels[level - 1];
+        size_t j = index >> level;
+        levels[level][j] = (2 * j + 1 < below.size()) ? Merge(below[2 * j], below[2 * j + 1]) : below[2 * j];
+    }
+}
+
+/**
+ * @brief Merges the buckets covering a range
+ * @param begin First sample of the range
+ * @param end Sample past the end of the range (at most the series length)
+ * @return Bucket of the range, missing if it holds no measured sample
+ *
+ * Walks up the levels from both ends of the range and merges the buckets that lie
+ * entirely inside it, touching at most two buckets per level.
+ */
+MinMaxPyramid::Bucket MinMaxPyramid::Query(size_t begin, size_t end) const {
+    Bucket result{ std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), 0, 0 };
+    for (size_t level = 0; level < levels.size() && begin < end; level++) {
+        if (begin & 1) {
+            result = Merge(result, levels[level][begin++]);
+        }
+        if (end & 1) {
+            result = Merge(result, levels[level][--end]);
+        }
+        begin /= 2;
+        end /= 2;
+    }
+    return result;
+}
+
+/**
+ * @brief Finds the extremes of the measured samples in a range
+ * @param begin First sample of the range
+ * @param end Sample past the end of the range (clamped to the series)
+ * @param min [out] Smallest value
+ * @param max [out] Largest value
+ * @return true if the range contains a measured sample, false otherwise
+ */
+bool MinMaxPyramid::Range(size_t begin, size_t end, double& min, double& max) const {
+    Bucket result = Query(begin, std::min(end, Size()));
+    if (result.IsMissing()) {
+        return false;
+    }
+    min = result.min;
+    max = result.max;
+    return true;
+}
+
+/**
+ * @brief Gets the buckets describing a range at the finest level that fits a bucket budget
+ * @param begin First sample of the range
+ * @param end Sample past the end of the range (clamped to the series)
+ * @param maxBuckets Largest number of buckets wanted
+ * @param buckets [out] Buckets in index order
+ * @return Number of samples per bucket of the chosen level
+ *
+ * The inner buckets are copied from the chosen level; the two edge buckets, which may
+ * stick out of the range, are queried for their part inside it instead.
+ */
+size_t MinMaxPyramid::Envelope(size_t begin, size_t end, size_t maxBuckets, std::vector<Bucket>& buckets) const {
+    buckets.clear();
+    end = std::min(end, Size());
+    if (begin >= end) {
+        return 1;
+    }
+
+    // Finest level whose buckets over the range fit the budget
+    size_t level = 0;
+    while (level + 1 < levels.size() && ((end - 1) >> level) - (begin >> level) + 1 > std::max<size_t>(1, maxBuckets)) {
+        level++;
+    }
+
+    const std::vector<Bucket>& selected = levels[level];
+    size_t first = begin >> level;
+    size_t last = (end - 1) >> level;
+    buckets.reserve(last - first + 1);
+    for (size_t j = first; j <= last; j++) {
+        size_t bucketBegin = j << level;
+        size_t bucketEnd = std::min((j + 1) << level, Size());
+        if (bucketBegin < begin || bucketEnd > end) {
+            buckets.push_back(Query(std::max(bucketBegin, begin), std::min(bucketEnd, end)));
+        }
+        else {
+            buckets.push_back(selected[j]);
+        }
+    }
+    return static_cast<size_t>(1) << level;
+}
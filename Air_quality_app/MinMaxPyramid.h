@@ -0,0 +1,105 @@
+#ifndef MIN_MAX_PYRAMID_H
+#define MIN_MAX_PYRAMID_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * @file MinMaxPyramid.h
+ * @brief Multi-resolution minimum/maximum summary of a series for zoomable charts
+ */
+
+ /**
+  * @class MinMaxPyramid
+  * @brief Levels of min/max buckets over a series, each level halving the resolution
+  *
+  * Level 0 holds one bucket per sample, level k one bucket per 2^k samples. Every bucket
+  * remembers where its minimum and maximum occur, so drawing the buckets of a window in
+  * index order reproduces the extremes of the line at every pixel (M4 aggregation).
+  * Building takes O(n) time and about twice the memory of the series; changing one
+  * sample and a range query take O(log n), an envelope of a window O(buckets).
+  */
+class MinMaxPyramid {
+public:
+    /**
+     * @struct Bucket
+     * @brief Extremes of the measured samples of a range
+     */
+    struct Bucket {
+        double min;         /**< Smallest value, NaN if no sample of the range was measured */
+        double max;         /**< Largest value, NaN if no sample of the range was measured */
+        size_t minIndex;    /**< Index of the smallest value */
+        size_t maxIndex;    /**< Index of the largest value */
+
+        /**
+         * @brief Checks whether the range has no measured sample
+         * @return true if the bucket is empty, false otherwise
+         */
+        bool IsMissing() const { return min != min; }
+    };
+
+    /**
+     * @brief Builds the pyramid over a series
+     * @param count Number of samples
+     * @param valueAt Function returning the value of a sample (NaN for a missing hour)
+     */
+    void Build(size_t count, const std::function<double(size_t)>& valueAt);
+
+    /**
+     * @brief Replaces one sample and updates the buckets covering it
+     * @param index Index of the sample
+     * @param value New value (NaN for a missing hour)
+     */
+    void Update(size_t index, double value);
+
+    /**
+     * @brief Gets the number of samples of the series
+     * @return Number of samples
+     */
+    size_t Size() const { return levels.empty() ? 0 : levels.front().size(); }
+
+    /**
+     * @brief Finds the extremes of the measured samples in a range
+     * @param begin First sample of the range
+     * @param end Sample past the end of the range (clamped to the series)
+     * @param min [out] Smallest value
+     * @param max [out] Largest value
+     * @return true if the range contains a measured sample, false otherwise
+     */
+    bool Range(size_t begin, size_t end, double& min, double& max) const;
+
+    /**
+     * @brief Gets the buckets describing a range at the finest level that fits a bucket budget
+     *
+     * Buckets are clipped to the range, so no sample outside it is ever reported.
+     *
+     * @param begin First sample of the range
+     * @param end Sample past the end of the range (clamped to the series)
+     * @param maxBuckets Largest number of buckets wanted (e.g. the chart width in pixels)
+     * @param buckets [out] Buckets in index order
+     * @return Number of samples per bucket of the chosen level
+     */
+    size_t Envelope(size_t begin, size_t end, size_t maxBuckets, std::vector<Bucket>& buckets) const;
+
+private:
+    std::vector<std::vector<Bucket>> levels; /**< Level k holds ceil(n / 2^k) buckets */
+
+    /**
+     * @brief Combines two buckets into the bucket of their union
+     * @param a First bucket
+     * @param b Second bucket
+     * @return Merged bucket
+     */
+    static Bucket Merge(const Bucket& a, const Bucket& b);
+
+    /**
+     * @brief Merges the buckets covering a range
+     * @param begin First sample of the range
+     * @param end Sample past the end of the range (at most the series length)
+     * @return Bucket of the range, missing if it holds no measured sample
+     */
+    Bucket Query(size_t begin, size_t end) const;
+};
+
+#endif // MIN_MAX_PYRAMID_H
@@ -4,6 +4,7 @@
  */
 
 #include "NetworkingAndFileHandling.h"
+#include "SensorStores.h"
 
  /**
   * @brief Formats a date string into a filename-friendly format (YYYY-MM-DD_HH)
@@ -40,15 +41,34 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::stri
     return newLength;
 }
 
+/**
+ * @brief Callback function for CURL that aborts the transfer once its token is cancelled
+ * @param token Pointer to the CancellationToken of the transfer
+ * @return Non-zero to abort the transfer, 0 to continue
+ *
+ * libcurl calls this function while waiting for the connection or data (about once
+ * per second when idle, more often while data arrives), so a cancelled transfer
+ * releases its connection without waiting for the timeout. The byte counts libcurl
+ * passes along are not needed.
+ */
+static int TransferInfoCallback(void* token, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    return static_cast<const CancellationToken*>(token)->IsCancelled() ? 1 : 0;
+}
+
 /**
  * @brief Performs an HTTP GET request to the specified URL and returns parsed JSON
  * @param url The URL to request data from
+ * @param cancel Token aborting the transfer when cancelled
  * @return Json::Value object containing the parsed JSON response
- * @throw std::runtime_error if the request fails or JSON parsing fails
+ * @throw std::runtime_error if the request fails, is cancelled or JSON parsing fails
  *
  * Uses libcurl to perform an HTTP GET request and parses the response as JSON.
  */
-Json::Value PerformHttpGet(const std::string& url) {
+Json::Value PerformHttpGet(const std::string& url, const CancellationToken& cancel) {
+    if (cancel.IsCancelled()) {
+        throw std::runtime_error("Download cancelled");
+    }
+
     // Initialize CURL session
     CURL* curl = curl_easy_init();
     Json::Value result;
@@ -65,6 +85,9 @@ Json::Value PerformHttpGet(const std::string& url) {
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, TransferInfoCallback);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &cancel);
 
     // Perform the HTTP request
     CURLcode res = curl_easy_perform(curl);
@@ -90,31 +113,6 @@ Json::Value PerformHttpGet(const std::string& url) {
     return result;
 }
 
-/**
- * @brief Saves JSON data to a file with indentation
- * @param data Json::Value object to save
- * @param filePath Path where the file will be saved
- * @return true if successful, false otherwise
- * @throw std::runtime_error if the file cannot be opened for writing
- *
- * Writes JSON data to a file with proper indentation for readability.
- */
-bool SaveToFile(Json::Value& data, const std::string& filePath) {
-    // Open file for writing
-    std::ofstream file(filePath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file for writing: " + filePath);
-    }
-
-    // Configure JSON writer with indentation and save to a file
-    Json::StreamWriterBuilder writerBuilder;
-    writerBuilder["indentation"] = "  ";
-    std::unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
-    writer->write(data, &file);
-    file.close();
-    return true;
-}
-
 /**
  * @brief Downloads JSON from URL, optionally transforms it, and saves to file
  * @param url The URL to download JSON from
@@ -148,16 +146,27 @@ bool DownloadJsonAndSaveToFile(const std::string& url, const std::string& filePa
  * @brief Downloads air quality data, filters valid entries, and saves to a file with date-based name
  * @param url The URL to download air quality data from
  * @param dirPath Directory path where the file will be saved
+ * @param onSaved Optional function receiving the saved measurements
+ * @param cancel Token aborting the download when cancelled
+ * @param error [out] Optional description of the failure
  * @return true if download and save were successful, false otherwise
  *
  * Downloads air quality data in JSON format, filters out invalid entries,
  * creates a filename based on the date range of the data, and saves the
- * filtered data to the specified directory.
+ * filtered data to the specified directory. The sensor's quantile rollups,
+ * exceedance counters, forecast model and anomaly flags are updated with the new
+ * values afterwards, and the filtered values are passed to onSaved, so consumers
+ * of new data never need to read the file back. A download cancelled while
+ * transferring, or before writing the file or the stores, fails silently, since
+ * nobody waits for its data any more. Other failures are returned through error
+ * rather than shown, since the function runs on download threads; the caller
+ * decides whether and how to report them.
  */
-bool DownloadJsonAndSaveData(const std::string& url, const std::string& dirPath) {
+bool DownloadJsonAndSaveData(const std::string& url, const std::string& dirPath, std::function<void(const Json::Value&)> onSaved,
+    const CancellationToken& cancel, std::string* error) {
     try {
         // Perform HTTP GET request
-        Json::Value root = PerformHttpGet(url);
+        Json::Value root = PerformHttpGet(url, cancel);
 
         const Json::Value& values = root["values"];
         Json::Value filteredValues(Json::arrayValue);
@@ -201,37 +210,34 @@ bool DownloadJsonAndSaveData(const std::string& url, const std::string& dirPath)
         }
         result["values"] = filteredValues;
 
+        // A download cancelled after its transfer leaves the files to the download replacing it
+        if (cancel.IsCancelled()) {
+            return false;
+        }
+
         // Save filtered data to file
-        return SaveToFile(result, filePath);
+        if (!SaveToFile(result, filePath)) {
+            throw std::runtime_error("Could not save " + filePath);
+        }
+
+        // Update percentile rollups, limit value counters, forecast model and anomaly flags of the sensor with the new values
+        if (cancel.IsCancelled()) {
+            return false;
+        }
+        UpdateSensorStores(dirPath, root.get("key", "").asString(), filteredValues);
+        if (onSaved) {
+            onSaved(filteredValues);
+        }
+        return true;
     }
     catch (const std::exception& e) {
-        // Display error message if download fails
-        wxMessageBox(wxString::Format("Error downloading data: %s", e.what()),
-            "Download Error", wxOK | wxICON_ERROR);
-        return false;
-    }
-}
-
-/**
- * @brief Loads and parses JSON data from a file into the provided output value
- * @param filePath Path of the file to load
- * @param output Json::Value object where parsed data will be stored
- * @return true if file loading and parsing were successful, false otherwise
- *
- * Opens a file, reads its contents, and parses it as JSON into the provided output parameter.
- */
-bool LoadJsonFromFile(const std::string& filePath, Json::Value& output) {
-    // Open file for reading
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+        if (cancel.IsCancelled()) {
+            return false;
+        }
+        // Hand the error to the caller, which reports it on the UI thread if anybody waits
+        if (error) {
+            *error = e.what();
+        }
         return false;
     }
-
-    // Parse JSON from file
-    Json::CharReaderBuilder builder;
-    std::string errors;
-    bool parsingSuccessful = Json::parseFromStream(builder, file, &output, &errors);
-    file.close();
-
-    return parsingSuccessful;
 }
\ No newline at end of file
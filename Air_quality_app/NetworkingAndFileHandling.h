@@ -9,6 +9,9 @@
 #include <fstream>
 #include <string>
 
+#include "CancellationToken.h"
+#include "JsonFiles.h"
+
 /**
  * @file NetworkingAndFileHandling.h
  * @brief Header file defining networking and file handling functionality
@@ -36,19 +39,11 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::stri
 /**
  * @brief Performs an HTTP GET request to the specified URL
  * @param url The URL to request data from
+ * @param cancel Token aborting the transfer when cancelled
  * @return Json::Value object containing the parsed JSON response
- * @throw std::runtime_error if the request fails or JSON parsing fails
- */
-Json::Value PerformHttpGet(const std::string& url);
-
-/**
- * @brief Saves JSON data to a file with indentation
- * @param data Json::Value object to save
- * @param filePath Path where the file will be saved
- * @return true if successful, false otherwise
- * @throw std::runtime_error if the file cannot be opened for writing
+ * @throw std::runtime_error if the request fails, is cancelled or JSON parsing fails
  */
-bool SaveToFile(Json::Value& data, const std::string& filePath);
+Json::Value PerformHttpGet(const std::string& url, const CancellationToken& cancel = CancellationToken());
 
 /**
  * @brief Downloads JSON from URL, optionally transforms it, and saves to file
@@ -63,16 +58,14 @@ bool DownloadJsonAndSaveToFile(const std::string& url, const std::string& filePa
  * @brief Downloads air quality data, filters valid entries, and saves to a file with date-based name
  * @param url The URL to download air quality data from
  * @param dirPath Directory path where the file will be saved
+ * @param onSaved Optional function receiving the saved measurements, e.g. to update live charts
+ * @param cancel Token aborting the download when cancelled; a cancelled download is not reported as an error
+ * @param error [out] Optional description of the failure; left empty for a cancelled download
  * @return true if download and save were successful, false otherwise
+ *
+ * May be called from any thread; errors are returned to the caller instead of being shown.
  */
-bool DownloadJsonAndSaveData(const std::string& url, const std::string& dirPath);
-
-/**
- * @brief Loads and parses JSON data from a file
- * @param filePath Path of the file to load
- * @param output Json::Value object where parsed data will be stored
- * @return true if file loading and parsing were successful, false otherwise
- */
-bool LoadJsonFromFile(const std::string& filePath, Json::Value& output);
+bool DownloadJsonAndSaveData(const std::string& url, const std::string& dirPath, std::function<void(const Json::Value&)> onSaved = nullptr,
+    const CancellationToken& cancel = CancellationToken(), std::string* error = nullptr);
 
 #endif // NETWORKING_AND_FILE_HANDLING_H
\ No newline at end of file
@@ -0,0 +1,175 @@
+/**
+ * @file PollutionMapDialog.cpp
+ * @brief Implementation of the PollutionMapDialog class
+ */
+
+#include "PollutionMapDialog.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "TimeSeries.h"
+
+namespace {
+    const int LEGEND_HEIGHT = 50;   ///< Height reserved below the map for the colour scale
+    const int MAP_MARGIN = 10;      ///< Margin around the map in pixels
+    const int MARKER_RADIUS = 4;    ///< Radius of the station markers in pixels
+}
+
+/**
+ * @brief Constructor that renders the grid and creates the dialog
+ * @param parent Pointer to the parent window
+ * @param paramCode Parameter code shown in the title and legend
+ * @param grid Interpolated grid
+ * @param stations Station values the grid was computed from (drawn as markers)
+ *
+ * The colour scale spans the range of the station values; interpolated cells always
+ * lie within that range.
+ */
+PollutionMapDialog::PollutionMapDialog(wxWindow* parent, const wxString& paramCode, const InterpolationGrid& grid, const std::vector<StationValue>& stations)
+    : wxDialog(parent, wxID_ANY, "Pollution map: " + paramCode, wxDefaultPosition, wxSize(820, 860), wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER),
+    stations(stations), paramCode(paramCode),
+    west(grid.west), east(grid.east), south(grid.south), north(grid.north), scale(0.0, 1.0) {
+    double minValue = stations.empty() ? 0.0 : stations.front().value;
+    double maxValue = minValue;
+    long long latestHour = stations.empty() ? 0 : stations.front().hour;
+    for (const auto& station : stations) {
+        minValue = std::min(minValue, station.value);
+        maxValue = std::max(maxValue, station.value);
+        latestHour = std::max(latestHour, station.hour);
+    }
+    scale = ColourScale(minValue, maxValue);
+
+    RenderHeatmap(grid);
+
+    wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
+
+    // Describe the data behind the map
+    wxString info = wxString::Format("Latest values of %d stations (up to %s), inverse distance weighting\n"
+        "Grid of %d x %d cells of %.0f km computed in %.0f ms",
+        static_cast<int>(stations.size()), FormatHoursAsTimestamp(latestHour).substr(0, 16),
+        static_cast<int>(grid.width), static_cast<int>(grid.height), grid.cellKm, grid.elapsedSeconds * 1000.0);
+    mainSizer->Add(new wxStaticText(this, wxID_ANY, info), 0, wxALL, 10);
+
+    mapPanel = new wxPanel(this, wxID_ANY);
+    mapPanel->SetBackgroundColour(*wxWHITE);
+    mainSizer->Add(mapPanel, 1, wxEXPAND | wxLEFT | wxRIGHT, 10);
+
+    mainSizer->Add(new wxButton(this, wxID_OK, "Close"), 0, wxALIGN_CENTER | wxALL, 10);
+    SetSizer(mainSizer);
+
+    mapPanel->Bind(wxEVT_PAINT, &PollutionMapDialog::OnPaintMap, this);
+    mapPanel->Bind(wxEVT_SIZE, [this](wxSizeEvent& event) {
+        mapPanel->Refresh();
+        event.Skip();
+        });
+}
+
+/**
+ * @brief Converts the grid into the heatmap image
+ * @param grid Interpolated grid
+ *
+ * One pass over the cells writes the colour and alpha buffers of the image directly,
+ * looking colours up in the precomputed palette of the colour scale.
+ */
+void PollutionMapDialog::RenderHeatmap(const InterpolationGrid& grid) {
+    if (grid.width == 0 || grid.height == 0) {
+        return;
+    }
+
+    heatmap = wxImage(static_cast<int>(grid.width), static_cast<int>(grid.height), false);
+    heatmap.SetAlpha();
+    unsigned char* rgb = heatmap.GetData();
+    unsigned char* alpha = heatmap.GetAlpha();
+    if (!rgb || !alpha) {
+        return;
+    }
+
+    for (size_t i = 0; i < grid.values.size(); i++) {
+        float value = grid.values[i];
+        if (std::isnan(value)) {
+            rgb[3 * i] = rgb[3 * i + 1] = rgb[3 * i + 2] = 255;
+            alpha[i] = 0;
+            continue;
+        }
+        const unsigned char* colour = scale.RgbAt(scale.IndexOf(value));
+        rgb[3 * i] = colour[0];
+        rgb[3 * i + 1] = colour[1];
+        rgb[3 * i + 2] = colour[2];
+        alpha[i] = 255;
+    }
+}
+
+/**
+ * @brief Paints the scaled heatmap, the station markers and the legend
+ * @param event The paint event
+ *
+ * The heatmap keeps its aspect ratio (cells are square in kilometres). It is only
+ * rescaled when the available area changes size.
+ */
+void PollutionMapDialog::OnPaintMap(wxPaintEvent& event) {
+    wxPaintDC dc(mapPanel);
+    if (!heatmap.IsOk() || heatmap.GetWidth() == 0 || heatmap.GetHeight() == 0) {
+        return;
+    }
+
+    // Fit the map into the panel above the legend
+    wxSize panelSize = mapPanel->GetClientSize();
+    int availableWidth = panelSize.GetWidth() - 2 * MAP_MARGIN;
+    int availableHeight = panelSize.GetHeight() - 2 * MAP_MARGIN - LEGEND_HEIGHT;
+    if (availableWidth <= 0 || availableHeight <= 0) {
+        return;
+    }
+    double aspect = static_cast<double>(heatmap.GetWidth()) / heatmap.GetHeight();
+    int mapWidth = std::min(availableWidth, static_cast<int>(availableHeight * aspect));
+    int mapHeight = static_cast<int>(mapWidth / aspect);
+    int mapLeft = MAP_MARGIN + (availableWidth - mapWidth) / 2;
+    int mapTop = MAP_MARGIN;
+
+    if (!scaledMap.IsOk() || scaledMap.GetWidth() != mapWidth || scaledMap.GetHeight() != mapHeight) {
+        scaledMap = wxBitmap(heatmap.Scale(mapWidth, mapHeight, wxIMAGE_QUALITY_NORMAL));
+    }
+    dc.DrawBitmap(scaledMap, mapLeft, mapTop, true);
+
+    dc.SetPen(wxPen(wxColour(200, 200, 200), 1));
+    dc.SetBrush(*wxTRANSPARENT_BRUSH);
+    dc.DrawRectangle(mapLeft, mapTop, mapWidth, mapHeight);
+
+    // Station markers, coloured by their own value
+    dc.SetPen(wxPen(*wxBLACK, 1));
+    for (const auto& station : stations) {
+        int x = mapLeft + static_cast<int>((station.longitude - west) / (east - west) * mapWidth);
+        int y = mapTop + static_cast<int>((north - station.latitude) / (north - south) * mapHeight);
+        dc.SetBrush(wxBrush(scale.ColourOf(station.value)));
+        dc.DrawCircle(x, y, MARKER_RADIUS);
+    }
+
+    DrawLegend(dc, wxRect(mapLeft, mapTop + mapHeight + MAP_MARGIN, mapWidth, LEGEND_HEIGHT - MAP_MARGIN));
+}
+
+/**
+ * @brief Draws the colour scale with its minimum and maximum
+ * @param dc Device context for drawing
+ * @param area Rectangle available for the legend
+ */
+void PollutionMapDialog::DrawLegend(wxDC& dc, const wxRect& area) {
+    const int barHeight = 12;
+    const int steps = 64;
+
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    for (int i = 0; i < steps; i++) {
+        int x0 = area.GetLeft() + i * area.GetWidth() / steps;
+        int x1 = area.GetLeft() + (i + 1) * area.GetWidth() / steps;
+        dc.SetBrush(wxBrush(scale.ColourOf(scale.GetMin() + (scale.GetMax() - scale.GetMin()) * (i + 0.5) / steps)));
+        dc.DrawRectangle(x0, area.GetTop(), x1 - x0, barHeight);
+    }
+
+    dc.SetTextForeground(*wxBLACK);
+    dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+    wxString minLabel = wxString::Format("%.1f", scale.GetMin());
+    wxString maxLabel = wxString::Format("%.1f", scale.GetMax());
+    wxString title = paramCode + " [ug/m3]";
+    dc.DrawText(minLabel, area.GetLeft(), area.GetTop() + barHeight + 2);
+    dc.DrawText(maxLabel, area.GetRight() - dc.GetTextExtent(maxLabel).GetWidth(), area.GetTop() + barHeight + 2);
+    dc.DrawText(title, area.GetLeft() + (area.GetWidth() - dc.GetTextExtent(title).GetWidth()) / 2, area.GetTop() + barHeight + 2);
+}
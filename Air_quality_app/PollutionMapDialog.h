@@ -0,0 +1,67 @@
+#ifndef POLLUTION_MAP_DIALOG_H
+#define POLLUTION_MAP_DIALOG_H
+
+#include <wx/wx.h>
+#include <vector>
+
+#include "ColourScale.h"
+#include "SpatialInterpolation.h"
+
+/**
+ * @file PollutionMapDialog.h
+ * @brief Dialog showing an interpolated concentration grid as a heatmap
+ */
+
+ /**
+  * @class PollutionMapDialog
+  * @brief A dialog that displays an interpolated grid with the stations it was computed from
+  *
+  * The grid is converted into an image once, one pixel per cell; painting only scales
+  * that image to the window, so resizing stays smooth for a 1 km grid of the country.
+  */
+class PollutionMapDialog : public wxDialog {
+public:
+    /**
+     * @brief Constructor that renders the grid and creates the dialog
+     * @param parent Pointer to the parent window
+     * @param paramCode Parameter code shown in the title and legend
+     * @param grid Interpolated grid
+     * @param stations Station values the grid was computed from (drawn as markers)
+     */
+    PollutionMapDialog(wxWindow* parent, const wxString& paramCode, const InterpolationGrid& grid, const std::vector<StationValue>& stations);
+
+private:
+    wxPanel* mapPanel;                    /**< Panel the map is painted on */
+    wxImage heatmap;                      /**< Grid rendered at one pixel per cell */
+    wxBitmap scaledMap;                   /**< Heatmap scaled to the current map area */
+    std::vector<StationValue> stations;   /**< Station markers */
+    wxString paramCode;                   /**< Parameter code for the legend */
+    double west;                          /**< Longitude of the western edge of the grid */
+    double east;                          /**< Longitude of the eastern edge of the grid */
+    double south;                         /**< Latitude of the southern edge of the grid */
+    double north;                         /**< Latitude of the northern edge of the grid */
+    ColourScale scale;                    /**< Colour scale spanning the station values */
+
+    /**
+     * @brief Converts the grid into the heatmap image
+     * @param grid Interpolated grid
+     *
+     * Cells without a value become transparent.
+     */
+    void RenderHeatmap(const InterpolationGrid& grid);
+
+    /**
+     * @brief Event handler for paint events of the map panel
+     * @param event The paint event
+     */
+    void OnPaintMap(wxPaintEvent& event);
+
+    /**
+     * @brief Draws the colour scale with its minimum and maximum
+     * @param dc Device context for drawing
+     * @param area Rectangle available for the legend
+     */
+    void DrawLegend(wxDC& dc, const wxRect& area);
+};
+
+#endif // POLLUTION_MAP_DIALOG_H
@@ -0,0 +1,480 @@
+/**
+ * @file QuantileSketch.cpp
+ * @brief Implementation of the t-digest quantile sketch and per-sensor rollup store
+ */
+
+#include "QuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <set>
+
+#include "JsonFiles.h"
+#include "TimeSeries.h"
+
+namespace {
+    const std::string QUANTILE_STORE_DIRECTORY = "store";          ///< Subdirectory of a sensor directory holding derived data
+    const std::string QUANTILE_STORE_MONTHS = "quantiles";         ///< Subdirectory of the store holding one rollup file per month
+    const std::string LEGACY_QUANTILE_FILE = "quantiles.json";     ///< Single rollup file written by earlier versions
+    const size_t BUFFER_FACTOR = 5;                                ///< Buffer size relative to compression before compressing
+    const double PI = 3.14159265358979323846;                      ///< Pi
+
+    /**
+     * @brief k1 scale function mapping a quantile to the centroid index space
+     */
+    double ScaleK(double q, double compression) {
+        return compression / (2.0 * PI) * std::asin(2.0 * q - 1.0);
+    }
+
+    /**
+     * @brief Inverse of the k1 scale function
+     */
+    double ScaleKInverse(double k, double compression) {
+        return (std::sin(k * 2.0 * PI / compression) + 1.0) / 2.0;
+    }
+
+    /**
+     * @brief Returns the key of the last day of a month ("YYYY-MM" -> "YYYY-MM-DD")
+     */
+    std::string LastDayOfMonth(const std::string& month) {
+        static const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        int year = std::stoi(month.substr(0, 4));
+        int monthIndex = std::stoi(month.substr(5, 2)) - 1;
+        int lastDay = daysInMonth[std::clamp(monthIndex, 0, 11)];
+        if (monthIndex == 1 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
+            lastDay = 29;
+        }
+        return month + "-" + std::to_string(lastDay);
+    }
+
+    /**
+     * @brief Returns the path of the rollup file of a month
+     */
+    std::string MonthFilePath(const std::string& sensorDirectory, const std::string& month) {
+        return sensorDirectory + "/" + QUANTILE_STORE_DIRECTORY + "/" + QUANTILE_STORE_MONTHS + "/" + month + ".json";
+    }
+
+    /**
+     * @brief Splits the single rollup file of earlier versions into monthly files
+     *
+     * The monthly files are written before the old file is removed, so an interrupted
+     * migration is simply repeated on the next load.
+     */
+    void MigrateLegacyQuantileFile(const std::string& sensorDirectory) {
+        std::string path = sensorDirectory + "/" + QUANTILE_STORE_DIRECTORY + "/" + LEGACY_QUANTILE_FILE;
+        Json::Value root;
+        if (!std::filesystem::exists(path) || !LoadJsonFromFile(path, root)) {
+            return;
+        }
+
+        std::map<std::string, Json::Value> monthFiles;
+        const Json::Value& storedDays = root["days"];
+        for (const auto& day : storedDays.getMemberNames()) {
+            if (day.length() >= 7) {
+                monthFiles[day.substr(0, 7)]["days"][day] = storedDays[day];
+            }
+        }
+        const Json::Value& storedMonths = root["months"];
+        for (const auto& month : storedMonths.getMemberNames()) {
+            monthFiles[month]["month"] = storedMonths[month];
+        }
+
+        try {
+            std::filesystem::create_directories(sensorDirectory + "/" + QUANTILE_STORE_DIRECTORY + "/" + QUANTILE_STORE_MONTHS);
+            for (auto& [month, monthRoot] : monthFiles) {
+                SaveToFile(monthRoot, MonthFilePath(sensorDirectory, month));
+            }
+            std::filesystem::remove(path);
+        }
+        catch (const std::exception&) {
+            // Keep the old file; the migration is retried on the next load
+        }
+    }
+}
+
+/**
+ * @brief Constructor that creates an empty digest with the given compression
+ * @param compression Accuracy/size trade-off; larger values keep more centroids
+ */
+TDigest::TDigest(double compression)
+    : compression(compression),
+    minValue(std::numeric_limits<double>::max()),
+    maxValue(std::numeric_limits<double>::lowest()),
+    totalWeight(0.0) {
+}
+
+/**
+ * @brief Adds a value to the buffer, compressing when the buffer grows too large
+ * @param value Measured value
+ * @param weight Weight of the value (number of occurrences)
+ */
+void TDigest::Add(double value, double weight) {
+    if (std::isnan(value) || weight <= 0.0) {
+        return;
+    }
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    buffer.push_back({ value, weight });
+
+    if (buffer.size() >= BUFFER_FACTOR * static_cast<size_t>(compression)) {
+        Compress();
+    }
+}
+
+/**
+ * @brief Merges another digest by feeding its centroids through the compression step
+ * @param other Digest built from a different part of the data
+ */
+void TDigest::Merge(const TDigest& other) {
+    other.Compress();
+    if (other.centroids.empty()) {
+        return;
+    }
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    buffer.insert(buffer.end(), other.centroids.begin(), other.centroids.end());
+    Compress();
+}
+
+/**
+ * @brief Merges buffered values with existing centroids respecting the k1 size limit
+ *
+ * All centroids and buffered values are sorted by mean and greedily merged from left
+ * to right. Two neighbours are merged only while the resulting centroid stays within
+ * one unit of the k1 scale, which keeps centroids small near the tails.
+ */
+void TDigest::Compress() const {
+    if (buffer.empty()) {
+        return;
+    }
+
+    // Combine existing centroids with buffered values and sort by mean
+    buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+    std::sort(buffer.begin(), buffer.end(),
+        [](const Centroid& a, const Centroid& b) {
+            return a.mean < b.mean;
+        });
+
+    double total = 0.0;
+    for (const auto& c : buffer) {
+        total += c.weight;
+    }
+
+    std::vector<Centroid> merged;
+    merged.reserve(static_cast<size_t>(compression) + 1);
+
+    Centroid current = buffer[0];
+    double weightSoFar = 0.0;
+    double qLimit = ScaleKInverse(ScaleK(0.0, compression) + 1.0, compression) * total;
+
+    for (size_t i = 1; i < buffer.size(); i++) {
+        const Centroid& next = buffer[i];
+        if (weightSoFar + current.weight + next.weight <= qLimit) {
+            // Absorb the neighbour into the current centroid
+            current.weight += next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / current.weight;
+        }
+        else {
+            // Close the current centroid and start a new one
+            weightSoFar += current.weight;
+            merged.push_back(current);
+            qLimit = ScaleKInverse(ScaleK(weightSoFar / total, compression) + 1.0, compression) * total;
+            current = next;
+        }
+    }
+    merged.push_back(current);
+
+    centroids.swap(merged);
+    buffer.clear();
+    totalWeight = total;
+}
+
+/**
+ * @brief Estimates the value at quantile q by interpolating between centroid centres
+ * @param q Quantile in range [0, 1]
+ * @return Estimated value, or NaN if the digest is empty
+ *
+ * The extreme quantiles are interpolated towards the exact minimum and maximum,
+ * which are tracked separately.
+ */
+double TDigest::Quantile(double q) const {
+    Compress();
+    if (centroids.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (centroids.size() == 1) {
+        return centroids[0].mean;
+    }
+
+    q = std::clamp(q, 0.0, 1.0);
+    double index = q * totalWeight;
+
+    // Left tail: interpolate between the minimum and the first centroid
+    const Centroid& first = centroids.front();
+    if (index < first.weight / 2.0) {
+        return minValue + (first.mean - minValue) * index / (first.weight / 2.0);
+    }
+
+    // Walk the centroids accumulating weight between consecutive centres
+    double cumulative = first.weight / 2.0;
+    for (size_t i = 0; i + 1 < centroids.size(); i++) {
+        double gap = (centroids[i].weight + centroids[i + 1].weight) / 2.0;
+        if (cumulative + gap > index) {
+            double t = (index - cumulative) / gap;
+            return centroids[i].mean + t * (centroids[i + 1].mean - centroids[i].mean);
+        }
+        cumulative += gap;
+    }
+
+    // Right tail: interpolate between the last centroid and the maximum
+    const Centroid& last = centroids.back();
+    double t = (last.weight > 0.0) ? (index - cumulative) / (last.weight / 2.0) : 1.0;
+    return last.mean + (maxValue - last.mean) * std::min(t, 1.0);
+}
+
+/**
+ * @brief Gets the number of values represented by the digest
+ * @return Total weight of centroids and buffered values
+ */
+double TDigest::Count() const {
+    Compress();
+    return totalWeight;
+}
+
+/**
+ * @brief Serializes the digest to a compact JSON representation
+ * @return Json::Value containing compression, min, max and [mean, weight] centroid pairs
+ */
+Json::Value TDigest::ToJson() const {
+    Compress();
+    Json::Value json;
+    json["compression"] = compression;
+    json["centroids"] = Json::Value(Json::arrayValue);
+    if (!centroids.empty()) {
+        json["min"] = minValue;
+        json["max"] = maxValue;
+    }
+    for (const auto& c : centroids) {
+        Json::Value pair(Json::arrayValue);
+        pair.append(c.mean);
+        pair.append(c.weight);
+        json["centroids"].append(pair);
+    }
+    return json;
+}
+
+/**
+ * @brief Restores a digest from its JSON representation
+ * @param json Serialized digest produced by ToJson()
+ * @return Restored digest, or an empty digest if json is malformed
+ */
+TDigest TDigest::FromJson(const Json::Value& json) {
+    TDigest digest(json.isMember("compression") ? json["compression"].asDouble() : 100.0);
+    if (!json.isMember("centroids") || !json["centroids"].isArray()) {
+        return digest;
+    }
+
+    for (const auto& pair : json["centroids"]) {
+        if (pair.isArray() && pair.size() == 2) {
+            digest.centroids.push_back({ pair[0].asDouble(), pair[1].asDouble() });
+            digest.totalWeight += pair[1].asDouble();
+        }
+    }
+    if (!digest.centroids.empty()) {
+        digest.minValue = json.get("min", digest.centroids.front().mean).asDouble();
+        digest.maxValue = json.get("max", digest.centroids.back().mean).asDouble();
+    }
+    return digest;
+}
+
+/**
+ * @brief Loads the rollups of a range of days from "store/quantiles/<YYYY-MM>.json" inside the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param firstDay First day to be queried ("YYYY-MM-DD"), inclusive
+ * @param lastDay Last day to be queried ("YYYY-MM-DD"), inclusive
+ * @return true if a stored sketch file was found and parsed, false otherwise
+ *
+ * Only the months of the range are read; Ingest() reads the other months it touches.
+ * An empty range just attaches the store to the directory. A store written by an
+ * earlier version as a single file is split into monthly files first.
+ */
+bool SensorQuantileStore::Load(const std::string& sensorDirectory, const std::string& firstDay, const std::string& lastDay) {
+    directory = sensorDirectory;
+    days.clear();
+    months.clear();
+    loadedMonths.clear();
+    changedMonths.clear();
+
+    MigrateLegacyQuantileFile(sensorDirectory);
+
+    bool found = false;
+    for (const auto& month : ListMonths(firstDay, lastDay)) {
+        found = LoadMonth(month) || found;
+    }
+    return found;
+}
+
+/**
+ * @brief Reads the rollups of a month unless they were read already
+ * @param month Month key ("YYYY-MM")
+ * @return true if a stored file of the month was parsed, false otherwise
+ */
+bool SensorQuantileStore::LoadMonth(const std::string& month) {
+    if (directory.empty() || !loadedMonths.insert(month).second) {
+        return false;
+    }
+
+    Json::Value root;
+    std::string path = MonthFilePath(directory, month);
+    if (!std::filesystem::exists(path) || !LoadJsonFromFile(path, root)) {
+        return false;
+    }
+
+    const Json::Value& storedDays = root["days"];
+    for (const auto& day : storedDays.getMemberNames()) {
+        DailySketch sketch;
+        sketch.hours = storedDays[day]["hours"].asInt();
+        sketch.digest = TDigest::FromJson(storedDays[day]["digest"]);
+        days[day] = sketch;
+    }
+    if (root.isMember("month")) {
+        months[month] = TDigest::FromJson(root["month"]);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the months changed by Ingest() into "store/quantiles" inside the sensor directory
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @return true if the store was written successfully, false otherwise
+ */
+bool SensorQuantileStore::Save(const std::string& sensorDirectory) const {
+    try {
+        std::filesystem::create_directories(sensorDirectory + "/" + QUANTILE_STORE_DIRECTORY + "/" + QUANTILE_STORE_MONTHS);
+        for (const auto& month : changedMonths) {
+            Json::Value root;
+            root["days"] = Json::Value(Json::objectValue);
+            for (auto it = days.lower_bound(month); it != days.end() && it->first.compare(0, 7, month) == 0; ++it) {
+                root["days"][it->first]["hours"] = it->second.hours;
+                root["days"][it->first]["digest"] = it->second.digest.ToJson();
+            }
+            auto monthSketch = months.find(month);
+            if (monthSketch != months.end()) {
+                root["month"] = monthSketch->second.ToJson();
+            }
+            SaveToFile(root, MonthFilePath(sensorDirectory, month));
+        }
+        return true;
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Adds measurements to the daily and monthly rollups
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return true if any rollup changed, false otherwise
+ *
+ * Downloads overlap (every API response covers the last few days), so values are not
+ * simply appended. Instead a day is rebuilt from the incoming values only when they
+ * cover more hours than the stored sketch, which makes repeated ingestion
+ * of the same file idempotent and lets a partial day be completed later.
+ */
+bool SensorQuantileStore::Ingest(const std::vector<std::pair<std::string, double>>& data) {
+    // Group incoming values by day
+    std::map<std::string, std::vector<double>> incoming;
+    for (const auto& point : data) {
+        if (point.first.length() >= 10) {
+            incoming[point.first.substr(0, 10)].push_back(point.second);
+        }
+    }
+
+    std::set<std::string> touchedMonths;
+    for (const auto& [day, values] : incoming) {
+        LoadMonth(day.substr(0, 7));
+        auto existing = days.find(day);
+        if (existing != days.end() && existing->second.hours >= static_cast<int>(values.size())) {
+            continue;
+        }
+
+        // Rebuild the day from the more complete incoming data
+        DailySketch sketch;
+        sketch.hours = static_cast<int>(values.size());
+        for (double value : values) {
+            sketch.digest.Add(value);
+        }
+        days[day] = sketch;
+        touchedMonths.insert(day.substr(0, 7));
+    }
+
+    for (const auto& month : touchedMonths) {
+        RebuildMonth(month);
+        changedMonths.insert(month);
+    }
+    return !touchedMonths.empty();
+}
+
+/**
+ * @brief Rebuilds a monthly rollup by merging all stored days of that month
+ * @param month Month key ("YYYY-MM")
+ */
+void SensorQuantileStore::RebuildMonth(const std::string& month) {
+    TDigest digest;
+    for (auto it = days.lower_bound(month); it != days.end() && it->first.compare(0, 7, month) == 0; ++it) {
+        digest.Merge(it->second.digest);
+    }
+    months[month] = digest;
+}
+
+/**
+ * @brief Merges stored rollups covering the given range of days
+ * @param firstDay First day of the range ("YYYY-MM-DD"), inclusive
+ * @param lastDay Last day of the range ("YYYY-MM-DD"), inclusive
+ * @return Digest of all measurements in the range whose months were loaded
+ *
+ * Months lying completely inside the range are taken from the monthly rollups,
+ * only the partial months at both ends are assembled from daily sketches.
+ */
+TDigest SensorQuantileStore::Query(const std::string& firstDay, const std::string& lastDay) const {
+    TDigest result;
+    auto it = days.lower_bound(firstDay);
+
+    while (it != days.end() && it->first <= lastDay) {
+        std::string month = it->first.substr(0, 7);
+        bool monthStartsInside = month + "-01" >= firstDay;
+        bool monthEndsInside = LastDayOfMonth(month) <= lastDay;
+        auto monthSketch = months.find(month);
+
+        if (monthStartsInside && monthEndsInside && monthSketch != months.end()) {
+            // Whole month inside the range - use the monthly rollup and skip its days
+            result.Merge(monthSketch->second);
+            it = days.lower_bound(month + "-32");
+        }
+        else {
+            result.Merge(it->second.digest);
+            ++it;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Updates the quantile store of a sensor with freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return true if the store was updated successfully, false otherwise
+ *
+ * Only the months covered by the download are read and rewritten.
+ * The caller holds LockSensorStore() of the sensor directory.
+ */
+bool UpdateSensorQuantileStore(const std::string& sensorDirectory, const std::vector<std::pair<std::string, double>>& data) {
+    SensorQuantileStore store;
+    store.Load(sensorDirectory, std::string(), std::string());
+    if (!store.Ingest(data)) {
+        return true;
+    }
+    return store.Save(sensorDirectory);
+}
@@ -0,0 +1,420 @@
+/**
+ * @file SensorCatalog.cpp
+ * @brief Implementation of the read-only measurement database helpers
+ */
+
+#include "SensorCatalog.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    const std::string RANGE_SEPARATOR = "_to_"; ///< Separator between the oldest and newest date in data file names
+
+    /**
+     * @brief Parses a JSON file without reporting errors to the user
+     * @return true if the file was opened and parsed, false otherwise
+     */
+    bool ParseJsonFile(const std::string& filePath, Json::Value& output) {
+        std::ifstream file(filePath);
+        if (!file.is_open()) {
+            return false;
+        }
+        Json::CharReaderBuilder builder;
+        std::string errors;
+        return Json::parseFromStream(builder, file, &output, &errors);
+    }
+
+    /**
+     * @brief Reads a coordinate stored either as a number or as a string with a decimal point
+     * @return true if a finite value was read, false otherwise
+     */
+    bool ParseCoordinate(const Json::Value& field, double& value) {
+        if (field.isNumeric()) {
+            value = field.asDouble();
+            return true;
+        }
+        return field.isString() && ParseDecimal(field.asString(), value);
+    }
+
+    /**
+     * @brief Gets the part of a data file name describing its newest measurement
+     */
+    std::string NewestDateOfFile(const std::string& fileName) {
+        size_t pos = fileName.find(RANGE_SEPARATOR);
+        return (pos == std::string::npos) ? fileName : fileName.substr(pos + RANGE_SEPARATOR.length());
+    }
+}
+
+/**
+ * @brief Gets the numeric subdirectories of a directory
+ * @param directory Path to search
+ * @return Directory names converted to integers
+ *
+ * Numeric directory names represent station or sensor IDs; other directories
+ * (such as a sensor's store/ subdirectory) are skipped.
+ */
+std::vector<int> ListNumericDirectories(const std::string& directory) {
+    std::vector<int> dirIds;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.is_directory()) {
+            std::string dirName = entry.path().filename().string();
+            // Skip non-numeric directories
+            if (!dirName.empty() && dirName.length() < 10 &&
+                std::all_of(dirName.begin(), dirName.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+                dirIds.push_back(std::stoi(dirName));
+            }
+        }
+    }
+    return dirIds;
+}
+
+/**
+ * @brief Gets the data files stored for a sensor
+ * @param sensorDirectory Path of the sensor directory
+ * @return File names of the .json data files sorted by name
+ */
+std::vector<std::string> ListDataFiles(const std::string& sensorDirectory) {
+    std::vector<std::string> dataFiles;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(sensorDirectory, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            dataFiles.push_back(entry.path().filename().string());
+        }
+    }
+    std::sort(dataFiles.begin(), dataFiles.end());
+    return dataFiles;
+}
+
+/**
+ * @brief Finds the data file with the most recent measurements of a sensor
+ * @param sensorDirectory Path of the sensor directory
+ * @return Full path of the file, or an empty string if there is none
+ *
+ * The dates in file names are zero-padded, so comparing them as strings orders them in time.
+ */
+std::string FindLatestDataFile(const std::string& sensorDirectory) {
+    std::vector<std::string> dataFiles = ListDataFiles(sensorDirectory);
+    if (dataFiles.empty()) {
+        return "";
+    }
+
+    auto latest = std::max_element(dataFiles.begin(), dataFiles.end(),
+        [](const std::string& a, const std::string& b) {
+            return NewestDateOfFile(a) < NewestDateOfFile(b);
+        });
+    return sensorDirectory + "/" + *latest;
+}
+
+/**
+ * @brief Loads the sensor list of a station
+ * @param stationDirectory Path of the station directory containing sensors.json
+ * @param sensors [out] Sensors of the station
+ * @return true if the file was loaded and parsed successfully, false otherwise
+ *
+ * Entries without a numeric ID are skipped. The parameter code is read from
+ * param.paramCode as returned by the sensors API.
+ */
+bool LoadStationSensors(const std::string& stationDirectory, std::vector<SensorInfo>& sensors) {
+    Json::Value root;
+    if (!ParseJsonFile(stationDirectory + "/sensors.json", root) || !root.isArray()) {
+        return false;
+    }
+
+    sensors.clear();
+    for (const auto& sensor : root) {
+        if (!sensor.isMember("id") || !sensor["id"].isInt()) {
+            continue;
+        }
+        SensorInfo info;
+        info.id = sensor["id"].asInt();
+        if (sensor.isMember("param")) {
+            const Json::Value& param = sensor["param"];
+            info.paramCode = param.isMember("paramCode") ? param["paramCode"].asString() : "";
+            info.paramName = param.isMember("paramName") ? param["paramName"].asString() : "";
+        }
+        sensors.push_back(info);
+    }
+    return true;
+}
+
+/**
+ * @brief Parses a decimal number with a period as the decimal separator
+ * @param text Text of the number, optionally surrounded by whitespace
+ * @param value [out] Parsed value
+ * @return true if the whole text is one finite number, false otherwise
+ *
+ * Uses std::from_chars, which ignores the user's locale and neither allocates nor
+ * builds a stream, so it is cheap enough to run for every station of a list.
+ */
+bool ParseDecimal(const std::string& text, double& value) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(*begin))) {
+        begin++;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(*(end - 1)))) {
+        end--;
+    }
+
+    double parsed = 0.0;
+    std::from_chars_result result = std::from_chars(begin, end, parsed);
+    if (result.ec != std::errc() || result.ptr != end || !std::isfinite(parsed)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief Reduces the station list of the API to the fields stored in stations.json
+ * @param root Station array as returned by the API
+ * @return Station array with id, stationName, cityName and numeric gegrLat/gegrLon
+ *
+ * The API sends the coordinates as strings; they are parsed here, once, so that
+ * readers of stations.json get numbers. A coordinate that cannot be parsed is left
+ * out, which makes LoadStationLocations() skip the station.
+ */
+Json::Value NormalizeStationList(const Json::Value& root) {
+    Json::Value stations(Json::arrayValue);
+    if (!root.isArray()) {
+        return stations;
+    }
+
+    for (const auto& station : root) {
+        Json::Value normalized;
+        if (station.isMember("id")) {
+            normalized["id"] = station["id"];
+        }
+        if (station.isMember("stationName")) {
+            normalized["stationName"] = station["stationName"];
+        }
+        if (station["city"].isObject() && station["city"]["name"].isString()) {
+            normalized["cityName"] = station["city"]["name"];
+        }
+
+        double latitude, longitude;
+        if (ParseCoordinate(station["gegrLat"], latitude) && ParseCoordinate(station["gegrLon"], longitude)) {
+            normalized["gegrLat"] = latitude;
+            normalized["gegrLon"] = longitude;
+        }
+        stations.append(normalized);
+    }
+    return stations;
+}
+
+/**
+ * @brief Loads the stations with valid coordinates from stations.json
+ * @param stationsFile Path of stations.json
+ * @param stations [out] Stations with parsed gegrLat/gegrLon
+ * @return true if the file was loaded and parsed successfully, false otherwise
+ *
+ * Stations without an ID or with unparsable coordinates are skipped. Coordinates are
+ * numbers in files written by NormalizeStationList(); strings, as stored by earlier
+ * versions, are still accepted.
+ */
+bool LoadStationLocations(const std::string& stationsFile, std::vector<StationLocation>& stations) {
+    Json::Value root;
+    if (!ParseJsonFile(stationsFile, root) || !root.isArray()) {
+        return false;
+    }
+
+    stations.clear();
+    stations.reserve(root.size());
+    for (const auto& station : root) {
+        StationLocation location;
+        if (!station.isMember("id") || !ParseCoordinate(station["gegrLat"], location.latitude)
+            || !ParseCoordinate(station["gegrLon"], location.longitude)) {
+            continue;
+        }
+        location.id = station["id"].asInt();
+        location.name = station.isMember("stationName") ? station["stationName"].asString() : "";
+        location.city = station["cityName"].isString() ? station["cityName"].asString() : "";
+        stations.push_back(location);
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the stored stations with a sensor measuring a parameter
+ * @param databaseDirectory Path of the measurements directory (containing stations.json)
+ * @param paramCode Parameter code (e.g. "PM10")
+ * @return One entry per station measuring the parameter, in stations.json order
+ *
+ * Only the first sensor of a station measuring the parameter is returned.
+ */
+std::vector<StationSensor> FindSensorsMeasuring(const std::string& databaseDirectory, const std::string& paramCode) {
+    std::vector<StationLocation> locations;
+    if (!LoadStationLocations(databaseDirectory + "/stations.json", locations)) {
+        return std::vector<StationSensor>();
+    }
+    return FindSensorsMeasuring(databaseDirectory, locations, paramCode);
+}
+
+/**
+ * @brief Finds the stations of a loaded station list with a stored sensor measuring a parameter
+ * @param databaseDirectory Path of the measurements directory
+ * @param locations Stations to consider, e.g. the station table kept by the user interface
+ * @param paramCode Parameter code (e.g. "PM10")
+ * @return One entry per station measuring the parameter, in the order of the locations
+ *
+ * Only the first sensor of a station measuring the parameter is returned.
+ */
+std::vector<StationSensor> FindSensorsMeasuring(const std::string& databaseDirectory, const std::vector<StationLocation>& locations, const std::string& paramCode) {
+    std::vector<StationSensor> result;
+    for (const auto& location : locations) {
+        std::string stationDirectory = databaseDirectory + "/" + std::to_string(location.id);
+        std::vector<SensorInfo> sensors;
+        if (!LoadStationSensors(stationDirectory, sensors)) {
+            continue;
+        }
+        for (const auto& sensor : sensors) {
+            if (sensor.paramCode == paramCode) {
+                StationSensor entry;
+                entry.station = location;
+                entry.sensorId = sensor.id;
+                entry.sensorDirectory = stationDirectory + "/" + std::to_string(sensor.id);
+                result.push_back(entry);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Loads the measurements of a data file
+ * @param filePath Path of the data file
+ * @param key [out] Value of the "key" field (parameter code), empty if missing
+ * @param data [out] Date-value pairs of all non-null measurements
+ * @return true if the file was loaded and contains a values array, false otherwise
+ */
+bool LoadMeasurementFile(const std::string& filePath, std::string& key, std::vector<std::pair<std::string, double>>& data) {
+    Json::Value root;
+    if (!ParseJsonFile(filePath, root) || !root.isMember("values") || !root["values"].isArray()) {
+        return false;
+    }
+
+    key = root.isMember("key") ? root["key"].asString() : "";
+
+    const Json::Value& values = root["values"];
+    data.clear();
+    data.reserve(values.size());
+    for (Json::Value::ArrayIndex i = 0; i < values.size(); i++) {
+        const Json::Value& item = values[i];
+        if (item.isMember("value") && !item["value"].isNull() && item.isMember("date")) {
+            data.push_back(std::make_pair(item["date"].asString(), item["value"].asDouble()));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Loads the latest stored data of every sensor of a station
+ * @param stationDirectory Path of the station directory (containing sensors.json)
+ * @param pool Thread pool used to load the sensors in parallel, or nullptr to load them sequentially
+ * @return One entry per sensor in sensors.json order
+ *
+ * Each sensor is loaded into its own preallocated entry, so workers share no state.
+ * Sensors without stored data keep an empty series.
+ */
+std::vector<PollutantSeries> LoadStationSeries(const std::string& stationDirectory, ThreadPool* pool) {
+    std::vector<SensorInfo> sensors;
+    if (!LoadStationSensors(stationDirectory, sensors)) {
+        return std::vector<PollutantSeries>();
+    }
+
+    std::vector<PollutantSeries> pollutants(sensors.size());
+    auto loadSensor = [&](size_t i) {
+        pollutants[i].sensorId = sensors[i].id;
+        pollutants[i].paramCode = sensors[i].paramCode;
+
+        std::string filePath = FindLatestDataFile(stationDirectory + "/" + std::to_string(sensors[i].id));
+        if (filePath.empty()) {
+            return;
+        }
+
+        std::string key;
+        std::vector<std::pair<std::string, double>> data;
+        if (!LoadMeasurementFile(filePath, key, data)) {
+            return;
+        }
+
+        // Prefer the code from sensors.json, the file key holds the same code
+        if (pollutants[i].paramCode.empty()) {
+            pollutants[i].paramCode = key;
+        }
+        pollutants[i].series = ResampleToHourlyGrid(data);
+        };
+
+    if (pool) {
+        pool->ParallelFor(sensors.size(), loadSensor);
+    }
+    else {
+        for (size_t i = 0; i < sensors.size(); i++) {
+            loadSensor(i);
+        }
+    }
+    return pollutants;
+}
+
+/**
+ * @brief Loads every stored data file of a sensor as one hourly series
+ * @param sensorDirectory Path of the sensor directory
+ * @param pool Thread pool used to parse the files in parallel, or nullptr to parse them sequentially
+ * @param fileCount [out] Optional number of data files that could be read
+ * @param paramCode [out] Optional parameter code; if empty, it is taken from the first readable file
+ * @return HourlySeries covering all stored measurements
+ *
+ * Each file is parsed into its own preallocated entry; the entries are then joined in
+ * file name order, so the hourly grid keeps the value of the latest file for every hour.
+ */
+HourlySeries LoadSensorHistory(const std::string& sensorDirectory, ThreadPool* pool, size_t* fileCount, std::string* paramCode) {
+    std::vector<std::string> dataFiles = ListDataFiles(sensorDirectory);
+    std::vector<std::vector<std::pair<std::string, double>>> fileData(dataFiles.size());
+    std::vector<std::string> fileKeys(dataFiles.size());
+    std::vector<char> fileRead(dataFiles.size(), 0);
+    auto loadFile = [&](size_t i) {
+        if (LoadMeasurementFile(sensorDirectory + "/" + dataFiles[i], fileKeys[i], fileData[i])) {
+            fileRead[i] = 1;
+        }
+        else {
+            fileData[i].clear();
+        }
+        };
+
+    if (pool) {
+        pool->ParallelFor(dataFiles.size(), loadFile);
+    }
+    else {
+        for (size_t i = 0; i < dataFiles.size(); i++) {
+            loadFile(i);
+        }
+    }
+
+    if (fileCount) {
+        *fileCount = static_cast<size_t>(std::count(fileRead.begin(), fileRead.end(), 1));
+    }
+    for (size_t i = 0; i < dataFiles.size() && paramCode && paramCode->empty(); i++) {
+        if (fileRead[i]) {
+            *paramCode = fileKeys[i];
+        }
+    }
+
+    size_t total = 0;
+    for (const auto& data : fileData) {
+        total += data.size();
+    }
+    std::vector<std::pair<std::string, double>> merged;
+    merged.reserve(total);
+    for (auto& data : fileData) {
+        std::move(data.begin(), data.end(), std::back_inserter(merged));
+    }
+    return ResampleToHourlyGrid(merged);
+}
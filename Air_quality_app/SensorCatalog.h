@@ -0,0 +1,183 @@
+#ifndef SENSOR_CATALOG_H
+#define SENSOR_CATALOG_H
+
+#include <json/json.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "TimeSeries.h"
+
+/**
+ * @file SensorCatalog.h
+ * @brief Read-only access to the stored measurement database without UI dependencies
+ *
+ * The database layout is measurements/<stationId>/sensors.json for the sensor list and
+ * measurements/<stationId>/<sensorId>/<from>_to_<to>.json for the downloaded data files.
+ * These helpers report errors through their return values only, so they can be used
+ * from worker threads and batch jobs.
+ */
+
+ /**
+  * @struct SensorInfo
+  * @brief Description of a sensor taken from a station's sensors.json
+  */
+struct SensorInfo {
+    int id = -1;            /**< Sensor ID */
+    std::string paramCode;  /**< Parameter code (e.g. "PM10", "NO2") */
+    std::string paramName;  /**< Human-readable parameter name */
+};
+
+/**
+ * @struct StationLocation
+ * @brief Station entry of stations.json with its geographic position
+ */
+struct StationLocation {
+    int id = -1;             /**< Station ID */
+    std::string name;        /**< Station name (UTF-8) */
+    std::string city;        /**< Name of the station's city (UTF-8), empty if unknown */
+    double latitude = 0.0;   /**< Latitude in degrees */
+    double longitude = 0.0;  /**< Longitude in degrees */
+};
+
+/**
+ * @brief Gets the numeric subdirectories of a directory
+ * @param directory Path to search
+ * @return Directory names converted to integers (station or sensor IDs), empty if the directory does not exist
+ */
+std::vector<int> ListNumericDirectories(const std::string& directory);
+
+/**
+ * @brief Gets the data files stored for a sensor
+ * @param sensorDirectory Path of the sensor directory
+ * @return File names of the .json data files sorted by name
+ */
+std::vector<std::string> ListDataFiles(const std::string& sensorDirectory);
+
+/**
+ * @brief Finds the data file with the most recent measurements of a sensor
+ *
+ * Data files are named "<oldest>_to_<newest>.json" with "YYYY-MM-DD_HH" dates,
+ * so the newest data is found by comparing the part after "_to_".
+ *
+ * @param sensorDirectory Path of the sensor directory
+ * @return Full path of the file, or an empty string if there is none
+ */
+std::string FindLatestDataFile(const std::string& sensorDirectory);
+
+/**
+ * @brief Loads the sensor list of a station
+ * @param stationDirectory Path of the station directory containing sensors.json
+ * @param sensors [out] Sensors of the station
+ * @return true if the file was loaded and parsed successfully, false otherwise
+ */
+bool LoadStationSensors(const std::string& stationDirectory, std::vector<SensorInfo>& sensors);
+
+/**
+ * @brief Parses a decimal number with a period as the decimal separator
+ * @param text Text of the number, optionally surrounded by whitespace
+ * @param value [out] Parsed value
+ * @return true if the whole text is one finite number, false otherwise
+ */
+bool ParseDecimal(const std::string& text, double& value);
+
+/**
+ * @brief Reduces the station list of the API to the fields stored in stations.json
+ *
+ * Keeps id, stationName and the city name and converts the gegrLat/gegrLon strings
+ * of the API to numbers, so the coordinates are parsed once when the list is downloaded.
+ *
+ * @param root Station array as returned by the API
+ * @return Station array with id, stationName, cityName and numeric gegrLat/gegrLon
+ */
+Json::Value NormalizeStationList(const Json::Value& root);
+
+/**
+ * @brief Loads the stations with valid coordinates from stations.json
+ * @param stationsFile Path of stations.json
+ * @param stations [out] Stations with their coordinates (numbers, or strings in older files)
+ * @return true if the file was loaded and parsed successfully, false otherwise
+ */
+bool LoadStationLocations(const std::string& stationsFile, std::vector<StationLocation>& stations);
+
+/**
+ * @struct StationSensor
+ * @brief Station together with its sensor measuring a particular parameter
+ */
+struct StationSensor {
+    StationLocation station;     /**< Station with its position */
+    int sensorId = -1;           /**< ID of the station's sensor measuring the parameter */
+    std::string sensorDirectory; /**< Path of the sensor directory */
+};
+
+/**
+ * @brief Finds the stored stations with a sensor measuring a parameter
+ *
+ * Reads the station positions from stations.json and the sensor list of every station
+ * directory; stations without a stored sensor list or without the parameter are skipped.
+ *
+ * @param databaseDirectory Path of the measurements directory (containing stations.json)
+ * @param paramCode Parameter code (e.g. "PM10")
+ * @return One entry per station measuring the parameter, in stations.json order
+ */
+std::vector<StationSensor> FindSensorsMeasuring(const std::string& databaseDirectory, const std::string& paramCode);
+
+/**
+ * @brief Finds the stations of a loaded station list with a stored sensor measuring a parameter
+ *
+ * Same as the overload above, without reading stations.json again.
+ *
+ * @param databaseDirectory Path of the measurements directory
+ * @param locations Stations to consider, e.g. the station table kept by the user interface
+ * @param paramCode Parameter code (e.g. "PM10")
+ * @return One entry per station measuring the parameter, in the order of the locations
+ */
+std::vector<StationSensor> FindSensorsMeasuring(const std::string& databaseDirectory, const std::vector<StationLocation>& locations, const std::string& paramCode);
+
+/**
+ * @brief Loads the measurements of a data file
+ * @param filePath Path of the data file
+ * @param key [out] Value of the "key" field (parameter code), empty if missing
+ * @param data [out] Date-value pairs of all non-null measurements
+ * @return true if the file was loaded and contains a values array, false otherwise
+ */
+bool LoadMeasurementFile(const std::string& filePath, std::string& key, std::vector<std::pair<std::string, double>>& data);
+
+/**
+ * @struct PollutantSeries
+ * @brief Hourly measurements of one sensor with the parameter it measures
+ */
+struct PollutantSeries {
+    int sensorId = -1;      /**< Sensor ID */
+    std::string paramCode;  /**< Parameter code of the sensor */
+    HourlySeries series;    /**< Measurements aligned to an hourly grid (empty if no data is stored) */
+};
+
+/**
+ * @brief Loads the latest stored data of every sensor of a station
+ *
+ * For each sensor in sensors.json the data file with the newest measurements is
+ * parsed and aligned to an hourly grid.
+ *
+ * @param stationDirectory Path of the station directory (containing sensors.json)
+ * @param pool Thread pool used to load the sensors in parallel, or nullptr to load them sequentially
+ * @return One entry per sensor in sensors.json order (empty if the sensor list cannot be read)
+ */
+std::vector<PollutantSeries> LoadStationSeries(const std::string& stationDirectory, ThreadPool* pool);
+
+/**
+ * @brief Loads every stored data file of a sensor as one hourly series
+ *
+ * Downloads overlap (each covers the last few days), so the files are merged in name
+ * order and a later file overrides the hours it shares with an earlier one.
+ *
+ * @param sensorDirectory Path of the sensor directory
+ * @param pool Thread pool used to parse the files in parallel, or nullptr to parse them sequentially
+ * @param fileCount [out] Optional number of data files that could be read
+ * @param paramCode [out] Optional parameter code; if empty, it is taken from the data files
+ * @return HourlySeries covering all stored measurements (empty if there are none)
+ */
+HourlySeries LoadSensorHistory(const std::string& sensorDirectory, ThreadPool* pool, size_t* fileCount = nullptr, std::string* paramCode = nullptr);
+
+#endif // SENSOR_CATALOG_H
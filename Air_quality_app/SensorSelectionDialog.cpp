@@ -6,20 +6,22 @@
 #include "SensorSelectionDialog.h"
 
  /**
-  * @brief Constructor that creates a dialog for selecting a sensor from JSON data
+  * @brief Constructor that creates a dialog for selecting a sensor of a station
   *
   * Creates a modal dialog with a listbox containing sensor names extracted from
-  * the provided JSON data, along with OK and Cancel buttons.
+  * the provided sensors, along with OK and Cancel buttons.
   *
-  * The constructor parses the JSON data, extracts sensor information (ID and parameter name),
-  * and populates the listbox with the parameter names while storing the corresponding IDs.
+  * The listbox is populated with the parameter names of the sensors while the
+  * corresponding IDs are stored; sensors without a parameter name are skipped.
   *
   * @param parent Pointer to the parent window
-  * @param sensors JSON value containing an array of sensor objects, each with an "id" field
-  *                and a "param" object that contains a "paramName" field
+  * @param sensors Sensors of the station, as loaded from its sensors.json
+  * @param onHighlight Function called with the ID of the sensor under the cursor or
+  *                    selected with the keyboard, may be empty
   */
-SensorSelectionDialog::SensorSelectionDialog(wxWindow* parent, const Json::Value& sensors)
-    : wxDialog(parent, wxID_ANY, "Select Sensor", wxDefaultPosition, wxSize(400, 300)) {
+SensorSelectionDialog::SensorSelectionDialog(wxWindow* parent, const std::vector<SensorInfo>& sensors, std::function<void(int)> onHighlight)
+    : wxDialog(parent, wxID_ANY, "Select Sensor", wxDefaultPosition, wxSize(400, 300)),
+    onHighlight(std::move(onHighlight)), highlighted(wxNOT_FOUND) {
     wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
 
     // Create listbox to display sensors
@@ -35,20 +37,17 @@ SensorSelectionDialog::SensorSelectionDialog(wxWindow* parent, const Json::Value
     SetSizer(mainSizer);
 
     // Load sensors into the listbox
-    if (!sensors.isNull() && sensors.isArray()) {
-        for (Json::Value::ArrayIndex i = 0; i < sensors.size(); i++) {
-            const Json::Value& sensor = sensors[i];
-            if (sensor.isMember("id") && sensor.isMember("param") && sensor["param"].isMember("paramName")) {
-                wxString paramName = wxString::FromUTF8(sensor["param"]["paramName"].asString());
-                int id = sensor["id"].asInt();
-                sensorIds.push_back(id);
-                sensorListBox->Append(paramName);
-            }
+    for (const auto& sensor : sensors) {
+        if (!sensor.paramName.empty()) {
+            sensorIds.push_back(sensor.id);
+            sensorListBox->Append(wxString::FromUTF8(sensor.paramName));
         }
     }
 
     // Bind events
     sensorListBox->Bind(wxEVT_LISTBOX_DCLICK, &SensorSelectionDialog::OnDoubleClick, this);
+    sensorListBox->Bind(wxEVT_LISTBOX, &SensorSelectionDialog::OnSelectionChanged, this);
+    sensorListBox->Bind(wxEVT_MOTION, &SensorSelectionDialog::OnMouseMove, this);
 }
 
 /**
@@ -63,6 +62,39 @@ void SensorSelectionDialog::OnDoubleClick(wxCommandEvent& event) {
     EndModal(wxID_OK);
 }
 
+/**
+ * @brief Handler for selection changes that reports the newly selected sensor
+ * @param event The wxCommandEvent associated with the selection
+ */
+void SensorSelectionDialog::OnSelectionChanged(wxCommandEvent& event) {
+    Highlight(sensorListBox->GetSelection());
+}
+
+/**
+ * @brief Handler for mouse movement that reports the sensor under the cursor
+ * @param event The wxMouseEvent with the cursor position
+ */
+void SensorSelectionDialog::OnMouseMove(wxMouseEvent& event) {
+    Highlight(sensorListBox->HitTest(event.GetPosition()));
+    event.Skip();
+}
+
+/**
+ * @brief Reports the sensor at a position of the list unless it is already highlighted
+ * @param item Position in the list, wxNOT_FOUND for none
+ *
+ * Moving within one item reports it only once.
+ */
+void SensorSelectionDialog::Highlight(int item) {
+    if (item == wxNOT_FOUND || item == highlighted || item >= static_cast<int>(sensorIds.size())) {
+        return;
+    }
+    highlighted = item;
+    if (onHighlight) {
+        onHighlight(sensorIds[item]);
+    }
+}
+
 /**
  * @brief Retrieves selected sensor information if a valid selection exists
  *
@@ -3,7 +3,9 @@
 
 #include <wx/wx.h>
 #include <vector>
-#include <json/json.h>
+#include <functional>
+
+#include "SensorCatalog.h"
 
 /**
  * @file SensorSelectionDialog.h
@@ -14,9 +16,11 @@
   * @class SensorSelectionDialog
   * @brief A dialog that displays a list of sensors and allows the user to select one
   *
-  * This dialog presents a list of sensors parsed from JSON data and provides
+  * This dialog presents a list of sensors of a station and provides
   * functionality for selecting a sensor either by double-clicking on it
-  * or by selecting it and clicking the OK button.
+  * or by selecting it and clicking the OK button. The sensor under the cursor or
+  * the keyboard selection is reported while the dialog is open, so its data can be
+  * downloaded before it is chosen.
   */
 class SensorSelectionDialog : public wxDialog {
 private:
@@ -40,16 +44,33 @@ private:
      */
     wxString selectedParamName;
 
+    /**
+     * @brief Called with the ID of a newly highlighted sensor, may be empty
+     */
+    std::function<void(int)> onHighlight;
+
+    /**
+     * @brief Position of the last highlighted sensor in the list, wxNOT_FOUND if none
+     */
+    int highlighted;
+
+    /**
+     * @brief Reports the sensor at a position of the list unless it is already highlighted
+     * @param item Position in the list
+     */
+    void Highlight(int item);
+
 public:
     /**
      * @brief Constructor that creates a sensor selection dialog
      *
-     * Creates a dialog with a list of sensors parsed from JSON data.
+     * Creates a dialog with a list of the given sensors.
      *
      * @param parent Pointer to the parent window
-     * @param sensors JSON value containing the sensor data array
+     * @param sensors Sensors of the station
+     * @param onHighlight Function called with the ID of the sensor under the cursor or selected with the keyboard
      */
-    SensorSelectionDialog(wxWindow* parent, const Json::Value& sensors);
+    SensorSelectionDialog(wxWindow* parent, const std::vector<SensorInfo>& sensors, std::function<void(int)> onHighlight = nullptr);
 
     /**
      * @brief Event handler for double-click events on the sensor list
@@ -60,6 +81,18 @@ public:
      */
     void OnDoubleClick(wxCommandEvent& event);
 
+    /**
+     * @brief Event handler for selection changes in the sensor list
+     * @param event The wxCommandEvent associated with the selection
+     */
+    void OnSelectionChanged(wxCommandEvent& event);
+
+    /**
+     * @brief Event handler for mouse movement over the sensor list
+     * @param event The wxMouseEvent with the cursor position
+     */
+    void OnMouseMove(wxMouseEvent& event);
+
     /**
      * @brief Gets information about the selected sensor
      *
@@ -0,0 +1,78 @@
+/**
+ * @file SensorStores.cpp
+ * @brief Implementation of the serialized per-sensor store updates
+ */
+
+#include "SensorStores.h"
+
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AnomalyDetection.h"
+#include "ExceedanceEngine.h"
+#include "Forecasting.h"
+#include "QuantileSketch.h"
+#include "TimeSeries.h"
+
+/**
+ * @brief Locks the stores of a sensor directory against concurrent updates
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @return Lock released when it goes out of scope
+ *
+ * The mutexes are created on first use and kept for the lifetime of the program (one per
+ * sensor that was opened). The directory is normalized first, so paths built by
+ * concatenation and paths returned by directory iteration share a mutex.
+ */
+std::unique_lock<std::mutex> LockSensorStore(const std::string& sensorDirectory) {
+    static std::mutex registryMutex;
+    static std::unordered_map<std::string, std::unique_ptr<std::mutex>> storeMutexes;
+
+    std::string key = std::filesystem::path(sensorDirectory).lexically_normal().generic_string();
+    std::mutex* storeMutex;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        std::unique_ptr<std::mutex>& entry = storeMutexes[key];
+        if (!entry) {
+            entry = std::make_unique<std::mutex>();
+        }
+        storeMutex = entry.get();
+    }
+    return std::unique_lock<std::mutex>(*storeMutex);
+}
+
+/**
+ * @brief Updates all stores of a sensor with freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param paramCode Parameter code of the sensor
+ * @param values JSON array of {date, value} objects
+ * @return true if every store was updated successfully, false otherwise
+ *
+ * This function:
+ * 1. Converts the values and aligns them to the hourly grid once for all stores
+ * 2. Locks the sensor's stores, so a concurrent download or backfill of the same sensor
+ *    cannot interleave its read-modify-write cycles with this one
+ * 3. Updates the quantile rollups, exceedance counters, forecast model and anomaly flags
+ */
+bool UpdateSensorStores(const std::string& sensorDirectory, const std::string& paramCode, const Json::Value& values) {
+    std::vector<std::pair<std::string, double>> data;
+    data.reserve(values.size());
+    for (const auto& item : values) {
+        if (item.isMember("date") && item.isMember("value") && !item["value"].isNull()) {
+            data.push_back(std::make_pair(item["date"].asString(), item["value"].asDouble()));
+        }
+    }
+    HourlySeries series = ResampleToHourlyGrid(data);
+    if (series.values.empty()) {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> lock = LockSensorStore(sensorDirectory);
+    bool success = UpdateSensorQuantileStore(sensorDirectory, data);
+    success = UpdateSensorExceedanceStore(sensorDirectory, paramCode, data) && success;
+    success = UpdateSensorForecastModel(sensorDirectory, series) && success;
+    success = UpdateSensorAnomalyFlags(sensorDirectory, series) && success;
+    return success;
+}
@@ -0,0 +1,34 @@
+#ifndef SENSOR_STORES_H
+#define SENSOR_STORES_H
+
+#include <json/json.h>
+#include <mutex>
+#include <string>
+
+/**
+ * @file SensorStores.h
+ * @brief Serialized updates of the derived data kept in a sensor's "store" directory
+ */
+
+ /**
+  * @brief Locks the stores of a sensor directory against concurrent updates
+  *
+  * Downloads run on several worker threads while the UI thread backfills the stores of
+  * the file it shows, so every load-modify-save of a store file has to hold this lock.
+  * Different sensors use different mutexes and do not wait for each other.
+  *
+  * @param sensorDirectory Directory containing the sensor's measurement files
+  * @return Lock released when it goes out of scope
+  */
+std::unique_lock<std::mutex> LockSensorStore(const std::string& sensorDirectory);
+
+/**
+ * @brief Updates all stores of a sensor with freshly downloaded values
+ * @param sensorDirectory Directory containing the sensor's measurement files
+ * @param paramCode Parameter code of the sensor
+ * @param values JSON array of {date, value} objects
+ * @return true if every store was updated successfully, false otherwise
+ */
+bool UpdateSensorStores(const std::string& sensorDirectory, const std::string& paramCode, const Json::Value& values);
+
+#endif // SENSOR_STORES_H
@@ -14,7 +14,7 @@
  * Sets a light gray background color and initializes all UI elements and selection state variables.
  */
 SidePanel::SidePanel(wxWindow* parent)
-    : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxSize(350, 800)) {
+    : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxSize(350, 800)), metadata(DATABASE_DIRECTORRY), liveFeed(LIVE_CAPACITY_HOURS), liveTimer(this), livePollRunning(false), exportRunning(false), aqiRunning(false), batchRunning(false), downloads(DOWNLOAD_CONNECTIONS) {
 
     SetBackgroundColour(wxColour(220, 220, 220));
 
@@ -29,6 +29,33 @@ SidePanel::SidePanel(wxWindow* parent)
     selectedFileName = "";
 }
 
+/**
+ * @brief Destructor that stops the live view and the chart export
+ *
+ * A periodic download or chart export still running holds a pointer to this panel, so
+ * it is waited for; all downloads and the remaining charts are cancelled first so that
+ * the wait does not last until they finish.
+ */
+SidePanel::~SidePanel() {
+    liveTimer.Stop();
+    downloads.CancelAll();
+    exportCancel.Cancel();
+    aqiCancel.Cancel();
+    batchCancel.Cancel();
+    if (liveThread.joinable()) {
+        liveThread.join();
+    }
+    if (exportThread.joinable()) {
+        exportThread.join();
+    }
+    if (aqiThread.joinable()) {
+        aqiThread.join();
+    }
+    if (batchThread.joinable()) {
+        batchThread.join();
+    }
+}
+
 /**
  * @brief Connects this side panel to other panels for data communication
  * @param info Pointer to the InfoPanel instance that displays textual information
@@ -46,8 +73,9 @@ void SidePanel::ConnectToPanels(InfoPanel* info, ChartPanel* chart) {
  * @brief Creates and arranges all UI elements including buttons and status text displays
  *
  * Sets up the vertical layout with buttons for station selection, sensor selection,
- * data file selection, and data viewing. Also creates status text labels to display
- * the currently selected items.
+ * data file selection, data viewing, the air quality index, the batch report,
+ * the correlation matrix, the pollution map, the calendar view, the station comparison, the live view and the chart export. Also creates status text labels
+ * to display the currently selected items.
  */
 void SidePanel::InitializeUI() {
     wxBoxSizer* btnSizer = new wxBoxSizer(wxVERTICAL);
@@ -56,6 +84,14 @@ void SidePanel::InitializeUI() {
     btn2 = new wxButton(this, wxID_ANY, "Chose sensor");
     btn3 = new wxButton(this, wxID_ANY, "Select data");
     btn4 = new wxButton(this, wxID_ANY, "View stored data");
+    btn5 = new wxButton(this, wxID_ANY, "Air quality index");
+    btn6 = new wxButton(this, wxID_ANY, "Batch report");
+    btn7 = new wxButton(this, wxID_ANY, "Correlations");
+    btn8 = new wxButton(this, wxID_ANY, "Pollution map");
+    btn9 = new wxButton(this, wxID_ANY, "Calendar view");
+    btn10 = new wxButton(this, wxID_ANY, "Compare stations");
+    btn11 = new wxButton(this, wxID_ANY, "Live view");
+    btn12 = new wxButton(this, wxID_ANY, "Export charts");
 
     // Set button fonts
     wxFont buttonFont(10, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD);
@@ -64,6 +100,14 @@ void SidePanel::InitializeUI() {
     btn2->SetFont(buttonFont);
     btn3->SetFont(buttonFont);
     btn4->SetFont(buttonFont);
+    btn5->SetFont(buttonFont);
+    btn6->SetFont(buttonFont);
+    btn7->SetFont(buttonFont);
+    btn8->SetFont(buttonFont);
+    btn9->SetFont(buttonFont);
+    btn10->SetFont(buttonFont);
+    btn11->SetFont(buttonFont);
+    btn12->SetFont(buttonFont);
 
     // Initialize status text controls
     wxFont statusFont(9, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
@@ -80,6 +124,14 @@ void SidePanel::InitializeUI() {
     btnSizer->Add(btn2, 0, wxALL | wxEXPAND, 10);
     btnSizer->Add(btn3, 0, wxALL | wxEXPAND, 10);
     btnSizer->Add(btn4, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn5, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn6, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn7, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn8, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn9, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn10, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn11, 0, wxALL | wxEXPAND, 10);
+    btnSizer->Add(btn12, 0, wxALL | wxEXPAND, 10);
     btnSizer->Add(selectedStationText, 0, wxALL | wxEXPAND, 10);
     btnSizer->Add(selectedSensorText, 0, wxALL | wxEXPAND, 10);
     btnSizer->Add(selectedFileText, 0, wxALL | wxEXPAND, 10);
@@ -98,6 +150,15 @@ void SidePanel::BindEvents() {
     btn2->Bind(wxEVT_BUTTON, &SidePanel::OnChooseSensor, this);
     btn3->Bind(wxEVT_BUTTON, &SidePanel::OnShowDataFiles, this);
     btn4->Bind(wxEVT_BUTTON, &SidePanel::OnViewStoredData, this);
+    btn5->Bind(wxEVT_BUTTON, &SidePanel::OnShowAirQualityIndex, this);
+    btn6->Bind(wxEVT_BUTTON, &SidePanel::OnRunBatchReport, this);
+    btn7->Bind(wxEVT_BUTTON, &SidePanel::OnShowCorrelations, this);
+    btn8->Bind(wxEVT_BUTTON, &SidePanel::OnShowPollutionMap, this);
+    btn9->Bind(wxEVT_BUTTON, &SidePanel::OnShowCalendar, this);
+    btn10->Bind(wxEVT_BUTTON, &SidePanel::OnCompareStations, this);
+    btn11->Bind(wxEVT_BUTTON, &SidePanel::OnLiveView, this);
+    btn12->Bind(wxEVT_BUTTON, &SidePanel::OnExportCharts, this);
+    Bind(wxEVT_TIMER, &SidePanel::OnLiveTimer, this);
 }
 
 /**
@@ -148,6 +209,30 @@ void SidePanel::UpdateSelectedFileDisplay() {
     }
 }
 
+/**
+ * @brief Selects a station, cancelling the downloads of the previous one
+ * @param id ID of the station
+ * @param name Name of the station
+ *
+ * The queued and running downloads of the previous station are cancelled (unless it is
+ * followed by the live view), so their connections are free for the new station. The
+ * sensor selection is reset since it's no longer valid.
+ */
+void SidePanel::SetSelectedStation(int id, const wxString& name) {
+    std::string previousStation = DATABASE_DIRECTORRY + "/" + std::to_string(selectedStationId);
+    if (id != selectedStationId && previousStation != liveStationDirectory) {
+        downloads.CancelGroup(previousStation);
+    }
+
+    selectedStationId = id;
+    selectedStationName = name;
+    UpdateSelectedStationDisplay();
+
+    selectedSensorId = -1;
+    selectedSensorParamName = "";
+    UpdateSelectedSensorDisplay();
+}
+
 /**
  * @brief Handles station selection by downloading station data if needed and showing selection dialog
  * @param event The button click event (unused)
@@ -155,9 +240,10 @@ void SidePanel::UpdateSelectedFileDisplay() {
  * This method:
  * 1. Ensures the data directory exists
  * 2. Downloads the station list from the API if it doesn't exist locally
- * 3. Opens a dialog for the user to select a station
- * 4. Updates the selection state and display when a station is selected
- * 5. Resets the sensor selection since it's no longer valid
+ * 3. Gets the station list from the metadata repository, which parses and indexes it on first use
+ * 4. Opens a dialog for the user to select a station, nearest stations first
+ * 5. Selects the chosen station through SetSelectedStation(), which resets the sensor
+ *    selection and cancels the downloads of the previous station
  */
 void SidePanel::OnChoseStation(wxCommandEvent& event) {
     std::string DATABASE_STATIONS = DATABASE_DIRECTORRY + "/stations.json";
@@ -165,55 +251,26 @@ void SidePanel::OnChoseStation(wxCommandEvent& event) {
 
     // Handles download of the station list
     if (!std::filesystem::exists(DATABASE_STATIONS)) {
-        auto stationTransformer = [](const Json::Value& root) {
-            Json::Value filteredStations(Json::arrayValue);
-
-            for (Json::Value::ArrayIndex i = 0; i < root.size(); i++) {
-                const Json::Value& station = root[i];
-                Json::Value filteredStation;
-
-                if (station.isMember("id"))
-                    filteredStation["id"] = station["id"];
-
-                if (station.isMember("stationName"))
-                    filteredStation["stationName"] = station["stationName"];
-
-                if (station.isMember("gegrLat"))
-                    filteredStation["gegrLat"] = station["gegrLat"];
-
-                if (station.isMember("gegrLon"))
-                    filteredStation["gegrLon"] = station["gegrLon"];
-
-                filteredStations.append(filteredStation);
-            }
-            return filteredStations;
-            };
-
-        bool success = DownloadJsonAndSaveToFile(STATIONS_API_URL, DATABASE_STATIONS, stationTransformer);
+        // Coordinates are stored as numbers, parsed once here instead of by every reader
+        bool success = DownloadJsonAndSaveToFile(STATIONS_API_URL, DATABASE_STATIONS, NormalizeStationList);
         if (!success) {
             return;
         }
+        metadata.InvalidateStations();
     }
 
-    Json::Value stations;
-    if (!LoadJsonFromFile(DATABASE_STATIONS, stations)) {
+    if (!metadata.LoadStations()) {
         wxMessageBox("Could not open or parse stations file.", "Error", wxOK | wxICON_ERROR);
         return;
     }
 
     // Invokes station selection class to chose station and updates display for chosen station
-    StationSelectionDialog dialog(this, stations);
+    StationSelectionDialog dialog(this, metadata.Stations(), metadata.StationSearch());
     if (dialog.ShowModal() == wxID_OK) {
         int id;
         wxString name;
         if (dialog.GetSelectedStation(id, name)) {
-            selectedStationId = id;
-            selectedStationName = name;
-            UpdateSelectedStationDisplay();
-
-            selectedSensorId = -1;
-            selectedSensorParamName = "";
-            UpdateSelectedSensorDisplay();
+            SetSelectedStation(id, name);
         }
     }
 }
@@ -225,10 +282,12 @@ void SidePanel::OnChoseStation(wxCommandEvent& event) {
  * This method:
  * 1. Checks if a station is selected
  * 2. Downloads the sensor list for the station if it doesn't exist locally
- * 3. Starts parallel downloads for all sensor data
- * 4. Opens a dialog for the user to select a sensor
+ * 3. Queues background downloads for all sensor data
+ * 4. Opens a dialog for the user to select a sensor; the highlighted sensor's download
+ *    is moved ahead of the others if it is still queued
  * 5. Updates the selection state and display when a sensor is selected
- * 6. Reports any download failures and ensures the selected sensor's data is available
+ * 6. Waits only for the selected sensor's download, so the chart is available after a
+ *    single request while the other sensors keep downloading
  */
 void SidePanel::OnChooseSensor(wxCommandEvent& event) {
     if (selectedStationId == -1) {
@@ -241,37 +300,40 @@ void SidePanel::OnChooseSensor(wxCommandEvent& event) {
     std::string apiUrl = SENSORS_API_URL + std::to_string(selectedStationId);
 
     // Downloads list of sensors for station
-    if (!InitializeSensorDatabase(STATION_DIRECTORY, DATABASE_SENSORS, apiUrl)) {
+    if (!InitializeSensorDatabase(selectedStationId, STATION_DIRECTORY, DATABASE_SENSORS, apiUrl)) {
         return;
     }
 
-    // Loads list of sensor into json object
-    Json::Value sensors;
-    if (!LoadSensorsData(DATABASE_SENSORS, sensors)) {
+    // Loads list of sensors from the metadata repository
+    std::vector<SensorInfo> sensors;
+    if (!LoadSensorsData(selectedStationId, sensors)) {
         return;
     }
 
-    // Start downloading data for all sensors in parallel
-    std::vector<std::string> failedSensors;
-    DownloadAllSensorsData(STATION_DIRECTORY, sensors, failedSensors);
-
-    // Invokes sensor selection class to chose sensor and updates display for chosen sensor
-    SensorSelectionDialog dialog(this, sensors);
-    if (dialog.ShowModal() == wxID_OK) {
-        int id;
-        wxString paramName;
-        if (dialog.GetSelectedSensor(id, paramName)) {
-            selectedSensorId = id;
-            selectedSensorParamName = paramName;
-            UpdateSelectedSensorDisplay();
-        }
+    // Start downloading data for all sensors in the background
+    PrefetchSensorsData(STATION_DIRECTORY, sensors);
+
+    // Invokes sensor selection class to chose sensor and updates display for chosen sensor;
+    // the sensor under the cursor is likely the next choice, so its queued download goes first
+    SensorSelectionDialog dialog(this, sensors, [this, STATION_DIRECTORY](int sensorId) {
+        downloads.Promote(STATION_DIRECTORY + "/" + std::to_string(sensorId));
+        });
+    int result = dialog.ShowModal();
+    downloads.DeprioritizeInteractive();
+    if (result != wxID_OK) {
+        return;
     }
 
-    // Report any download failures
-    ReportFailedDownloads(failedSensors);
+    int id;
+    wxString paramName;
+    if (dialog.GetSelectedSensor(id, paramName)) {
+        selectedSensorId = id;
+        selectedSensorParamName = paramName;
+        UpdateSelectedSensorDisplay();
 
-    // Ensure the selected sensor's data is available
-    EnsureSelectedSensorData(STATION_DIRECTORY, failedSensors);
+        // Ensure the selected sensor's data is available
+        EnsureSelectedSensorData(STATION_DIRECTORY);
+    }
 }
 
 /**
@@ -353,17 +415,25 @@ void SidePanel::OnViewStoredData(wxCommandEvent& event) {
     }
 
     // Load the full stations data
-    Json::Value allStations;
-    if (!LoadJsonFromFile(DATABASE_STATIONS, allStations)) {
+    if (!metadata.LoadStations()) {
         wxMessageBox("Could not open or parse stations file.", "Error", wxOK | wxICON_ERROR);
         return;
     }
 
-    // Filter stations
-    Json::Value filteredStations = FilterItemsByExistingDirectories(allStations, stationDirIds);
+    // Filter stations and index the ones with stored data
+    std::vector<StationLocation> storedStations;
+    for (const auto& station : metadata.Stations().Stations()) {
+        if (std::find(stationDirIds.begin(), stationDirIds.end(), station.id) != stationDirIds.end()) {
+            storedStations.push_back(station);
+        }
+    }
+    StationLocator storedLocator;
+    storedLocator.Build(storedStations);
+    StationSearchIndex storedSearch;
+    storedSearch.Build(storedStations);
 
     // Select a station
-    if (SelectStation(filteredStations)) {
+    if (SelectStation(storedLocator, storedSearch)) {
         // Select a sensor
         if (SelectSensor()) {
             // Show available data files for the selected sensor
@@ -372,37 +442,460 @@ void SidePanel::OnViewStoredData(wxCommandEvent& event) {
     }
 }
 
+/**
+ * @brief Shows the air quality index of the selected station or of all stored stations
+ * @param event The button click event (unused)
+ *
+ * With a station selected, the latest data of all its sensors is downloaded and the
+ * hourly station index is displayed. Without a selection, the current index of every
+ * station with stored data is computed and summarized.
+ */
+void SidePanel::OnShowAirQualityIndex(wxCommandEvent& event) {
+    if (selectedStationId == -1) {
+        ShowAllStationsAirQualityIndex();
+    }
+    else {
+        ShowStationAirQualityIndex();
+    }
+}
+
+/**
+ * @brief Analyses every stored sensor and writes a consolidated report
+ * @param event The button click event (unused)
+ *
+ * This method:
+ * 1. Checks if any data exists and no batch report is running
+ * 2. Runs the batch analytics over all stored sensors on a background thread with its
+ *    own thread pool, so the window stays responsive during the database scan
+ * 3. Writes the report as CSV and JSON into the reports directory
+ * 4. Shows the number of analysed sensors and the throughput of the run when it is done
+ */
+void SidePanel::OnRunBatchReport(wxCommandEvent& event) {
+    if (!CheckForDownloadedData()) {
+        return;
+    }
+    if (batchRunning) {
+        wxMessageBox("A batch report is already running.", "Batch Report", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    if (batchThread.joinable()) {
+        batchThread.join();
+    }
+
+    batchRunning = true;
+    batchThread = std::thread([this]() {
+        ThreadPool batchPool;
+        BatchReport report = RunBatchAnalytics(DATABASE_DIRECTORRY, batchPool, batchCancel);
+
+        std::string csvPath;
+        std::string jsonPath;
+        if (!report.sensors.empty() && !batchCancel.IsCancelled()) {
+            std::error_code error;
+            std::filesystem::create_directories(REPORTS_DIRECTORY, error);
+            csvPath = REPORTS_DIRECTORY + "/batch_report.csv";
+            jsonPath = REPORTS_DIRECTORY + "/batch_report.json";
+            if (!WriteBatchReportCsv(report, csvPath) || !WriteBatchReportJson(report, jsonPath)) {
+                csvPath.clear();
+                jsonPath.clear();
+            }
+        }
+        batchRunning = false;
+        if (!batchCancel.IsCancelled()) {
+            CallAfter([this, report, csvPath, jsonPath]() { ShowBatchReportSummary(report, csvPath, jsonPath); });
+        }
+        });
+}
+
+/**
+ * @brief Shows the results of a finished batch report
+ * @param report Report of the run
+ * @param csvPath Path of the CSV report, empty if it could not be written
+ * @param jsonPath Path of the JSON report, empty if it could not be written
+ */
+void SidePanel::ShowBatchReportSummary(const BatchReport& report, const std::string& csvPath, const std::string& jsonPath) {
+    if (report.sensors.empty()) {
+        wxMessageBox("No sensor data found. Please download sensor data first.",
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+    if (csvPath.empty() || jsonPath.empty()) {
+        wxMessageBox("Could not write the batch report.", "Error", wxOK | wxICON_ERROR);
+        return;
+    }
+
+    size_t failed = std::count_if(report.sensors.begin(), report.sensors.end(),
+        [](const SensorReport& sensor) { return !sensor.error.empty(); });
+
+    wxString summary = wxString::Format("Analysed %d sensors (%d without usable data) in %.2f s\n"
+        "Throughput: %.1f sensors/s on %d threads\n\nReport saved to:\n%s\n%s",
+        static_cast<int>(report.sensors.size()), static_cast<int>(failed), report.elapsedSeconds,
+        report.SensorsPerSecond(), static_cast<int>(report.workerCount), csvPath, jsonPath);
+    wxMessageBox(summary, "Batch Report", wxOK | wxICON_INFORMATION);
+}
+
+/**
+ * @brief Shows the correlation matrix of the selected station's pollutants
+ * @param event The button click event (unused)
+ *
+ * Uses the newest stored data file of every sensor of the station, loaded on the
+ * analysis thread pool, and displays the matrix in the info panel.
+ */
+void SidePanel::OnShowCorrelations(wxCommandEvent& event) {
+    if (selectedStationId == -1) {
+        wxMessageBox("Please select a station first.", "No Station Selected", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    std::string STATION_DIRECTORY = DATABASE_DIRECTORRY + "/" + std::to_string(selectedStationId);
+    std::vector<PollutantSeries> series = LoadStationSeries(STATION_DIRECTORY, &analysisPool);
+
+    CorrelationMatrix matrix = ComputeCorrelationMatrix(series);
+    if (matrix.labels.size() < 2) {
+        wxMessageBox("At least two sensors with stored data are needed. Please download sensor data first.",
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    if (infoPanel) {
+        infoPanel->UpdateCorrelations(selectedStationName, FormatCorrelationTable(matrix));
+    }
+}
+
+/**
+ * @brief Shows an interpolated map of a parameter across all stored stations
+ * @param event The button click event (unused)
+ *
+ * This method:
+ * 1. Asks for the parameter to map
+ * 2. Loads the latest stored value of the parameter at every station (in parallel)
+ * 3. Interpolates the values onto a 1 km grid over Poland on the analysis thread pool
+ * 4. Shows the grid as a heatmap with the stations marked
+ */
+void SidePanel::OnShowPollutionMap(wxCommandEvent& event) {
+    if (!CheckForDownloadedData()) {
+        return;
+    }
+
+    std::string paramCode;
+    if (!ChooseParameterCode("Choose the parameter to map:", "Pollution map", paramCode)) {
+        return;
+    }
+
+    std::vector<StationValue> values = LoadLatestStationValues(DATABASE_DIRECTORRY, paramCode, analysisPool);
+    if (values.empty()) {
+        wxMessageBox(wxString::Format("No stored %s data found. Please download sensor data first.", paramCode),
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    InterpolationGrid grid = InterpolateIdw(values, MAP_CELL_KM, MAP_NEIGHBOURS, analysisPool);
+    PollutionMapDialog mapDialog(this, paramCode, grid, values);
+    mapDialog.ShowModal();
+}
+
+/**
+ * @brief Shows the whole stored history of the selected sensor as a calendar heatmap
+ * @param event The button click event (unused)
+ *
+ * All data files of the sensor are parsed on the analysis thread pool and merged into
+ * one hourly series. The day-by-hour aggregate is built once and handed to the chart
+ * panel, which keeps showing it until another data file is selected.
+ */
+void SidePanel::OnShowCalendar(wxCommandEvent& event) {
+    if (selectedSensorId == -1) {
+        wxMessageBox("Please select a sensor first.", "No Sensor Selected", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    std::string SENSOR_DIRECTORY = DATABASE_DIRECTORRY + "/" + std::to_string(selectedStationId) + "/" + std::to_string(selectedSensorId);
+    CalendarAggregate calendar = BuildCalendarAggregate(LoadSensorHistory(SENSOR_DIRECTORY, &analysisPool));
+    if (calendar.measuredHours == 0) {
+        wxMessageBox("No data files found for this sensor. Please collect data first.",
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    if (chartPanel) {
+        chartPanel->SetCalendarData(calendar, wxString::Format("Hourly history: %s - %s (%d days)",
+            selectedStationName, selectedSensorParamName, static_cast<int>(calendar.dayCount)));
+    }
+}
+
+/**
+ * @brief Compares one parameter across the stations nearest to the user's location
+ * @param event The button click event (unused)
+ *
+ * This method:
+ * 1. Asks for the parameter and the number of stations to compare
+ * 2. Orders the stored stations measuring the parameter by distance from the location in config.ini
+ * 3. Loads the latest data of the nearest stations in parallel and aligns it on one time axis
+ * 4. Overlays the series in the chart panel with a legend of the stations
+ */
+void SidePanel::OnCompareStations(wxCommandEvent& event) {
+    if (!CheckForDownloadedData()) {
+        return;
+    }
+
+    std::string paramCode;
+    if (!ChooseParameterCode("Choose the parameter to compare:", "Compare stations", paramCode)) {
+        return;
+    }
+
+    std::vector<StationSensor> sensors = metadata.FindSensorsMeasuring(paramCode);
+    if (sensors.size() < 2) {
+        wxMessageBox(wxString::Format("At least two stations with stored %s data are needed. Please download sensor data first.", paramCode),
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    long stationCount = wxGetNumberFromUser(wxString::Format("%d stations with stored %s data were found.", static_cast<int>(sensors.size()), paramCode),
+        "Number of nearest stations:", "Compare stations", std::min<long>(COMPARE_DEFAULT_STATIONS, static_cast<long>(sensors.size())),
+        2, std::min<long>(COMPARE_MAX_STATIONS, static_cast<long>(sensors.size())), this);
+    if (stationCount < 2) {
+        return;
+    }
+
+    // Keep the nearest stations, ordered by distance like the station selection dialog
+    std::vector<StationLocation> locations;
+    locations.reserve(sensors.size());
+    for (const auto& sensor : sensors) {
+        locations.push_back(sensor.station);
+    }
+    StationLocator locator;
+    locator.Build(locations);
+
+    double latitude, longitude;
+    StationSelectionDialog::LoadReferenceLocation(latitude, longitude);
+    std::vector<StationDistance> nearest;
+    locator.FindNearest(latitude, longitude, static_cast<size_t>(stationCount), nearest);
+    std::vector<StationSensor> nearestSensors;
+    nearestSensors.reserve(nearest.size());
+    for (const auto& entry : nearest) {
+        nearestSensors.push_back(sensors[entry.index]);
+    }
+    sensors = std::move(nearestSensors);
+
+    StationComparison comparison = LoadStationComparison(sensors, analysisPool);
+    if (comparison.values.empty()) {
+        wxMessageBox(wxString::Format("No recent %s data found at the nearest stations.", paramCode),
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    if (chartPanel) {
+        std::vector<wxString> timestamps;
+        timestamps.reserve(comparison.hourCount);
+        for (size_t i = 0; i < comparison.hourCount; i++) {
+            timestamps.push_back(wxString(FormatHoursAsTimestamp(comparison.startHour + static_cast<long long>(i))));
+        }
+
+        std::vector<ChartSeries> series(comparison.values.size());
+        for (size_t i = 0; i < series.size(); i++) {
+            series[i].label = comparison.stationNames[i];
+            series[i].values = std::move(comparison.values[i]);
+        }
+
+        wxString title = wxString::Format("%s at the %d nearest stations", paramCode, static_cast<int>(series.size()));
+        if (comparison.skippedStations > 0) {
+            title += wxString::Format(" (%d without recent data)", static_cast<int>(comparison.skippedStations));
+        }
+        chartPanel->SetComparisonData(timestamps, series, title, "Date", paramCode);
+    }
+}
+
+/**
+ * @brief Starts the live view, or switches its sensor or stops it while it runs
+ * @param event The button click event (unused)
+ *
+ * Without a live view, all sensors of the selected station are followed and the
+ * selected one is shown. While it runs, a list of the followed sensors offers to show
+ * another one or to stop.
+ */
+void SidePanel::OnLiveView(wxCommandEvent& event) {
+    if (liveStationDirectory.empty()) {
+        StartLiveView();
+        return;
+    }
+
+    wxArrayString choices;
+    std::vector<int> sensorIds;
+    for (const auto& sensor : liveSensors) {
+        sensorIds.push_back(sensor.id);
+        choices.Add(wxString::FromUTF8(sensor.paramName.c_str()));
+    }
+    choices.Add("Stop live view");
+
+    wxSingleChoiceDialog choiceDialog(this, "Choose the sensor to show live:", "Live view", choices);
+    if (choiceDialog.ShowModal() != wxID_OK) {
+        return;
+    }
+    int selection = choiceDialog.GetSelection();
+    if (selection < 0 || static_cast<size_t>(selection) >= sensorIds.size()) {
+        StopLiveView();
+        return;
+    }
+    ShowLiveSensor(liveStationDirectory + "/" + std::to_string(sensorIds[selection]), choices[selection]);
+}
+
+/**
+ * @brief Renders the chart of every stored sensor into an SVG or PNG file
+ * @param event The button click event (unused)
+ *
+ * This method:
+ * 1. Checks if any data exists and no export is running
+ * 2. Asks for the format: SVG is rendered entirely on the worker threads, PNG is drawn
+ *    into a bitmap on the UI thread after the workers prepared the chart
+ * 3. Runs the export on a background thread with its own thread pool, so the window
+ *    stays responsive and the analysis pool stays free for the other buttons
+ * 4. Shows the number of written charts and the throughput when the export is done
+ *
+ * Servers without a display use the "--export-charts" command line instead.
+ */
+void SidePanel::OnExportCharts(wxCommandEvent& event) {
+    if (!CheckForDownloadedData()) {
+        return;
+    }
+    if (exportRunning) {
+        wxMessageBox("A chart export is already running.", "Export Charts", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    wxArrayString formats;
+    formats.Add("SVG (vector graphics)");
+    formats.Add("PNG (bitmap)");
+    wxSingleChoiceDialog choiceDialog(this, "Choose the format of the charts:", "Export Charts", formats);
+    if (choiceDialog.ShowModal() != wxID_OK) {
+        return;
+    }
+    bool png = choiceDialog.GetSelection() == 1;
+
+    if (exportThread.joinable()) {
+        exportThread.join();
+    }
+
+    exportRunning = true;
+    exportThread = std::thread([this, png]() {
+        ThreadPool exportPool;
+        ChartExportReport report;
+        if (png) {
+            report = ExportSensorCharts(DATABASE_DIRECTORRY, CHARTS_DIRECTORY, EXPORT_CHART_WIDTH, EXPORT_CHART_HEIGHT, exportPool, ".png",
+                [this](const ChartRenderer& renderer, int width, int height, const std::string& filePath) {
+                    return WritePngChart(renderer, width, height, filePath);
+                }, exportCancel);
+        }
+        else {
+            report = ExportSensorCharts(DATABASE_DIRECTORRY, CHARTS_DIRECTORY, EXPORT_CHART_WIDTH, EXPORT_CHART_HEIGHT, exportPool, ".svg",
+                WriteSvgChart, exportCancel);
+        }
+        exportRunning = false;
+        if (!exportCancel.IsCancelled()) {
+            CallAfter([this, report]() { ShowChartExportSummary(report); });
+        }
+        });
+}
+
+/**
+ * @brief Draws a prepared chart into a PNG file on the UI thread and waits for it
+ * @param renderer Renderer holding the chart's data
+ * @param width Width of the chart in pixels
+ * @param height Height of the chart in pixels
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ *
+ * Called on an export worker thread. Bitmaps and device contexts may only be used on the
+ * UI thread, so the drawing is handed over with CallAfter; the worker keeps the renderer
+ * alive until the drawing is done. The wait ends early when the panel is being destroyed:
+ * the destructor runs on the UI thread, so the handed-over drawing cannot start anymore
+ * and is discarded with the panel's pending events.
+ */
+bool SidePanel::WritePngChart(const ChartRenderer& renderer, int width, int height, const std::string& filePath) {
+    auto written = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = written->get_future();
+    CallAfter([&renderer, width, height, filePath, written]() {
+        wxBitmap bitmap(width, height);
+        {
+            wxMemoryDC memoryDC(bitmap);
+            memoryDC.SetBackground(wxBrush(wxColour(255, 255, 255)));
+            memoryDC.Clear();
+            DcChartCanvas canvas;
+            canvas.Attach(memoryDC);
+            renderer.Render(canvas);
+        }
+        written->set_value(bitmap.ConvertToImage().SaveFile(wxString::FromUTF8(filePath), wxBITMAP_TYPE_PNG));
+        });
+
+    while (result.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+        if (exportCancel.IsCancelled()) {
+            return false;
+        }
+    }
+    return result.get();
+}
+
+/**
+ * @brief Shows the results of a finished chart export
+ * @param report Report of the export
+ */
+void SidePanel::ShowChartExportSummary(const ChartExportReport& report) {
+    if (report.charts.empty()) {
+        wxMessageBox("No sensor data found. Please download sensor data first.",
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    size_t written = report.WrittenCount();
+    wxString summary = wxString::Format("Exported %d charts (%d sensors failed) in %.2f s\n"
+        "Throughput: %.1f charts/s on %d threads\n\nCharts saved to:\n%s",
+        static_cast<int>(written), static_cast<int>(report.charts.size() - written), report.elapsedSeconds,
+        report.ChartsPerSecond(), static_cast<int>(report.workerCount), CHARTS_DIRECTORY);
+    wxMessageBox(summary, "Export Charts", wxOK | wxICON_INFORMATION);
+}
+
+/**
+ * @brief Downloads the live station every LIVE_POLL_MINUTES
+ * @param event The timer event (unused)
+ */
+void SidePanel::OnLiveTimer(wxTimerEvent& event) {
+    PollLiveStation();
+}
+
 /////Helper functions for OnChoseSensor
 
 /**
  * @brief Creates the sensor database directory and downloads sensor data if needed
+ * @param stationId ID of the station
  * @param STATION_DIRECTORY Directory path for the station data
  * @param databasePath Path to the sensor database file
  * @param apiUrl URL for the API endpoint to download sensor data
  * @return true if initialization succeeds, false otherwise
  *
  * Creates the directory structure for sensor data and downloads the sensors list
- * if it doesn't exist locally.
+ * if it doesn't exist locally. A downloaded list replaces the station's sensors
+ * cached by the metadata repository.
  */
-bool SidePanel::InitializeSensorDatabase(const std::string& STATION_DIRECTORY, const std::string& databasePath, const std::string& apiUrl) {
+bool SidePanel::InitializeSensorDatabase(int stationId, const std::string& STATION_DIRECTORY, const std::string& databasePath, const std::string& apiUrl) {
     std::filesystem::create_directories(STATION_DIRECTORY);
     if (!std::filesystem::exists(databasePath)) {
-        return DownloadJsonAndSaveToFile(apiUrl, databasePath);
+        if (!DownloadJsonAndSaveToFile(apiUrl, databasePath)) {
+            return false;
+        }
+        metadata.InvalidateSensors(stationId);
     }
     return true;
 }
 
 /**
- * @brief Loads sensor data from JSON file into the provided object
- * @param databasePath Path to the sensor database file
- * @param sensors JSON value to load the data into
+ * @brief Gets the sensors of a station from the metadata repository
+ * @param stationId ID of the station
+ * @param sensors Vector to store the sensors of the station
  * @return true if data was successfully loaded, false otherwise
  *
- * Attempts to load and parse the sensor database file, displaying an error
- * message if the operation fails.
+ * The repository parses the station's sensors.json only if it changed since it was
+ * last read; an error message is displayed if the file cannot be read.
  */
-bool SidePanel::LoadSensorsData(const std::string& databasePath, Json::Value& sensors) {
-    if (!LoadJsonFromFile(databasePath, sensors)) {
+bool SidePanel::LoadSensorsData(int stationId, std::vector<SensorInfo>& sensors) {
+    if (!metadata.GetStationSensors(stationId, sensors)) {
         wxMessageBox("Could not open or parse sensors file.", "Error", wxOK | wxICON_ERROR);
         return false;
     }
@@ -410,67 +903,124 @@ bool SidePanel::LoadSensorsData(const std::string& databasePath, Json::Value& se
 }
 
 /**
- * @brief Downloads data for a specific sensor and records any failures
+ * @brief Downloads data for a specific sensor
  * @param sensorId ID of the sensor to download data for
  * @param STATION_DIRECTORY Directory path for the station data
- * @param failedSensors Vector to record failed sensor IDs
- * @param mutex Mutex for thread-safe access to the failedSensors vector
+ * @param cancel Token aborting the download when the data is no longer needed
  * @return true if download succeeds, false otherwise
  *
  * Creates the directory for the sensor data and attempts to download the data.
- * If the download fails, the sensor ID is added to the failedSensors vector.
+ * The saved measurements are passed to the live feed, which keeps the sensor's live
+ * chart current if it is followed. The error of a failed download is recorded for
+ * GetDownloadError() instead of being shown, so background downloads stay silent.
+ * May be called from any thread.
  */
-bool SidePanel::DownloadSensorData(int sensorId, const std::string& STATION_DIRECTORY, std::vector<std::string>& failedSensors, std::mutex& mutex) {
+bool SidePanel::DownloadSensorData(int sensorId, const std::string& STATION_DIRECTORY, const CancellationToken& cancel) {
     std::string sensorDirectory = STATION_DIRECTORY + "/" + std::to_string(sensorId);
     std::filesystem::create_directories(sensorDirectory);
     std::string sensorApiUrl = SENSOR_API_URL + std::to_string(sensorId);
 
-    bool success = DownloadJsonAndSaveData(sensorApiUrl, sensorDirectory);
+    // Hand the new measurements of followed sensors to the live view
+    auto onSaved = [this, sensorDirectory](const Json::Value& values) {
+        std::vector<std::pair<std::string, double>> data;
+        for (const auto& item : values) {
+            data.push_back(std::make_pair(item["date"].asString(), item["value"].asDouble()));
+        }
+        std::vector<std::pair<long long, double>> changed = liveFeed.Ingest(sensorDirectory, data);
+        if (!changed.empty()) {
+            CallAfter([this, sensorDirectory, changed]() { ShowLiveUpdates(sensorDirectory, changed); });
+        }
+    };
+    std::string error;
+    bool success = DownloadJsonAndSaveData(sensorApiUrl, sensorDirectory, onSaved, cancel, &error);
 
-    if (!success) {
-        std::lock_guard<std::mutex> lock(mutex);
-        failedSensors.push_back(std::to_string(sensorId));
-        return false;
+    std::lock_guard<std::mutex> lock(downloadErrorsMutex);
+    if (error.empty()) {
+        downloadErrors.erase(sensorDirectory);
     }
-    return true;
+    else {
+        downloadErrors[sensorDirectory] = error;
+    }
+    return success;
 }
 
 /**
- * @brief Starts parallel downloads for all sensors in the station
+ * @brief Queues the download of a sensor's data
+ * @param sensorId ID of the sensor
  * @param STATION_DIRECTORY Directory path for the station data
- * @param sensors JSON value containing the sensors data
- * @param failedSensors Vector to record failed sensor IDs
+ * @param priority Priority of the download
+ * @return Future of the download's result
  *
- * Creates and manages threads to download data for all sensors in parallel,
- * improving the download performance by utilizing multiple connections.
+ * The download is keyed by the sensor directory, so a sensor already queued is not
+ * downloaded twice; an interactive request moves it to the front of the queue.
+ */
+std::shared_future<bool> SidePanel::ScheduleSensorDownload(int sensorId, const std::string& STATION_DIRECTORY, DownloadPriority priority) {
+    std::string sensorDirectory = STATION_DIRECTORY + "/" + std::to_string(sensorId);
+    return downloads.Schedule(sensorDirectory, STATION_DIRECTORY, priority,
+        [this, sensorId, STATION_DIRECTORY](const CancellationToken& cancel) { return DownloadSensorData(sensorId, STATION_DIRECTORY, cancel); });
+}
+
+/**
+ * @brief Gets the error of the last failed download of a sensor
+ * @param sensorId ID of the sensor
+ * @param STATION_DIRECTORY Directory path for the station data
+ * @return Description of the error, empty if the last download did not fail with one
  */
-void SidePanel::DownloadAllSensorsData(const std::string& STATION_DIRECTORY, const Json::Value& sensors, std::vector<std::string>& failedSensors) {
-    std::vector<std::thread> downloadThreads;
-    std::mutex downloadMutex;
+std::string SidePanel::GetDownloadError(int sensorId, const std::string& STATION_DIRECTORY) {
+    std::string sensorDirectory = STATION_DIRECTORY + "/" + std::to_string(sensorId);
+    std::lock_guard<std::mutex> lock(downloadErrorsMutex);
+    auto it = downloadErrors.find(sensorDirectory);
+    return (it != downloadErrors.end()) ? it->second : std::string();
+}
 
-    // Create and start threads for each sensor
+/**
+ * @brief Downloads data for all sensors in the station and waits for the downloads
+ * @param STATION_DIRECTORY Directory path for the station data
+ * @param sensors Sensors of the station
+ * @param priority Priority of the downloads
+ * @param failedSensors Vector to record failed sensor IDs, followed by their errors
+ *
+ * The downloads run on the scheduler's connections, DOWNLOAD_CONNECTIONS at a time.
+ * Nothing is shown here; callers the user waits for pass the list to ReportFailedDownloads().
+ */
+void SidePanel::DownloadAllSensorsData(const std::string& STATION_DIRECTORY, const std::vector<SensorInfo>& sensors, DownloadPriority priority, std::vector<std::string>& failedSensors) {
+    std::vector<std::shared_future<bool>> results;
     for (auto const& sensor : sensors) {
-        if (sensor.isMember("id") && sensor["id"].isInt()) {
-            int sensorId = sensor["id"].asInt();
-            downloadThreads.push_back(std::thread(&SidePanel::DownloadSensorData, this,
-                sensorId, STATION_DIRECTORY, std::ref(failedSensors), std::ref(downloadMutex)));
-        }
+        results.push_back(ScheduleSensorDownload(sensor.id, STATION_DIRECTORY, priority));
     }
 
     // Wait for all downloads to complete
-    for (auto& thread : downloadThreads) {
-        if (thread.joinable()) {
-            thread.join();
+    for (size_t i = 0; i < results.size(); i++) {
+        if (!results[i].get()) {
+            std::string failed = std::to_string(sensors[i].id);
+            std::string error = GetDownloadError(sensors[i].id, STATION_DIRECTORY);
+            if (!error.empty()) {
+                failed += " (" + error + ")";
+            }
+            failedSensors.push_back(failed);
         }
     }
 }
 
+/**
+ * @brief Queues background downloads of all sensors in the station without waiting for them
+ * @param STATION_DIRECTORY Directory path for the station data
+ * @param sensors Sensors of the station
+ *
+ * A sensor the user selects later is moved ahead of the remaining downloads.
+ */
+void SidePanel::PrefetchSensorsData(const std::string& STATION_DIRECTORY, const std::vector<SensorInfo>& sensors) {
+    for (auto const& sensor : sensors) {
+        ScheduleSensorDownload(sensor.id, STATION_DIRECTORY, DownloadPriority::Background);
+    }
+}
+
 /**
  * @brief Shows a message box listing any sensors that failed to download
- * @param failedSensors Vector containing IDs of sensors that failed to download
+ * @param failedSensors Vector containing IDs of sensors that failed to download, with their errors
  *
  * If any sensors failed to download, displays a warning message with the list
- * of sensor IDs that could not be downloaded.
+ * of sensor IDs that could not be downloaded. Must be called on the UI thread.
  */
 void SidePanel::ReportFailedDownloads(const std::vector<std::string>& failedSensors) {
     if (!failedSensors.empty()) {
@@ -488,21 +1038,30 @@ void SidePanel::ReportFailedDownloads(const std::vector<std::string>& failedSens
 /**
  * @brief Makes sure data for the selected sensor is available, retrying download if needed
  * @param STATION_DIRECTORY Directory path for the station data
- * @param failedSensors Vector containing IDs of sensors that failed to download
  *
- * If the selected sensor's data download failed, attempts to download it again
- * to ensure that the user can proceed with the selected sensor.
+ * The prefetch of the selected sensor is moved ahead of the queued background downloads
+ * and waited for only while it is still pending; a finished prefetch is not downloaded
+ * again. Only if it failed (or is unknown to the scheduler) is the sensor downloaded
+ * once more, to ensure that the user can proceed with the selected sensor, and the
+ * error of that attempt is shown.
  */
-void SidePanel::EnsureSelectedSensorData(const std::string& STATION_DIRECTORY, const std::vector<std::string>& failedSensors) {
+void SidePanel::EnsureSelectedSensorData(const std::string& STATION_DIRECTORY) {
     if (selectedSensorId != -1) {
         std::string sensorDirectory = STATION_DIRECTORY + "/" + std::to_string(selectedSensorId);
-
-        // Check if the selected sensor's data was downloaded successfully
-        if (std::find(failedSensors.begin(), failedSensors.end(), std::to_string(selectedSensorId)) != failedSensors.end()) {
-            // If the selected sensor's download failed, try one more time directly
-            std::string apiUrl = SENSOR_API_URL + std::to_string(selectedSensorId);
-            if (!DownloadJsonAndSaveData(apiUrl, sensorDirectory)) {
-                wxMessageBox("Failed to download data for the selected sensor.", "Error", wxOK | wxICON_ERROR);
+        std::shared_future<bool> prefetch;
+        bool known = downloads.FindResult(sensorDirectory, prefetch);
+        if (known) {
+            downloads.Promote(sensorDirectory);
+        }
+        if (!known || !prefetch.get()) {
+            // If the selected sensor's download failed, try one more time
+            if (!ScheduleSensorDownload(selectedSensorId, STATION_DIRECTORY, DownloadPriority::Interactive).get()) {
+                std::string error = GetDownloadError(selectedSensorId, STATION_DIRECTORY);
+                wxString message = "Failed to download data for the selected sensor.";
+                if (!error.empty()) {
+                    message += "\n\n" + wxString::FromUTF8(error.c_str());
+                }
+                wxMessageBox(message, "Error", wxOK | wxICON_ERROR);
             }
         }
     }
@@ -534,64 +1093,25 @@ bool SidePanel::CheckForDownloadedData() {
  * which represent station or sensor IDs in the application's file structure.
  */
 std::vector<int> SidePanel::GetNumericDirectories(const std::string& directory) {
-    std::vector<int> dirIds;
-    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
-        if (entry.is_directory()) {
-            std::string dirName = entry.path().filename().string();
-            // Skip non-numeric directories
-            if (std::all_of(dirName.begin(), dirName.end(), ::isdigit)) {
-                dirIds.push_back(std::stoi(dirName));
-            }
-        }
-    }
-    return dirIds;
-}
-
-/**
- * @brief Filters a list of items to only include those with existing directories
- * @param allItems JSON value containing all items
- * @param dirIds Vector of directory IDs
- * @return Filtered JSON value containing only items with existing directories
- *
- * Creates a filtered list of items (stations or sensors) that have corresponding
- * directories in the file system, ensuring that only items with data are shown.
- */
-Json::Value SidePanel::FilterItemsByExistingDirectories(const Json::Value& allItems, const std::vector<int>& dirIds) {
-    Json::Value filteredItems(Json::arrayValue);
-    for (const auto& item : allItems) {
-        if (item.isMember("id")) {
-            int itemId = item["id"].asInt();
-            // Check if this item has a directory
-            if (std::find(dirIds.begin(), dirIds.end(), itemId) != dirIds.end()) {
-                filteredItems.append(item);
-            }
-        }
-    }
-    return filteredItems;
+    return ListNumericDirectories(directory);
 }
 
 /**
  * @brief Shows a dialog for selecting a station and updates the selection state
- * @param filteredStations JSON value containing filtered station data
+ * @param stations Stations to choose from
+ * @param search Search index built over the same stations
  * @return true if a station was selected, false otherwise
  *
  * Opens a dialog showing available stations with data and updates the
  * selection state if the user selects a station.
  */
-bool SidePanel::SelectStation(Json::Value& filteredStations) {
-    StationSelectionDialog stationDialog(this, filteredStations);
+bool SidePanel::SelectStation(const StationLocator& stations, const StationSearchIndex& search) {
+    StationSelectionDialog stationDialog(this, stations, search);
     if (stationDialog.ShowModal() == wxID_OK) {
         int id;
         wxString name;
         if (stationDialog.GetSelectedStation(id, name)) {
-            selectedStationId = id;
-            selectedStationName = name;
-            UpdateSelectedStationDisplay();
-
-            // Reset sensor selection
-            selectedSensorId = -1;
-            selectedSensorParamName = "";
-            UpdateSelectedSensorDisplay();
+            SetSelectedStation(id, name);
             return true;
         }
     }
@@ -616,15 +1136,18 @@ bool SidePanel::SelectSensor() {
     }
 
     // Load sensors data
-    std::string databaseSensors = stationDirectory + "/sensors.json";
-    Json::Value allSensors;
-    if (!std::filesystem::exists(databaseSensors) || !LoadJsonFromFile(databaseSensors, allSensors)) {
-        wxMessageBox("Could not open or parse sensors file.", "Error", wxOK | wxICON_ERROR);
+    std::vector<SensorInfo> allSensors;
+    if (!LoadSensorsData(selectedStationId, allSensors)) {
         return false;
     }
 
     // Filter sensors
-    Json::Value filteredSensors = FilterItemsByExistingDirectories(allSensors, sensorDirIds);
+    std::vector<SensorInfo> filteredSensors;
+    for (const auto& sensor : allSensors) {
+        if (std::find(sensorDirIds.begin(), sensorDirIds.end(), sensor.id) != sensorDirIds.end()) {
+            filteredSensors.push_back(sensor);
+        }
+    }
 
     // Show sensor selection dialog
     SensorSelectionDialog sensorDialog(this, filteredSensors);
@@ -639,4 +1162,278 @@ bool SidePanel::SelectSensor() {
         }
     }
     return false;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Prompts the user to choose one of the monitored parameters
+ * @param prompt Message shown above the list
+ * @param caption Title of the dialog
+ * @param paramCode [out] Chosen parameter code
+ * @return true if a parameter was chosen, false if the dialog was cancelled
+ *
+ * Offers the parameters measured by the GIOS network, using the codes of sensors.json.
+ */
+bool SidePanel::ChooseParameterCode(const wxString& prompt, const wxString& caption, std::string& paramCode) {
+    wxArrayString parameters;
+    for (const char* code : { "PM10", "PM2.5", "NO2", "SO2", "O3", "CO", "C6H6" }) {
+        parameters.Add(code);
+    }
+    wxSingleChoiceDialog choiceDialog(this, prompt, caption, parameters);
+    if (choiceDialog.ShowModal() != wxID_OK) {
+        return false;
+    }
+    paramCode = choiceDialog.GetStringSelection().ToStdString();
+    return true;
+}
+
+/////Helper functions for OnShowAirQualityIndex
+
+/**
+ * @brief Shows the hourly air quality index of the selected station
+ *
+ * This method:
+ * 1. Downloads the sensor list of the station if it doesn't exist locally
+ * 2. On a background thread, downloads the latest data for all sensors in parallel
+ *    (joining the prefetches that are still pending), so the window stays responsive
+ * 3. Loads the newest data file of every sensor on the analysis thread pool and
+ *    computes the hourly station index
+ * 4. Hands the index to ShowStationAqiResult() on the UI thread through CallAfter
+ */
+void SidePanel::ShowStationAirQualityIndex() {
+    std::string STATION_DIRECTORY = DATABASE_DIRECTORRY + "/" + std::to_string(selectedStationId);
+    std::string DATABASE_SENSORS = STATION_DIRECTORY + "/sensors.json";
+    std::string apiUrl = SENSORS_API_URL + std::to_string(selectedStationId);
+
+    if (!InitializeSensorDatabase(selectedStationId, STATION_DIRECTORY, DATABASE_SENSORS, apiUrl)) {
+        return;
+    }
+
+    std::vector<SensorInfo> sensors;
+    if (!LoadSensorsData(selectedStationId, sensors)) {
+        return;
+    }
+
+    if (aqiRunning) {
+        wxMessageBox("The air quality index is already being computed.", "Air Quality Index", wxOK | wxICON_INFORMATION);
+        return;
+    }
+    if (aqiThread.joinable()) {
+        aqiThread.join();
+    }
+
+    // wxString is not shared across threads; the name travels as UTF-8
+    std::string stationName = selectedStationName.ToUTF8().data();
+    aqiRunning = true;
+    aqiThread = std::thread([this, STATION_DIRECTORY, sensors, stationName]() {
+        // Refresh the data of all sensors so the index describes the latest hours
+        std::vector<std::string> failedSensors;
+        if (!aqiCancel.IsCancelled()) {
+            DownloadAllSensorsData(STATION_DIRECTORY, sensors, DownloadPriority::Interactive, failedSensors);
+        }
+        StationAqi aqi = LoadStationAqi(STATION_DIRECTORY, &analysisPool);
+        aqiRunning = false;
+        if (!aqiCancel.IsCancelled()) {
+            CallAfter([this, stationName, aqi, failedSensors]() {
+                ShowStationAqiResult(wxString::FromUTF8(stationName.c_str()), aqi, failedSensors);
+                });
+        }
+        });
+}
+
+/**
+ * @brief Shows a computed station index in the info and chart panels
+ * @param stationName Name of the station the index was computed for
+ * @param aqi Hourly index of the station
+ * @param failedSensors IDs of the sensors that failed to download, with their errors
+ *
+ * Runs on the UI thread. Reports the failed downloads, shows the latest hour in the
+ * info panel and plots the index level of every hour in the chart panel.
+ */
+void SidePanel::ShowStationAqiResult(const wxString& stationName, const StationAqi& aqi, const std::vector<std::string>& failedSensors) {
+    ReportFailedDownloads(failedSensors);
+
+    size_t latest;
+    if (!aqi.FindLatestLevel(latest)) {
+        wxMessageBox("No measurements of indexed pollutants found for this station.",
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    if (infoPanel) {
+        infoPanel->UpdateAirQualityIndex(stationName, FormatHoursAsTimestamp(aqi.HourAt(latest)),
+            AqiLevelName(aqi.levels[latest]), aqi.pollutants[aqi.dominantPollutant[latest]],
+            static_cast<int>(aqi.pollutants.size()));
+    }
+
+    // Plot the index level of every hour, leaving gaps where nothing was measured
+    if (chartPanel) {
+        std::vector<std::pair<wxString, double>> chartData;
+        chartData.reserve(aqi.levels.size());
+        for (size_t i = 0; i < aqi.levels.size(); i++) {
+            double level = (aqi.levels[i] == AQI_NO_DATA) ? MISSING_VALUE : static_cast<double>(aqi.levels[i]);
+            chartData.push_back(std::make_pair(wxString(FormatHoursAsTimestamp(aqi.HourAt(i))), level));
+        }
+        chartPanel->SetChartData(chartData, wxString::Format("Air Quality Index: %s", stationName),
+            "Date", "Index (0 = very good, 5 = very bad)");
+    }
+}
+
+/**
+ * @brief Shows a summary of the current index of all stored stations
+ *
+ * Computes the index of every station with stored data on the analysis thread pool
+ * and lists the number of stations per level together with the stations in the
+ * worst condition. No data is downloaded.
+ */
+void SidePanel::ShowAllStationsAirQualityIndex() {
+    if (!CheckForDownloadedData()) {
+        return;
+    }
+
+    std::vector<std::pair<int, StationAqi>> results = LoadAllStationsAqi(DATABASE_DIRECTORRY, analysisPool);
+
+    // Collect the latest level of every station with indexed data
+    std::vector<int> stationsPerLevel(AQI_LEVEL_COUNT, 0);
+    std::vector<std::pair<int, int>> latestLevels;
+    for (const auto& result : results) {
+        size_t latest;
+        if (result.second.FindLatestLevel(latest)) {
+            int level = result.second.levels[latest];
+            stationsPerLevel[level]++;
+            latestLevels.push_back(std::make_pair(level, result.first));
+        }
+    }
+
+    if (latestLevels.empty()) {
+        wxMessageBox("No stored measurements of indexed pollutants found. Please download sensor data first.",
+            "No Data", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    // Station names for the report come from the metadata repository
+    metadata.LoadStations();
+
+    wxString report = wxString::Format("Current index of %d stations:\n", static_cast<int>(latestLevels.size()));
+    for (int level = 0; level < AQI_LEVEL_COUNT; level++) {
+        report += wxString::Format("%s: %d\n", AqiLevelName(level), stationsPerLevel[level]);
+    }
+
+    // List the stations with the worst index first
+    std::stable_sort(latestLevels.begin(), latestLevels.end(),
+        [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+
+    const size_t WORST_STATIONS_SHOWN = 10;
+    report += "\nWorst stations:\n";
+    for (size_t i = 0; i < latestLevels.size() && i < WORST_STATIONS_SHOWN; i++) {
+        int stationId = latestLevels[i].second;
+        const StationLocation* station = metadata.FindStation(stationId);
+        wxString name = station ? wxString::FromUTF8(station->name.c_str()) : wxString("Unknown");
+        report += wxString::Format("(ID: %d) %s: %s\n", stationId, name, AqiLevelName(latestLevels[i].first));
+    }
+
+    wxMessageBox(report, "Air Quality Index", wxOK | wxICON_INFORMATION);
+}
+
+/////Helper functions for OnLiveView
+
+/**
+ * @brief Follows all sensors of the selected station and shows the selected one live
+ *
+ * This method:
+ * 1. Seeds the live feed of every sensor of the station with its stored history, so
+ *    the chart starts with the last LIVE_CAPACITY_HOURS instead of an empty axis
+ * 2. Shows the selected sensor in the chart panel
+ * 3. Downloads the station right away and then every LIVE_POLL_MINUTES
+ */
+void SidePanel::StartLiveView() {
+    if (selectedSensorId == -1) {
+        wxMessageBox("Please select a sensor first.", "No Sensor Selected", wxOK | wxICON_INFORMATION);
+        return;
+    }
+
+    std::string STATION_DIRECTORY = DATABASE_DIRECTORRY + "/" + std::to_string(selectedStationId);
+    std::vector<SensorInfo> sensors;
+    if (!LoadSensorsData(selectedStationId, sensors)) {
+        return;
+    }
+
+    liveFeed.Clear();
+    for (const auto& sensor : sensors) {
+        std::string sensorDirectory = STATION_DIRECTORY + "/" + std::to_string(sensor.id);
+        liveFeed.Follow(sensorDirectory, LoadSensorHistory(sensorDirectory, &analysisPool));
+    }
+    liveStationDirectory = STATION_DIRECTORY;
+    liveSensors = sensors;
+
+    ShowLiveSensor(STATION_DIRECTORY + "/" + std::to_string(selectedSensorId), selectedSensorParamName);
+    btn11->SetLabel("Live view (on)");
+    PollLiveStation();
+    liveTimer.Start(LIVE_POLL_MINUTES * 60 * 1000);
+}
+
+/**
+ * @brief Stops the periodic downloads and leaves the chart as it is
+ *
+ * A download already running finishes on its own; its data is no longer followed.
+ */
+void SidePanel::StopLiveView() {
+    liveTimer.Stop();
+    liveFeed.Clear();
+    liveStationDirectory.clear();
+    liveSensorDirectory.clear();
+    liveSensors.clear();
+    btn11->SetLabel("Live view");
+}
+
+/**
+ * @brief Shows a followed sensor in the chart panel
+ * @param sensorDirectory Directory of the sensor's data files
+ * @param paramName Parameter name of the sensor, used in the title
+ */
+void SidePanel::ShowLiveSensor(const std::string& sensorDirectory, const wxString& paramName) {
+    HourlyRingBuffer buffer;
+    if (!chartPanel || !liveFeed.Snapshot(sensorDirectory, buffer)) {
+        return;
+    }
+    liveSensorDirectory = sensorDirectory;
+    chartPanel->SetLiveData(buffer, wxString::Format("Live: %s - %s (last %d days)",
+        selectedStationName, paramName, static_cast<int>(LIVE_CAPACITY_HOURS / 24)), "Date", paramName);
+}
+
+/**
+ * @brief Starts a download of the live station on a background thread
+ *
+ * The download takes as long as the slowest sensor, so it runs off the UI thread;
+ * new measurements reach the chart through DownloadSensorData. A poll is skipped
+ * while the previous one is still running. Failed sensors are not reported, since the
+ * next poll retries them; their errors stay available through GetDownloadError().
+ */
+void SidePanel::PollLiveStation() {
+    if (livePollRunning || liveStationDirectory.empty()) {
+        return;
+    }
+    if (liveThread.joinable()) {
+        liveThread.join();
+    }
+
+    livePollRunning = true;
+    liveThread = std::thread([this, stationDirectory = liveStationDirectory, sensors = liveSensors]() {
+        std::vector<std::string> failedSensors;
+        DownloadAllSensorsData(stationDirectory, sensors, DownloadPriority::Background, failedSensors);
+        livePollRunning = false;
+    });
+}
+
+/**
+ * @brief Appends new hours of a followed sensor to the chart if it is shown
+ * @param sensorDirectory Directory of the sensor's data files
+ * @param points New or changed hours (since 1970-01-01 00:00) and values
+ *
+ * Runs on the UI thread. Sensors of the live station that are not shown are only
+ * kept current in the live feed, so switching to them shows their newest data.
+ */
+void SidePanel::ShowLiveUpdates(const std::string& sensorDirectory, const std::vector<std::pair<long long, double>>& points) {
+    if (chartPanel && chartPanel->IsLive() && sensorDirectory == liveSensorDirectory) {
+        chartPanel->AppendLiveData(points);
+    }
+}
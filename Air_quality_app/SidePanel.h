@@ -10,8 +10,14 @@
 #include <wx/msgdlg.h>
 #include <wx/listbox.h>
 #include <wx/stattext.h>
+#include <wx/choicdlg.h>
+#include <wx/numdlg.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <thread>
+#include <map>
 #include <mutex>
 #include <json/json.h>
 #include <filesystem>
@@ -19,12 +25,28 @@
 #include "StationSelectionDialog.h"
 #include "SensorSelectionDialog.h"
 #include "FileSelectionDialog.h"
+#include "PollutionMapDialog.h"
 
 #include "ChartPanel.h"
 #include "InfoPanel.h"
 
+#include "AirQualityIndex.h"
+#include "BatchAnalytics.h"
+#include "CalendarHeatmap.h"
+#include "ChartExport.h"
+#include "CorrelationAnalysis.h"
 #include "DataProcessing.h"
+#include "DcChartCanvas.h"
+#include "DownloadScheduler.h"
+#include "LiveFeed.h"
+#include "MetadataRepository.h"
 #include "NetworkingAndFileHandling.h"
+#include "SensorCatalog.h"
+#include "SpatialInterpolation.h"
+#include "StationComparison.h"
+#include "StationLocator.h"
+#include "StationSearch.h"
+#include "ThreadPool.h"
 
 /**
  * @file SidePanel.cpp
@@ -47,6 +69,14 @@ private:
     wxButton* btn2;                  ///< Button for sensor selection
     wxButton* btn3;                  ///< Button for showing data files
     wxButton* btn4;                  ///< Button for viewing stored data
+    wxButton* btn5;                  ///< Button for showing the air quality index
+    wxButton* btn6;                  ///< Button for running the batch report
+    wxButton* btn7;                  ///< Button for showing pollutant correlations
+    wxButton* btn8;                  ///< Button for showing the interpolated pollution map
+    wxButton* btn9;                  ///< Button for showing the sensor history as a calendar heatmap
+    wxButton* btn10;                 ///< Button for comparing one parameter across the nearest stations
+    wxButton* btn11;                 ///< Button for starting, switching and stopping the live view
+    wxButton* btn12;                 ///< Button for exporting the charts of all stored sensors
     wxStaticText* selectedStationText; ///< Display text for selected station
     wxStaticText* selectedSensorText;  ///< Display text for selected sensor
     wxStaticText* selectedFileText;    ///< Display text for selected file
@@ -67,6 +97,8 @@ private:
     ChartPanel* chartPanel;          ///< Reference to the chart panel
     ///@}
 
+    ThreadPool analysisPool;         ///< Worker threads for CPU-bound analysis
+
     /// @name Constants
     ///@{
     const std::string STATIONS_API_URL = "http://api.gios.gov.pl/pjp-api/rest/station/findAll";     ///< API endpoint for all stations
@@ -74,8 +106,61 @@ private:
     const std::string SENSOR_API_URL = "http://api.gios.gov.pl/pjp-api/rest/data/getData/";         ///< API endpoint prefix for sensor data
     const std::string DATABASE_DIRECTORRY = "measurements";                                          ///< Base directory for measurements data
     const std::string DATABASE_STATIONS = DATABASE_DIRECTORRY + "/stations.json";                    ///< Path to the stations database file
+    const std::string REPORTS_DIRECTORY = "reports";                                                 ///< Directory for batch reports
+    const std::string CHARTS_DIRECTORY = REPORTS_DIRECTORY + "/charts";                              ///< Directory for exported charts
+    const int EXPORT_CHART_WIDTH = 1200;                                                             ///< Width of an exported chart in pixels
+    const int EXPORT_CHART_HEIGHT = 600;                                                             ///< Height of an exported chart in pixels
+    const double MAP_CELL_KM = 1.0;                                                                  ///< Cell size of the pollution map grid
+    const size_t MAP_NEIGHBOURS = 8;                                                                 ///< Nearest stations used per map cell
+    const int COMPARE_DEFAULT_STATIONS = 5;                                                          ///< Number of stations compared by default
+    const int COMPARE_MAX_STATIONS = 20;                                                             ///< Largest number of stations in a comparison
+    const size_t LIVE_CAPACITY_HOURS = 30 * 24;                                                      ///< Hours kept per sensor in the live view
+    const int LIVE_POLL_MINUTES = 10;                                                                ///< Minutes between two downloads of the live station
+    const size_t DOWNLOAD_CONNECTIONS = 4;                                                           ///< Sensor downloads running at the same time
+    ///@}
+
+    MetadataRepository metadata;     ///< Stations and sensors of the database, parsed once and reloaded when their files change
+
+    /// @name Live view state
+    ///@{
+    LiveFeed liveFeed;               ///< Newest hours of every sensor of the live station
+    wxTimer liveTimer;               ///< Starts the periodic download of the live station
+    std::thread liveThread;          ///< Thread of the last periodic download
+    std::atomic<bool> livePollRunning; ///< Whether a periodic download is still running
+    std::string liveStationDirectory; ///< Directory of the live station, empty when the live view is off
+    std::string liveSensorDirectory; ///< Directory of the sensor shown live
+    std::vector<SensorInfo> liveSensors; ///< Sensors of the live station, as listed in sensors.json
+    ///@}
+
+    /// @name Chart export state
+    ///@{
+    std::thread exportThread;        ///< Thread of the last chart export
+    std::atomic<bool> exportRunning; ///< Whether a chart export is still running
+    CancellationToken exportCancel;  ///< Stops a running export when the panel is destroyed
     ///@}
 
+    /// @name Air quality index state
+    ///@{
+    std::thread aqiThread;           ///< Thread of the last station index computation
+    std::atomic<bool> aqiRunning;    ///< Whether a station index is still being computed
+    CancellationToken aqiCancel;     ///< Skips the result of a running computation when the panel is destroyed
+    ///@}
+
+    /// @name Batch report state
+    ///@{
+    std::thread batchThread;         ///< Thread of the last batch report
+    std::atomic<bool> batchRunning;  ///< Whether a batch report is still running
+    CancellationToken batchCancel;   ///< Stops a running batch report when the panel is destroyed
+    ///@}
+
+    /// @name Download error state
+    ///@{
+    std::map<std::string, std::string> downloadErrors; ///< Error of the last failed download, by sensor directory
+    std::mutex downloadErrorsMutex;  ///< Protects downloadErrors
+    ///@}
+
+    DownloadScheduler downloads;     ///< Sensor downloads, interactive ones first (last member, so it stops before the state its downloads use)
+
 public:
     /**
      * @brief Constructor for the SidePanel
@@ -83,6 +168,11 @@ public:
      */
     SidePanel(wxWindow* parent);
 
+    /**
+     * @brief Destructor, waits for a running live download and chart export
+     */
+    ~SidePanel();
+
     /**
      * @brief Connects this panel to the info and chart panels
      * @param info Pointer to the InfoPanel instance
@@ -120,6 +210,13 @@ private:
      * @brief Updates the selected file display text
      */
     void UpdateSelectedFileDisplay();
+
+    /**
+     * @brief Selects a station, cancelling the downloads of the previous one
+     * @param id ID of the station
+     * @param name Name of the station
+     */
+    void SetSelectedStation(int id, const wxString& name);
     ///@}
 
     /// @name Button event handlers
@@ -147,57 +244,197 @@ private:
      * @param event The button click event
      */
     void OnViewStoredData(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Air quality index" button click
+     * @param event The button click event
+     */
+    void OnShowAirQualityIndex(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Batch report" button click
+     * @param event The button click event
+     */
+    void OnRunBatchReport(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Correlations" button click
+     * @param event The button click event
+     */
+    void OnShowCorrelations(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Pollution map" button click
+     * @param event The button click event
+     */
+    void OnShowPollutionMap(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Calendar view" button click
+     * @param event The button click event
+     */
+    void OnShowCalendar(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Compare stations" button click
+     * @param event The button click event
+     */
+    void OnCompareStations(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Live view" button click
+     * @param event The button click event
+     */
+    void OnLiveView(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the "Export charts" button click
+     * @param event The button click event
+     */
+    void OnExportCharts(wxCommandEvent& event);
+
+    /**
+     * @brief Handles the live view timer
+     * @param event The timer event
+     */
+    void OnLiveTimer(wxTimerEvent& event);
+    ///@}
+
+    /// @name Helper functions for the live view
+    ///@{
+    /**
+     * @brief Follows all sensors of the selected station and shows the selected one live
+     */
+    void StartLiveView();
+
+    /**
+     * @brief Stops the periodic downloads and leaves the chart as it is
+     */
+    void StopLiveView();
+
+    /**
+     * @brief Shows a followed sensor in the chart panel
+     * @param sensorDirectory Directory of the sensor's data files
+     * @param paramName Parameter name of the sensor, used in the title
+     */
+    void ShowLiveSensor(const std::string& sensorDirectory, const wxString& paramName);
+
+    /**
+     * @brief Starts a download of the live station on a background thread
+     */
+    void PollLiveStation();
+
+    /**
+     * @brief Appends new hours of a followed sensor to the chart if it is shown
+     * @param sensorDirectory Directory of the sensor's data files
+     * @param points New or changed hours (since 1970-01-01 00:00) and values
+     */
+    void ShowLiveUpdates(const std::string& sensorDirectory, const std::vector<std::pair<long long, double>>& points);
+    ///@}
+
+    /// @name Helper functions for the chart export
+    ///@{
+    /**
+     * @brief Draws a prepared chart into a PNG file on the UI thread and waits for it
+     * @param renderer Renderer holding the chart's data
+     * @param width Width of the chart in pixels
+     * @param height Height of the chart in pixels
+     * @param filePath Path of the output file
+     * @return true if the file was written successfully, false otherwise
+     */
+    bool WritePngChart(const ChartRenderer& renderer, int width, int height, const std::string& filePath);
+
+    /**
+     * @brief Shows the results of a finished chart export
+     * @param report Report of the export
+     */
+    void ShowChartExportSummary(const ChartExportReport& report);
+    ///@}
+
+    /// @name Helper functions for the batch report
+    ///@{
+    /**
+     * @brief Shows the results of a finished batch report
+     * @param report Report of the run
+     * @param csvPath Path of the CSV report, empty if it could not be written
+     * @param jsonPath Path of the JSON report, empty if it could not be written
+     */
+    void ShowBatchReportSummary(const BatchReport& report, const std::string& csvPath, const std::string& jsonPath);
     ///@}
 
     /// @name Helper functions for sensor selection
     ///@{
     /**
      * @brief Initializes the sensor database
+     * @param stationId ID of the station
      * @param STATION_DIRECTORY Directory for the station data
      * @param databasePath Path to the database file
      * @param apiUrl URL for the API endpoint
      * @return true if initialization was successful, false otherwise
      */
-    bool InitializeSensorDatabase(const std::string& STATION_DIRECTORY, const std::string& databasePath, const std::string& apiUrl);
+    bool InitializeSensorDatabase(int stationId, const std::string& STATION_DIRECTORY, const std::string& databasePath, const std::string& apiUrl);
 
     /**
-     * @brief Loads sensor data from the database
-     * @param databasePath Path to the database file
-     * @param sensors JSON value to store the loaded sensor data
+     * @brief Gets the sensors of a station from the metadata repository
+     * @param stationId ID of the station
+     * @param sensors Vector to store the sensors of the station
      * @return true if data was successfully loaded, false otherwise
      */
-    bool LoadSensorsData(const std::string& databasePath, Json::Value& sensors);
+    bool LoadSensorsData(int stationId, std::vector<SensorInfo>& sensors);
+
+    /**
+     * @brief Downloads data for all sensors and waits for the downloads
+     * @param STATION_DIRECTORY Directory for the station data
+     * @param sensors Sensors of the station
+     * @param priority Priority of the downloads
+     * @param failedSensors Vector to store IDs of sensors that failed to download, with their errors
+     */
+    void DownloadAllSensorsData(const std::string& STATION_DIRECTORY, const std::vector<SensorInfo>& sensors, DownloadPriority priority, std::vector<std::string>& failedSensors);
+
+    /**
+     * @brief Queues background downloads of all sensors without waiting for them
+     * @param STATION_DIRECTORY Directory for the station data
+     * @param sensors Sensors of the station
+     */
+    void PrefetchSensorsData(const std::string& STATION_DIRECTORY, const std::vector<SensorInfo>& sensors);
 
     /**
-     * @brief Downloads data for all sensors
+     * @brief Queues the download of a sensor's data
+     * @param sensorId ID of the sensor
      * @param STATION_DIRECTORY Directory for the station data
-     * @param sensors JSON value containing sensor information
-     * @param failedSensors Vector to store IDs of sensors that failed to download
+     * @param priority Priority of the download
+     * @return Future of the download's result
      */
-    void DownloadAllSensorsData(const std::string& STATION_DIRECTORY, const Json::Value& sensors, std::vector<std::string>& failedSensors);
+    std::shared_future<bool> ScheduleSensorDownload(int sensorId, const std::string& STATION_DIRECTORY, DownloadPriority priority);
+
+    /**
+     * @brief Gets the error of the last failed download of a sensor
+     * @param sensorId ID of the sensor
+     * @param STATION_DIRECTORY Directory for the station data
+     * @return Description of the error, empty if the last download did not fail with one
+     */
+    std::string GetDownloadError(int sensorId, const std::string& STATION_DIRECTORY);
 
     /**
      * @brief Reports sensors that failed to download
-     * @param failedSensors Vector containing IDs of sensors that failed to download
+     * @param failedSensors Vector containing IDs of sensors that failed to download, with their errors
      */
     void ReportFailedDownloads(const std::vector<std::string>& failedSensors);
 
     /**
-     * @brief Ensures the selected sensor data is available
+     * @brief Waits for the selected sensor's prefetch if it is pending, downloading it again only if it failed
      * @param STATION_DIRECTORY Directory for the station data
-     * @param failedSensors Vector containing IDs of sensors that failed to download
      */
-    void EnsureSelectedSensorData(const std::string& STATION_DIRECTORY, const std::vector<std::string>& failedSensors);
+    void EnsureSelectedSensorData(const std::string& STATION_DIRECTORY);
 
     /**
      * @brief Downloads data for a specific sensor
      * @param sensorId ID of the sensor
      * @param STATION_DIRECTORY Directory for the station data
-     * @param failedSensors Vector to store IDs of sensors that failed to download
-     * @param mutex Mutex for thread synchronization
+     * @param cancel Token aborting the download when the data is no longer needed
      * @return true if download was successful, false otherwise
      */
-    bool DownloadSensorData(int sensorId, const std::string& STATION_DIRECTORY, std::vector<std::string>& failedSensors, std::mutex& mutex);
+    bool DownloadSensorData(int sensorId, const std::string& STATION_DIRECTORY, const CancellationToken& cancel);
     ///@}
 
     /// @name Helper functions for viewing stored data
@@ -215,26 +452,49 @@ private:
      */
     std::vector<int> GetNumericDirectories(const std::string& directory);
 
-    /**
-     * @brief Filters JSON items by existing directory IDs
-     * @param allItems JSON value containing all items
-     * @param dirIds Vector of directory IDs
-     * @return Filtered JSON value
-     */
-    Json::Value FilterItemsByExistingDirectories(const Json::Value& allItems, const std::vector<int>& dirIds);
-
     /**
      * @brief Prompts the user to select a station
-     * @param filteredStations JSON value containing filtered station data
+     * @param stations Stations to choose from
+     * @param search Search index built over the same stations
      * @return true if a station was selected, false otherwise
      */
-    bool SelectStation(Json::Value& filteredStations);
+    bool SelectStation(const StationLocator& stations, const StationSearchIndex& search);
 
     /**
      * @brief Prompts the user to select a sensor
      * @return true if a sensor was selected, false otherwise
      */
     bool SelectSensor();
+
+    /**
+     * @brief Prompts the user to choose one of the monitored parameters
+     * @param prompt Message shown above the list
+     * @param caption Title of the dialog
+     * @param paramCode [out] Chosen parameter code
+     * @return true if a parameter was chosen, false if the dialog was cancelled
+     */
+    bool ChooseParameterCode(const wxString& prompt, const wxString& caption, std::string& paramCode);
+    ///@}
+
+    /// @name Helper functions for the air quality index
+    ///@{
+    /**
+     * @brief Shows the hourly air quality index of the selected station
+     */
+    void ShowStationAirQualityIndex();
+
+    /**
+     * @brief Shows a computed station index in the info and chart panels
+     * @param stationName Name of the station the index was computed for
+     * @param aqi Hourly index of the station
+     * @param failedSensors IDs of the sensors that failed to download, with their errors
+     */
+    void ShowStationAqiResult(const wxString& stationName, const StationAqi& aqi, const std::vector<std::string>& failedSensors);
+
+    /**
+     * @brief Shows a summary of the current index of all stored stations
+     */
+    void ShowAllStationsAirQualityIndex();
     ///@}
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+ * @file SpatialIndex.cpp
+ * @brief Implementation of the 2-d tree
+ */
+
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const double KM_PER_DEGREE_LATITUDE = 111.2;  ///< Length of one degree of latitude in kilometres
+    const double PROJECTION_LATITUDE = 52.0;      ///< Latitude at which longitude distances are exact (centre of Poland)
+    const double PI = 3.14159265358979323846;     ///< Pi
+}
+
+/**
+ * @brief Projects geographic coordinates onto a plane in kilometres
+ * @param latitude Latitude in degrees
+ * @param longitude Longitude in degrees
+ * @return Projected point
+ */
+SpatialPoint ProjectToKilometers(double latitude, double longitude) {
+    static const double kmPerDegreeLongitude = KM_PER_DEGREE_LATITUDE * std::cos(PROJECTION_LATITUDE * PI / 180.0);
+    SpatialPoint point;
+    point.x = longitude * kmPerDegreeLongitude;
+    point.y = latitude * KM_PER_DEGREE_LATITUDE;
+    return point;
+}
+
+/**
+ * @brief Builds the tree over a set of points
+ * @param points Points to index; results refer to positions in this vector
+ */
+void SpatialIndex::Build(const std::vector<SpatialPoint>& points) {
+    nodes.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        nodes[i].point = points[i];
+        nodes[i].index = i;
+    }
+    BuildRange(0, nodes.size(), 0);
+}
+
+/**
+ * @brief Orders a range so that its median splits it along the axis of the given depth
+ * @param begin First position of the range
+ * @param end Position past the end of the range
+ * @param depth Depth of the range's node (even: split by x, odd: split by y)
+ */
+void SpatialIndex::BuildRange(size_t begin, size_t end, int depth) {
+    if (end - begin < 2) {
+        return;
+    }
+    size_t middle = begin + (end - begin) / 2;
+    bool byX = (depth % 2) == 0;
+    std::nth_element(nodes.begin() + begin, nodes.begin() + middle, nodes.begin() + end,
+        [byX](const Node& a, const Node& b) { return byX ? a.point.x < b.point.x : a.point.y < b.point.y; });
+
+    BuildRange(begin, middle, depth + 1);
+    BuildRange(middle + 1, end, depth + 1);
+}
+
+/**
+ * @brief Finds the k points closest to a query point
+ * @param x East-west coordinate of the query point in kilometres
+ * @param y North-south coordinate of the query point in kilometres
+ * @param k Number of neighbours to find
+ * @param result [out] Up to k neighbours sorted by increasing distance
+ */
+void SpatialIndex::FindNearest(double x, double y, size_t k, std::vector<Neighbor>& result) const {
+    result.clear();
+    if (k == 0 || nodes.empty()) {
+        return;
+    }
+    SearchRange(0, nodes.size(), 0, x, y, k, result);
+}
+
+/**
+ * @brief Searches a subtree for neighbours closer than the current k-th best
+ * @param begin First position of the subtree's range
+ * @param end Position past the end of the range
+ * @param depth Depth of the subtree's root
+ * @param x Query coordinate
+ * @param y Query coordinate
+ * @param k Number of neighbours to find
+ * @param result Best neighbours found so far, sorted by distance
+ *
+ * The result is kept as a small sorted array (k is a handful of stations), which is
+ * faster than a heap at this size. The far subtree is only visited when the splitting
+ * line is closer than the current k-th neighbour.
+ */
+void SpatialIndex::SearchRange(size_t begin, size_t end, int depth, double x, double y, size_t k, std::vector<Neighbor>& result) const {
+    if (begin >= end) {
+        return;
+    }
+    size_t middle = begin + (end - begin) / 2;
+    const Node& node = nodes[middle];
+
+    // Insert the node into the sorted result if it is among the k closest so far
+    double dx = node.point.x - x;
+    double dy = node.point.y - y;
+    double distanceSquared = dx * dx + dy * dy;
+    if (result.size() < k || distanceSquared < result.back().distanceSquared) {
+        Neighbor neighbor;
+        neighbor.index = node.index;
+        neighbor.distanceSquared = distanceSquared;
+        auto position = std::upper_bound(result.begin(), result.end(), distanceSquared,
+            [](double distance, const Neighbor& entry) { return distance < entry.distanceSquared; });
+        result.insert(position, neighbor);
+        if (result.size() > k) {
+            result.pop_back();
+        }
+    }
+
+    // Visit the side containing the query point first
+    double delta = (depth % 2 == 0) ? x - node.point.x : y - node.point.y;
+    if (delta < 0.0) {
+        SearchRange(begin, middle, depth + 1, x, y, k, result);
+        if (result.size() < k || delta * delta < result.back().distanceSquared) {
+            SearchRange(middle + 1, end, depth + 1, x, y, k, result);
+        }
+    }
+    else {
+        SearchRange(middle + 1, end, depth + 1, x, y, k, result);
+        if (result.size() < k || delta * delta < result.back().distanceSquared) {
+            SearchRange(begin, middle, depth + 1, x, y, k, result);
+        }
+    }
+}
+
+/**
+ * @brief Finds all points within a distance of a query point
+ * @param x East-west coordinate of the query point in kilometres
+ * @param y North-south coordinate of the query point in kilometres
+ * @param radius Largest distance in kilometres
+ * @param result [out] Points within the radius sorted by increasing distance
+ */
+void SpatialIndex::FindWithinRadius(double x, double y, double radius, std::vector<Neighbor>& result) const {
+    result.clear();
+    if (radius < 0.0 || nodes.empty()) {
+        return;
+    }
+    CollectRange(0, nodes.size(), 0, x, y, radius * radius, result);
+    std::sort(result.begin(), result.end(),
+        [](const Neighbor& a, const Neighbor& b) { return a.distanceSquared < b.distanceSquared; });
+}
+
+/**
+ * @brief Collects the points of a subtree within a squared distance
+ * @param begin First position of the subtree's range
+ * @param end Position past the end of the range
+ * @param depth Depth of the subtree's root
+ * @param x Query coordinate
+ * @param y Query coordinate
+ * @param radiusSquared Largest squared distance in km^2
+ * @param result Points found so far, unsorted
+ *
+ * A subtree is skipped when the circle lies entirely on the other side of its splitting line.
+ */
+void SpatialIndex::CollectRange(size_t begin, size_t end, int depth, double x, double y, double radiusSquared, std::vector<Neighbor>& result) const {
+    if (begin >= end) {
+        return;
+    }
+    size_t middle = begin + (end - begin) / 2;
+    const Node& node = nodes[middle];
+
+    double dx = node.point.x - x;
+    double dy = node.point.y - y;
+    double distanceSquared = dx * dx + dy * dy;
+    if (distanceSquared <= radiusSquared) {
+        Neighbor neighbor;
+        neighbor.index = node.index;
+        neighbor.distanceSquared = distanceSquared;
+        result.push_back(neighbor);
+    }
+
+    double delta = (depth % 2 == 0) ? x - node.point.x : y - node.point.y;
+    if (delta < 0.0 || delta * delta <= radiusSquared) {
+        CollectRange(begin, middle, depth + 1, x, y, radiusSquared, result);
+    }
+    if (delta >= 0.0 || delta * delta <= radiusSquared) {
+        CollectRange(middle + 1, end, depth + 1, x, y, radiusSquared, result);
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file SpatialIndex.h
+ * @brief Static 2-d tree for nearest-neighbour queries over station locations
+ */
+
+ /**
+  * @struct SpatialPoint
+  * @brief Point on a plane, in kilometres
+  */
+struct SpatialPoint {
+    double x = 0.0; /**< East-west coordinate in kilometres */
+    double y = 0.0; /**< North-south coordinate in kilometres */
+};
+
+/**
+ * @brief Projects geographic coordinates onto a plane in kilometres
+ *
+ * Uses an equirectangular projection centred on Poland, which keeps distances
+ * within a few percent across the country and is cheap enough for per-cell use.
+ *
+ * @param latitude Latitude in degrees
+ * @param longitude Longitude in degrees
+ * @return Projected point
+ */
+SpatialPoint ProjectToKilometers(double latitude, double longitude);
+
+/**
+ * @class SpatialIndex
+ * @brief Balanced 2-d tree answering k-nearest-neighbour queries
+ *
+ * The tree is stored implicitly in one array: the median of every range is its node,
+ * with the left and right subtrees on either side. Building takes O(n log n); a query
+ * for k neighbours visits O(log n + k) nodes on typical data, a radius query O(log n)
+ * nodes plus those inside the circle.
+ */
+class SpatialIndex {
+public:
+    /**
+     * @struct Neighbor
+     * @brief Result entry of a nearest-neighbour query
+     */
+    struct Neighbor {
+        size_t index = 0;              /**< Index of the point in the vector passed to Build() */
+        double distanceSquared = 0.0;  /**< Squared distance to the query point in km^2 */
+    };
+
+    /**
+     * @brief Builds the tree over a set of points
+     * @param points Points to index; results refer to positions in this vector
+     */
+    void Build(const std::vector<SpatialPoint>& points);
+
+    /**
+     * @brief Gets the number of indexed points
+     * @return Number of points
+     */
+    size_t Size() const { return nodes.size(); }
+
+    /**
+     * @brief Finds the k points closest to a query point
+     * @param x East-west coordinate of the query point in kilometres
+     * @param y North-south coordinate of the query point in kilometres
+     * @param k Number of neighbours to find
+     * @param result [out] Up to k neighbours sorted by increasing distance
+     */
+    void FindNearest(double x, double y, size_t k, std::vector<Neighbor>& result) const;
+
+    /**
+     * @brief Finds all points within a distance of a query point
+     * @param x East-west coordinate of the query point in kilometres
+     * @param y North-south coordinate of the query point in kilometres
+     * @param radius Largest distance in kilometres
+     * @param result [out] Points within the radius sorted by increasing distance
+     */
+    void FindWithinRadius(double x, double y, double radius, std::vector<Neighbor>& result) const;
+
+private:
+    /**
+     * @struct Node
+     * @brief Indexed point with its original position
+     */
+    struct Node {
+        SpatialPoint point;  /**< Coordinates */
+        size_t index = 0;    /**< Position in the vector passed to Build() */
+    };
+
+    std::vector<Node> nodes; /**< Points in implicit tree order */
+
+    /**
+     * @brief Orders a range so that its median splits it along the axis of the given depth
+     * @param begin First position of the range
+     * @param end Position past the end of the range
+     * @param depth Depth of the range's node (even: split by x, odd: split by y)
+     */
+    void BuildRange(size_t begin, size_t end, int depth);
+
+    /**
+     * @brief Searches a subtree for neighbours closer than the current k-th best
+     * @param begin First position of the subtree's range
+     * @param end Position past the end of the range
+     * @param depth Depth of the subtree's root
+     * @param x Query coordinate
+     * @param y Query coordinate
+     * @param k Number of neighbours to find
+     * @param result Best neighbours found so far, sorted by distance
+     */
+    void SearchRange(size_t begin, size_t end, int depth, double x, double y, size_t k, std::vector<Neighbor>& result) const;
+
+    /**
+     * @brief Collects the points of a subtree within a squared distance
+     * @param begin First position of the subtree's range
+     * @param end Position past the end of the range
+     * @param depth Depth of the subtree's root
+     * @param x Query coordinate
+     * @param y Query coordinate
+     * @param radiusSquared Largest squared distance in km^2
+     * @param result Points found so far, unsorted
+     */
+    void CollectRange(size_t begin, size_t end, int depth, double x, double y, double radiusSquared, std::vector<Neighbor>& result) const;
+};
+
+#endif // SPATIAL_INDEX_H
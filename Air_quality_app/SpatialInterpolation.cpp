@@ -0,0 +1,168 @@
+/**
+ * @file SpatialInterpolation.cpp
+ * @brief Implementation of the station value loading and the IDW grid
+ */
+
+#include "SpatialInterpolation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "SensorCatalog.h"
+#include "TimeSeries.h"
+
+namespace {
+    const double POLAND_WEST = 14.0;                  ///< Western edge of the grid in degrees of longitude
+    const double POLAND_EAST = 24.2;                  ///< Eastern edge of the grid in degrees of longitude
+    const double POLAND_SOUTH = 49.0;                 ///< Southern edge of the grid in degrees of latitude
+    const double POLAND_NORTH = 54.9;                 ///< Northern edge of the grid in degrees of latitude
+    const double MAX_STATION_DISTANCE_KM = 60.0;      ///< Cells farther than this from every station are left empty
+    const long long MAX_VALUE_AGE_HOURS = 24;         ///< Largest age of a station's value relative to the newest one
+    const double COINCIDENT_DISTANCE_SQUARED = 1e-6;  ///< Squared distance (km^2) at which a cell takes the station value directly
+
+    /**
+     * @brief Finds the newest measurement of a sensor
+     * @return true if the sensor has a stored measurement, false otherwise
+     */
+    bool LoadLatestValue(const std::string& sensorDirectory, long long& hour, double& value) {
+        std::string filePath = FindLatestDataFile(sensorDirectory);
+        std::string key;
+        std::vector<std::pair<std::string, double>> data;
+        if (filePath.empty() || !LoadMeasurementFile(filePath, key, data)) {
+            return false;
+        }
+
+        bool found = false;
+        for (const auto& [timestamp, measured] : data) {
+            long long measuredHour;
+            if (ParseTimestampToHours(timestamp, measuredHour) && (!found || measuredHour > hour)) {
+                hour = measuredHour;
+                value = measured;
+                found = true;
+            }
+        }
+        return found;
+    }
+}
+
+/**
+ * @brief Loads the latest stored value of a parameter at every station
+ * @param databaseDirectory Path of the measurements directory (containing stations.json)
+ * @param paramCode Parameter code (e.g. "PM10")
+ * @param pool Thread pool used to read the data files
+ * @return One entry per station with a current value
+ *
+ * This function:
+ * 1. Finds the stored stations with a sensor measuring the parameter
+ * 2. Loads the newest value of each such sensor in parallel
+ * 3. Drops values older than a day relative to the newest value
+ */
+std::vector<StationValue> LoadLatestStationValues(const std::string& databaseDirectory, const std::string& paramCode, ThreadPool& pool) {
+    std::vector<StationSensor> sensors = FindSensorsMeasuring(databaseDirectory, paramCode);
+    std::vector<StationValue> candidates(sensors.size());
+    for (size_t i = 0; i < sensors.size(); i++) {
+        candidates[i].stationId = sensors[i].station.id;
+        candidates[i].latitude = sensors[i].station.latitude;
+        candidates[i].longitude = sensors[i].station.longitude;
+    }
+
+    // Read the newest value of every sensor in parallel
+    std::vector<char> found(candidates.size(), 0);
+    pool.ParallelFor(candidates.size(), [&](size_t i) {
+        found[i] = LoadLatestValue(sensors[i].sensorDirectory, candidates[i].hour, candidates[i].value) ? 1 : 0;
+        });
+
+    long long newestHour = std::numeric_limits<long long>::min();
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (found[i]) {
+            newestHour = std::max(newestHour, candidates[i].hour);
+        }
+    }
+
+    std::vector<StationValue> result;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (found[i] && newestHour - candidates[i].hour <= MAX_VALUE_AGE_HOURS) {
+            result.push_back(candidates[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Interpolates station values onto a grid covering Poland
+ * @param stations Station values to interpolate
+ * @param cellKm Cell size in kilometres (1 for a 1 km grid)
+ * @param neighbours Number of nearest stations used per cell
+ * @param pool Thread pool computing the rows
+ * @return InterpolationGrid (empty if there are no stations or the cell size is not positive)
+ *
+ * This function:
+ * 1. Projects the stations to kilometres and builds the 2-d tree
+ * 2. Sizes the grid so that the bounding box of Poland is covered by square cells
+ * 3. For every cell centre finds the nearest stations and computes the weighted mean
+ *    with weights 1 / d^2 (no square root is needed), in parallel over rows
+ *
+ * A cell whose nearest station is farther than 60 km is set to NaN, which leaves
+ * areas without measurements (sea, neighbouring countries) blank on the map.
+ */
+InterpolationGrid InterpolateIdw(const std::vector<StationValue>& stations, double cellKm, size_t neighbours, ThreadPool& pool) {
+    InterpolationGrid grid;
+    if (stations.empty() || cellKm <= 0.0 || neighbours == 0) {
+        return grid;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<SpatialPoint> points;
+    points.reserve(stations.size());
+    for (const auto& station : stations) {
+        points.push_back(ProjectToKilometers(station.latitude, station.longitude));
+    }
+    SpatialIndex index;
+    index.Build(points);
+
+    SpatialPoint northWest = ProjectToKilometers(POLAND_NORTH, POLAND_WEST);
+    SpatialPoint southEast = ProjectToKilometers(POLAND_SOUTH, POLAND_EAST);
+    grid.west = POLAND_WEST;
+    grid.east = POLAND_EAST;
+    grid.south = POLAND_SOUTH;
+    grid.north = POLAND_NORTH;
+    grid.cellKm = cellKm;
+    grid.width = static_cast<size_t>(std::ceil((southEast.x - northWest.x) / cellKm));
+    grid.height = static_cast<size_t>(std::ceil((northWest.y - southEast.y) / cellKm));
+    grid.values.assign(grid.width * grid.height, std::numeric_limits<float>::quiet_NaN());
+
+    const double maxDistanceSquared = MAX_STATION_DISTANCE_KM * MAX_STATION_DISTANCE_KM;
+    pool.ParallelFor(grid.height, [&](size_t row) {
+        std::vector<SpatialIndex::Neighbor> nearest;
+        nearest.reserve(neighbours + 1);
+        double y = northWest.y - (static_cast<double>(row) + 0.5) * cellKm;
+        float* rowValues = grid.values.data() + row * grid.width;
+
+        for (size_t column = 0; column < grid.width; column++) {
+            double x = northWest.x + (static_cast<double>(column) + 0.5) * cellKm;
+            index.FindNearest(x, y, neighbours, nearest);
+            if (nearest.front().distanceSquared > maxDistanceSquared) {
+                continue;
+            }
+            if (nearest.front().distanceSquared < COINCIDENT_DISTANCE_SQUARED) {
+                rowValues[column] = static_cast<float>(stations[nearest.front().index].value);
+                continue;
+            }
+
+            double weightedSum = 0.0;
+            double weightSum = 0.0;
+            for (const auto& neighbour : nearest) {
+                double weight = 1.0 / neighbour.distanceSquared;
+                weightedSum += weight * stations[neighbour.index].value;
+                weightSum += weight;
+            }
+            rowValues[column] = static_cast<float>(weightedSum / weightSum);
+        }
+        });
+
+    grid.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return grid;
+}
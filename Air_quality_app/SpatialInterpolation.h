@@ -0,0 +1,83 @@
+#ifndef SPATIAL_INTERPOLATION_H
+#define SPATIAL_INTERPOLATION_H
+
+#include <string>
+#include <vector>
+
+#include "SpatialIndex.h"
+#include "ThreadPool.h"
+
+/**
+ * @file SpatialInterpolation.h
+ * @brief Inverse-distance-weighted concentration grid over Poland from the latest station values
+ */
+
+ /**
+  * @struct StationValue
+  * @brief Latest measurement of one parameter at a station
+  */
+struct StationValue {
+    int stationId = -1;      /**< Station ID */
+    double latitude = 0.0;   /**< Latitude in degrees */
+    double longitude = 0.0;  /**< Longitude in degrees */
+    long long hour = 0;      /**< Hour of the measurement (since 1970-01-01 00:00) */
+    double value = 0.0;      /**< Measured value */
+};
+
+/**
+ * @brief Loads the latest stored value of a parameter at every station
+ *
+ * For each station of stations.json with a sensor measuring the parameter, the newest
+ * data file is read on the thread pool. Stations whose latest value is more than a day
+ * older than the newest value overall are left out, so the map shows one point in time.
+ *
+ * @param databaseDirectory Path of the measurements directory (containing stations.json)
+ * @param paramCode Parameter code (e.g. "PM10")
+ * @param pool Thread pool used to read the data files
+ * @return One entry per station with a current value
+ */
+std::vector<StationValue> LoadLatestStationValues(const std::string& databaseDirectory, const std::string& paramCode, ThreadPool& pool);
+
+/**
+ * @struct InterpolationGrid
+ * @brief Regular grid of interpolated values over a geographic rectangle
+ *
+ * Cells are square in kilometres. Row 0 is the northern edge and column 0 the western
+ * edge; cells too far from any station hold NaN.
+ */
+struct InterpolationGrid {
+    double west = 0.0;             /**< Longitude of the western edge in degrees */
+    double east = 0.0;             /**< Longitude of the eastern edge in degrees */
+    double south = 0.0;            /**< Latitude of the southern edge in degrees */
+    double north = 0.0;            /**< Latitude of the northern edge in degrees */
+    double cellKm = 0.0;           /**< Cell size in kilometres */
+    size_t width = 0;              /**< Number of columns */
+    size_t height = 0;             /**< Number of rows */
+    std::vector<float> values;     /**< Row-major cell values */
+    double elapsedSeconds = 0.0;   /**< Time spent computing the grid */
+
+    /**
+     * @brief Gets the value of a cell
+     * @param row Row index (0 = north)
+     * @param column Column index (0 = west)
+     * @return Interpolated value or NaN
+     */
+    float At(size_t row, size_t column) const { return values[row * width + column]; }
+};
+
+/**
+ * @brief Interpolates station values onto a grid covering Poland
+ *
+ * Each cell takes the inverse-square-distance weighted mean of its nearest stations,
+ * found with a 2-d tree, so the cost per cell does not depend on the number of stations.
+ * Rows are computed in parallel on the thread pool.
+ *
+ * @param stations Station values to interpolate
+ * @param cellKm Cell size in kilometres (1 for a 1 km grid)
+ * @param neighbours Number of nearest stations used per cell
+ * @param pool Thread pool computing the rows
+ * @return InterpolationGrid (empty if there are no stations or the cell size is not positive)
+ */
+InterpolationGrid InterpolateIdw(const std::vector<StationValue>& stations, double cellKm, size_t neighbours, ThreadPool& pool);
+
+#endif // SPATIAL_INTERPOLATION_H
@@ -0,0 +1,88 @@
+/**
+ * @file StationComparison.cpp
+ * @brief Implementation of the multi-station loading and time alignment
+ */
+
+#include "StationComparison.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+    const long long MAX_STATION_LAG_HOURS = 48;        ///< Largest gap between a station's last hour and the newest hour overall
+    const long long MAX_COMPARISON_HOURS = 31 * 24;    ///< Longest common time axis
+}
+
+/**
+ * @brief Loads the latest data of the given sensors and aligns it on one time axis
+ * @param sensors Sensors to compare
+ * @param pool Thread pool used to load the sensors in parallel
+ * @return StationComparison of the sensors with recent data
+ *
+ * This function:
+ * 1. Loads and resamples the newest data file of every sensor in parallel
+ * 2. Finds the newest hour over all stations and drops stations lagging behind it
+ * 3. Determines the common axis from the kept series, limited to a month
+ * 4. Copies every kept series into its place on the common axis
+ */
+StationComparison LoadStationComparison(const std::vector<StationSensor>& sensors, ThreadPool& pool) {
+    StationComparison comparison;
+    auto start = std::chrono::steady_clock::now();
+
+    // Each sensor is loaded into its own preallocated slot, so workers share no state
+    std::vector<HourlySeries> loaded(sensors.size());
+    pool.ParallelFor(sensors.size(), [&](size_t i) {
+        std::string filePath = FindLatestDataFile(sensors[i].sensorDirectory);
+        std::string key;
+        std::vector<std::pair<std::string, double>> data;
+        if (!filePath.empty() && LoadMeasurementFile(filePath, key, data)) {
+            loaded[i] = ResampleToHourlyGrid(data);
+        }
+        });
+
+    long long newestHour = std::numeric_limits<long long>::min();
+    for (const auto& series : loaded) {
+        if (!series.values.empty()) {
+            newestHour = std::max(newestHour, series.HourAt(series.values.size() - 1));
+        }
+    }
+
+    // Keep the stations with recent data and find where the earliest of them starts
+    std::vector<size_t> kept;
+    long long firstHour = newestHour;
+    for (size_t i = 0; i < loaded.size(); i++) {
+        const HourlySeries& series = loaded[i];
+        if (series.values.empty() || newestHour - series.HourAt(series.values.size() - 1) > MAX_STATION_LAG_HOURS) {
+            comparison.skippedStations++;
+            continue;
+        }
+        kept.push_back(i);
+        firstHour = std::min(firstHour, series.startHour);
+    }
+    if (kept.empty()) {
+        return comparison;
+    }
+
+    firstHour = std::max(firstHour, newestHour - MAX_COMPARISON_HOURS + 1);
+    comparison.startHour = firstHour;
+    comparison.hourCount = static_cast<size_t>(newestHour - firstHour + 1);
+
+    // Place every series on the common axis
+    for (size_t i : kept) {
+        const HourlySeries& series = loaded[i];
+        std::vector<double> aligned(comparison.hourCount, MISSING_VALUE);
+        for (size_t slot = 0; slot < series.values.size(); slot++) {
+            long long offset = series.HourAt(slot) - firstHour;
+            if (offset >= 0 && offset < static_cast<long long>(comparison.hourCount)) {
+                aligned[static_cast<size_t>(offset)] = series.values[slot];
+            }
+        }
+        comparison.stationIds.push_back(sensors[i].station.id);
+        comparison.stationNames.push_back(sensors[i].station.name);
+        comparison.values.push_back(std::move(aligned));
+    }
+
+    comparison.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return comparison;
+}
@@ -0,0 +1,47 @@
+#ifndef STATION_COMPARISON_H
+#define STATION_COMPARISON_H
+
+#include <string>
+#include <vector>
+
+#include "SensorCatalog.h"
+#include "ThreadPool.h"
+
+/**
+ * @file StationComparison.h
+ * @brief Loading one parameter at several stations onto a common hourly time axis
+ */
+
+ /**
+  * @struct StationComparison
+  * @brief Measurements of one parameter at several stations aligned on the same hours
+  *
+  * Every station's values cover the same hours, so slot i of each series refers to
+  * hour startHour + i and the series can be overlaid directly.
+  */
+struct StationComparison {
+    long long startHour = 0;                     /**< Hour (since 1970-01-01 00:00) of the first slot */
+    size_t hourCount = 0;                        /**< Number of slots of every series */
+    std::vector<int> stationIds;                 /**< Station ID of each series */
+    std::vector<std::string> stationNames;       /**< Station name (UTF-8) of each series */
+    std::vector<std::vector<double>> values;     /**< Values of each series, MISSING_VALUE where nothing was measured */
+    size_t skippedStations = 0;                  /**< Stations left out because they had no recent data */
+    double elapsedSeconds = 0.0;                 /**< Time spent loading and aligning */
+};
+
+/**
+ * @brief Loads the latest data of the given sensors and aligns it on one time axis
+ *
+ * The newest data file of every sensor is parsed on the thread pool. The common axis
+ * ends at the newest measurement of all stations and starts at the earliest kept
+ * measurement, but spans at most a month. Stations whose data ends more than two days
+ * before the newest measurement are left out, so one outdated station cannot stretch
+ * the axis. The order of the sensors is kept.
+ *
+ * @param sensors Sensors to compare (e.g. the stations nearest to a location)
+ * @param pool Thread pool used to load the sensors in parallel
+ * @return StationComparison of the sensors with recent data
+ */
+StationComparison LoadStationComparison(const std::vector<StationSensor>& sensors, ThreadPool& pool);
+
+#endif // STATION_COMPARISON_H
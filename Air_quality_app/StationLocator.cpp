@@ -0,0 +1,164 @@
+/**
+ * @file StationLocator.cpp
+ * @brief Implementation of the StationLocator class
+ */
+
+#include "StationLocator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const double EARTH_RADIUS_KM = 6371.0;        ///< Mean radius of the Earth in kilometres
+    const double PI = 3.14159265358979323846;     ///< Pi
+    const double PROJECTION_TOLERANCE = 1.1;      ///< Factor covering the deviation of projected from great-circle distances across Poland (under 7%)
+}
+
+/**
+ * @brief Calculates the distance between two geographical coordinates using the Haversine formula
+ * @param lat1 Latitude of the first location in degrees
+ * @param lon1 Longitude of the first location in degrees
+ * @param lat2 Latitude of the second location in degrees
+ * @param lon2 Longitude of the second location in degrees
+ * @return Distance in kilometres
+ *
+ * The Haversine formula calculates the great-circle distance between two points
+ * on the Earth's surface given their longitude and latitude.
+ */
+double GreatCircleDistance(double lat1, double lon1, double lat2, double lon2) {
+    // Convert degrees to radians
+    const double toRad = PI / 180.0;
+    lat1 *= toRad;
+    lon1 *= toRad;
+    lat2 *= toRad;
+    lon2 *= toRad;
+
+    double dLat = lat2 - lat1;
+    double dLon = lon2 - lon1;
+    double a = std::sin(dLat / 2) * std::sin(dLat / 2) + std::cos(lat1) * std::cos(lat2) * std::sin(dLon / 2) * std::sin(dLon / 2);
+    double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+    return EARTH_RADIUS_KM * c;
+}
+
+/**
+ * @brief Indexes a station list
+ * @param stations Stations with their coordinates; query results refer to positions in this vector
+ */
+void StationLocator::Build(const std::vector<StationLocation>& stations) {
+    this->stations = stations;
+
+    std::vector<SpatialPoint> points;
+    points.reserve(stations.size());
+    for (const auto& station : stations) {
+        points.push_back(ProjectToKilometers(station.latitude, station.longitude));
+    }
+    index.Build(points);
+    ordered.clear();
+    orderedValid = false;
+}
+
+/**
+ * @brief Finds the k stations nearest to a location
+ * @param latitude Latitude of the location in degrees
+ * @param longitude Longitude of the location in degrees
+ * @param k Number of stations to find
+ * @param result [out] Up to k stations sorted by increasing distance
+ *
+ * This function:
+ * 1. Finds the k nearest stations in the projected tree
+ * 2. Searches the tree again within the largest of their great-circle distances,
+ *    widened by the projection's deviation, so no station the projection ranked
+ *    too far is missed
+ * 3. Keeps the k stations nearest by great-circle distance
+ */
+void StationLocator::FindNearest(double latitude, double longitude, size_t k, std::vector<StationDistance>& result) const {
+    SpatialPoint query = ProjectToKilometers(latitude, longitude);
+    std::vector<SpatialIndex::Neighbor> neighbors;
+    index.FindNearest(query.x, query.y, k, neighbors);
+    ToStationDistances(latitude, longitude, neighbors, result);
+    if (result.empty() || k >= stations.size()) {
+        return;
+    }
+
+    index.FindWithinRadius(query.x, query.y, result.back().distance * PROJECTION_TOLERANCE, neighbors);
+    ToStationDistances(latitude, longitude, neighbors, result);
+    if (result.size() > k) {
+        result.resize(k);
+    }
+}
+
+/**
+ * @brief Finds the stations within a distance of a location
+ * @param latitude Latitude of the location in degrees
+ * @param longitude Longitude of the location in degrees
+ * @param radius Largest distance in kilometres
+ * @param result [out] Stations within the radius sorted by increasing distance
+ *
+ * The tree is searched with the radius widened by the projection's deviation;
+ * candidates are then checked against their great-circle distance.
+ */
+void StationLocator::FindWithinRadius(double latitude, double longitude, double radius, std::vector<StationDistance>& result) const {
+    SpatialPoint query = ProjectToKilometers(latitude, longitude);
+    std::vector<SpatialIndex::Neighbor> neighbors;
+    index.FindWithinRadius(query.x, query.y, radius * PROJECTION_TOLERANCE, neighbors);
+    ToStationDistances(latitude, longitude, neighbors, result);
+    result.erase(std::remove_if(result.begin(), result.end(),
+        [radius](const StationDistance& entry) { return entry.distance > radius; }), result.end());
+}
+
+/**
+ * @brief Orders all stations by their distance from a location
+ * @param latitude Latitude of the location in degrees
+ * @param longitude Longitude of the location in degrees
+ * @return All stations sorted by increasing distance
+ *
+ * This function:
+ * 1. Returns the cached ordering if it was computed for the same location since the last Build()
+ * 2. Otherwise computes the great-circle distance of every station and sorts them once,
+ *    which is cheaper than a k-nearest query with k equal to the number of stations
+ */
+const std::vector<StationDistance>& StationLocator::OrderByDistance(double latitude, double longitude) const {
+    if (orderedValid && orderedLatitude == latitude && orderedLongitude == longitude) {
+        return ordered;
+    }
+
+    ordered.clear();
+    ordered.reserve(stations.size());
+    for (size_t i = 0; i < stations.size(); i++) {
+        StationDistance entry;
+        entry.index = i;
+        entry.distance = GreatCircleDistance(latitude, longitude, stations[i].latitude, stations[i].longitude);
+        ordered.push_back(entry);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(),
+        [](const StationDistance& a, const StationDistance& b) { return a.distance < b.distance; });
+
+    orderedLatitude = latitude;
+    orderedLongitude = longitude;
+    orderedValid = true;
+    return ordered;
+}
+
+/**
+ * @brief Converts tree neighbours to stations with their great-circle distances
+ * @param latitude Latitude of the query location in degrees
+ * @param longitude Longitude of the query location in degrees
+ * @param neighbors Neighbours found in the tree
+ * @param result [out] Stations sorted by increasing distance
+ *
+ * Only the neighbours get the Haversine formula applied; they are sorted again by
+ * their exact distance, which can differ from the projected order.
+ */
+void StationLocator::ToStationDistances(double latitude, double longitude, const std::vector<SpatialIndex::Neighbor>& neighbors, std::vector<StationDistance>& result) const {
+    result.clear();
+    result.reserve(neighbors.size());
+    for (const auto& neighbor : neighbors) {
+        const StationLocation& station = stations[neighbor.index];
+        StationDistance entry;
+        entry.index = neighbor.index;
+        entry.distance = GreatCircleDistance(latitude, longitude, station.latitude, station.longitude);
+        result.push_back(entry);
+    }
+    std::stable_sort(result.begin(), result.end(),
+        [](const StationDistance& a, const StationDistance& b) { return a.distance < b.distance; });
+}
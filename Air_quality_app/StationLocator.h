@@ -0,0 +1,117 @@
+#ifndef STATION_LOCATOR_H
+#define STATION_LOCATOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "SensorCatalog.h"
+#include "SpatialIndex.h"
+
+/**
+ * @file StationLocator.h
+ * @brief Nearest-station and within-radius queries over the station list
+ */
+
+ /**
+  * @struct StationDistance
+  * @brief Result entry of a station query
+  */
+struct StationDistance {
+    size_t index = 0;       /**< Index of the station in StationLocator::Stations() */
+    double distance = 0.0;  /**< Great-circle distance from the query location in kilometres */
+};
+
+/**
+ * @brief Calculates the distance between two geographical coordinates using the Haversine formula
+ * @param lat1 Latitude of the first location in degrees
+ * @param lon1 Longitude of the first location in degrees
+ * @param lat2 Latitude of the second location in degrees
+ * @param lon2 Longitude of the second location in degrees
+ * @return Distance in kilometres
+ */
+double GreatCircleDistance(double lat1, double lon1, double lat2, double lon2);
+
+/**
+ * @class StationLocator
+ * @brief Station list with a 2-d tree over the station positions
+ *
+ * Built once when the station list is loaded; afterwards the stations nearest to a
+ * location are found without computing the distance to every station. The tree works
+ * on the projected positions of ProjectToKilometers; candidates are taken from a
+ * slightly wider area and ranked by their great-circle distance, so results match
+ * the Haversine formula for locations in Poland.
+ */
+class StationLocator {
+public:
+    /**
+     * @brief Indexes a station list
+     * @param stations Stations with their coordinates; query results refer to positions in this vector
+     */
+    void Build(const std::vector<StationLocation>& stations);
+
+    /**
+     * @brief Gets the indexed stations
+     * @return Stations in the order passed to Build()
+     */
+    const std::vector<StationLocation>& Stations() const { return stations; }
+
+    /**
+     * @brief Gets the number of indexed stations
+     * @return Number of stations
+     */
+    size_t Size() const { return stations.size(); }
+
+    /**
+     * @brief Checks whether no station is indexed
+     * @return true if the locator is empty, false otherwise
+     */
+    bool Empty() const { return stations.empty(); }
+
+    /**
+     * @brief Finds the k stations nearest to a location
+     * @param latitude Latitude of the location in degrees
+     * @param longitude Longitude of the location in degrees
+     * @param k Number of stations to find
+     * @param result [out] Up to k stations sorted by increasing distance
+     */
+    void FindNearest(double latitude, double longitude, size_t k, std::vector<StationDistance>& result) const;
+
+    /**
+     * @brief Finds the stations within a distance of a location
+     * @param latitude Latitude of the location in degrees
+     * @param longitude Longitude of the location in degrees
+     * @param radius Largest distance in kilometres
+     * @param result [out] Stations within the radius sorted by increasing distance
+     */
+    void FindWithinRadius(double latitude, double longitude, double radius, std::vector<StationDistance>& result) const;
+
+    /**
+     * @brief Orders all stations by their distance from a location
+     * @param latitude Latitude of the location in degrees
+     * @param longitude Longitude of the location in degrees
+     * @return All stations sorted by increasing distance
+     *
+     * The ordering is computed once per Build() and location and reused by later calls,
+     * so it must not be requested from several threads at once.
+     */
+    const std::vector<StationDistance>& OrderByDistance(double latitude, double longitude) const;
+
+private:
+    std::vector<StationLocation> stations; /**< Indexed stations */
+    SpatialIndex index; /**< 2-d tree over the projected station positions */
+    mutable std::vector<StationDistance> ordered; /**< Cached result of OrderByDistance() */
+    mutable double orderedLatitude = 0.0;  /**< Latitude the cached ordering was computed for */
+    mutable double orderedLongitude = 0.0; /**< Longitude the cached ordering was computed for */
+    mutable bool orderedValid = false;     /**< Whether the cached ordering matches the stations */
+
+    /**
+     * @brief Converts tree neighbours to stations with their great-circle distances
+     * @param latitude Latitude of the query location in degrees
+     * @param longitude Longitude of the query location in degrees
+     * @param neighbors Neighbours found in the tree
+     * @param result [out] Stations sorted by increasing distance
+     */
+    void ToStationDistances(double latitude, double longitude, const std::vector<SpatialIndex::Neighbor>& neighbors, std::vector<StationDistance>& result) const;
+};
+
+#endif // STATION_LOCATOR_H
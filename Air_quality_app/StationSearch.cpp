@@ -0,0 +1,214 @@
+/**
+ * @file StationSearch.cpp
+ * @brief Implementation of the station search index
+ */
+
+#include "StationSearch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace {
+    const size_t MAX_GRAM_LENGTH = 3;   ///< Longest indexed substring of a word
+
+    /**
+     * @struct FoldedLetter
+     * @brief Polish letter with the base letter it is searched as
+     */
+    struct FoldedLetter {
+        const char* utf8;   ///< UTF-8 bytes of the letter
+        char base;          ///< Lower-case ASCII letter it is folded to
+    };
+
+    const FoldedLetter FOLDED_LETTERS[] = {
+        { "\xC4\x85", 'a' }, { "\xC4\x84", 'a' },   // ą Ą
+        { "\xC4\x87", 'c' }, { "\xC4\x86", 'c' },   // ć Ć
+        { "\xC4\x99", 'e' }, { "\xC4\x98", 'e' },   // ę Ę
+        { "\xC5\x82", 'l' }, { "\xC5\x81", 'l' },   // ł Ł
+        { "\xC5\x84", 'n' }, { "\xC5\x83", 'n' },   // ń Ń
+        { "\xC3\xB3", 'o' }, { "\xC3\x93", 'o' },   // ó Ó
+        { "\xC5\x9B", 's' }, { "\xC5\x9A", 's' },   // ś Ś
+        { "\xC5\xBA", 'z' }, { "\xC5\xB9", 'z' },   // ź Ź
+        { "\xC5\xBC", 'z' }, { "\xC5\xBB", 'z' },   // ż Ż
+    };
+
+    /**
+     * @brief Packs an n-gram of up to MAX_GRAM_LENGTH characters and its length into a key
+     */
+    uint32_t GramKey(const std::string& text, size_t position, size_t length) {
+        uint32_t key = static_cast<uint32_t>(length);
+        for (size_t i = 0; i < length; i++) {
+            key = (key << 8) | static_cast<unsigned char>(text[position + i]);
+        }
+        return key;
+    }
+
+    /**
+     * @brief Splits a normalized text into its words
+     */
+    std::vector<std::string> SplitWords(const std::string& text) {
+        std::vector<std::string> words;
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t end = text.find(' ', start);
+            if (end == std::string::npos) {
+                end = text.size();
+            }
+            if (end > start) {
+                words.push_back(text.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return words;
+    }
+}
+
+/**
+ * @brief Brings a text to the form searched by StationSearchIndex
+ * @param text UTF-8 text
+ * @return Normalized ASCII text
+ *
+ * Letters outside ASCII other than the Polish ones are kept as a placeholder
+ * character, so they still have to match the same placeholder in a query.
+ */
+std::string NormalizeSearchText(const std::string& text) {
+    std::string normalized;
+    normalized.reserve(text.size());
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            normalized += std::isalnum(c) ? static_cast<char>(std::tolower(c)) : ' ';
+            i++;
+            continue;
+        }
+
+        // Length of the UTF-8 sequence starting here
+        size_t length = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 1;
+        char folded = '#';
+        for (const auto& letter : FOLDED_LETTERS) {
+            if (text.compare(i, 2, letter.utf8) == 0) {
+                folded = letter.base;
+                break;
+            }
+        }
+        normalized += folded;
+        i += length;
+    }
+    return normalized;
+}
+
+/**
+ * @brief Indexes the names and cities of a station list
+ * @param stations Stations to index; results refer to positions in this vector
+ *
+ * Stations are visited in order, so every posting list is sorted without sorting
+ * and a station is appended at most once per n-gram.
+ */
+void StationSearchIndex::Build(const std::vector<StationLocation>& stations) {
+    texts.clear();
+    postings.clear();
+    texts.reserve(stations.size());
+    for (size_t s = 0; s < stations.size(); s++) {
+        std::string text = NormalizeSearchText(stations[s].name + " " + stations[s].city);
+        for (const auto& word : SplitWords(text)) {
+            for (size_t length = 1; length <= MAX_GRAM_LENGTH; length++) {
+                for (size_t position = 0; position + length <= word.size(); position++) {
+                    std::vector<uint32_t>& list = postings[GramKey(word, position, length)];
+                    if (list.empty() || list.back() != s) {
+                        list.push_back(static_cast<uint32_t>(s));
+                    }
+                }
+            }
+        }
+        texts.push_back(text);
+    }
+}
+
+/**
+ * @brief Finds the stations matching a query
+ * @param query UTF-8 text typed by the user; words may appear anywhere and in any order
+ * @param matches [out] Positions of the matching stations in ascending order; all stations for an empty query
+ *
+ * This function:
+ * 1. Normalizes the query like the indexed texts and splits it into words
+ * 2. Looks up the stations of each word and intersects them, starting from the
+ *    first word's result and stopping as soon as nothing is left
+ */
+void StationSearchIndex::Find(const std::string& query, std::vector<size_t>& matches) const {
+    matches.clear();
+    std::vector<std::string> words = SplitWords(NormalizeSearchText(query));
+    if (words.empty()) {
+        matches.resize(texts.size());
+        for (size_t i = 0; i < matches.size(); i++) {
+            matches[i] = i;
+        }
+        return;
+    }
+
+    FindWord(words[0], matches);
+    std::vector<size_t> wordMatches;
+    std::vector<size_t> intersection;
+    for (size_t w = 1; w < words.size() && !matches.empty(); w++) {
+        FindWord(words[w], wordMatches);
+        intersection.clear();
+        std::set_intersection(matches.begin(), matches.end(), wordMatches.begin(), wordMatches.end(), std::back_inserter(intersection));
+        matches.swap(intersection);
+    }
+}
+
+/**
+ * @brief Finds the stations containing one normalized word
+ * @param word Word of the normalized query
+ * @param matches [out] Positions of the stations in ascending order
+ *
+ * For a word longer than an n-gram, the trigram lists are intersected from the
+ * shortest one; containing all trigrams does not guarantee containing the word, so
+ * the candidates are confirmed against their text.
+ */
+void StationSearchIndex::FindWord(const std::string& word, std::vector<size_t>& matches) const {
+    matches.clear();
+    if (word.size() <= MAX_GRAM_LENGTH) {
+        const std::vector<uint32_t>* list = Postings(GramKey(word, 0, word.size()));
+        if (list) {
+            matches.assign(list->begin(), list->end());
+        }
+        return;
+    }
+
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (size_t position = 0; position + MAX_GRAM_LENGTH <= word.size(); position++) {
+        const std::vector<uint32_t>* list = Postings(GramKey(word, position, MAX_GRAM_LENGTH));
+        if (!list) {
+            return;
+        }
+        lists.push_back(list);
+    }
+    std::sort(lists.begin(), lists.end(),
+        [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+
+    std::vector<uint32_t> candidates(lists[0]->begin(), lists[0]->end());
+    std::vector<uint32_t> intersection;
+    for (size_t l = 1; l < lists.size() && !candidates.empty(); l++) {
+        intersection.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), lists[l]->begin(), lists[l]->end(), std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    for (uint32_t candidate : candidates) {
+        if (texts[candidate].find(word) != std::string::npos) {
+            matches.push_back(candidate);
+        }
+    }
+}
+
+/**
+ * @brief Gets the stations containing an n-gram
+ * @param key Key of the n-gram, see GramKey()
+ * @return Stations in ascending order, or nullptr if no station contains it
+ */
+const std::vector<uint32_t>* StationSearchIndex::Postings(uint32_t key) const {
+    auto it = postings.find(key);
+    return (it != postings.end()) ? &it->second : nullptr;
+}
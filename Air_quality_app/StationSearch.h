@@ -0,0 +1,80 @@
+#ifndef STATION_SEARCH_H
+#define STATION_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SensorCatalog.h"
+
+/**
+ * @file StationSearch.h
+ * @brief Type-ahead search over station names and cities
+ */
+
+ /**
+  * @brief Brings a text to the form searched by StationSearchIndex
+  *
+  * Lower-cases ASCII letters, folds the Polish letters to their base letters
+  * ("Kraków" becomes "krakow") and turns every other character that is not a letter
+  * or digit into a space, so a query matches regardless of case and diacritics.
+  *
+  * @param text UTF-8 text
+  * @return Normalized ASCII text
+  */
+std::string NormalizeSearchText(const std::string& text);
+
+/**
+ * @class StationSearchIndex
+ * @brief N-gram index finding the stations whose name or city contains every word of a query
+ *
+ * Every word of a station's normalized name and city contributes all its substrings
+ * of one to three characters, each with a sorted list of the stations containing it.
+ * A query word of up to three characters is answered by one list; a longer word by
+ * intersecting the lists of its trigrams and checking the few remaining candidates,
+ * so a keystroke costs the length of the shortest lists instead of a scan of all
+ * station names.
+ */
+class StationSearchIndex {
+public:
+    /**
+     * @brief Indexes the names and cities of a station list
+     * @param stations Stations to index; results refer to positions in this vector
+     */
+    void Build(const std::vector<StationLocation>& stations);
+
+    /**
+     * @brief Gets the number of indexed stations
+     * @return Number of stations
+     */
+    size_t Size() const { return texts.size(); }
+
+    /**
+     * @brief Finds the stations matching a query
+     * @param query UTF-8 text typed by the user; words may appear anywhere and in any order
+     * @param matches [out] Positions of the matching stations in ascending order; all stations for an empty query
+     */
+    void Find(const std::string& query, std::vector<size_t>& matches) const;
+
+private:
+    std::vector<std::string> texts; /**< Normalized name and city of each station */
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings; /**< Stations containing each n-gram, in ascending order */
+
+    /**
+     * @brief Finds the stations containing one normalized word
+     * @param word Word of the normalized query
+     * @param matches [out] Positions of the stations in ascending order
+     */
+    void FindWord(const std::string& word, std::vector<size_t>& matches) const;
+
+    /**
+     * @brief Gets the stations containing an n-gram
+     * @param key Key of the n-gram, see GramKey()
+     * @return Stations in ascending order, or nullptr if no station contains it
+     */
+    const std::vector<uint32_t>* Postings(uint32_t key) const;
+};
+
+#endif // STATION_SEARCH_H
@@ -6,29 +6,68 @@
 #include "StationSelectionDialog.h"
 
  /**
-  * @brief Constructor that creates a dialog for selecting a station from JSON data and sorts by distance
-  *
-  * Creates a modal dialog with a listbox containing station names and their distances
-  * from a reference location, along with OK and Cancel buttons.
-  *
-  * The constructor:
-  * 1. Loads reference coordinates from config.ini
-  * 2. Parses the JSON data to extract station information
-  * 3. Calculates the distance from each station to the reference point
-  * 4. Sorts stations by distance
-  * 5. Populates the listbox with station names and distances
-  *
-  * @param parent Pointer to the parent window
-  * @param stations JSON value containing an array of station objects with id, stationName,
-  *                 gegrLat, and gegrLon fields
+  * @brief Creates the list with its name, city and distance columns
+  * @param parent Parent window
+  * @param stations All stations of the dialog, nearest first
+  * @param visibleRows Positions in stations of the rows shown, in display order
   */
-StationSelectionDialog::StationSelectionDialog(wxWindow* parent, const Json::Value& stations)
-    : wxDialog(parent, wxID_ANY, "Select Station", wxDefaultPosition, wxSize(500, 400)) {
+StationListCtrl::StationListCtrl(wxWindow* parent, const std::vector<StationInfo>& stations, const std::vector<size_t>& visibleRows)
+    : wxListCtrl(parent, wxID_ANY, wxDefaultPosition, wxSize(560, 300), wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL),
+    stations(stations), visibleRows(visibleRows) {
+    InsertColumn(0, "Station", wxLIST_FORMAT_LEFT, 300);
+    InsertColumn(1, "City", wxLIST_FORMAT_LEFT, 140);
+    InsertColumn(2, "Distance", wxLIST_FORMAT_RIGHT, 90);
+}
+
+/**
+ * @brief Gets the text of one cell when the control draws it
+ * @param item Row in the displayed list
+ * @param column Column index (0: name, 1: city, 2: distance)
+ * @return Text of the cell
+ */
+wxString StationListCtrl::OnGetItemText(long item, long column) const {
+    if (item < 0 || static_cast<size_t>(item) >= visibleRows.size()) {
+        return wxString();
+    }
+    const StationInfo& station = stations[visibleRows[item]];
+    switch (column) {
+    case 0:
+        return station.name;
+    case 1:
+        return station.city;
+    default:
+        return wxString::Format("%.2f km", station.distance);
+    }
+}
+
+/**
+ * @brief Constructor that creates a dialog for selecting a station, nearest stations first
+ *
+ * Creates a modal dialog with a search box, a virtual list containing station names,
+ * cities and their distances from a reference location, and OK and Cancel buttons.
+ *
+ * The constructor:
+ * 1. Loads reference coordinates from config.ini
+ * 2. Asks the locator for all stations ordered by distance from the reference point;
+ *    the coordinates were parsed and indexed when the station list was loaded
+ * 3. Shows all of them; the list asks for the text of the visible rows only
+ *
+ * @param parent Pointer to the parent window
+ * @param locator Stations to choose from, indexed by position
+ * @param searchIndex Index built over the same stations as the locator; must outlive the dialog
+ */
+StationSelectionDialog::StationSelectionDialog(wxWindow* parent, const StationLocator& locator, const StationSearchIndex& searchIndex)
+    : wxDialog(parent, wxID_ANY, "Select Station", wxDefaultPosition, wxSize(600, 450)), searchIndex(searchIndex) {
     wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
 
-    // Create listbox to display stations
-    stationListBox = new wxListBox(this, wxID_ANY, wxDefaultPosition, wxSize(480, 300));
-    mainSizer->Add(stationListBox, 1, wxEXPAND | wxALL, 10);
+    // Create search box above the list
+    searchBox = new wxTextCtrl(this, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxTE_PROCESS_ENTER);
+    searchBox->SetHint("Search by station or city");
+    mainSizer->Add(searchBox, 0, wxEXPAND | wxLEFT | wxRIGHT | wxTOP, 10);
+
+    // Create virtual list to display stations
+    stationList = new StationListCtrl(this, stations, visibleRows);
+    mainSizer->Add(stationList, 1, wxEXPAND | wxALL, 10);
 
     // Add OK and Cancel buttons
     wxBoxSizer* buttonSizer = new wxBoxSizer(wxHORIZONTAL);
@@ -41,97 +80,102 @@ StationSelectionDialog::StationSelectionDialog(wxWindow* parent, const Json::Val
     // Read reference coordinates from config.ini
     ReadReferenceCoordinates();
 
-    // Load and sort stations by distance
-    if (!stations.isNull() && stations.isArray()) {
-        for (Json::Value::ArrayIndex i = 0; i < stations.size(); i++) {
-            const Json::Value& station = stations[i];
-            if (station.isMember("id") && station.isMember("stationName") &&
-                station.isMember("gegrLat") && station.isMember("gegrLon")) {
-
-                // Creates container for station information
-                StationInfo info;
-                info.id = station["id"].asInt();
-                info.name = wxString::FromUTF8(station["stationName"].asString().c_str());
-                try {
-                    // Use stringstream with classic locale to ensure correct decimal point handling
-                    std::string latStr = station["gegrLat"].asString();
-                    std::string lonStr = station["gegrLon"].asString();
-
-                    std::istringstream latStream(latStr);
-                    std::istringstream lonStream(lonStr);
-
-                    // Set classic "C" locale to ensure period as decimal separator
-                    latStream.imbue(std::locale::classic());
-                    lonStream.imbue(std::locale::classic());
-
-                    latStream >> info.latitude;
-                    lonStream >> info.longitude;
-
-                    if (latStream.fail() || lonStream.fail()) {
-                        wxLogWarning("Failed to parse coordinates for station %s", info.name);
-                        info.latitude = 0.0;
-                        info.longitude = 0.0;
-                    }
-                }
-                catch (const std::exception& e) {
-                    wxLogWarning("Exception parsing coordinates for station %s: %s",
-                    info.name, e.what());
-                    info.latitude = 0.0;
-                    info.longitude = 0.0;
-                }
-
-                // Calculate distance from reference point
-                info.distance = CalculateDistance(refLatitude, refLongitude, info.latitude, info.longitude);
-
-                this->stations.push_back(info);
-            }
-        }
+    // Get the stations ordered by distance, computed once per locator and reference point
+    const std::vector<StationDistance>& nearest = locator.OrderByDistance(refLatitude, refLongitude);
+    stations.reserve(nearest.size());
+    rowOfStation.resize(locator.Size());
+    for (const auto& entry : nearest) {
+        const StationLocation& station = locator.Stations()[entry.index];
+
+        // Creates container for station information
+        StationInfo info;
+        info.id = station.id;
+        info.name = wxString::FromUTF8(station.name.c_str());
+        info.city = wxString::FromUTF8(station.city.c_str());
+        info.latitude = station.latitude;
+        info.longitude = station.longitude;
+        info.distance = entry.distance;
+        rowOfStation[entry.index] = stations.size();
+        stations.push_back(info);
+    }
+    ApplySearch();
 
-        // Sort stations by distance
-        std::sort(this->stations.begin(), this->stations.end(),
-            [](const StationInfo& a, const StationInfo& b) {
-                return a.distance < b.distance;
-            });
-
-        // Add sorted stations to the listbox
-        for (const auto& station : this->stations) {
-            // Format: Station Name (Distance: X.XX km)
-            wxString displayStr = wxString::Format("%s (Distance: %.2f km)",
-                station.name, station.distance
-            );
-            stationListBox->Append(displayStr);
+    // Bind events
+    searchBox->Bind(wxEVT_TEXT, [this](wxCommandEvent&) { ApplySearch(); }); // Filters the list on every keystroke
+    searchBox->Bind(wxEVT_TEXT_ENTER, &StationSelectionDialog::OnSearchEnter, this);
+    stationList->Bind(wxEVT_LIST_ITEM_ACTIVATED, &StationSelectionDialog::OnDoubleClick, this); // Connects double-click event to handler
+    searchBox->SetFocus();
+}
+
+/**
+ * @brief Shows only the stations matching the text of the search box
+ *
+ * This function:
+ * 1. Looks up the matching stations in the search index
+ * 2. Maps them to their rows and sorts those, so matches stay ordered by distance
+ * 3. Sets the new row count of the virtual list and selects the nearest match, so
+ *    Enter picks it
+ *
+ * Nothing is inserted into the list, so the cost depends on the number of matches,
+ * not on the length of the station list.
+ */
+void StationSelectionDialog::ApplySearch() {
+    std::vector<size_t> matches;
+    searchIndex.Find(std::string(searchBox->GetValue().utf8_str()), matches);
+
+    visibleRows.clear();
+    visibleRows.reserve(matches.size());
+    for (size_t match : matches) {
+        if (match < rowOfStation.size()) {
+            visibleRows.push_back(rowOfStation[match]);
         }
     }
+    std::sort(visibleRows.begin(), visibleRows.end());
 
-    // Bind events
-    stationListBox->Bind(wxEVT_LISTBOX_DCLICK, &StationSelectionDialog::OnDoubleClick, this); // Connects double-click event to handler
+    stationList->SetItemState(-1, 0, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+    stationList->SetItemCount(static_cast<long>(visibleRows.size()));
+    if (!visibleRows.empty()) {
+        stationList->SetItemState(0, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+        stationList->EnsureVisible(0);
+    }
+    stationList->Refresh();
+}
+
+/**
+ * @brief Reads the reference coordinates used for the distance of every station
+ *
+ * The coordinates come from config.ini, see LoadReferenceLocation().
+ */
+void StationSelectionDialog::ReadReferenceCoordinates() {
+    LoadReferenceLocation(refLatitude, refLongitude);
 }
 
 /**
  * @brief Reads user location coordinates from config file or sets defaults if not found
+ * @param[out] latitude Latitude of the location in degrees
+ * @param[out] longitude Longitude of the location in degrees
  *
  * Attempts to read latitude and longitude values from the config.ini file located
  * in the application directory. If the file or values are not found, default
  * coordinates for the central point of Poland (52.11433, 19.42367) are used.
  */
-void StationSelectionDialog::ReadReferenceCoordinates() {
-    refLatitude = 52.11433;  // Default latitude (central point of Poland)
-    refLongitude = 19.42367; // Default longitude (central point of Poland)
+void StationSelectionDialog::LoadReferenceLocation(double& latitude, double& longitude) {
+    latitude = 52.11433;  // Default latitude (central point of Poland)
+    longitude = 19.42367; // Default longitude (central point of Poland)
 
     // Create a file config object pointing to config.ini in the application directory
     wxString configPath = wxFileName::GetCwd() + wxFileName::GetPathSeparator() + "config.ini";
     wxFileConfig config(wxEmptyString, wxEmptyString, configPath, wxEmptyString, wxCONFIG_USE_LOCAL_FILE);
 
     // Read coordinates
-    config.Read("/Location/Latitude", &refLatitude);
-    config.Read("/Location/Longitude", &refLongitude);
+    config.Read("/Location/Latitude", &latitude);
+    config.Read("/Location/Longitude", &longitude);
 }
 
 /**
  * @brief Calculates distance between two geographical coordinates using the Haversine formula
  *
- * The Haversine formula calculates the great-circle distance between two points
- * on the Earth's surface given their longitude and latitude.
+ * Kept for the callers of the dialog; the formula lives in GreatCircleDistance().
  *
  * @param lat1 Latitude of first location in degrees
  * @param lon1 Longitude of first location in degrees
@@ -140,23 +184,7 @@ void StationSelectionDialog::ReadReferenceCoordinates() {
  * @return double Distance in kilometers
  */
 double StationSelectionDialog::CalculateDistance(double lat1, double lon1, double lat2, double lon2) {
-    // Convert degrees to radians
-    const double toRad = M_PI / 180.0; // Conversion constant
-    lat1 *= toRad;
-    lon1 *= toRad;
-    lat2 *= toRad;
-    lon2 *= toRad;
-
-    // Haversine formula to calculate distance between two points on Earth
-    const double R = 6371.0; // Earth radius in kilometers
-    double dLat = lat2 - lat1;
-    double dLon = lon2 - lon1;
-
-    double a = sin(dLat / 2) * sin(dLat / 2) + cos(lat1) * cos(lat2) * sin(dLon / 2) * sin(dLon / 2);
-    double c = 2 * atan2(sqrt(a), sqrt(1 - a));
-    double distance = R * c;
-
-    return distance;
+    return GreatCircleDistance(lat1, lon1, lat2, lon2);
 }
 
 /**
@@ -165,12 +193,26 @@ double StationSelectionDialog::CalculateDistance(double lat1, double lon1, doubl
  * When a station is double-clicked, the dialog is closed with an OK status.
  * The selected station can then be retrieved using GetSelectedStation().
  *
- * @param event The wxCommandEvent associated with the double-click
+ * @param event The wxListEvent associated with the double-click
  */
-void StationSelectionDialog::OnDoubleClick(wxCommandEvent& event) {
+void StationSelectionDialog::OnDoubleClick(wxListEvent& event) {
     EndModal(wxID_OK);
 }
 
+/**
+ * @brief Handler for Enter in the search box that confirms the selected station
+ *
+ * The nearest match is selected after every keystroke, so typing part of a name and
+ * pressing Enter picks it.
+ *
+ * @param event The wxCommandEvent of the text control
+ */
+void StationSelectionDialog::OnSearchEnter(wxCommandEvent& event) {
+    if (stationList->GetNextItem(-1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED) != -1) {
+        EndModal(wxID_OK);
+    }
+}
+
 /**
  * @brief Retrieves selected station information if a valid selection exists
  *
@@ -183,10 +225,11 @@ void StationSelectionDialog::OnDoubleClick(wxCommandEvent& event) {
  *              false if no selection was made or the selection is invalid
  */
 bool StationSelectionDialog::GetSelectedStation(int& id, wxString& name) {
-    int selection = stationListBox->GetSelection();
-    if (selection != wxNOT_FOUND && selection < stations.size()) {
-        id = stations[selection].id;
-        name = stations[selection].name;
+    long selection = stationList->GetNextItem(-1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
+    if (selection >= 0 && static_cast<size_t>(selection) < visibleRows.size()) {
+        const StationInfo& station = stations[visibleRows[selection]];
+        id = station.id;
+        name = station.name;
         return true;
     }
     return false;
@@ -4,13 +4,17 @@
 #include <wx/wx.h>
 #include <wx/fileconf.h>
 #include <wx/filename.h>
-#include <json/json.h>
+#include <wx/listctrl.h>
 #include <algorithm>
 #include <cmath>
+#include <vector>
+
+#include "StationLocator.h"
+#include "StationSearch.h"
 
 /**
  * @file StationSelectionDialog.h
- * @brief Dialog for selecting a station sorted by distance from reference location
+ * @brief Dialog for selecting a station sorted by distance from reference location, with type-ahead search
  */
 
  /**
@@ -20,31 +24,87 @@
 struct StationInfo {
     int id;             /**< Unique identifier for the station */
     wxString name;      /**< Name of the station */
+    wxString city;      /**< Name of the station's city */
     double latitude;    /**< Geographical latitude of the station */
     double longitude;   /**< Geographical longitude of the station */
     double distance;    /**< Calculated distance from reference location in kilometers */
 };
 
+/**
+ * @class StationListCtrl
+ * @brief Virtual list showing the stations of StationSelectionDialog that match the search
+ *
+ * The control only knows the number of rows and asks for the text of the rows it
+ * displays, so filtering thousands of stations does not insert a single item.
+ */
+class StationListCtrl : public wxListCtrl {
+public:
+    /**
+     * @brief Creates the list with its name, city and distance columns
+     * @param parent Parent window
+     * @param stations All stations of the dialog, nearest first
+     * @param visibleRows Positions in stations of the rows shown, in display order
+     */
+    StationListCtrl(wxWindow* parent, const std::vector<StationInfo>& stations, const std::vector<size_t>& visibleRows);
+
+private:
+    const std::vector<StationInfo>& stations; /**< All stations of the dialog, owned by the dialog */
+    const std::vector<size_t>& visibleRows; /**< Rows shown, owned by the dialog */
+
+    /**
+     * @brief Gets the text of one cell when the control draws it
+     * @param item Row in the displayed list
+     * @param column Column index (0: name, 1: city, 2: distance)
+     * @return Text of the cell
+     */
+    wxString OnGetItemText(long item, long column) const override;
+};
+
 /**
  * @class StationSelectionDialog
  * @brief A dialog that displays a list of stations sorted by distance from a reference location
  *
- * This dialog presents a list of stations parsed from JSON data, calculates their
- * distance from a reference location (loaded from config or using defaults),
- * sorts them by distance, and allows the user to select one.
+ * This dialog presents the stations of a StationLocator ordered by their distance from
+ * a reference location (loaded from config or using defaults), and allows the user to
+ * select one. The order is computed by the locator once per build and reference location,
+ * so opening the dialog again neither parses coordinates nor sorts the station list.
+ *
+ * Typing into the search box filters the list by station name and city as the user
+ * types, through a StationSearchIndex built together with the locator. The list is
+ * virtual, so a keystroke only changes the row count and redraws the visible rows.
  */
 class StationSelectionDialog : public wxDialog {
 private:
     /**
-     * @brief ListBox widget that displays the station names and distances
+     * @brief Search box filtering the list
+     */
+    wxTextCtrl* searchBox;
+
+    /**
+     * @brief Virtual list that displays the matching stations with their distances
+     */
+    StationListCtrl* stationList;
+
+    /**
+     * @brief Index of the station names and cities, positions as in the locator
      */
-    wxListBox* stationListBox;
+    const StationSearchIndex& searchIndex;
 
     /**
-     * @brief Vector storing the information about stations
+     * @brief Vector storing the information about stations, nearest first
      */
     std::vector<StationInfo> stations;
 
+    /**
+     * @brief Position in stations of each station of the locator
+     */
+    std::vector<size_t> rowOfStation;
+
+    /**
+     * @brief Positions in stations of the rows matching the search, in display order
+     */
+    std::vector<size_t> visibleRows;
+
     /**
      * @brief Reference latitude used for distance calculation
      */
@@ -63,36 +123,40 @@ private:
     void ReadReferenceCoordinates();
 
     /**
-     * @brief Calculates distance between two geographical coordinates using the Haversine formula
-     *
-     * @param lat1 Latitude of first location in degrees
-     * @param lon1 Longitude of first location in degrees
-     * @param lat2 Latitude of second location in degrees
-     * @param lon2 Longitude of second location in degrees
-     * @return double Distance in kilometers
+     * @brief Shows only the stations matching the text of the search box
      */
-    double CalculateDistance(double lat1, double lon1, double lat2, double lon2);
+    void ApplySearch();
 
     /**
      * @brief Event handler for double-click events on the station list
      *
      * Closes the dialog with OK status when a station is double-clicked.
      *
-     * @param event The wxCommandEvent associated with the double-click
+     * @param event The wxListEvent associated with the double-click
+     */
+    void OnDoubleClick(wxListEvent& event);
+
+    /**
+     * @brief Event handler for Enter in the search box
+     *
+     * Closes the dialog with OK status if a station is selected.
+     *
+     * @param event The wxCommandEvent of the text control
      */
-    void OnDoubleClick(wxCommandEvent& event);
+    void OnSearchEnter(wxCommandEvent& event);
 
 public:
     /**
      * @brief Constructor that creates a station selection dialog
      *
-     * Creates a dialog with a list of stations parsed from JSON data and
-     * sorted by distance from a reference location.
+     * Creates a dialog with a list of the stations of a locator, nearest to the
+     * reference location first, and a search box filtering it.
      *
      * @param parent Pointer to the parent window
-     * @param stationsData JSON value containing the station data array
+     * @param locator Stations to choose from, indexed by position
+     * @param searchIndex Index built over the same stations as the locator; must outlive the dialog
      */
-    StationSelectionDialog(wxWindow* parent, const Json::Value& stationsData);
+    StationSelectionDialog(wxWindow* parent, const StationLocator& locator, const StationSearchIndex& searchIndex);
 
     /**
      * @brief Gets information about the selected station
@@ -104,6 +168,29 @@ public:
      * @return bool True if a station was selected, false otherwise
      */
     bool GetSelectedStation(int& id, wxString& name);
+
+    /**
+     * @brief Reads the user's location from config.ini
+     *
+     * If coordinates are not found in the config file, the central point of Poland is used.
+     *
+     * @param[out] latitude Latitude of the location in degrees
+     * @param[out] longitude Longitude of the location in degrees
+     */
+    static void LoadReferenceLocation(double& latitude, double& longitude);
+
+    /**
+     * @brief Calculates distance between two geographical coordinates using the Haversine formula
+     *
+     * Same as GreatCircleDistance().
+     *
+     * @param lat1 Latitude of first location in degrees
+     * @param lon1 Longitude of first location in degrees
+     * @param lat2 Latitude of second location in degrees
+     * @param lon2 Longitude of second location in degrees
+     * @return double Distance in kilometers
+     */
+    static double CalculateDistance(double lat1, double lon1, double lat2, double lon2);
 };
 
 #endif // STATION_SELECTION_DIALOG_H
\ No newline at end of file
@@ -0,0 +1,267 @@
+/**
+ * @file SvgChartCanvas.cpp
+ * @brief Implementation of the SvgChartCanvas class
+ */
+
+#include "SvgChartCanvas.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <locale>
+
+namespace {
+    const double GLYPH_WIDTH_RATIO = 0.6;   ///< Estimated average glyph width relative to the font size
+    const double LINE_HEIGHT_RATIO = 1.2;   ///< Line height relative to the font size
+    const double ASCENT_RATIO = 0.9;        ///< Distance from the top of a line to its baseline, relative to the font size
+
+    /**
+     * @brief Gets the pixel size of a chart text style (the point sizes of the window at 96 dpi)
+     */
+    int FontPixelSize(ChartFont font) {
+        switch (font) {
+        case CHART_FONT_TITLE:
+            return 16;
+        case CHART_FONT_AXIS_LABEL:
+            return 13;
+        default:
+            return 11;
+        }
+    }
+
+    /**
+     * @brief Formats a colour as an SVG hex triple
+     */
+    std::string ToHex(const ChartColour& colour) {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "#%02x%02x%02x", colour.red, colour.green, colour.blue);
+        return buffer;
+    }
+
+    /**
+     * @brief Escapes the XML special characters of a text
+     */
+    std::string EscapeXml(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '"': escaped += "&quot;"; break;
+            default: escaped += c; break;
+            }
+        }
+        return escaped;
+    }
+
+    /**
+     * @brief Counts the code points of a UTF-8 text (continuation bytes are skipped)
+     */
+    size_t CountCodePoints(const std::string& text) {
+        size_t count = 0;
+        for (unsigned char c : text) {
+            if ((c & 0xC0) != 0x80) {
+                count++;
+            }
+        }
+        return count;
+    }
+}
+
+/**
+ * @brief Starts an empty document with a white background
+ * @param width Width in pixels
+ * @param height Height in pixels
+ */
+SvgChartCanvas::SvgChartCanvas(int width, int height) : width(width), height(height), font(CHART_FONT_TICK), openClips(0), clipCount(0) {
+    stroke = "stroke=\"#000000\" stroke-width=\"1\"";
+    fill = "#ffffff";
+    textColour = "#000000";
+    // Numbers are always written with a decimal point, independent of the user's locale
+    body.imbue(std::locale::classic());
+    body << "<rect x=\"0\" y=\"0\" width=\"" << width << "\" height=\"" << height << "\" fill=\"#ffffff\"/>\n";
+}
+
+/**
+ * @brief Gets the finished document
+ * @return SVG text, with all open clipping groups closed
+ */
+std::string SvgChartCanvas::GetDocument() const {
+    std::string document = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    document += "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" + std::to_string(width) + "\" height=\"" + std::to_string(height) +
+        "\" viewBox=\"0 0 " + std::to_string(width) + " " + std::to_string(height) + "\" font-family=\"sans-serif\">\n";
+    document += body.str();
+    for (int i = 0; i < openClips; i++) {
+        document += "</g>\n";
+    }
+    return document + "</svg>\n";
+}
+
+/**
+ * @brief Writes the finished document to a file
+ * @param filePath Path of the output file
+ * @return true if the file was written successfully, false otherwise
+ */
+bool SvgChartCanvas::Save(const std::string& filePath) const {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << GetDocument();
+    return file.good();
+}
+
+/**
+ * @brief Sets the pen used for lines and outlines
+ *
+ * Dash lengths grow with the line width, like those of wxWidgets pens.
+ */
+void SvgChartCanvas::SetPen(const ChartColour& colour, int width, ChartLineStyle style) {
+    stroke = "stroke=\"" + ToHex(colour) + "\" stroke-width=\"" + std::to_string(width) + "\"";
+    if (style == CHART_LINE_DOT) {
+        stroke += " stroke-dasharray=\"" + std::to_string(width) + "," + std::to_string(2 * width) + "\"";
+    }
+    else if (style == CHART_LINE_SHORT_DASH) {
+        stroke += " stroke-dasharray=\"" + std::to_string(3 * width) + "," + std::to_string(3 * width) + "\"";
+    }
+}
+
+/**
+ * @brief Draws following shapes without an outline
+ */
+void SvgChartCanvas::SetNoPen() {
+    stroke = "stroke=\"none\"";
+}
+
+/**
+ * @brief Sets the brush used to fill shapes
+ */
+void SvgChartCanvas::SetBrush(const ChartColour& colour) {
+    fill = ToHex(colour);
+}
+
+/**
+ * @brief Sets the font of following text
+ */
+void SvgChartCanvas::SetFont(ChartFont font) {
+    this->font = font;
+}
+
+/**
+ * @brief Sets the colour of following text
+ */
+void SvgChartCanvas::SetTextColour(const ChartColour& colour) {
+    textColour = ToHex(colour);
+}
+
+/**
+ * @brief Draws a line with the pen
+ */
+void SvgChartCanvas::DrawLine(int x1, int y1, int x2, int y2) {
+    body << "<line x1=\"" << x1 << "\" y1=\"" << y1 << "\" x2=\"" << x2 << "\" y2=\"" << y2 << "\" " << stroke << "/>\n";
+}
+
+/**
+ * @brief Draws a polyline with the pen
+ */
+void SvgChartCanvas::DrawLines(const std::vector<ChartPoint>& points) {
+    body << "<polyline fill=\"none\" " << stroke << " stroke-linejoin=\"round\" points=\"";
+    for (const auto& point : points) {
+        body << point.x << ',' << point.y << ' ';
+    }
+    body << "\"/>\n";
+}
+
+/**
+ * @brief Draws a closed polygon, filled with the brush and outlined with the pen
+ */
+void SvgChartCanvas::DrawPolygon(const std::vector<ChartPoint>& points) {
+    body << "<polygon fill=\"" << fill << "\" " << stroke << " points=\"";
+    for (const auto& point : points) {
+        body << point.x << ',' << point.y << ' ';
+    }
+    body << "\"/>\n";
+}
+
+/**
+ * @brief Draws a rectangle, filled with the brush and outlined with the pen
+ */
+void SvgChartCanvas::DrawRectangle(int x, int y, int width, int height) {
+    body << "<rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << width << "\" height=\"" << height << "\" fill=\"" << fill << "\" " << stroke << "/>\n";
+}
+
+/**
+ * @brief Draws a circle, filled with the brush and outlined with the pen
+ */
+void SvgChartCanvas::DrawCircle(int x, int y, int radius) {
+    body << "<circle cx=\"" << x << "\" cy=\"" << y << "\" r=\"" << radius << "\" fill=\"" << fill << "\" " << stroke << "/>\n";
+}
+
+/**
+ * @brief Draws UTF-8 text with its top left corner at a position
+ */
+void SvgChartCanvas::DrawText(const std::string& text, int x, int y) {
+    WriteText(text, x, y, 0.0);
+}
+
+/**
+ * @brief Draws UTF-8 text rotated counter-clockwise around its top left corner
+ */
+void SvgChartCanvas::DrawRotatedText(const std::string& text, int x, int y, double angle) {
+    WriteText(text, x, y, angle);
+}
+
+/**
+ * @brief Estimates the size of UTF-8 text in the current font
+ */
+void SvgChartCanvas::GetTextExtent(const std::string& text, int& width, int& height) {
+    int size = FontPixelSize(font);
+    width = static_cast<int>(std::lround(GLYPH_WIDTH_RATIO * size * CountCodePoints(text)));
+    height = static_cast<int>(std::lround(LINE_HEIGHT_RATIO * size));
+}
+
+/**
+ * @brief Limits drawing to a rectangle inside the current clipping area
+ *
+ * Opens a group clipped to the rectangle; nested groups intersect their clip paths.
+ */
+void SvgChartCanvas::PushClip(int x, int y, int width, int height) {
+    std::string id = "clip" + std::to_string(clipCount++);
+    body << "<clipPath id=\"" << id << "\"><rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << width << "\" height=\"" << height << "\"/></clipPath>\n";
+    body << "<g clip-path=\"url(#" << id << ")\">\n";
+    openClips++;
+}
+
+/**
+ * @brief Restores the clipping area before the last PushClip
+ */
+void SvgChartCanvas::PopClip() {
+    if (openClips == 0) {
+        return;
+    }
+    body << "</g>\n";
+    openClips--;
+}
+
+/**
+ * @brief Writes a text element, optionally rotated around its top left corner
+ *
+ * SVG places text at its baseline, so the position is moved down by the ascent first.
+ */
+void SvgChartCanvas::WriteText(const std::string& text, int x, int y, double angle) {
+    int size = FontPixelSize(font);
+    int baseline = y + static_cast<int>(std::lround(ASCENT_RATIO * size));
+    body << "<text x=\"" << x << "\" y=\"" << baseline << "\" font-size=\"" << size << "\" fill=\"" << textColour << "\"";
+    if (font == CHART_FONT_TITLE || font == CHART_FONT_LEGEND) {
+        body << " font-weight=\"bold\"";
+    }
+    if (font == CHART_FONT_NOTE) {
+        body << " font-style=\"italic\"";
+    }
+    if (angle != 0.0) {
+        body << " transform=\"rotate(" << -angle << ' ' << x << ' ' << y << ")\"";
+    }
+    body << '>' << EscapeXml(text) << "</text>\n";
+}
@@ -0,0 +1,79 @@
+#ifndef SVG_CHART_CANVAS_H
+#define SVG_CHART_CANVAS_H
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ChartCanvas.h"
+
+/**
+ * @file SvgChartCanvas.h
+ * @brief Chart canvas writing an SVG document, usable without a display
+ */
+
+ /**
+  * @class SvgChartCanvas
+  * @brief ChartCanvas collecting the drawing operations as SVG elements
+  *
+  * Needs neither a window nor a GUI toolkit, so charts can be rendered on worker
+  * threads and on machines without a display. Text is measured with an estimate of
+  * the average glyph width, which is good enough to centre titles and align tick
+  * labels; the viewer renders the actual glyphs.
+  */
+class SvgChartCanvas : public ChartCanvas {
+public:
+    /**
+     * @brief Starts an empty document with a white background
+     * @param width Width in pixels
+     * @param height Height in pixels
+     */
+    SvgChartCanvas(int width, int height);
+
+    /**
+     * @brief Gets the finished document
+     * @return SVG text, with all open clipping groups closed
+     */
+    std::string GetDocument() const;
+
+    /**
+     * @brief Writes the finished document to a file
+     * @param filePath Path of the output file
+     * @return true if the file was written successfully, false otherwise
+     */
+    bool Save(const std::string& filePath) const;
+
+    void SetPen(const ChartColour& colour, int width, ChartLineStyle style = CHART_LINE_SOLID) override;
+    void SetNoPen() override;
+    void SetBrush(const ChartColour& colour) override;
+    void SetFont(ChartFont font) override;
+    void SetTextColour(const ChartColour& colour) override;
+    void DrawLine(int x1, int y1, int x2, int y2) override;
+    void DrawLines(const std::vector<ChartPoint>& points) override;
+    void DrawPolygon(const std::vector<ChartPoint>& points) override;
+    void DrawRectangle(int x, int y, int width, int height) override;
+    void DrawCircle(int x, int y, int radius) override;
+    void DrawText(const std::string& text, int x, int y) override;
+    void DrawRotatedText(const std::string& text, int x, int y, double angle) override;
+    void GetTextExtent(const std::string& text, int& width, int& height) override;
+    void PushClip(int x, int y, int width, int height) override;
+    void PopClip() override;
+
+private:
+    int width; /**< Width of the document in pixels */
+    int height; /**< Height of the document in pixels */
+    std::ostringstream body; /**< Elements drawn so far */
+    std::string stroke; /**< Stroke attributes of the current pen, or stroke="none" */
+    std::string fill; /**< Fill colour of the current brush */
+    std::string textColour; /**< Fill colour of following text */
+    ChartFont font; /**< Current text style */
+    int openClips; /**< Number of clipping groups not yet closed */
+    int clipCount; /**< Number of clip paths defined, used for their IDs */
+
+    /**
+     * @brief Writes a text element, optionally rotated around its top left corner
+     */
+    void WriteText(const std::string& text, int x, int y, double angle);
+};
+
+#endif // SVG_CHART_CANVAS_H
@@ -0,0 +1,130 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implementation of the ThreadPool class
+ */
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+    const size_t CHUNKS_PER_WORKER = 4; ///< Number of ParallelFor chunks per worker for load balancing
+}
+
+/**
+ * @brief Constructor that starts the worker threads
+ * @param threadCount Number of workers (0 selects the number of hardware threads)
+ */
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+/**
+ * @brief Destructor that lets the workers drain the queue and joins them
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+/**
+ * @brief Queues a task for execution on a worker thread
+ * @param task Function to run
+ * @return Future that becomes ready when the task finishes
+ */
+std::future<void> ThreadPool::Submit(std::function<void()> task) {
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> result = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        tasks.push_back(std::move(packaged));
+    }
+    queueCondition.notify_one();
+    return result;
+}
+
+/**
+ * @brief Runs body(i) for every i in [0, count) on the pool and waits for completion
+ * @param count Number of items
+ * @param body Function processing a single item
+ *
+ * The first exception thrown by any chunk is rethrown after all chunks have finished.
+ */
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    size_t chunkCount = std::min(count, workers.size() * CHUNKS_PER_WORKER);
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunkCount);
+    for (size_t begin = 0; begin < count; begin += chunkSize) {
+        size_t end = std::min(begin + chunkSize, count);
+        pending.push_back(Submit([&body, begin, end]() {
+            for (size_t i = begin; i < end; i++) {
+                body(i);
+            }
+            }));
+    }
+
+    // Wait for every chunk before propagating a failure, since chunks reference body
+    std::exception_ptr firstError;
+    for (auto& future : pending) {
+        try {
+            future.get();
+        }
+        catch (...) {
+            if (!firstError) {
+                firstError = std::current_exception();
+            }
+        }
+    }
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+/**
+ * @brief Gets the number of worker threads
+ * @return Number of workers
+ */
+size_t ThreadPool::Size() const {
+    return workers.size();
+}
+
+/**
+ * @brief Takes tasks from the queue and runs them until the pool is stopped
+ */
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() {
+                return stopping || !tasks.empty();
+                });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
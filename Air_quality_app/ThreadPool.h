@@ -0,0 +1,77 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file ThreadPool.h
+ * @brief Fixed-size pool of worker threads for CPU-bound analysis jobs
+ */
+
+ /**
+  * @class ThreadPool
+  * @brief Runs submitted tasks on a fixed set of worker threads
+  *
+  * Creating a thread per item (as done for downloads) does not scale to thousands of
+  * sensors; the pool keeps one worker per core and feeds them from a shared queue.
+  */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructor that starts the worker threads
+     * @param threadCount Number of workers (0 selects the number of hardware threads)
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Destructor that finishes queued tasks and joins the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task for execution
+     * @param task Function to run on a worker thread
+     * @return Future that becomes ready when the task finishes (and rethrows its exception)
+     */
+    std::future<void> Submit(std::function<void()> task);
+
+    /**
+     * @brief Runs body(i) for every i in [0, count) and waits for completion
+     *
+     * Items are split into contiguous chunks, a few per worker, to balance uneven work.
+     * Must not be called from a task running on the same pool.
+     *
+     * @param count Number of items
+     * @param body Function processing a single item
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    /**
+     * @brief Gets the number of worker threads
+     * @return Number of workers
+     */
+    size_t Size() const;
+
+private:
+    std::vector<std::thread> workers;               /**< Worker threads */
+    std::deque<std::packaged_task<void()>> tasks;   /**< Queue of pending tasks */
+    std::mutex queueMutex;                          /**< Protects the task queue */
+    std::condition_variable queueCondition;         /**< Signals new tasks or shutdown */
+    bool stopping;                                  /**< Set when the pool is being destroyed */
+
+    /**
+     * @brief Main loop of a worker thread
+     */
+    void WorkerLoop();
+};
+
+#endif // THREAD_POOL_H
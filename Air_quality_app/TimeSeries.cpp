@@ -0,0 +1,302 @@
+/**
+ * @file TimeSeries.cpp
+ * @brief Implementation of the time axis helpers
+ */
+
+#include "TimeSeries.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    const long long MAX_GRID_HOURS = 20LL * 366 * 24; ///< Upper bound on the grid length protecting against corrupt timestamps
+    const long long FIRST_MONDAY_HOUR = 4 * 24;       ///< Hour of 1970-01-05 00:00, the first Monday after the epoch
+
+    /**
+     * @brief Units a time axis can be divided into
+     */
+    enum TickUnit { TICK_HOURS, TICK_DAYS, TICK_WEEKS, TICK_MONTHS };
+
+    /**
+     * @brief One rung of the tick spacing ladder
+     */
+    struct TickSpacing {
+        TickUnit unit;          ///< Unit the ticks are aligned to
+        int count;              ///< Number of units between ticks
+        long long approxHours;  ///< Approximate spacing in hours, used to pick the rung
+    };
+
+    /**
+     * @brief Tick spacings from finest to coarsest
+     */
+    const TickSpacing TICK_LADDER[] = {
+        { TICK_HOURS, 1, 1 }, { TICK_HOURS, 2, 2 }, { TICK_HOURS, 3, 3 }, { TICK_HOURS, 6, 6 }, { TICK_HOURS, 12, 12 },
+        { TICK_DAYS, 1, 24 }, { TICK_DAYS, 2, 48 }, { TICK_WEEKS, 1, 168 }, { TICK_WEEKS, 2, 336 },
+        { TICK_MONTHS, 1, 730 }, { TICK_MONTHS, 2, 1461 }, { TICK_MONTHS, 3, 2191 }, { TICK_MONTHS, 6, 4383 },
+        { TICK_MONTHS, 12, 8766 }, { TICK_MONTHS, 24, 17532 }, { TICK_MONTHS, 60, 43830 }
+    };
+
+    /**
+     * @brief Divides rounding towards negative infinity
+     */
+    long long FloorDivide(long long value, long long divisor) {
+        return (value >= 0) ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    /**
+     * @brief Parses a fixed-width run of decimal digits
+     * @return true if all characters were digits, false otherwise
+     */
+    bool ParseDigits(const std::string& text, size_t pos, size_t length, int& result) {
+        result = 0;
+        for (size_t i = pos; i < pos + length; i++) {
+            char c = text[i];
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            result = result * 10 + (c - '0');
+        }
+        return true;
+    }
+
+    /**
+     * @brief Converts a civil date to the number of days since 1970-01-01 (proleptic Gregorian)
+     */
+    long long DaysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const long long era = (year >= 0 ? year : year - 399) / 400;
+        const long long yearOfEra = year - era * 400;
+        const long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    /**
+     * @brief Converts the number of days since 1970-01-01 back to a civil date
+     */
+    void CivilFromDays(long long days, int& year, int& month, int& day) {
+        days += 719468;
+        const long long era = (days >= 0 ? days : days - 146096) / 146097;
+        const long long dayOfEra = days - era * 146097;
+        const long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const long long monthPart = (5 * dayOfYear + 2) / 153;
+        day = static_cast<int>(dayOfYear - (153 * monthPart + 2) / 5 + 1);
+        month = static_cast<int>(monthPart < 10 ? monthPart + 3 : monthPart - 9);
+        year = static_cast<int>(yearOfEra + era * 400 + (month <= 2));
+    }
+}
+
+/**
+ * @brief Parses a measurement timestamp into whole hours since 1970-01-01 00:00
+ * @param timestamp Timestamp string in the format "YYYY-MM-DD HH:MM:SS"
+ * @param hours [out] Number of hours since the epoch
+ * @return true if the timestamp was parsed successfully, false otherwise
+ *
+ * Reads the fixed-width date and hour fields directly, which avoids the overhead
+ * and locale dependence of stream-based parsing.
+ */
+bool ParseTimestampToHours(const std::string& timestamp, long long& hours) {
+    // Check if timestamp has sufficient length for date and hour
+    if (timestamp.length() < 13 || timestamp[4] != '-' || timestamp[7] != '-') {
+        return false;
+    }
+
+    int year, month, day, hour;
+    if (!ParseDigits(timestamp, 0, 4, year) || !ParseDigits(timestamp, 5, 2, month) ||
+        !ParseDigits(timestamp, 8, 2, day) || !ParseDigits(timestamp, 11, 2, hour)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23) {
+        return false;
+    }
+
+    hours = DaysFromCivil(year, month, day) * 24 + hour;
+    return true;
+}
+
+/**
+ * @brief Formats hours since 1970-01-01 00:00 as a measurement timestamp
+ * @param hours Number of hours since the epoch
+ * @return Timestamp in the API format "YYYY-MM-DD HH:00:00"
+ */
+std::string FormatHoursAsTimestamp(long long hours) {
+    long long days = (hours >= 0) ? hours / 24 : (hours - 23) / 24;
+    int hour = static_cast<int>(hours - days * 24);
+
+    int year, month, day;
+    CivilFromDays(days, year, month, day);
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d %02d:00:00", year, month, day, hour);
+    return std::string(buffer);
+}
+
+/**
+ * @brief Lists the months touched by a range of dates
+ * @param first First date or timestamp of the range ("YYYY-MM..."), inclusive
+ * @param last Last date or timestamp of the range ("YYYY-MM..."), inclusive
+ * @return Month keys ("YYYY-MM") in ascending order, empty if the range is empty or malformed
+ */
+std::vector<std::string> ListMonths(const std::string& first, const std::string& last) {
+    std::vector<std::string> months;
+    int year, month, lastYear, lastMonth;
+    if (first.length() < 7 || last.length() < 7 ||
+        std::sscanf(first.c_str(), "%4d-%2d", &year, &month) != 2 ||
+        std::sscanf(last.c_str(), "%4d-%2d", &lastYear, &lastMonth) != 2) {
+        return months;
+    }
+
+    char buffer[16];
+    while (year < lastYear || (year == lastYear && month <= lastMonth)) {
+        std::snprintf(buffer, sizeof(buffer), "%04d-%02d", year, month);
+        months.push_back(buffer);
+        if (++month > 12) {
+            month = 1;
+            year++;
+        }
+    }
+    return months;
+}
+
+/**
+ * @brief Counts slots holding a measurement
+ * @return Number of non-missing values
+ */
+size_t HourlySeries::ValidCount() const {
+    size_t count = 0;
+    for (double value : values) {
+        if (!IsMissingValue(value)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Computes minimum, maximum and average over the measured hours of a series
+ * @param series Measurements aligned to an hourly grid
+ * @return SeriesStatistics of the series; missing hours are ignored
+ *
+ * Shared by the interactive view and the batch analytics, so both report identical values.
+ */
+SeriesStatistics ComputeSeriesStatistics(const HourlySeries& series) {
+    SeriesStatistics stats;
+    double max = std::numeric_limits<double>::lowest();
+    double min = std::numeric_limits<double>::max();
+    double sum = 0.0;
+
+    for (double value : series.values) {
+        if (!IsMissingValue(value)) {
+            max = std::max(max, value);
+            min = std::min(min, value);
+            sum += value;
+            stats.count++;
+        }
+    }
+
+    if (stats.count > 0) {
+        stats.min = min;
+        stats.max = max;
+        stats.mean = sum / static_cast<double>(stats.count);
+    }
+    return stats;
+}
+
+/**
+ * @brief Aligns measurements to a regular hourly grid with explicit missing-value markers
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return HourlySeries covering the first to the last valid timestamp (empty if none)
+ *
+ * The API reports hours without a measurement as null values, which are dropped when
+ * the data is stored. Placing each measurement at its hour restores those gaps, so
+ * downstream statistics and the chart no longer treat the sample index as time.
+ */
+HourlySeries ResampleToHourlyGrid(const std::vector<std::pair<std::string, double>>& data) {
+    HourlySeries series;
+
+    // First pass: find the covered range of hours
+    long long firstHour = 0;
+    long long lastHour = 0;
+    bool found = false;
+    for (const auto& point : data) {
+        long long hour;
+        if (ParseTimestampToHours(point.first, hour)) {
+            firstHour = found ? std::min(firstHour, hour) : hour;
+            lastHour = found ? std::max(lastHour, hour) : hour;
+            found = true;
+        }
+    }
+    if (!found || lastHour - firstHour >= MAX_GRID_HOURS) {
+        return series;
+    }
+
+    // Allocate the grid once, then place every measurement in its slot
+    series.startHour = firstHour;
+    series.values.assign(static_cast<size_t>(lastHour - firstHour + 1), MISSING_VALUE);
+    for (const auto& point : data) {
+        long long hour;
+        if (ParseTimestampToHours(point.first, hour)) {
+            series.values[static_cast<size_t>(hour - firstHour)] = point.second;
+        }
+    }
+    return series;
+}
+
+/**
+ * @brief Chooses calendar-aligned ticks for a range of hours
+ * @param firstHour First hour of the range
+ * @param lastHour Last hour of the range
+ * @param maxTicks Largest number of ticks wanted
+ * @return Ticks inside the range in increasing order
+ *
+ * This function:
+ * 1. Walks the spacing ladder until the range divided by the spacing fits maxTicks
+ *    (the coarsest rung is used for ranges longer than the ladder covers)
+ * 2. Hour, day and week ticks are multiples of their spacing, counted from the epoch
+ *    and from the first Monday respectively, so they stay put while the range moves
+ * 3. Month and year ticks step through the first days of months whose index is a
+ *    multiple of the spacing, which keeps quarters and years on their usual boundaries
+ */
+std::vector<TimeTick> ChooseTimeTicks(long long firstHour, long long lastHour, size_t maxTicks) {
+    std::vector<TimeTick> ticks;
+    if (lastHour < firstHour || maxTicks == 0) {
+        return ticks;
+    }
+
+    const size_t rungCount = sizeof(TICK_LADDER) / sizeof(TICK_LADDER[0]);
+    size_t rung = 0;
+    while (rung + 1 < rungCount && static_cast<size_t>((lastHour - firstHour) / TICK_LADDER[rung].approxHours) + 1 > maxTicks) {
+        rung++;
+    }
+    const TickSpacing& spacing = TICK_LADDER[rung];
+
+    if (spacing.unit != TICK_MONTHS) {
+        long long step = spacing.approxHours;
+        long long origin = (spacing.unit == TICK_WEEKS) ? FIRST_MONDAY_HOUR : 0;
+        for (long long hour = origin + FloorDivide(firstHour - origin + step - 1, step) * step; hour <= lastHour; hour += step) {
+            std::string timestamp = FormatHoursAsTimestamp(hour);
+            ticks.push_back(TimeTick{ hour, spacing.unit == TICK_HOURS ? timestamp.substr(5, 11) : timestamp.substr(5, 5) });
+        }
+        return ticks;
+    }
+
+    int year, month, day;
+    CivilFromDays(FloorDivide(firstHour, 24), year, month, day);
+    long long monthIndex = static_cast<long long>(year) * 12 + (month - 1);
+    monthIndex = FloorDivide(monthIndex + spacing.count - 1, spacing.count) * spacing.count;
+    while (true) {
+        int tickYear = static_cast<int>(FloorDivide(monthIndex, 12));
+        int tickMonth = static_cast<int>(monthIndex - static_cast<long long>(tickYear) * 12) + 1;
+        long long hour = DaysFromCivil(tickYear, tickMonth, 1) * 24;
+        if (hour > lastHour) {
+            break;
+        }
+        if (hour >= firstHour) {
+            std::string timestamp = FormatHoursAsTimestamp(hour);
+            ticks.push_back(TimeTick{ hour, spacing.count >= 12 ? timestamp.substr(0, 4) : timestamp.substr(0, 7) });
+        }
+        monthIndex += spacing.count;
+    }
+    return ticks;
+}
@@ -0,0 +1,135 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file TimeSeries.h
+ * @brief Hourly time series with explicit gaps and helpers for the numeric time axis
+ */
+
+ /**
+  * @brief Parses a measurement timestamp into whole hours since 1970-01-01 00:00
+  *
+  * Accepts the API format "YYYY-MM-DD HH:MM:SS" (the minutes and seconds are ignored,
+  * since measurements are hourly). Parsing is locale-independent and does not allocate.
+  *
+  * @param timestamp Timestamp string
+  * @param hours [out] Number of hours since the epoch
+  * @return true if the timestamp was parsed successfully, false otherwise
+  */
+bool ParseTimestampToHours(const std::string& timestamp, long long& hours);
+
+/**
+ * @brief Formats hours since 1970-01-01 00:00 as a measurement timestamp
+ * @param hours Number of hours since the epoch
+ * @return Timestamp in the API format "YYYY-MM-DD HH:00:00"
+ */
+std::string FormatHoursAsTimestamp(long long hours);
+
+/**
+ * @brief Lists the months touched by a range of dates
+ * @param first First date or timestamp of the range ("YYYY-MM..."), inclusive
+ * @param last Last date or timestamp of the range ("YYYY-MM..."), inclusive
+ * @return Month keys ("YYYY-MM") in ascending order, empty if the range is empty or malformed
+ */
+std::vector<std::string> ListMonths(const std::string& first, const std::string& last);
+
+/**
+ * @struct HourlySeries
+ * @brief Measurements aligned to a regular hourly grid
+ *
+ * Slot i holds the value measured at hour startHour + i. Hours without a measurement
+ * hold a missing-value marker (NaN), so the position in the vector is proportional
+ * to time and outages stay visible to every consumer of the series.
+ */
+struct HourlySeries {
+    long long startHour = 0;   /**< Hour (since 1970-01-01 00:00) of the first slot */
+    std::vector<double> values; /**< One value per hour, MISSING_VALUE where no measurement exists */
+
+    /**
+     * @brief Gets the hour of the given slot
+     * @param index Slot index
+     * @return Hours since 1970-01-01 00:00
+     */
+    long long HourAt(size_t index) const { return startHour + static_cast<long long>(index); }
+
+    /**
+     * @brief Counts slots holding a measurement
+     * @return Number of non-missing values
+     */
+    size_t ValidCount() const;
+};
+
+/**
+ * @brief Marker stored in HourlySeries slots without a measurement
+ */
+const double MISSING_VALUE = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * @brief Checks whether a series value is the missing-value marker
+ * @param value Value from a HourlySeries slot
+ * @return true if the value is missing, false otherwise
+ */
+inline bool IsMissingValue(double value) { return std::isnan(value); }
+
+/**
+ * @struct SeriesStatistics
+ * @brief Summary statistics over the measured hours of a series
+ */
+struct SeriesStatistics {
+    size_t count = 0;    /**< Number of measured hours */
+    double min = 0.0;    /**< Minimum value (0 if there are no measurements) */
+    double max = 0.0;    /**< Maximum value (0 if there are no measurements) */
+    double mean = 0.0;   /**< Average value (0 if there are no measurements) */
+};
+
+/**
+ * @brief Computes minimum, maximum and average over the measured hours of a series
+ * @param series Measurements aligned to an hourly grid
+ * @return SeriesStatistics of the series; missing hours are ignored
+ */
+SeriesStatistics ComputeSeriesStatistics(const HourlySeries& series);
+
+/**
+ * @brief Aligns measurements to a regular hourly grid
+ *
+ * Runs in linear time: one pass finds the covered range, the grid is allocated once,
+ * and a second pass writes every measurement directly into its slot. Input order does
+ * not matter; if an hour occurs more than once, the last value wins.
+ *
+ * @param data Vector of date-value pairs ("YYYY-MM-DD HH:MM:SS", value)
+ * @return HourlySeries covering the first to the last valid timestamp (empty if none)
+ */
+HourlySeries ResampleToHourlyGrid(const std::vector<std::pair<std::string, double>>& data);
+
+/**
+ * @struct TimeTick
+ * @brief Labelled position on a time axis
+ */
+struct TimeTick {
+    long long hour = 0;   /**< Hour (since 1970-01-01 00:00) of the tick */
+    std::string label;    /**< Label formatted for the tick spacing */
+};
+
+/**
+ * @brief Chooses calendar-aligned ticks for a range of hours
+ *
+ * Picks the finest spacing from a ladder of hours, days, weeks, months and years that
+ * yields at most maxTicks ticks, places the ticks on whole units (midnight, Mondays,
+ * the first of a month or year) and labels them for that scale: "MM-DD HH:00" for
+ * hours, "MM-DD" for days and weeks, "YYYY-MM" for months and "YYYY" for years.
+ * Runs in time proportional to the number of ticks, not to the length of the range.
+ *
+ * @param firstHour First hour of the range
+ * @param lastHour Last hour of the range
+ * @param maxTicks Largest number of ticks wanted (e.g. chart width / label spacing)
+ * @return Ticks inside the range in increasing order
+ */
+std::vector<TimeTick> ChooseTimeTicks(long long firstHour, long long lastHour, size_t maxTicks);
+
+#endif // TIME_SERIES_H
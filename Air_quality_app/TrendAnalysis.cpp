@@ -0,0 +1,306 @@
+/**
+ * @file TrendAnalysis.cpp
+ * @brief Implementation of the Theil-Sen / Mann-Kendall trend engine
+ */
+
+#include "TrendAnalysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace {
+    const double SIGNIFICANCE_LEVEL = 0.05; ///< p-value below which a trend is considered real
+    const int HOURS_PER_SEASON_CYCLE = 24;  ///< Length of the daily cycle used as seasons
+    const int MAX_BISECTION_STEPS = 200;    ///< Safety limit for the slope bisection
+    const double SEASONAL_TREND_MIN_HOURS = 14 * 24; ///< Series length from which the seasonal trend test is used
+
+    /**
+     * @struct SeasonGroup
+     * @brief Samples belonging to one season (or the whole series in the non-seasonal test)
+     */
+    struct SeasonGroup {
+        std::vector<double> x; ///< Sample times relative to the first sample, strictly increasing
+        std::vector<double> y; ///< Sample values
+    };
+
+    /**
+     * @brief Sorts data in place and counts pairs i < j with data[i] > data[j]
+     * @param data Values to sort
+     * @param scratch Buffer of the same size used by the merge passes
+     * @return Number of strict inversions
+     *
+     * Bottom-up merge sort; equal values are never counted as inversions.
+     */
+    long long CountInversions(std::vector<double>& data, std::vector<double>& scratch) {
+        const size_t n = data.size();
+        long long inversions = 0;
+        scratch.resize(n);
+
+        for (size_t width = 1; width < n; width *= 2) {
+            for (size_t lo = 0; lo < n; lo += 2 * width) {
+                size_t mid = std::min(lo + width, n);
+                size_t hi = std::min(lo + 2 * width, n);
+                size_t i = lo, j = mid, k = lo;
+
+                while (i < mid && j < hi) {
+                    if (data[j] < data[i]) {
+                        // Every remaining element of the left run is greater than data[j]
+                        inversions += static_cast<long long>(mid - i);
+                        scratch[k++] = data[j++];
+                    }
+                    else {
+                        scratch[k++] = data[i++];
+                    }
+                }
+                while (i < mid) scratch[k++] = data[i++];
+                while (j < hi) scratch[k++] = data[j++];
+            }
+            data.swap(scratch);
+        }
+        return inversions;
+    }
+
+    /**
+     * @brief Counts pairwise slopes strictly below the given value
+     *
+     * For samples ordered by time, the slope of pair (i, j) is below s exactly when
+     * y[j] - s * x[j] < y[i] - s * x[i], i.e. when the pair is an inversion of the
+     * sequence y - s * x. Counting inversions takes O(n log n).
+     */
+    long long CountSlopesBelow(const std::vector<SeasonGroup>& groups, double slope,
+        std::vector<double>& work, std::vector<double>& scratch) {
+        long long count = 0;
+        for (const auto& group : groups) {
+            work.resize(group.x.size());
+            for (size_t i = 0; i < group.x.size(); i++) {
+                work[i] = group.y[i] - slope * group.x[i];
+            }
+            count += CountInversions(work, scratch);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Finds the k-th smallest pairwise slope (0-based) by bisection on the slope value
+     *
+     * Each step costs one O(n log n) inversion count. The number of steps depends only on
+     * the floating-point precision of the bracket, not on the number of samples.
+     */
+    double FindKthSlope(const std::vector<SeasonGroup>& groups, long long k, double bound,
+        std::vector<double>& work, std::vector<double>& scratch) {
+        double lo = -bound;
+        double hi = bound;
+        double tolerance = bound * 1e-12;
+
+        for (int step = 0; step < MAX_BISECTION_STEPS && hi - lo > tolerance; step++) {
+            double mid = lo + (hi - lo) / 2.0;
+            if (mid <= lo || mid >= hi) {
+                break;
+            }
+            // Invariant: the k-th slope lies in [lo, hi)
+            if (CountSlopesBelow(groups, mid, work, scratch) > k) {
+                hi = mid;
+            }
+            else {
+                lo = mid;
+            }
+        }
+        return lo + (hi - lo) / 2.0;
+    }
+
+    /**
+     * @brief Adds the Mann-Kendall S statistic and its variance for one group
+     *
+     * S = concordant - discordant pairs. For time-ordered samples the discordant pairs
+     * are the inversions of y, and tied pairs are found in the sorted values.
+     */
+    void AccumulateMannKendall(const SeasonGroup& group, double& s, double& variance,
+        std::vector<double>& work, std::vector<double>& scratch) {
+        const double n = static_cast<double>(group.y.size());
+        if (n < 2) {
+            return;
+        }
+
+        work = group.y;
+        double discordant = static_cast<double>(CountInversions(work, scratch));
+
+        // work is now sorted - count tied pairs and the tie correction of the variance
+        double tiedPairs = 0.0;
+        double tieCorrection = 0.0;
+        for (size_t i = 0; i < work.size();) {
+            size_t j = i;
+            while (j < work.size() && work[j] == work[i]) {
+                j++;
+            }
+            double t = static_cast<double>(j - i);
+            tiedPairs += t * (t - 1.0) / 2.0;
+            tieCorrection += t * (t - 1.0) * (2.0 * t + 5.0);
+            i = j;
+        }
+
+        double totalPairs = n * (n - 1.0) / 2.0;
+        double concordant = totalPairs - discordant - tiedPairs;
+        s += concordant - discordant;
+        variance += (n * (n - 1.0) * (2.0 * n + 5.0) - tieCorrection) / 18.0;
+    }
+}
+
+/**
+ * @brief Computes the Theil-Sen slope and Mann-Kendall significance of a time series
+ * @param hours Time of each sample in hours, strictly increasing
+ * @param values Value of each sample
+ * @param seasonal Whether to use the seasonal (hour of day) variant
+ * @return TrendResult with slope, significance and relative change
+ *
+ * The Theil-Sen slope is the median of all pairwise slopes. Instead of computing the
+ * n(n-1)/2 slopes explicitly, the median is located by bisection on the slope value,
+ * counting slopes below a candidate with an O(n log n) inversion count. A single
+ * outlier (e.g. a smog spike) moves the median by at most one rank, unlike the least
+ * squares slope.
+ *
+ * The seasonal variant (Hirsch seasonal Kendall test) forms pairs only within the same
+ * hour of the day and sums the per-season statistics.
+ */
+TrendResult AnalyzeTrend(const std::vector<double>& hours, const std::vector<double>& values, bool seasonal) {
+    TrendResult result;
+    result.seasonal = seasonal;
+    const size_t n = values.size();
+    if (n < 3 || hours.size() != n) {
+        return result;
+    }
+
+    // Determine the smallest time step and the value range to bracket all slopes
+    double minStep = std::numeric_limits<double>::max();
+    for (size_t i = 1; i < n; i++) {
+        minStep = std::min(minStep, hours[i] - hours[i - 1]);
+    }
+    if (minStep <= 0.0) {
+        return result;
+    }
+    auto range = std::minmax_element(values.begin(), values.end());
+    double bound = (*range.second - *range.first) / minStep + 1.0;
+
+    // Split samples into seasons (hours of the day) or keep a single group
+    std::vector<SeasonGroup> groups(seasonal ? HOURS_PER_SEASON_CYCLE : 1);
+    for (size_t i = 0; i < n; i++) {
+        size_t season = 0;
+        if (seasonal) {
+            long long hour = static_cast<long long>(std::floor(hours[i]));
+            season = static_cast<size_t>(((hour % HOURS_PER_SEASON_CYCLE) + HOURS_PER_SEASON_CYCLE) % HOURS_PER_SEASON_CYCLE);
+        }
+        groups[season].x.push_back(hours[i] - hours[0]);
+        groups[season].y.push_back(values[i]);
+    }
+
+    long long totalPairs = 0;
+    for (const auto& group : groups) {
+        long long m = static_cast<long long>(group.x.size());
+        totalPairs += m * (m - 1) / 2;
+    }
+    if (totalPairs == 0) {
+        return result;
+    }
+
+    std::vector<double> work;
+    std::vector<double> scratch;
+    work.reserve(n);
+    scratch.reserve(n);
+
+    // Median of pairwise slopes (average of the two middle ones for an even count)
+    long long lowerRank = (totalPairs - 1) / 2;
+    long long upperRank = totalPairs / 2;
+    double lowerSlope = FindKthSlope(groups, lowerRank, bound, work, scratch);
+    double upperSlope = (upperRank == lowerRank) ? lowerSlope : FindKthSlope(groups, upperRank, bound, work, scratch);
+    result.slopePerHour = (lowerSlope + upperSlope) / 2.0;
+
+    // Mann-Kendall test statistic summed over seasons
+    double s = 0.0;
+    double variance = 0.0;
+    for (const auto& group : groups) {
+        AccumulateMannKendall(group, s, variance, work, scratch);
+    }
+    result.kendallS = s;
+    if (variance > 0.0 && s != 0.0) {
+        // Continuity correction moves S one step towards zero
+        result.kendallZ = (s > 0 ? s - 1.0 : s + 1.0) / std::sqrt(variance);
+    }
+    result.pValue = std::erfc(std::abs(result.kendallZ) / std::sqrt(2.0));
+
+    // Express the change over the covered period relative to the average value
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    double average = sum / static_cast<double>(n);
+    double totalChange = result.slopePerHour * (hours.back() - hours.front());
+    result.percentChange = (average != 0) ? (totalChange / average) * 100.0 : 0.0;
+
+    result.valid = true;
+    return result;
+}
+
+/**
+ * @brief Computes the trend of an hourly series
+ * @param series Measurements aligned to an hourly grid
+ * @return TrendResult with slope, significance and relative change
+ *
+ * Only measured hours take part in the analysis; missing hours keep their position
+ * on the time axis, so an outage does not compress the time between measurements.
+ * The seasonal test is used once every hour of the day has enough samples.
+ */
+TrendResult AnalyzeSeriesTrend(const HourlySeries& series) {
+    std::vector<double> hours;
+    std::vector<double> values;
+    hours.reserve(series.values.size());
+    values.reserve(series.values.size());
+    for (size_t i = 0; i < series.values.size(); i++) {
+        if (!IsMissingValue(series.values[i])) {
+            hours.push_back(static_cast<double>(series.HourAt(i)));
+            values.push_back(series.values[i]);
+        }
+    }
+
+    bool seasonal = !hours.empty() && (hours.back() - hours.front()) >= SEASONAL_TREND_MIN_HOURS;
+    return AnalyzeTrend(hours, values, seasonal);
+}
+
+/**
+ * @brief Describes a trend result as text
+ * @param result Result of AnalyzeTrend()
+ * @return std::string Description of the trend
+ *
+ * A trend is reported only if the Mann-Kendall test is significant at the 5% level;
+ * its strength is then classified with the same thresholds as before:
+ * - "stable": not significant, or the change is less than 5%
+ * - "increasing" / "decreasing": change between 5% and 20%
+ * - "strongly increasing" / "strongly decreasing": change greater than 20%
+ */
+std::string DescribeTrend(const TrendResult& result) {
+    if (!result.valid) {
+        return "insufficient data for trend analysis";
+    }
+
+    std::string direction;
+    if (result.pValue >= SIGNIFICANCE_LEVEL || std::abs(result.percentChange) < 5.0) {
+        direction = "stable";
+    }
+    else if (result.percentChange > 0) {
+        direction = (result.percentChange > 20.0) ? "strongly increasing" : "increasing";
+    }
+    else {
+        direction = (result.percentChange < -20.0) ? "strongly decreasing" : "decreasing";
+    }
+
+    char details[128];
+    if (result.pValue < 0.001) {
+        std::snprintf(details, sizeof(details), " (Theil-Sen %+.3g per day, %sMann-Kendall p < 0.001)",
+            result.slopePerHour * 24.0, result.seasonal ? "seasonal " : "");
+    }
+    else {
+        std::snprintf(details, sizeof(details), " (Theil-Sen %+.3g per day, %sMann-Kendall p = %.3f)",
+            result.slopePerHour * 24.0, result.seasonal ? "seasonal " : "", result.pValue);
+    }
+    return direction + details;
+}
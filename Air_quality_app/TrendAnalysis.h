@@ -0,0 +1,64 @@
+#ifndef TREND_ANALYSIS_H
+#define TREND_ANALYSIS_H
+
+#include <string>
+#include <vector>
+
+#include "TimeSeries.h"
+
+/**
+ * @file TrendAnalysis.h
+ * @brief Robust trend estimation (Theil-Sen slope with Mann-Kendall significance)
+ */
+
+ /**
+  * @struct TrendResult
+  * @brief Result of the robust trend analysis of a time series
+  */
+struct TrendResult {
+    bool valid = false;          /**< Whether enough data was available for the analysis */
+    bool seasonal = false;       /**< Whether the seasonal (hour of day) variant was used */
+    double slopePerHour = 0.0;   /**< Theil-Sen median slope in value units per hour */
+    double percentChange = 0.0;  /**< Change over the whole series relative to the average value */
+    double kendallS = 0.0;       /**< Mann-Kendall S statistic */
+    double kendallZ = 0.0;       /**< Normalized Mann-Kendall statistic */
+    double pValue = 1.0;         /**< Two-sided p-value of the Mann-Kendall test */
+};
+
+/**
+ * @brief Computes the Theil-Sen slope and Mann-Kendall significance of a time series
+ *
+ * Both statistics are computed in O(n log n) by counting inversions with merge sort
+ * instead of enumerating all n(n-1)/2 pairs. In the seasonal variant pairs are only
+ * formed within the same hour of the day, so the daily cycle does not mask the trend.
+ *
+ * @param hours Time of each sample in hours, strictly increasing
+ * @param values Value of each sample
+ * @param seasonal Whether to use the seasonal (hour of day) variant
+ * @return TrendResult with slope, significance and relative change
+ */
+TrendResult AnalyzeTrend(const std::vector<double>& hours, const std::vector<double>& values, bool seasonal);
+
+/**
+ * @brief Computes the trend of an hourly series
+ *
+ * Only measured hours take part; missing hours keep their place on the time axis.
+ * Series covering at least two weeks use the seasonal variant.
+ *
+ * @param series Measurements aligned to an hourly grid
+ * @return TrendResult with slope, significance and relative change
+ */
+TrendResult AnalyzeSeriesTrend(const HourlySeries& series);
+
+/**
+ * @brief Describes a trend result as text
+ *
+ * Returns "stable", "increasing", "strongly increasing", "decreasing" or
+ * "strongly decreasing" followed by the slope and the test's p-value.
+ *
+ * @param result Result of AnalyzeTrend()
+ * @return std::string Description of the trend
+ */
+std::string DescribeTrend(const TrendResult& result);
+
+#endif // TREND_ANALYSIS_H
@@ -15,6 +15,7 @@
 #include <wx/intl.h>
 #include <curl/curl.h>
 
+#include "ChartExportCommand.h"
 #include "ChartPanel.h"
 #include "InfoPanel.h"
 #include "SidePanel.h"
@@ -79,8 +80,9 @@ public:
      * @brief Initializes application resources
      * @return true if initialization succeeded, false otherwise
      *
-     * This method initializes the curl library for HTTP requests and
-     * sets up localization. It also creates and displays the main application window.
+     * This method initializes the curl library for HTTP requests, the image handlers
+     * for PNG chart export and sets up localization. It also creates and displays the
+     * main application window.
      */
     bool OnInit() override {
         // Initialize curl library for HTTP requests
@@ -90,6 +92,7 @@ public:
         }
 
         m_locale = new wxLocale(wxLANGUAGE_DEFAULT);
+        wxInitAllImageHandlers();
 
         // Create and display the main application window
         MyFrame* frame = new MyFrame();
@@ -112,5 +115,42 @@ public:
     }
 };
 
-// wxWidgets macro to declare the application entry point
-wxIMPLEMENT_APP(MyApp);
\ No newline at end of file
+// wxWidgets macro to declare the application class; the entry points below start it
+wxIMPLEMENT_APP_NO_MAIN(MyApp);
+
+#ifdef __WXMSW__
+/**
+ * @brief Windows entry point that runs a command-line job or starts the application
+ * @return Exit code of the job or of the application
+ *
+ * Command-line jobs run before wxWidgets is initialized, so no window is created.
+ * Their output goes to the console the program was started from, if any.
+ */
+int WINAPI WinMain(HINSTANCE instance, HINSTANCE previousInstance, LPSTR commandLine, int showCommand) {
+    if (IsChartExportCommand(__argc, __argv)) {
+        FILE* stream;
+        if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+            freopen_s(&stream, "CONOUT$", "w", stdout);
+            freopen_s(&stream, "CONOUT$", "w", stderr);
+        }
+        return RunChartExportCommand(__argc, __argv);
+    }
+    return wxEntry(instance, previousInstance, commandLine, showCommand);
+}
+#else
+/**
+ * @brief Entry point that runs a command-line job or starts the application
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments
+ * @return Exit code of the job or of the application
+ *
+ * Command-line jobs run before wxWidgets is initialized, so they need no display
+ * (e.g. "Air_quality_app --export-charts" on a server).
+ */
+int main(int argc, char* argv[]) {
+    if (IsChartExportCommand(argc, argv)) {
+        return RunChartExportCommand(argc, argv);
+    }
+    return wxEntry(argc, argv);
+}
+#endif
\ No newline at end of file